@@ -0,0 +1,257 @@
+#include "pch.h"
+
+FrameWriter::FrameWriter()
+{
+	field = new uint16_t[Width * Height];
+	memset(field, 0, Width * Height * sizeof(uint16_t));
+	rgb = new uint8_t[Width * Height * 3];
+	memset(rgb, 0, Width * Height * 3);
+}
+
+FrameWriter::~FrameWriter()
+{
+	if (y4m != nullptr)
+	{
+		fclose(y4m);
+	}
+	delete[] field;
+	delete[] rgb;
+	delete[] planes;
+}
+
+void FrameWriter::SetImageOutput(FrameFormat _format, const char* dir)
+{
+	format = _format;
+	image_dir = dir;
+}
+
+bool FrameWriter::OpenY4M(const char* filename, uint32_t rate_num, uint32_t rate_den)
+{
+	y4m = fopen(filename, "wb");
+	if (y4m == nullptr)
+		return false;
+
+	planes = new uint8_t[Width * Height * 3];
+	fprintf(y4m, "YUV4MPEG2 W%d H%d F%u:%u Ip A1:1 C444\n", Width, Height, rate_num, rate_den);
+	return true;
+}
+
+bool FrameWriter::Enabled()
+{
+	return format != FrameFormat::None || y4m != nullptr;
+}
+
+void FrameWriter::ProcessSample(size_t h, size_t v, PPUSim::VideoOutSignal& sample)
+{
+	if (h < Width && v < Height)
+	{
+		field[v * Width + h] = sample.RAW.raw;
+	}
+}
+
+bool FrameWriter::FieldDone(size_t field_num)
+{
+	bool ok = true;
+
+	ConvertField();
+
+	if (format != FrameFormat::None)
+	{
+		char filename[0x200]{};
+		snprintf(filename, sizeof(filename), "%s/frame_%06zu.%s", image_dir.c_str(), field_num, format == FrameFormat::PNG ? "png" : "ppm");
+		ok = format == FrameFormat::PNG ? WritePNG(filename) : WritePPM(filename);
+	}
+
+	if (y4m != nullptr)
+	{
+		WriteY4MFrame();
+	}
+
+	return ok;
+}
+
+void FrameWriter::ConvertField()
+{
+	PPUSim::VideoOutSignal sample{};
+	uint8_t* ptr = rgb;
+
+	for (size_t n = 0; n < Width * Height; n++)
+	{
+		sample.RAW.raw = field[n];
+
+		if (sample.RAW.Sync)
+		{
+			ptr[0] = ptr[1] = ptr[2] = 0;
+		}
+		else
+		{
+			ConvertRAWToRGB(sample.RAW.raw, &ptr[0], &ptr[1], &ptr[2]);
+		}
+		ptr += 3;
+	}
+}
+
+bool FrameWriter::WritePPM(const char* filename)
+{
+	FILE* f = fopen(filename, "wb");
+	if (f == nullptr)
+		return false;
+
+	fprintf(f, "P6\n%d %d\n255\n", Width, Height);
+	bool ok = fwrite(rgb, 1, Width * Height * 3, f) == Width * Height * 3;
+	fclose(f);
+	return ok;
+}
+
+/// <summary>
+/// The PNG is written without compression (stored deflate blocks), so that no zlib is needed.
+/// </summary>
+bool FrameWriter::WritePNG(const char* filename)
+{
+	FILE* f = fopen(filename, "wb");
+	if (f == nullptr)
+		return false;
+
+	static const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+	fwrite(signature, 1, sizeof(signature), f);
+
+	uint8_t ihdr[13]{};
+	PutBE32(&ihdr[0], Width);
+	PutBE32(&ihdr[4], Height);
+	ihdr[8] = 8;		// Bit depth
+	ihdr[9] = 2;		// Truecolor
+	WritePNGChunk(f, "IHDR", ihdr, sizeof(ihdr));
+
+	// Each row: filter type 0 + RGB
+
+	const size_t row_size = 1 + Width * 3;
+	const size_t raw_size = row_size * Height;
+	const size_t max_block = 0xffff;
+	const size_t num_blocks = (raw_size + max_block - 1) / max_block;
+
+	uint8_t* raw = new uint8_t[raw_size];
+	for (size_t y = 0; y < Height; y++)
+	{
+		raw[y * row_size] = 0;
+		memcpy(&raw[y * row_size + 1], &rgb[y * Width * 3], Width * 3);
+	}
+
+	size_t idat_size = 2 + num_blocks * 5 + raw_size + 4;
+	uint8_t* idat = new uint8_t[idat_size];
+	uint8_t* ptr = idat;
+
+	*ptr++ = 0x78;		// zlib header: deflate, 32K window, no compression
+	*ptr++ = 0x01;
+
+	uint32_t adler_a = 1, adler_b = 0;
+	size_t offset = 0;
+
+	while (offset < raw_size)
+	{
+		size_t block = std::min(max_block, raw_size - offset);
+		*ptr++ = offset + block == raw_size ? 1 : 0;	// BFINAL, BTYPE=00
+		*ptr++ = (uint8_t)block;
+		*ptr++ = (uint8_t)(block >> 8);
+		*ptr++ = (uint8_t)~block;
+		*ptr++ = (uint8_t)(~block >> 8);
+		memcpy(ptr, &raw[offset], block);
+		ptr += block;
+
+		for (size_t n = 0; n < block; n++)
+		{
+			adler_a = (adler_a + raw[offset + n]) % 65521;
+			adler_b = (adler_b + adler_a) % 65521;
+		}
+		offset += block;
+	}
+
+	PutBE32(ptr, (adler_b << 16) | adler_a);
+	WritePNGChunk(f, "IDAT", idat, idat_size);
+	WritePNGChunk(f, "IEND", nullptr, 0);
+
+	delete[] raw;
+	delete[] idat;
+
+	bool ok = ferror(f) == 0;
+	fclose(f);
+	return ok;
+}
+
+void FrameWriter::WritePNGChunk(FILE* f, const char* type, const uint8_t* data, size_t size)
+{
+	uint8_t buf[4];
+
+	PutBE32(buf, (uint32_t)size);
+	fwrite(buf, 1, 4, f);
+	fwrite(type, 1, 4, f);
+	if (size != 0)
+	{
+		fwrite(data, 1, size, f);
+	}
+
+	uint32_t crc = Crc32(0xffffffff, (const uint8_t*)type, 4);
+	if (size != 0)
+	{
+		crc = Crc32(crc, data, size);
+	}
+	PutBE32(buf, crc ^ 0xffffffff);
+	fwrite(buf, 1, 4, f);
+}
+
+uint32_t FrameWriter::Crc32(uint32_t crc, const uint8_t* data, size_t size)
+{
+	static uint32_t table[256]{};
+	static bool table_ready = false;
+
+	if (!table_ready)
+	{
+		for (uint32_t n = 0; n < 256; n++)
+		{
+			uint32_t c = n;
+			for (int k = 0; k < 8; k++)
+			{
+				c = (c & 1) ? 0xedb88320 ^ (c >> 1) : c >> 1;
+			}
+			table[n] = c;
+		}
+		table_ready = true;
+	}
+
+	for (size_t n = 0; n < size; n++)
+	{
+		crc = table[(crc ^ data[n]) & 0xff] ^ (crc >> 8);
+	}
+	return crc;
+}
+
+void FrameWriter::PutBE32(uint8_t* ptr, uint32_t value)
+{
+	ptr[0] = (uint8_t)(value >> 24);
+	ptr[1] = (uint8_t)(value >> 16);
+	ptr[2] = (uint8_t)(value >> 8);
+	ptr[3] = (uint8_t)value;
+}
+
+/// <summary>
+/// BT.601 (studio range) RGB -> YCbCr, without chroma subsampling.
+/// </summary>
+void FrameWriter::WriteY4MFrame()
+{
+	uint8_t* y_plane = planes;
+	uint8_t* cb_plane = planes + Width * Height;
+	uint8_t* cr_plane = planes + 2 * Width * Height;
+
+	for (size_t n = 0; n < Width * Height; n++)
+	{
+		int r = rgb[3 * n];
+		int g = rgb[3 * n + 1];
+		int b = rgb[3 * n + 2];
+
+		y_plane[n] = (uint8_t)(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+		cb_plane[n] = (uint8_t)((-38 * r - 74 * g + 112 * b + 128 + (128 << 8)) >> 8);
+		cr_plane[n] = (uint8_t)((112 * r - 94 * g - 18 * b + 128 + (128 << 8)) >> 8);
+	}
+
+	fputs("FRAME\n", y4m);
+	fwrite(planes, 1, Width * Height * 3, y4m);
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+/// <summary>
+/// Image format of the separate frame files.
+/// </summary>
+enum class FrameFormat
+{
+	None = 0,
+	PPM,
+	PNG,
+};
+
+/// <summary>
+/// Saves the visible part of the PPU fields (256x240) as PPM/PNG files and/or as a raw Y4M stream.
+/// The field is collected from the RAW color samples (SetRAWColorMode) and converted to RGB by ConvertRAWToRGB.
+/// </summary>
+class FrameWriter
+{
+	static const int Width = 256;
+	static const int Height = 240;
+
+	uint16_t* field = nullptr;		// RAW color of each visible pixel
+	uint8_t* rgb = nullptr;
+
+	FrameFormat format = FrameFormat::None;
+	std::string image_dir;
+
+	FILE* y4m = nullptr;
+	uint8_t* planes = nullptr;		// Y, Cb, Cr (4:4:4)
+
+	void ConvertField();
+	bool WritePPM(const char* filename);
+	bool WritePNG(const char* filename);
+	void WriteY4MFrame();
+
+	static uint32_t Crc32(uint32_t crc, const uint8_t* data, size_t size);
+	static void PutBE32(uint8_t* ptr, uint32_t value);
+	static void WritePNGChunk(FILE* f, const char* type, const uint8_t* data, size_t size);
+
+public:
+	FrameWriter();
+	~FrameWriter();
+
+	/// <summary>
+	/// Save each field to the specified directory as frame_NNNNNN.ppm/png.
+	/// </summary>
+	void SetImageOutput(FrameFormat format, const char* dir);
+
+	/// <summary>
+	/// Create the Y4M file. The frame rate is given as a fraction (fields per second of the simulated time).
+	/// </summary>
+	/// <returns>false: the file cannot be created</returns>
+	bool OpenY4M(const char* filename, uint32_t rate_num, uint32_t rate_den);
+
+	/// <summary>
+	/// true: at least one output is set, so the fields need to be collected.
+	/// </summary>
+	bool Enabled();
+
+	/// <summary>
+	/// Put the sample of the PPU video output. The samples outside the visible part are ignored.
+	/// </summary>
+	void ProcessSample(size_t h, size_t v, PPUSim::VideoOutSignal& sample);
+
+	/// <summary>
+	/// The field is over: write it to all outputs.
+	/// </summary>
+	/// <param name="field_num">Field number, used in the image file names</param>
+	/// <returns>false: write error</returns>
+	bool FieldDone(size_t field_num);
+};
@@ -0,0 +1,128 @@
+#include "pch.h"
+
+PerfReport::PerfReport()
+{
+}
+
+PerfReport::~PerfReport()
+{
+	delete[] field_ms;
+}
+
+void PerfReport::Start()
+{
+	start_time = Clock::now();
+	field_start = start_time;
+}
+
+void PerfReport::FieldDone()
+{
+	Clock::time_point now = Clock::now();
+
+	if (num_fields >= max_fields)
+	{
+		size_t capacity = max_fields != 0 ? max_fields * 2 : 256;
+		double* mem = new double[capacity];
+		if (field_ms != nullptr)
+		{
+			memcpy(mem, field_ms, num_fields * sizeof(double));
+		}
+		delete[] field_ms;
+		field_ms = mem;
+		max_fields = capacity;
+	}
+
+	field_ms[num_fields++] = std::chrono::duration<double, std::milli>(now - field_start).count();
+	field_start = now;
+}
+
+void PerfReport::Stop()
+{
+	wall_seconds = std::chrono::duration<double>(Clock::now() - start_time).count();
+}
+
+double PerfReport::GetWallSeconds()
+{
+	return wall_seconds;
+}
+
+/// <summary>
+/// Escape the string for JSON (paths may contain backslashes). nullptr is saved as null.
+/// </summary>
+static void PutJsonString(FILE* f, const char* str)
+{
+	if (str == nullptr)
+	{
+		fputs("null", f);
+		return;
+	}
+
+	fputc('"', f);
+	for (const char* ptr = str; *ptr; ptr++)
+	{
+		if (*ptr == '"' || *ptr == '\\')
+		{
+			fputc('\\', f);
+			fputc(*ptr, f);
+		}
+		else if ((uint8_t)*ptr < 0x20)
+		{
+			fprintf(f, "\\u%04x", (uint8_t)*ptr);
+		}
+		else
+		{
+			fputc(*ptr, f);
+		}
+	}
+	fputc('"', f);
+}
+
+bool PerfReport::Save(const char* filename, RunInfo& info)
+{
+	FILE* f = fopen(filename, "wt");
+	if (f == nullptr)
+		return false;
+
+	double sim_seconds = info.clk / (2.0 * info.clk_hz);
+	double sim_mhz = wall_seconds > 0 ? info.clk / 2.0 / wall_seconds / 1e6 : 0;
+	double realtime = wall_seconds > 0 ? 100.0 * sim_seconds / wall_seconds : 0;
+
+	double min_ms = 0, max_ms = 0, sum_ms = 0;
+	for (size_t n = 0; n < num_fields; n++)
+	{
+		min_ms = n == 0 ? field_ms[n] : std::min(min_ms, field_ms[n]);
+		max_ms = std::max(max_ms, field_ms[n]);
+		sum_ms += field_ms[n];
+	}
+
+	fprintf(f, "{\n");
+	fprintf(f, "\t\"rom\": "); PutJsonString(f, info.rom); fprintf(f, ",\n");
+	fprintf(f, "\t\"board\": "); PutJsonString(f, info.board); fprintf(f, ",\n");
+	fprintf(f, "\t\"apu\": "); PutJsonString(f, info.apu); fprintf(f, ",\n");
+	fprintf(f, "\t\"ppu\": "); PutJsonString(f, info.ppu); fprintf(f, ",\n");
+	fprintf(f, "\t\"movie\": "); PutJsonString(f, info.movie); fprintf(f, ",\n");
+	fprintf(f, "\t\"clk_hz\": %.0f,\n", info.clk_hz);
+	fprintf(f, "\t\"clk_half_cycles\": %llu,\n", (unsigned long long)info.clk);
+	fprintf(f, "\t\"cpu_cycles\": %llu,\n", (unsigned long long)info.cpu_cycles);
+	fprintf(f, "\t\"fields\": %zu,\n", num_fields);
+	fprintf(f, "\t\"simulated_seconds\": %.6f,\n", sim_seconds);
+	fprintf(f, "\t\"wall_seconds\": %.6f,\n", wall_seconds);
+	fprintf(f, "\t\"simulated_mhz\": %.6f,\n", sim_mhz);
+	fprintf(f, "\t\"realtime_percent\": %.6f,\n", realtime);
+	fprintf(f, "\t\"field_wall_ms\": {\n");
+	fprintf(f, "\t\t\"min\": %.3f,\n", min_ms);
+	fprintf(f, "\t\t\"avg\": %.3f,\n", num_fields != 0 ? sum_ms / num_fields : 0);
+	fprintf(f, "\t\t\"max\": %.3f,\n", max_ms);
+	fprintf(f, "\t\t\"each\": [");
+	for (size_t n = 0; n < num_fields; n++)
+	{
+		fprintf(f, "%s%.3f", n != 0 ? ", " : "", field_ms[n]);
+	}
+	fprintf(f, "]\n");
+	fprintf(f, "\t}\n");
+	fprintf(f, "}\n");
+
+	bool ok = ferror(f) == 0;
+	fclose(f);
+	return ok;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+/// <summary>
+/// Measures the simulation speed (wall time of each field) and saves the summary as JSON.
+/// </summary>
+class PerfReport
+{
+	using Clock = std::chrono::steady_clock;
+
+	Clock::time_point start_time;
+	Clock::time_point field_start;
+	double wall_seconds = 0;
+
+	double* field_ms = nullptr;		// Wall time of each field (ms)
+	size_t num_fields = 0;
+	size_t max_fields = 0;
+
+public:
+	PerfReport();
+	~PerfReport();
+
+	/// <summary>
+	/// Start the clock (right before the run).
+	/// </summary>
+	void Start();
+
+	/// <summary>
+	/// Called at the end of each field.
+	/// </summary>
+	void FieldDone();
+
+	/// <summary>
+	/// Stop the clock (right after the run).
+	/// </summary>
+	void Stop();
+
+	double GetWallSeconds();
+
+	/// <summary>
+	/// The description of the run, put into the report as is.
+	/// </summary>
+	struct RunInfo
+	{
+		const char* rom;
+		const char* board;
+		const char* apu;
+		const char* ppu;
+		const char* movie;
+		uint64_t clk;				// CLK half cycles simulated
+		uint64_t cpu_cycles;		// PHI cycles simulated
+		double clk_hz;				// Master clock of the board
+	};
+
+	/// <summary>
+	/// Save the report.
+	/// </summary>
+	/// <returns>false: the file cannot be created</returns>
+	bool Save(const char* filename, RunInfo& info);
+};
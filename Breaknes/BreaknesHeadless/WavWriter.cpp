@@ -0,0 +1,108 @@
+#include "pch.h"
+
+WavWriter::WavWriter()
+{
+}
+
+WavWriter::~WavWriter()
+{
+	if (f != nullptr)
+	{
+		Flush();
+		WriteHeader();
+		fclose(f);
+	}
+	delete[] buf;
+}
+
+bool WavWriter::Open(const char* filename, uint32_t _output_rate, uint64_t _input_rate)
+{
+	f = fopen(filename, "wb");
+	if (f == nullptr)
+		return false;
+
+	output_rate = _output_rate;
+	input_rate = _input_rate;
+	acc = 0;
+	num_samples = 0;
+
+	buf = new int16_t[BufSize];
+	buf_ptr = 0;
+
+	// The header is overwritten with the actual size at the end
+
+	WriteHeader();
+	return true;
+}
+
+bool WavWriter::Enabled()
+{
+	return f != nullptr;
+}
+
+void WavWriter::FeedSample()
+{
+	acc += output_rate;
+	if (acc < input_rate)
+		return;
+	acc -= input_rate;
+
+	float sample;
+	SampleAudioSignal(&sample);
+
+	sample = std::max(-1.0f, std::min(1.0f, sample));
+	buf[buf_ptr++] = (int16_t)(sample * (float)INT16_MAX);
+	num_samples++;
+
+	if (buf_ptr >= BufSize)
+	{
+		Flush();
+	}
+}
+
+uint32_t WavWriter::GetSampleCount()
+{
+	return num_samples;
+}
+
+void WavWriter::Flush()
+{
+	fwrite(buf, sizeof(int16_t), buf_ptr, f);
+	buf_ptr = 0;
+}
+
+/// <summary>
+/// RIFF/WAVE header of the PCM 16-bit mono file (little endian).
+/// </summary>
+void WavWriter::WriteHeader()
+{
+	uint8_t header[44]{};
+	uint32_t data_size = num_samples * sizeof(int16_t);
+
+	auto put16 = [&](size_t offset, uint16_t value) {
+		header[offset] = (uint8_t)value;
+		header[offset + 1] = (uint8_t)(value >> 8);
+	};
+	auto put32 = [&](size_t offset, uint32_t value) {
+		put16(offset, (uint16_t)value);
+		put16(offset + 2, (uint16_t)(value >> 16));
+	};
+
+	memcpy(&header[0], "RIFF", 4);
+	put32(4, 36 + data_size);
+	memcpy(&header[8], "WAVE", 4);
+	memcpy(&header[12], "fmt ", 4);
+	put32(16, 16);
+	put16(20, 1);						// PCM
+	put16(22, 1);						// Mono
+	put32(24, output_rate);
+	put32(28, output_rate * sizeof(int16_t));
+	put16(32, sizeof(int16_t));
+	put16(34, 16);
+	memcpy(&header[36], "data", 4);
+	put32(40, data_size);
+
+	fseek(f, 0, SEEK_SET);
+	fwrite(header, 1, sizeof(header), f);
+	fseek(f, 0, SEEK_END);
+}
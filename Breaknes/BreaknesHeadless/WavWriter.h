@@ -0,0 +1,44 @@
+#pragma once
+
+/// <summary>
+/// Resamples the board audio output to the output rate and writes it to a 16-bit mono WAV file.
+/// The sample is taken when the fractional accumulator crosses the simulated half cycle, so the rate is exact on average (not just an integer decimation).
+/// </summary>
+class WavWriter
+{
+	FILE* f = nullptr;
+	uint32_t output_rate = 0;
+	uint64_t input_rate = 0;		// CLK half cycles per second
+	uint64_t acc = 0;
+	uint32_t num_samples = 0;
+
+	int16_t* buf = nullptr;
+	size_t buf_ptr = 0;
+	static const size_t BufSize = 0x1000;
+
+	void WriteHeader();
+	void Flush();
+
+public:
+	WavWriter();
+	~WavWriter();
+
+	/// <summary>
+	/// Create the WAV file.
+	/// </summary>
+	/// <param name="input_rate">Frequency of FeedSample calls (CLK half cycles per second of the simulated time)</param>
+	/// <returns>false: the file cannot be created</returns>
+	bool Open(const char* filename, uint32_t output_rate, uint64_t input_rate);
+
+	bool Enabled();
+
+	/// <summary>
+	/// Called after each simulated half cycle.
+	/// </summary>
+	void FeedSample();
+
+	/// <summary>
+	/// Number of the samples written.
+	/// </summary>
+	uint32_t GetSampleCount();
+};
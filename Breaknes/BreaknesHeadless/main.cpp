@@ -0,0 +1,387 @@
+#include "pch.h"
+
+/// <summary>
+/// Command line of the headless run.
+/// </summary>
+struct Options
+{
+	const char* rom = nullptr;
+	const char* board = "NES";
+	const char* apu = "RP2A03G";
+	const char* ppu = "RP2C02G";
+	const char* p1 = "NES";
+
+	// Run length (the first one that is set; by default 60 fields)
+
+	size_t frames = 0;
+	uint64_t cycles = 0;
+	double seconds = 0;
+
+	const char* movie = nullptr;
+	size_t controller_port[IO_MaxPorts]{};
+	uint32_t controller_id[IO_MaxPorts]{};
+	size_t num_controllers = 0;
+
+	FrameFormat image_format = FrameFormat::None;
+	const char* image_dir = nullptr;
+	size_t frame_step = 1;
+	const char* y4m = nullptr;
+	const char* wav = nullptr;
+	const char* report = nullptr;
+	const char* pla_cache = nullptr;
+	bool quiet = false;
+};
+
+static void Usage()
+{
+	printf("Use: breaknes-headless <file.nes> [options]\n");
+	printf("\n");
+	printf("Board:\n");
+	printf("  --board NAME            Motherboard (default: NES; HVC-xxx: Famicom)\n");
+	printf("  --apu REV               APU revision (default: RP2A03G)\n");
+	printf("  --ppu REV               PPU revision (default: RP2C02G)\n");
+	printf("  --p1 NAME               P1 board (default: NES)\n");
+	printf("\n");
+	printf("Run length (default: --frames 60):\n");
+	printf("  --frames N              Simulate N PPU fields\n");
+	printf("  --cycles N              Simulate N CPU (PHI) cycles\n");
+	printf("  --seconds S             Simulate S seconds of the emulated time\n");
+	printf("\n");
+	printf("Input:\n");
+	printf("  --movie FILE            Play back the input movie (started right after Reset)\n");
+	printf("  --controller PORT:ID    Attach the IO device to the port (repeat for each port; the order must be the same as at recording).\n");
+	printf("                          Default with --movie: the standard controller(s) of the board\n");
+	printf("\n");
+	printf("Output:\n");
+	printf("  --ppm DIR               Save each field as DIR/frame_NNNNNN.ppm\n");
+	printf("  --png DIR               Save each field as DIR/frame_NNNNNN.png\n");
+	printf("  --frame-step N          Save only each Nth field as image (default: 1)\n");
+	printf("  --y4m FILE              Save all fields as a raw Y4M (4:4:4) stream\n");
+	printf("  --wav FILE              Save the audio as a 48 kHz 16-bit mono WAV\n");
+	printf("  --report FILE           Save the performance report (JSON)\n");
+	printf("  --pla-cache DIR         Where the chips cache their PLA matrices (*.bin; default: the current directory)\n");
+	printf("  --quiet                 Do not print the progress\n");
+}
+
+static bool ParseOptions(int argc, char** argv, Options& opts)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		std::string arg = argv[i];
+		bool has_value = i + 1 < argc;
+
+		if (arg[0] != '-')
+		{
+			if (opts.rom != nullptr)
+			{
+				printf("Only one ROM can be specified: %s\n", argv[i]);
+				return false;
+			}
+			opts.rom = argv[i];
+			continue;
+		}
+
+		if (arg == "--quiet")
+		{
+			opts.quiet = true;
+			continue;
+		}
+
+		if (!has_value)
+		{
+			printf("Option %s requires a value\n", argv[i]);
+			return false;
+		}
+
+		const char* value = argv[++i];
+
+		if (arg == "--board") opts.board = value;
+		else if (arg == "--apu") opts.apu = value;
+		else if (arg == "--ppu") opts.ppu = value;
+		else if (arg == "--p1") opts.p1 = value;
+		else if (arg == "--frames") opts.frames = strtoull(value, nullptr, 0);
+		else if (arg == "--cycles") opts.cycles = strtoull(value, nullptr, 0);
+		else if (arg == "--seconds") opts.seconds = atof(value);
+		else if (arg == "--movie") opts.movie = value;
+		else if (arg == "--controller")
+		{
+			char* end = nullptr;
+			size_t port = strtoul(value, &end, 0);
+			if (end == value || *end != ':' || opts.num_controllers >= IO_MaxPorts)
+			{
+				printf("Wrong controller: %s (expected PORT:ID)\n", value);
+				return false;
+			}
+			opts.controller_port[opts.num_controllers] = port;
+			opts.controller_id[opts.num_controllers] = (uint32_t)strtoul(end + 1, nullptr, 0);
+			opts.num_controllers++;
+		}
+		else if (arg == "--ppm" || arg == "--png")
+		{
+			opts.image_format = arg == "--png" ? FrameFormat::PNG : FrameFormat::PPM;
+			opts.image_dir = value;
+		}
+		else if (arg == "--frame-step") opts.frame_step = std::max<size_t>(1, strtoull(value, nullptr, 0));
+		else if (arg == "--y4m") opts.y4m = value;
+		else if (arg == "--wav") opts.wav = value;
+		else if (arg == "--report") opts.report = value;
+		else if (arg == "--pla-cache") opts.pla_cache = value;
+		else
+		{
+			printf("Unknown option: %s\n", argv[i]);
+			return false;
+		}
+	}
+
+	if (opts.rom == nullptr)
+	{
+		return false;
+	}
+
+	if (opts.frames == 0 && opts.cycles == 0 && opts.seconds <= 0)
+	{
+		opts.frames = 60;
+	}
+
+	return true;
+}
+
+static uint8_t* LoadFile(const char* filename, size_t* size)
+{
+	FILE* f = fopen(filename, "rb");
+	if (f == nullptr)
+		return nullptr;
+
+	fseek(f, 0, SEEK_END);
+	long file_size = ftell(f);
+	fseek(f, 0, SEEK_SET);
+
+	uint8_t* data = new uint8_t[file_size];
+	if (fread(data, 1, file_size, f) != (size_t)file_size)
+	{
+		delete[] data;
+		fclose(f);
+		return nullptr;
+	}
+	fclose(f);
+
+	*size = file_size;
+	return data;
+}
+
+/// <summary>
+/// Create the IO devices and attach them to the ports. The handles are given in the order of creation, so the movie must be played with the devices created in the same order as at recording.
+/// </summary>
+static void AttachControllers(Options& opts)
+{
+	if (opts.num_controllers == 0 && opts.movie != nullptr)
+	{
+		if (std::string(opts.board).find("HVC") != std::string::npos)
+		{
+			opts.controller_port[0] = 0;
+			opts.controller_id[0] = (uint32_t)IO::DeviceID::FamiController_1;
+			opts.controller_port[1] = 1;
+			opts.controller_id[1] = (uint32_t)IO::DeviceID::FamiController_2;
+			opts.num_controllers = 2;
+		}
+		else
+		{
+			opts.controller_port[0] = 0;
+			opts.controller_id[0] = (uint32_t)IO::DeviceID::NESController;
+			opts.num_controllers = 1;
+		}
+	}
+
+	for (size_t n = 0; n < opts.num_controllers; n++)
+	{
+		size_t handle = IOCreateInstance(opts.controller_id[n]);
+		IOAttach(opts.controller_port[n], handle);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	Options opts;
+
+	if (!ParseOptions(argc, argv, opts))
+	{
+		Usage();
+		return -1;
+	}
+
+	size_t nes_image_size = 0;
+	uint8_t* nes_image = LoadFile(opts.rom, &nes_image_size);
+	if (nes_image == nullptr)
+	{
+		printf("Cannot load: %s\n", opts.rom);
+		return -2;
+	}
+
+	// The chips save their optimized PLA matrices (Decoder6502.bin, HPLA_xxx.bin, ...) on the first run and load them afterwards
+
+	if (opts.pla_cache != nullptr)
+	{
+		BaseLogic::PLA::SetCacheDir(opts.pla_cache);
+	}
+
+	CreateBoard((char*)opts.board, (char*)opts.apu, (char*)opts.ppu, (char*)opts.p1);
+
+	if (InsertCartridge(nes_image, nes_image_size) < 0)
+	{
+		printf("InsertCartridge failed!\n");
+		delete[] nes_image;
+		DestroyBoard();
+		return -3;
+	}
+
+	// The cartridge keeps its own (shared) copy of the ROM contents
+	delete[] nes_image;
+
+	AttachControllers(opts);
+	Reset();
+
+	SetOamDecayBehavior(PPUSim::OAMDecayBehavior::Keep);
+	SetRAWColorMode(true);
+
+	if (opts.movie != nullptr && StartInputPlayback((char*)opts.movie) < 0)
+	{
+		printf("Cannot play the movie: %s\n", opts.movie);
+		DestroyBoard();
+		return -4;
+	}
+
+	// The master clock of the board is taken from the video standard of the PPU (APUSim reports only the NTSC rate so far)
+
+	PPUSim::VideoSignalFeatures ppu_features{};
+	GetPpuSignalFeatures(&ppu_features);
+
+	bool pal = ppu_features.ScansPerField == 312;
+	double clk_hz = pal ? 26601712.0 : 21477272.0;
+	uint64_t half_cycles_per_second = (uint64_t)(2 * clk_hz);
+
+	FrameWriter* frames = new FrameWriter();
+	WavWriter* wav = new WavWriter();
+	PerfReport* perf = new PerfReport();
+	int result = 0;
+
+	if (opts.image_dir != nullptr)
+	{
+		frames->SetImageOutput(opts.image_format, opts.image_dir);
+	}
+
+	if (opts.y4m != nullptr)
+	{
+		uint32_t half_cycles_per_field = (uint32_t)(ppu_features.SamplesPerPCLK * ppu_features.PixelsPerScan * ppu_features.ScansPerField);
+		if (!frames->OpenY4M(opts.y4m, (uint32_t)half_cycles_per_second, half_cycles_per_field))
+		{
+			printf("Cannot create: %s\n", opts.y4m);
+			result = -5;
+		}
+	}
+
+	if (opts.wav != nullptr)
+	{
+		const uint32_t OutputSampleRate = 48000;
+		SetAudioFilter(Breaknes::AudioFilterPlacement::ExactRate, OutputSampleRate);
+
+		if (!wav->Open(opts.wav, OutputSampleRate, half_cycles_per_second))
+		{
+			printf("Cannot create: %s\n", opts.wav);
+			result = -5;
+		}
+	}
+
+	uint64_t max_clk = opts.seconds > 0 ? (uint64_t)(opts.seconds * half_cycles_per_second) : 0;
+	uint64_t phi_start = GetPHICounter();
+	uint64_t clk = 0;
+	size_t fields = 0;
+	size_t prev_v = 0;
+	bool video = frames->Enabled();
+	bool audio = wav->Enabled();
+
+	perf->Start();
+
+	while (result == 0)
+	{
+		if (opts.frames != 0 && fields >= opts.frames)
+			break;
+		if (opts.cycles != 0 && GetPHICounter() - phi_start >= opts.cycles)
+			break;
+		if (max_clk != 0 && clk >= max_clk)
+			break;
+
+		Step();
+		clk++;
+
+		if (InResetState())
+			continue;
+
+		if (audio)
+		{
+			wav->FeedSample();
+		}
+
+		size_t v = GetVCounter();
+
+		if (v == 0 && prev_v != 0)
+		{
+			if (video && (fields % opts.frame_step) == 0 && !frames->FieldDone(fields))
+			{
+				printf("Cannot save the field %zu\n", fields);
+				result = -6;
+			}
+
+			perf->FieldDone();
+			fields++;
+
+			if (!opts.quiet)
+			{
+				printf("field: %zu\n", fields);
+			}
+		}
+		prev_v = v;
+
+		if (video)
+		{
+			PPUSim::VideoOutSignal sample;
+			SampleVideoSignal(&sample);
+			frames->ProcessSample(GetHCounter(), v, sample);
+		}
+	}
+
+	perf->Stop();
+
+	uint64_t cpu_cycles = GetPHICounter() - phi_start;
+	printf("Simulated: %zu fields, %llu CLK half cycles, %llu CPU cycles in %.3f s (%.3f%% of realtime)\n",
+		fields, (unsigned long long)clk, (unsigned long long)cpu_cycles, perf->GetWallSeconds(),
+		perf->GetWallSeconds() > 0 ? 100.0 * clk / half_cycles_per_second / perf->GetWallSeconds() : 0);
+
+	if (opts.report != nullptr)
+	{
+		PerfReport::RunInfo info{};
+		info.rom = opts.rom;
+		info.board = opts.board;
+		info.apu = opts.apu;
+		info.ppu = opts.ppu;
+		info.movie = opts.movie;
+		info.clk = clk;
+		info.cpu_cycles = cpu_cycles;
+		info.clk_hz = clk_hz;
+
+		if (!perf->Save(opts.report, info))
+		{
+			printf("Cannot create: %s\n", opts.report);
+			result = -5;
+		}
+	}
+
+	delete frames;
+	delete wav;
+	delete perf;
+
+	StopInputMovie();
+	EjectCartridge();
+	DestroyBoard();
+
+	return result;
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <algorithm>
+#include <chrono>
+
+#include "../BreaksCore/BreaksCore.h"
+#include "FrameWriter.h"
+#include "WavWriter.h"
+#include "PerfReport.h"
@@ -73,6 +73,9 @@ int main(int argc, char ** argv) {
 		return -4;
 	}
 
+	// The cartridge keeps its own (shared) copy of the ROM contents
+	delete[] nes_image;
+
 	bool quit = false;
 
 #if !CONSOLE_ONLY
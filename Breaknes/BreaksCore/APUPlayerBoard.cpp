@@ -34,20 +34,20 @@ namespace Breaknes
 	{
 		// Simulate APU
 
-		TriState inputs[(size_t)APUSim::APU_Input::Max]{};
-		TriState outputs[(size_t)APUSim::APU_Output::Max]{};
+		Pins32 inputs{};
+		Pins32 outputs{};
 
-		inputs[(size_t)APUSim::APU_Input::CLK] = CLK;
+		inputs.set((size_t)APUSim::APU_Input::CLK, CLK);
 
-		inputs[(size_t)APUSim::APU_Input::n_NMI] = TriState::One;
-		inputs[(size_t)APUSim::APU_Input::n_IRQ] = TriState::One;
-		inputs[(size_t)APUSim::APU_Input::n_RES] = in_reset ? TriState::Zero : TriState::One;
-		inputs[(size_t)APUSim::APU_Input::DBG] = TriState::Zero;
+		inputs.set((size_t)APUSim::APU_Input::n_NMI, TriState::One);
+		inputs.set((size_t)APUSim::APU_Input::n_IRQ, TriState::One);
+		inputs.set((size_t)APUSim::APU_Input::n_RES, in_reset ? TriState::Zero : TriState::One);
+		inputs.set((size_t)APUSim::APU_Input::DBG, TriState::Zero);
 
 		apu->sim(inputs, outputs, &data_bus, &addr_bus, aux);
 
-		TriState RnW = outputs[(size_t)APUSim::APU_Output::RnW];
-		TriState M2 = outputs[(size_t)APUSim::APU_Output::M2];		// There doesn't seem to be any use for it...
+		TriState RnW = outputs.get((size_t)APUSim::APU_Output::RnW);
+		TriState M2 = outputs.get((size_t)APUSim::APU_Output::M2);		// There doesn't seem to be any use for it...
 
 		if (RnW == TriState::Z)
 		{
@@ -62,6 +62,11 @@ namespace Breaknes
 		bool dz = false;
 		wram->sim(NOT(wram_cs), n_WE, n_OE, &wram_addr, &data_bus, dz);
 
+		if (events)
+		{
+			TreatEvents(apu->GetPHI2(), RnW, TriState::One, TriState::One);
+		}
+
 		// Tick
 
 		CLK = NOT(CLK);
@@ -89,4 +94,27 @@ namespace Breaknes
 			core->SetRegDump(data, data_size);
 		}
 	}
+
+	bool APUPlayerBoard::MapRegDump(const char* filename)
+	{
+		return core->MapRegDump(filename);
+	}
+
+	int APUPlayerBoard::SeekRegDump(size_t frame)
+	{
+		int resume_frame = core->GetRegDumpSeekFrame(frame);
+		if (resume_frame < 0)
+			return -1;
+
+		Reset();
+
+		uint8_t* state = nullptr;
+		size_t state_size = 0;
+		core->SeekRegDump(frame, &state, &state_size);
+		if (state != nullptr)
+		{
+			LoadRegDumpState(state, state_size);
+		}
+		return resume_frame;
+	}
 }
@@ -21,6 +21,7 @@ namespace Breaknes
 		bool in_reset = false;
 
 		static uint8_t DumpWRAM(void* opaque, size_t addr);
+		static uint8_t* SpanWRAM(void* opaque);
 		static void WriteWRAM(void* opaque, size_t addr, uint8_t data);
 
 		static uint32_t GetApuDebugInfo(void* opaque, DebugInfoEntry* entry);
@@ -47,5 +48,9 @@ namespace Breaknes
 		bool InResetState() override;
 
 		void LoadRegDump(uint8_t* data, size_t data_size) override;
+
+		bool MapRegDump(const char* filename) override;
+
+		int SeekRegDump(size_t frame) override;
 	};
 }
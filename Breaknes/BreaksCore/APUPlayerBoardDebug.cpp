@@ -16,7 +16,7 @@ namespace Breaknes
 		memset(wramRegion, 0, sizeof(MemDesciptor));
 		strcpy(wramRegion->name, WRAM_NAME);
 		wramRegion->size = (int32_t)wram->Dbg_GetSize();
-		dbg_hub->AddMemRegion(wramRegion, DumpWRAM, WriteWRAM, this, false);
+		dbg_hub->AddMemRegion(wramRegion, DumpWRAM, WriteWRAM, this, false, SpanWRAM);
 	}
 
 	static SignalOffsetPair board_signals[] = {
@@ -131,6 +131,12 @@ namespace Breaknes
 		return board->wram->Dbg_ReadByte(addr);
 	}
 
+	uint8_t* APUPlayerBoard::SpanWRAM(void* opaque)
+	{
+		APUPlayerBoard* board = (APUPlayerBoard*)opaque;
+		return board->wram->Dbg_GetMemory();
+	}
+
 	void APUPlayerBoard::WriteWRAM(void* opaque, size_t addr, uint8_t data)
 	{
 		APUPlayerBoard* board = (APUPlayerBoard*)opaque;
@@ -7,6 +7,7 @@ namespace Breaknes
 	{
 		p1_type = p1;
 		pal = new RGB_Triplet[8 * 64];
+		hub = dbg_hub;
 	}
 
 	Board::~Board()
@@ -16,6 +17,14 @@ namespace Breaknes
 			delete ppu_regdump;
 		if (apu_regdump)
 			delete apu_regdump;
+		if (recorder)
+			delete recorder;
+		if (events)
+			delete events;
+		if (snapshot)
+			delete snapshot;
+		if (movie)
+			delete movie;
 	}
 
 	int Board::InsertCartridge(uint8_t* nesImage, size_t nesImageSize)
@@ -37,9 +46,28 @@ namespace Breaknes
 			return -2;
 		}
 
+		cart_strobe_driven = cart->StrobeDriven();
+		ResetCartBus();
+
 		return 0;
 	}
 
+	bool Board::CartBusActive(BaseLogic::TriState nROMSEL, BaseLogic::TriState PPU_nRD, BaseLogic::TriState PPU_nWR)
+	{
+		if (!cart_strobe_driven)
+			return true;
+
+		bool strobed = nROMSEL != BaseLogic::TriState::One || PPU_nRD != BaseLogic::TriState::One || PPU_nWR != BaseLogic::TriState::One;
+		bool active = strobed || cart_bus_strobed;
+		cart_bus_strobed = strobed;
+		return active;
+	}
+
+	void Board::ResetCartBus()
+	{
+		cart_bus_strobed = true;
+	}
+
 	void Board::EjectCartridge()
 	{
 		if (cart)
@@ -71,27 +99,242 @@ namespace Breaknes
 		return apu->GetPHICounter();
 	}
 
+	float Board::MixAudio()
+	{
+		// There are 2 resistors (12k and 20k) on the motherboard that equalize the AUX A/B levels and then mix.
+		// Although the internal resistance of the AUX A/B terminals inside the APU we counted with the 100 ohm pull-ups -- the above 2 resistors are part of the "Board", so they count here.
+
+		return (aux.normalized.a * 0.4f /* 20k resistor */ + aux.normalized.b /* 12k resistor */) / 2.0f;
+
+		// This is essentially "muting" AUX A, because the level of AUX A at its peak is about 300 mV, and the level of AUX B at its peak is about 1100 mV.
+		// Accordingly, if you do just (A+B)/2, the square channels will be "overshoot".
+	}
+
 	void Board::SampleAudioSignal(float* sample)
 	{
-		// NES/Famicom motherboards have some analog circuitry that acts as a LPF/HPF. Now the sound from the simulator comes without filtering, so there may be some ear-unpleasant harmonics.
-		// TBD: Add LPF/HPF
+		// NES/Famicom motherboards have some analog circuitry that acts as a LPF/HPF. Without the board filters (see SetAudioFilter) the sound comes unfiltered, so there may be some ear-unpleasant harmonics.
 
 		if (sample != nullptr)
 		{
-			// There are 2 resistors (12k and 20k) on the motherboard that equalize the AUX A/B levels and then mix.
-			// Although the internal resistance of the AUX A/B terminals inside the APU we counted with the 100 ohm pull-ups -- the above 2 resistors are part of the "Board", so they count here.
+			switch (audio_placement)
+			{
+				case AudioFilterPlacement::ExactRate:
+					*sample = audio_filtered;
+					break;
+
+				case AudioFilterPlacement::PostResample:
+					*sample = MixAudio();
+					audio_filter.Process(sample, 1);
+					break;
+
+				default:
+					*sample = MixAudio();
+					break;
+			}
+		}
+	}
+
+	void Board::SetAudioFilter(AudioFilterPlacement placement, int32_t output_sample_rate)
+	{
+		audio_placement = placement;
+		audio_filtered = 0.0f;
+
+		switch (placement)
+		{
+			case AudioFilterPlacement::ExactRate:
+				if (apu != nullptr)
+				{
+					APUSim::AudioSignalFeatures feat{};
+					apu->GetSignalFeatures(feat);
+					audio_filter.Configure(audio_preset, feat.SampleRate);
+				}
+				else
+				{
+					audio_placement = AudioFilterPlacement::None;
+				}
+				break;
+
+			case AudioFilterPlacement::PostResample:
+				if (output_sample_rate > 0)
+				{
+					audio_filter.Configure(audio_preset, output_sample_rate);
+				}
+				else
+				{
+					audio_placement = AudioFilterPlacement::None;
+				}
+				break;
+
+			default:
+				break;
+		}
+	}
+
+	void Board::TreatAudioFilter()
+	{
+		if (audio_placement != AudioFilterPlacement::ExactRate)
+			return;
+
+		// The filter is causal, so the current output needs only the current mix and the filter history.
+
+		audio_filtered = MixAudio();
+		audio_filter.Process(&audio_filtered, 1);
+	}
+
+	void Board::EnableSignalRecorder(bool enable, size_t capacity)
+	{
+		if (recorder)
+		{
+			delete recorder;
+			recorder = nullptr;
+		}
+
+		if (enable)
+		{
+			// The board master clock: 21.477272 MHz for NTSC, 26.601712 MHz for PAL (312 scanlines per field).
+			double clk_freq = 21477272.0;
+			if (ppu != nullptr)
+			{
+				PPUSim::VideoSignalFeatures feat{};
+				ppu->GetSignalFeatures(feat);
+				if (feat.ScansPerField == 312)
+				{
+					clk_freq = 26601712.0;
+				}
+			}
+			recorder = new SignalRecorder(core, apu, ppu, capacity, clk_freq);
+		}
+	}
+
+	SignalRecorder* Board::GetSignalRecorder()
+	{
+		return recorder;
+	}
+
+	void Board::TreatSignalRecorder()
+	{
+		if (recorder)
+			recorder->Sample();
+	}
+
+	void Board::SubscribeEvents(uint32_t mask, size_t capacity)
+	{
+		if (events)
+		{
+			delete events;
+			events = nullptr;
+		}
+
+		if (mask != 0)
+		{
+			events = new BoardEvents(this, mask, capacity);
+		}
+	}
+
+	BoardEvents* Board::GetEvents()
+	{
+		return events;
+	}
 
-			*sample = (aux.normalized.a * 0.4f /* 20k resistor */ + aux.normalized.b /* 12k resistor */) / 2.0f;
+	void Board::EnableDebugSnapshot(DebugSnapshotCadence cadence, size_t period, bool with_memory)
+	{
+		if (snapshot)
+		{
+			delete snapshot;
+			snapshot = nullptr;
+		}
 
-			// This is essentially "muting" AUX A, because the level of AUX A at its peak is about 300 mV, and the level of AUX B at its peak is about 1100 mV.
-			// Accordingly, if you do just (A+B)/2, the square channels will be "overshoot".
+		if (cadence != DebugSnapshotCadence::Disabled)
+		{
+			snapshot = new DebugSnapshot(cadence, period, with_memory);
 		}
 	}
 
+	DebugSnapshot* Board::GetDebugSnapshot()
+	{
+		return snapshot;
+	}
+
+	void Board::TreatDebugSnapshot()
+	{
+		if (snapshot)
+			snapshot->Treat(core, ppu, GetPHICounter());
+	}
+
+	int Board::StartInputMovie(bool record, char* filename)
+	{
+		StopInputMovie();
+
+		movie = new InputMovie();
+		int res = record ? movie->StartRecording(filename, GetPHICounter()) : movie->StartPlayback(filename, GetPHICounter());
+		if (res < 0)
+		{
+			delete movie;
+			movie = nullptr;
+		}
+		return res;
+	}
+
+	void Board::StopInputMovie()
+	{
+		if (movie)
+		{
+			delete movie;
+			movie = nullptr;
+		}
+	}
+
+	InputMovie* Board::GetInputMovie()
+	{
+		return movie;
+	}
+
+	void Board::TreatInputMovie()
+	{
+		if (movie)
+			movie->Treat(io, GetPHICounter());
+	}
+
+	void Board::TreatEvents(BaseLogic::TriState phi2, BaseLogic::TriState rnw, BaseLogic::TriState n_nmi, BaseLogic::TriState n_irq)
+	{
+		events->Treat(ppu, apu, addr_bus, data_bus, phi2, rnw, n_nmi, n_irq);
+	}
+
 	void Board::LoadRegDump(uint8_t* data, size_t data_size)
 	{
 	}
 
+	bool Board::MapRegDump(const char* filename)
+	{
+		return false;
+	}
+
+	int Board::SeekRegDump(size_t frame)
+	{
+		return -1;
+	}
+
+	void Board::SetRegDumpKeyframeInterval(size_t frames)
+	{
+		regdump_keyframe_interval = frames;
+	}
+
+	void Board::SetRegDumpFormat(RegDumpFormat format, bool drop_when_full)
+	{
+		regdump_format = format;
+		regdump_drop_when_full = drop_when_full;
+	}
+
+	bool Board::GetRegDumpStats(bool ppu_dump, RegDumpStats* stats)
+	{
+		RegDumper* dumper = ppu_dump ? ppu_regdump : apu_regdump;
+		if (dumper == nullptr)
+			return false;
+
+		dumper->GetStats(stats);
+		return true;
+	}
+
 	void Board::EnablePpuRegDump(bool enable, char* regdump_dir)
 	{
 		if (enable) {
@@ -103,8 +346,11 @@ namespace Breaknes
 				delete ppu_regdump;
 				ppu_regdump = nullptr;
 			}
-			ppu_regdump = new RegDumper("PPU", GetPHICounter(), filename);
+			ppu_regdump = new RegDumper("PPU", GetPHICounter(), filename, regdump_format, regdump_drop_when_full);
+			ppu_regdump->SetKeyframeInterval(regdump_keyframe_interval);
 			prev_phi_counter_for_ppuregdump = GetPHICounter();
+			prev_v_for_regdump = ppu != nullptr ? ppu->GetVCounter() : 0;
+			AddRegdumpKeyframe(ppu_regdump);
 
 			printf("PPU regdump enabled to file: %s\n", filename);
 		}
@@ -129,8 +375,11 @@ namespace Breaknes
 				delete apu_regdump;
 				apu_regdump = nullptr;
 			}
-			apu_regdump = new RegDumper("APU", GetPHICounter(), filename);
+			apu_regdump = new RegDumper("APU", GetPHICounter(), filename, regdump_format, regdump_drop_when_full);
+			apu_regdump->SetKeyframeInterval(regdump_keyframe_interval);
 			prev_phi_counter_for_apuregdump = GetPHICounter();
+			prev_v_for_regdump = ppu != nullptr ? ppu->GetVCounter() : 0;
+			AddRegdumpKeyframe(apu_regdump);
 
 			printf("APU regdump enabled to file: %s\n", filename);
 		}
@@ -151,6 +400,16 @@ namespace Breaknes
 	/// </summary>
 	void Board::TreatCoreForRegdump(uint16_t addr_bus, uint8_t data_bus, BaseLogic::TriState phi2, BaseLogic::TriState rnw)
 	{
+		// Frames are counted by the PPU fields (the APU regdump uses the same frames)
+		if ((apu_regdump || ppu_regdump) && ppu != nullptr) {
+
+			size_t v = ppu->GetVCounter();
+			if (v == 0 && prev_v_for_regdump != 0) {
+				MarkRegdumpFrame();
+			}
+			prev_v_for_regdump = v;
+		}
+
 		// APU Regdump
 		if (apu_regdump && (addr_bus & ~MappedAPUMask) == MappedAPUBase) {
 
@@ -179,6 +438,173 @@ namespace Breaknes
 		}
 	}
 
+	/// <summary>
+	/// The keyframe of frame 0 holds the initial state, so that seeking to the first frames restores it as well.
+	/// </summary>
+	void Board::AddRegdumpKeyframe(RegDumper* dumper)
+	{
+		if (dumper->KeyframeDue())
+		{
+			uint8_t* state = nullptr;
+			size_t state_size = SaveRegDumpState(&state);
+			dumper->AddKeyframe(GetPHICounter(), state, state_size);
+			delete[] state;
+		}
+	}
+
+	void Board::MarkRegdumpFrame()
+	{
+		uint64_t phi_now = GetPHICounter();
+		RegDumper* dumpers[] = { apu_regdump, ppu_regdump };
+		uint8_t* state = nullptr;
+		size_t state_size = 0;
+
+		for (size_t n = 0; n < 2; n++)
+		{
+			if (dumpers[n] == nullptr)
+				continue;
+
+			dumpers[n]->MarkFrame(phi_now);
+
+			if (dumpers[n]->KeyframeDue())
+			{
+				if (state == nullptr)
+				{
+					state_size = SaveRegDumpState(&state);
+				}
+				dumpers[n]->AddKeyframe(phi_now, state, state_size);
+			}
+		}
+
+		delete[] state;
+	}
+
+	size_t Board::SaveRegDumpState(uint8_t** state)
+	{
+		std::list<DebugInfoProvider>* regs[] = { &hub->apuRegsInfo, &hub->ppuRegsInfo };
+		DebugInfoType regs_type[] = { DebugInfoType::DebugInfoType_APURegs, DebugInfoType::DebugInfoType_PPURegs };
+
+		size_t size = 0;
+
+		for (auto it = hub->memMap.begin(); it != hub->memMap.end(); ++it)
+		{
+			size += sizeof(BaseBoard::RegDumpStateRecord) + it->descr->size;
+		}
+		for (size_t n = 0; n < 2; n++)
+		{
+			size += regs[n]->size() * (sizeof(BaseBoard::RegDumpStateRecord) + sizeof(uint32_t));
+		}
+
+		uint8_t* buf = new uint8_t[size];
+		uint8_t* ptr = buf;
+
+		for (auto it = hub->memMap.begin(); it != hub->memMap.end(); ++it)
+		{
+			BaseBoard::RegDumpStateRecord* rec = (BaseBoard::RegDumpStateRecord*)ptr;
+			memset(rec, 0, sizeof(BaseBoard::RegDumpStateRecord));
+			rec->type = REGDUMP_STATE_MEMORY;
+			snprintf(rec->name, sizeof(rec->name), "%s", it->descr->name);
+			rec->size = it->descr->size;
+			ptr += sizeof(BaseBoard::RegDumpStateRecord);
+
+			hub->ReadMemRegion(&(*it), ptr);
+			ptr += it->descr->size;
+		}
+
+		for (size_t n = 0; n < 2; n++)
+		{
+			for (auto it = regs[n]->begin(); it != regs[n]->end(); ++it)
+			{
+				BaseBoard::RegDumpStateRecord* rec = (BaseBoard::RegDumpStateRecord*)ptr;
+				memset(rec, 0, sizeof(BaseBoard::RegDumpStateRecord));
+				rec->type = regs_type[n];
+				snprintf(rec->name, sizeof(rec->name), "%s", it->entry->name);
+				rec->size = sizeof(uint32_t);
+				ptr += sizeof(BaseBoard::RegDumpStateRecord);
+
+				uint32_t value = it->GetValue(it->opaque, it->entry);
+				memcpy(ptr, &value, sizeof(value));
+				ptr += sizeof(value);
+			}
+		}
+
+		*state = buf;
+		return size;
+	}
+
+	void Board::LoadRegDumpState(uint8_t* state, size_t state_size)
+	{
+		ResetCartBus();
+
+		uint8_t* ptr = state;
+		uint8_t* end = state + state_size;
+
+		while (ptr + sizeof(BaseBoard::RegDumpStateRecord) <= end)
+		{
+			BaseBoard::RegDumpStateRecord* rec = (BaseBoard::RegDumpStateRecord*)ptr;
+			uint8_t* data = ptr + sizeof(BaseBoard::RegDumpStateRecord);
+			if (data + rec->size > end)
+				break;
+
+			if (rec->type == REGDUMP_STATE_MEMORY)
+			{
+				// Only the regions of the same size (e.g. WRAM of NES and APUPlayer are different things)
+
+				for (auto it = hub->memMap.begin(); it != hub->memMap.end(); ++it)
+				{
+					if (!strncmp(it->descr->name, rec->name, sizeof(rec->name)) && it->descr->size == (int32_t)rec->size && it->WriteByte != nullptr)
+					{
+						// Board memories with a span are plain memories. The cartridge memories always go through the provider:
+						// the cartridge ROM may be shared with other instances (ROMPool) until the provider makes a private copy on the first write.
+						// Only the bytes that differ are written, so that loading the same contents keeps the ROM shared.
+
+						uint8_t* span = !it->cartRelated && it->GetSpan != nullptr ? it->GetSpan(it->opaque) : nullptr;
+						if (span != nullptr)
+						{
+							memcpy(span, data, rec->size);
+						}
+						else
+						{
+							for (uint32_t i = 0; i < rec->size; i++)
+							{
+								if (!it->cartRelated || it->ReadByte(it->opaque, i) != data[i])
+								{
+									it->WriteByte(it->opaque, i, data[i]);
+								}
+							}
+						}
+						break;
+					}
+				}
+			}
+			else
+			{
+				std::list<DebugInfoProvider>* regs = nullptr;
+				if (rec->type == DebugInfoType::DebugInfoType_APURegs)
+					regs = &hub->apuRegsInfo;
+				else if (rec->type == DebugInfoType::DebugInfoType_PPURegs)
+					regs = &hub->ppuRegsInfo;
+
+				if (regs != nullptr && rec->size == sizeof(uint32_t))
+				{
+					uint32_t value;
+					memcpy(&value, data, sizeof(value));
+
+					for (auto it = regs->begin(); it != regs->end(); ++it)
+					{
+						if (!strncmp(it->entry->name, rec->name, sizeof(rec->name)) && it->SetValue != nullptr)
+						{
+							it->SetValue(it->opaque, it->entry, value);
+							break;
+						}
+					}
+				}
+			}
+
+			ptr = data + rec->size;
+		}
+	}
+
 	void Board::GetApuSignalFeatures(APUSim::AudioSignalFeatures* features)
 	{
 		APUSim::AudioSignalFeatures feat{};
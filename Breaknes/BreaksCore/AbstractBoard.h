@@ -40,6 +40,24 @@ namespace Breaknes
 		Mappers::AbstractCartridge* cart = nullptr;
 		Mappers::ConnectorType p1_type = Mappers::ConnectorType::None;
 
+		// The debug hub in which the board and its cartridge register their providers (created before the board).
+
+		DebugHub* hub = nullptr;
+
+		bool cart_strobe_driven = false;
+		bool cart_bus_strobed = true;
+
+		/// <summary>
+		/// Whether the cartridge must be simulated in this half cycle. The cartridges that only react to the bus strobes (AbstractCartridge::StrobeDriven) are simulated
+		/// while the CPU (/ROMSEL) or PPU (/RD, /WR) bus is strobed and one half cycle after that, to see the strobe release. In between their outputs keep the last values.
+		/// </summary>
+		bool CartBusActive(BaseLogic::TriState nROMSEL, BaseLogic::TriState PPU_nRD, BaseLogic::TriState PPU_nWR);
+
+		/// <summary>
+		/// Simulate the cartridge in the next half cycle regardless of the strobes. Used when the board state changes abruptly (cartridge insertion, reset, regdump seek).
+		/// </summary>
+		void ResetCartBus();
+
 		// Pre-calculated PPU palette
 
 		RGB_Triplet* pal = nullptr;
@@ -52,9 +70,66 @@ namespace Breaknes
 		RegDumper* apu_regdump = nullptr;
 		size_t prev_phi_counter_for_ppuregdump = 0;
 		size_t prev_phi_counter_for_apuregdump = 0;
+		size_t prev_v_for_regdump = 0;
+		size_t regdump_keyframe_interval = 0;
+		RegDumpFormat regdump_format = RegDumpFormat::Indexed;
+		bool regdump_drop_when_full = false;
 
 		void TreatCoreForRegdump(uint16_t addr_bus, uint8_t data_bus, BaseLogic::TriState phi2, BaseLogic::TriState rnw);
 
+		/// <summary>
+		/// Start a new frame in the regdumps and save a keyframe if it is time.
+		/// </summary>
+		void MarkRegdumpFrame();
+
+		void AddRegdumpKeyframe(RegDumper* dumper);
+
+		/// <summary>
+		/// Collect the state for the regdump keyframe: all memory regions and the APU/PPU registers available through DebugHub.
+		/// This is not the full state of the chips (internal latches, counters and channel timers are not included).
+		/// </summary>
+		/// <returns>State size in bytes (the buffer must be deleted by the caller)</returns>
+		size_t SaveRegDumpState(uint8_t** state);
+
+		/// <summary>
+		/// Restore the keyframe state. Memory regions and registers are matched by name, the ones missing on this board are skipped.
+		/// </summary>
+		void LoadRegDumpState(uint8_t* state, size_t state_size);
+
+		// Board audio filters. In ExactRate placement the mix is filtered on every half cycle and `audio_filtered` is the output for the current half cycle.
+
+		AudioFilterChain audio_filter{};
+		AudioFilterPreset audio_preset = AudioFilterPreset::NES;
+		AudioFilterPlacement audio_placement = AudioFilterPlacement::None;
+		float audio_filtered = 0.0f;
+
+		// Signal recorder. Does not exist until enabled, so that it costs nothing in normal simulation.
+
+		SignalRecorder* recorder = nullptr;
+
+		// Board events. Also exist only while subscribed; the boards check the pointer before calling TreatEvents.
+
+		BoardEvents* events = nullptr;
+
+		// DebugHub snapshots for the GUI. Exist only while enabled.
+
+		DebugSnapshot* snapshot = nullptr;
+
+		// Input movie (recording or playback). Exists only while in use.
+
+		InputMovie* movie = nullptr;
+
+		/// <summary>
+		/// Check the events at the end of the simulated half cycle.
+		/// </summary>
+		void TreatEvents(BaseLogic::TriState phi2, BaseLogic::TriState rnw, BaseLogic::TriState n_nmi, BaseLogic::TriState n_irq);
+
+		/// <summary>
+		/// Mix the AUX outputs (and other sound sources of the board) before the filters.
+		/// </summary>
+		/// <returns></returns>
+		virtual float MixAudio();
+
 	public:
 		Board(APUSim::Revision apu_rev, PPUSim::Revision ppu_rev, Mappers::ConnectorType p1);
 		virtual ~Board();
@@ -107,10 +182,93 @@ namespace Breaknes
 
 		/// <summary>
 		/// Get the current resulting AUX value in normalized [0.0; 1.0] format.
+		/// When the board filters are enabled, the value is AC-coupled (centered around 0).
 		/// </summary>
 		/// <returns></returns>
 		virtual void SampleAudioSignal(float* sample);
 
+		/// <summary>
+		/// Enable the board filters (HPF/LPF) for the audio signal.
+		/// </summary>
+		/// <param name="placement">Where the filters are applied</param>
+		/// <param name="output_sample_rate">The rate at which the consumer takes samples (used only for PostResample placement)</param>
+		void SetAudioFilter(AudioFilterPlacement placement, int32_t output_sample_rate);
+
+		/// <summary>
+		/// Feed the board filters after each simulated half cycle (ExactRate placement only).
+		/// </summary>
+		void TreatAudioFilter();
+
+		/// <summary>
+		/// Create/delete the signal recorder. The recording begins from scratch.
+		/// </summary>
+		/// <param name="enable">true: create the recorder</param>
+		/// <param name="capacity">Ring size (in signal changes)</param>
+		void EnableSignalRecorder(bool enable, size_t capacity);
+
+		/// <summary>
+		/// Get the signal recorder (nullptr if disabled).
+		/// </summary>
+		SignalRecorder* GetSignalRecorder();
+
+		/// <summary>
+		/// Take a sample of the recorded signals after each simulated half cycle.
+		/// </summary>
+		void TreatSignalRecorder();
+
+		/// <summary>
+		/// Subscribe to the board events. The previous subscription and its unread events are discarded.
+		/// </summary>
+		/// <param name="mask">Combination of BOARD_EVENT_BIT(BoardEventType). 0: unsubscribe</param>
+		/// <param name="capacity">Ring size (in events)</param>
+		void SubscribeEvents(uint32_t mask, size_t capacity);
+
+		/// <summary>
+		/// Get the event ring (nullptr if there is no subscription).
+		/// </summary>
+		BoardEvents* GetEvents();
+
+		/// <summary>
+		/// Enable/disable the DebugHub snapshots. Disabled: the snapshots are deleted.
+		/// </summary>
+		/// <param name="cadence">When to take the snapshot</param>
+		/// <param name="period">CLK half cycles between the snapshots (Cycles cadence)</param>
+		/// <param name="with_memory">true: the snapshot also includes all memory regions of the DebugHub</param>
+		void EnableDebugSnapshot(DebugSnapshotCadence cadence, size_t period, bool with_memory);
+
+		/// <summary>
+		/// Get the snapshots (nullptr if disabled).
+		/// </summary>
+		DebugSnapshot* GetDebugSnapshot();
+
+		/// <summary>
+		/// Take the snapshot, when it is due, after each simulated half cycle.
+		/// </summary>
+		void TreatDebugSnapshot();
+
+		/// <summary>
+		/// Start recording the IO state changes to the movie file, or playing them back from it. The previous movie is stopped.
+		/// The time of the movie is the board PHI counter (see InputMovie).
+		/// </summary>
+		/// <param name="record">true: record; false: play back</param>
+		/// <returns>0: OK; -1: the file cannot be created/opened or it is not a movie</returns>
+		int StartInputMovie(bool record, char* filename);
+
+		/// <summary>
+		/// Stop the movie (the recording is closed).
+		/// </summary>
+		void StopInputMovie();
+
+		/// <summary>
+		/// Get the movie (nullptr if there is none).
+		/// </summary>
+		InputMovie* GetInputMovie();
+
+		/// <summary>
+		/// Apply the IO state changes of the movie after each simulated half cycle.
+		/// </summary>
+		void TreatInputMovie();
+
 		/// <summary>
 		/// Load APU/PPU registers dump (APUPlayer/PPUPlayer only)
 		/// </summary>
@@ -118,6 +276,12 @@ namespace Breaknes
 		/// <param name="data_size">Dump size (bytes)</param>
 		virtual void LoadRegDump(uint8_t* data, size_t data_size);
 
+		/// <summary>
+		/// Play APU/PPU registers dump directly from the file (APUPlayer/PPUPlayer only). The file is memory-mapped instead of being loaded.
+		/// </summary>
+		/// <returns>false: the file cannot be mapped or the board does not play dumps</returns>
+		virtual bool MapRegDump(const char* filename);
+
 		/// <summary>
 		/// Enable/disable saving the history of PPU register accesses.
 		/// </summary>
@@ -128,6 +292,35 @@ namespace Breaknes
 		/// </summary>
 		virtual void EnableApuRegDump(bool enable, char* regdump_dir);
 
+		/// <summary>
+		/// Save a keyframe (the memories and registers visible through DebugHub, not the full chip state) to the regdumps every N frames. 0: do not save keyframes.
+		/// Applies to the regdumps enabled after the call.
+		/// </summary>
+		void SetRegDumpKeyframeInterval(size_t frames);
+
+		/// <summary>
+		/// Select the regdump file format. Applies to the regdumps enabled after the call.
+		/// </summary>
+		/// <param name="format">File layout</param>
+		/// <param name="drop_when_full">If the writer cannot keep up, drop the register operations instead of slowing down the simulation (indexed formats only)</param>
+		void SetRegDumpFormat(RegDumpFormat format, bool drop_when_full);
+
+		/// <summary>
+		/// Get the counters of the regdump being saved.
+		/// </summary>
+		/// <param name="ppu_dump">true: PPU regdump, false: APU regdump</param>
+		/// <returns>false: the regdump is not enabled</returns>
+		bool GetRegDumpStats(bool ppu_dump, RegDumpStats* stats);
+
+		/// <summary>
+		/// Approximate seek: rewind the loaded regdump to the nearest keyframe before the specified frame (APUPlayer/PPUPlayer only).
+		/// The board is reset and the keyframe state is loaded; the register operations are played from the keyframe on.
+		/// The keyframe holds only the DebugHub-visible state, so the output after the seek can differ from the continuous playback.
+		/// </summary>
+		/// <param name="frame">Desired frame</param>
+		/// <returns>The frame from which the playback resumes, or -1 if the regdump does not support seeking</returns>
+		virtual int SeekRegDump(size_t frame);
+
 		/// <summary>
 		/// Get audio signal settings that help with its rendering on the consumer side.
 		/// </summary>
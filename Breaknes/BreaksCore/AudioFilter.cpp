@@ -0,0 +1,84 @@
+// Board-level analog audio filters.
+
+#include "pch.h"
+
+namespace Breaknes
+{
+	void AudioFilterChain::Configure(AudioFilterPreset preset, double sample_rate)
+	{
+		num_sections = 0;
+
+		switch (preset)
+		{
+			case AudioFilterPreset::NES:
+				AddHighPass(90.0, sample_rate);
+				AddHighPass(440.0, sample_rate);
+				AddLowPass(14000.0, sample_rate);
+				break;
+
+			case AudioFilterPreset::Famicom:
+				AddHighPass(37.0, sample_rate);
+				AddLowPass(14000.0, sample_rate);
+				break;
+		}
+
+		Reset();
+	}
+
+	void AudioFilterChain::AddHighPass(double cutoff, double sample_rate)
+	{
+		const double pi = 3.14159265358979323846;
+		double rc = 1.0 / (2.0 * pi * cutoff);
+		double dt = 1.0 / sample_rate;
+		double a = rc / (rc + dt);
+
+		Section& s = sect[num_sections++];
+		s.b0 = a;
+		s.b1 = -a;
+		s.a1 = -a;
+	}
+
+	void AudioFilterChain::AddLowPass(double cutoff, double sample_rate)
+	{
+		const double pi = 3.14159265358979323846;
+		double rc = 1.0 / (2.0 * pi * cutoff);
+		double dt = 1.0 / sample_rate;
+		double b = dt / (rc + dt);
+
+		Section& s = sect[num_sections++];
+		s.b0 = b;
+		s.b1 = 0.0;
+		s.a1 = -(1.0 - b);
+	}
+
+	void AudioFilterChain::Reset()
+	{
+		for (size_t n = 0; n < MaxSections; n++)
+		{
+			sect[n].x1 = 0.0;
+			sect[n].y1 = 0.0;
+		}
+	}
+
+	void AudioFilterChain::Process(float* samples, size_t count)
+	{
+		for (size_t n = 0; n < num_sections; n++)
+		{
+			Section& s = sect[n];
+			double x1 = s.x1;
+			double y1 = s.y1;
+
+			for (size_t i = 0; i < count; i++)
+			{
+				double x = samples[i];
+				double y = s.b0 * x + s.b1 * x1 - s.a1 * y1;
+				x1 = x;
+				y1 = y;
+				samples[i] = (float)y;
+			}
+
+			s.x1 = x1;
+			s.y1 = y1;
+		}
+	}
+}
@@ -0,0 +1,71 @@
+// Board-level analog audio filters.
+
+#pragma once
+
+namespace Breaknes
+{
+	/// <summary>
+	/// Where the board filter chain is applied.
+	/// </summary>
+	enum class AudioFilterPlacement
+	{
+		None = 0,			// No filtering (the AUX mix comes as is)
+		ExactRate,			// The filter runs on every simulated half cycle (AudioSignalFeatures::SampleRate), sample by sample. Accurate but costs a little on every Step.
+		PostResample,		// The filter runs only on the samples actually taken by the consumer (at the consumer's output rate). Cheap, but the signal is already aliased by decimation.
+	};
+
+	/// <summary>
+	/// Set of RC filters that the motherboard puts between the APU AUX outputs and the audio output.
+	/// </summary>
+	enum class AudioFilterPreset
+	{
+		NES = 0,		// HPF 90 Hz, HPF 440 Hz, LPF 14 kHz
+		Famicom,		// HPF 37 Hz, LPF 14 kHz
+	};
+
+	/// <summary>
+	/// A cascade of first-order IIR sections, each corresponding to one RC stage of the board.
+	/// A block is processed section by section, so that the inner loop is short and branch-free. The board feeds one sample at a time (the output must not lag).
+	/// The state is kept in double precision: at the simulation rate (tens of MHz) the HPF pole is too close to 1.0 for a float.
+	/// </summary>
+	class AudioFilterChain
+	{
+		static const size_t MaxSections = 4;
+
+		struct Section
+		{
+			// y[n] = b0 * x[n] + b1 * x[n-1] - a1 * y[n-1]
+			double b0;
+			double b1;
+			double a1;
+			double x1;
+			double y1;
+		};
+
+		Section sect[MaxSections]{};
+		size_t num_sections = 0;
+
+		void AddHighPass(double cutoff, double sample_rate);
+		void AddLowPass(double cutoff, double sample_rate);
+
+	public:
+		/// <summary>
+		/// Build the filter chain for the board preset and sampling rate. The filter state is reset.
+		/// </summary>
+		/// <param name="preset">Set of board filters</param>
+		/// <param name="sample_rate">The rate at which the samples are fed to the filter (Hz)</param>
+		void Configure(AudioFilterPreset preset, double sample_rate);
+
+		/// <summary>
+		/// Clear the filter history.
+		/// </summary>
+		void Reset();
+
+		/// <summary>
+		/// Filter a block of samples in place.
+		/// </summary>
+		/// <param name="samples">Samples</param>
+		/// <param name="count">Number of samples</param>
+		void Process(float* samples, size_t count);
+	};
+}
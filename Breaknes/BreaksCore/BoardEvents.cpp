@@ -0,0 +1,176 @@
+// Board events (field, VBlank, interrupts, OAM DMA, register accesses) for the frontends and headless runners.
+
+#include "pch.h"
+
+using namespace BaseLogic;
+
+namespace Breaknes
+{
+	BoardEvents::BoardEvents(Board* _board, uint32_t _mask, size_t capacity)
+	{
+		board = _board;
+		mask = _mask;
+		ring_size = capacity != 0 ? capacity : 1;
+		ring = new BoardEvent[ring_size];
+	}
+
+	BoardEvents::~BoardEvents()
+	{
+		delete[] ring;
+	}
+
+	uint32_t BoardEvents::GetMask()
+	{
+		return mask;
+	}
+
+	void BoardEvents::Push(BoardEventType type, uint16_t addr, uint8_t value)
+	{
+		if (type == BoardEventType::Max || (mask & BOARD_EVENT_BIT(type)) == 0)
+			return;
+
+		size_t slot = produced.load(std::memory_order_relaxed);
+
+		if (slot - consumed.load(std::memory_order_acquire) == ring_size)
+		{
+			lost.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		BoardEvent* ev = &ring[slot % ring_size];
+		ev->clk = clk;
+		ev->phi = board->GetPHICounter();
+		ev->type = (uint32_t)type;
+		ev->addr = addr;
+		ev->value = value;
+		ev->reserved = 0;
+
+		produced.store(slot + 1, std::memory_order_release);
+	}
+
+	/// <summary>
+	/// Only the clean transitions between 0 and 1 are events (`x` and `z` at power-up are not).
+	/// </summary>
+	void BoardEvents::Edge(TriState& prev, TriState now, BoardEventType fall, BoardEventType rise)
+	{
+		if (prev == TriState::One && now == TriState::Zero)
+			Push(fall, 0, 0);
+		else if (prev == TriState::Zero && now == TriState::One)
+			Push(rise, 0, 0);
+		prev = now;
+	}
+
+	void BoardEvents::Treat(PPUSim::PPU* ppu, APUSim::APU* apu, uint16_t addr_bus, uint8_t data_bus,
+		TriState PHI2, TriState RnW, TriState n_NMI, TriState n_IRQ)
+	{
+		const uint32_t field_mask = BOARD_EVENT_BIT(BoardEventType::FieldStart) | BOARD_EVENT_BIT(BoardEventType::FieldEnd) |
+			BOARD_EVENT_BIT(BoardEventType::VBlankSet) | BOARD_EVENT_BIT(BoardEventType::VBlankClear);
+		const uint32_t int_mask = BOARD_EVENT_BIT(BoardEventType::NMIAssert) | BOARD_EVENT_BIT(BoardEventType::NMIRelease) |
+			BOARD_EVENT_BIT(BoardEventType::IRQAssert) | BOARD_EVENT_BIT(BoardEventType::IRQRelease);
+		const uint32_t dma_mask = BOARD_EVENT_BIT(BoardEventType::OAMDMAStart) | BOARD_EVENT_BIT(BoardEventType::OAMDMAEnd);
+		const uint32_t regs_mask = BOARD_EVENT_BIT(BoardEventType::PPURegRead) | BOARD_EVENT_BIT(BoardEventType::PPURegWrite) |
+			BOARD_EVENT_BIT(BoardEventType::APURegRead) | BOARD_EVENT_BIT(BoardEventType::APURegWrite);
+
+		if ((mask & field_mask) && ppu != nullptr)
+		{
+			TriState VSYNC, n_VSET, RESCL;
+			ppu->GetFieldSignals(VSYNC, n_VSET, RESCL);
+
+			Edge(prev_VSYNC, VSYNC, BoardEventType::FieldStart, BoardEventType::FieldEnd);
+			Edge(prev_n_VSET, n_VSET, BoardEventType::VBlankSet, BoardEventType::Max);
+			Edge(prev_RESCL, RESCL, BoardEventType::Max, BoardEventType::VBlankClear);
+		}
+
+		if (mask & int_mask)
+		{
+			Edge(prev_n_NMI, n_NMI, BoardEventType::NMIAssert, BoardEventType::NMIRelease);
+			Edge(prev_n_IRQ, n_IRQ, BoardEventType::IRQAssert, BoardEventType::IRQRelease);
+		}
+
+		if ((mask & dma_mask) && apu != nullptr)
+		{
+			Edge(prev_NOSPR, apu->GetNOSPR(), BoardEventType::OAMDMAStart, BoardEventType::OAMDMAEnd);
+		}
+
+		// The register access is taken once per CPU cycle. The writes are taken at the beginning of PHI2 (as for the regdump).
+		// The read data is driven by the chip during PHI2 and is latched by the CPU when PHI2 falls, so the read is pushed at the falling edge
+		// with the last value of the data bus before it.
+
+		if (mask & regs_mask)
+		{
+			if (pending_read != BoardEventType::Max)
+			{
+				if (PHI2 == TriState::One)
+				{
+					pending_read_data = data_bus;
+				}
+				else
+				{
+					Push(pending_read, pending_read_addr, pending_read_data);
+					pending_read = BoardEventType::Max;
+				}
+			}
+
+			if (prev_PHI2 == TriState::Zero && PHI2 == TriState::One && (RnW == TriState::Zero || RnW == TriState::One))
+			{
+				bool read = RnW == TriState::One;
+				BoardEventType type = BoardEventType::Max;
+
+				// The PPU decodes only A13-A15 and A0-A2, so its registers are mirrored over $2000-$3FFF
+
+				uint16_t addr = addr_bus;
+
+				if ((addr_bus & 0xE000) == 0x2000)
+				{
+					type = read ? BoardEventType::PPURegRead : BoardEventType::PPURegWrite;
+					addr = addr_bus & 7;
+				}
+				else if (addr_bus >= 0x4000 && addr_bus <= 0x4017)
+				{
+					type = read ? BoardEventType::APURegRead : BoardEventType::APURegWrite;
+				}
+
+				if (type != BoardEventType::Max)
+				{
+					if (read)
+					{
+						pending_read = type;
+						pending_read_addr = addr;
+						pending_read_data = data_bus;
+					}
+					else
+					{
+						Push(type, addr, data_bus);
+					}
+				}
+			}
+			prev_PHI2 = PHI2;
+		}
+
+		clk++;
+	}
+
+	size_t BoardEvents::GetCount()
+	{
+		return produced.load(std::memory_order_acquire) - consumed.load(std::memory_order_relaxed);
+	}
+
+	size_t BoardEvents::Read(BoardEvent* events, size_t max_count)
+	{
+		size_t slot = consumed.load(std::memory_order_relaxed);
+		size_t count = std::min(max_count, produced.load(std::memory_order_acquire) - slot);
+
+		for (size_t n = 0; n < count; n++)
+		{
+			events[n] = ring[(slot + n) % ring_size];
+		}
+
+		consumed.store(slot + count, std::memory_order_release);
+		return count;
+	}
+
+	uint64_t BoardEvents::GetLost()
+	{
+		return lost.load(std::memory_order_relaxed);
+	}
+}
@@ -0,0 +1,108 @@
+// Board events (field, VBlank, interrupts, OAM DMA, register accesses) for the frontends and headless runners.
+
+#pragma once
+
+namespace Breaknes
+{
+	class Board;
+
+	enum class BoardEventType : uint32_t
+	{
+		FieldStart = 0,		// End of the vertical sync lines of the PPU
+		FieldEnd,			// Beginning of the vertical sync lines of the PPU
+		VBlankSet,			// /VSET of the PPU FSM
+		VBlankClear,		// RESCL of the PPU FSM
+		NMIAssert,			// /NMI of the board 1 -> 0
+		NMIRelease,			// /NMI of the board 0 -> 1
+		IRQAssert,			// /IRQ of the board 1 -> 0
+		IRQRelease,			// /IRQ of the board 0 -> 1
+		OAMDMAStart,
+		OAMDMAEnd,
+		PPURegRead,			// CPU access to $2000-$3FFF (the PPU registers and their mirrors)
+		PPURegWrite,
+		APURegRead,			// CPU access to $4000-$4017
+		APURegWrite,
+		Max,
+	};
+
+	/// <summary>
+	/// Subscription mask bit of the event type.
+	/// </summary>
+	#define BOARD_EVENT_BIT(type) (1 << (uint32_t)(type))
+
+	struct BoardEvent
+	{
+		uint64_t clk;			// CLK half cycles since the subscription
+		uint64_t phi;			// 6502 core cycle counter (GetPHICounter)
+		uint32_t type;			// BoardEventType
+		uint16_t addr;			// Register accesses: PPU register number (0-7) or CPU address of the APU register
+		uint8_t value;			// Register accesses: CPU data bus (writes: at the beginning of PHI2; reads: at the end of PHI2, the event is also timed there)
+		uint8_t reserved;
+	};
+
+	/// <summary>
+	/// Detects the subscribed events after each simulated half cycle and puts them into a ring of fixed size. When the ring is full, the new events are lost.
+	/// The board creates the object only while there is a subscription, so that the events cost nothing otherwise.
+	/// The ring has one writer (the simulation thread) and one reader (the frontend thread), in the same way as the RegDumpEmitter queue.
+	/// </summary>
+	class BoardEvents
+	{
+		uint32_t mask = 0;
+
+		BoardEvent* ring = nullptr;
+		size_t ring_size = 0;
+		std::atomic<size_t> produced{ 0 };	// Number of events put into the ring (the writer)
+		std::atomic<size_t> consumed{ 0 };	// Number of events taken out of the ring (the reader)
+		std::atomic<uint64_t> lost{ 0 };
+
+		uint64_t clk = 0;
+		Board* board = nullptr;
+
+		// Signal values of the previous half cycle (the events are their edges)
+
+		BaseLogic::TriState prev_VSYNC = BaseLogic::TriState::X;
+		BaseLogic::TriState prev_n_VSET = BaseLogic::TriState::X;
+		BaseLogic::TriState prev_RESCL = BaseLogic::TriState::X;
+		BaseLogic::TriState prev_n_NMI = BaseLogic::TriState::X;
+		BaseLogic::TriState prev_n_IRQ = BaseLogic::TriState::X;
+		BaseLogic::TriState prev_NOSPR = BaseLogic::TriState::X;
+		BaseLogic::TriState prev_PHI2 = BaseLogic::TriState::X;
+
+		// The register read in progress (Max: none). It is pushed when PHI2 falls.
+
+		BoardEventType pending_read = BoardEventType::Max;
+		uint16_t pending_read_addr = 0;
+		uint8_t pending_read_data = 0;
+
+		void Edge(BaseLogic::TriState& prev, BaseLogic::TriState now, BoardEventType fall, BoardEventType rise);
+		void Push(BoardEventType type, uint16_t addr, uint8_t value);
+
+	public:
+		BoardEvents(Board* board, uint32_t mask, size_t capacity);
+		~BoardEvents();
+
+		uint32_t GetMask();
+
+		/// <summary>
+		/// Check the signals at the end of the half cycle. The chips that the board does not have are nullptr, the missing signals are 1.
+		/// </summary>
+		void Treat(PPUSim::PPU* ppu, APUSim::APU* apu, uint16_t addr_bus, uint8_t data_bus,
+			BaseLogic::TriState PHI2, BaseLogic::TriState RnW, BaseLogic::TriState n_NMI, BaseLogic::TriState n_IRQ);
+
+		/// <summary>
+		/// Number of the events waiting in the ring.
+		/// </summary>
+		size_t GetCount();
+
+		/// <summary>
+		/// Take the oldest events out of the ring.
+		/// </summary>
+		/// <returns>Number of events copied to `events`</returns>
+		size_t Read(BoardEvent* events, size_t max_count);
+
+		/// <summary>
+		/// Number of the events lost because the ring was full.
+		/// </summary>
+		uint64_t GetLost();
+	};
+}
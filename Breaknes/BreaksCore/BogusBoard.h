@@ -28,6 +28,7 @@ namespace Breaknes
 		const size_t wram_size = 1ULL << wram_bits;
 
 		static uint8_t DumpWRAM(void* opaque, size_t addr);
+		static uint8_t* SpanWRAM(void* opaque);
 		static void WriteWRAM(void* opaque, size_t addr, uint8_t data);
 
 		static uint32_t GetCoreDebugInfo(void* opaque, DebugInfoEntry* entry);
@@ -14,7 +14,7 @@ namespace Breaknes
 		memset(wramRegion, 0, sizeof(MemDesciptor));
 		strcpy(wramRegion->name, WRAM_NAME);
 		wramRegion->size = (int32_t)wram->Dbg_GetSize();
-		dbg_hub->AddMemRegion(wramRegion, DumpWRAM, WriteWRAM, this, false);
+		dbg_hub->AddMemRegion(wramRegion, DumpWRAM, WriteWRAM, this, false, SpanWRAM);
 	}
 
 	static SignalOffsetPair board_signals[] = {
@@ -126,6 +126,12 @@ namespace Breaknes
 		return board->wram->Dbg_ReadByte(addr);
 	}
 
+	uint8_t* BogusBoard::SpanWRAM(void* opaque)
+	{
+		BogusBoard* board = (BogusBoard*)opaque;
+		return board->wram->Dbg_GetMemory();
+	}
+
 	void BogusBoard::WriteWRAM(void* opaque, size_t addr, uint8_t data)
 	{
 		BogusBoard* board = (BogusBoard*)opaque;
@@ -27,6 +27,10 @@ extern "C"
 		if (board != nullptr)
 		{
 			printf("DestroyBoard\n");
+#ifdef BREAKS_PROFILER
+			BaseLogic::Profiler::Report(stdout);
+			BaseLogic::Profiler::SaveFolded("breaknes.folded");
+#endif
 			delete board;
 			board = nullptr;
 			DisposeDebugHub();
@@ -60,6 +64,10 @@ extern "C"
 		if (board != nullptr)
 		{
 			board->Step();
+			board->TreatAudioFilter();
+			board->TreatSignalRecorder();
+			board->TreatDebugSnapshot();
+			board->TreatInputMovie();
 		}
 	}
 
@@ -115,6 +123,14 @@ extern "C"
 		}
 	}
 
+	DLL_EXPORT void SetAudioFilter(Breaknes::AudioFilterPlacement placement, int32_t output_sample_rate)
+	{
+		if (board != nullptr)
+		{
+			board->SetAudioFilter(placement, output_sample_rate);
+		}
+	}
+
 	DLL_EXPORT void LoadRegDump(uint8_t* data, size_t data_size)
 	{
 		if (board != nullptr)
@@ -123,6 +139,242 @@ extern "C"
 		}
 	}
 
+	DLL_EXPORT int MapRegDump(char* filename)
+	{
+		if (board != nullptr)
+		{
+			return board->MapRegDump(filename) ? 1 : 0;
+		}
+		return 0;
+	}
+
+	DLL_EXPORT int SeekRegDump(size_t frame)
+	{
+		if (board != nullptr)
+		{
+			return board->SeekRegDump(frame);
+		}
+		return -1;
+	}
+
+	DLL_EXPORT void EnableSignalRecorder(bool enable, size_t capacity)
+	{
+		if (board != nullptr)
+		{
+			board->EnableSignalRecorder(enable, capacity);
+		}
+	}
+
+	DLL_EXPORT int AddRecorderSignal(char* category, char* name)
+	{
+		if (board != nullptr && board->GetSignalRecorder() != nullptr)
+		{
+			return board->GetSignalRecorder()->AddSignal(category, name);
+		}
+		else
+		{
+			return -1;
+		}
+	}
+
+	DLL_EXPORT void GetRecorderTimeRange(uint64_t* oldest, uint64_t* now)
+	{
+		*oldest = 0;
+		*now = 0;
+
+		if (board != nullptr && board->GetSignalRecorder() != nullptr)
+		{
+			*oldest = board->GetSignalRecorder()->GetOldestTime();
+			*now = board->GetSignalRecorder()->GetTime();
+		}
+	}
+
+	DLL_EXPORT int ExportSignalRecording(char* filename, uint64_t from, uint64_t to)
+	{
+		if (board != nullptr && board->GetSignalRecorder() != nullptr)
+		{
+			return board->GetSignalRecorder()->ExportVCD(filename, from, to) ? 1 : 0;
+		}
+		else
+		{
+			return 0;
+		}
+	}
+
+	DLL_EXPORT void SubscribeEvents(uint32_t mask, size_t capacity)
+	{
+		if (board != nullptr)
+		{
+			board->SubscribeEvents(mask, capacity);
+		}
+	}
+
+	DLL_EXPORT size_t GetEventCount()
+	{
+		if (board != nullptr && board->GetEvents() != nullptr)
+		{
+			return board->GetEvents()->GetCount();
+		}
+		else
+		{
+			return 0;
+		}
+	}
+
+	DLL_EXPORT size_t ReadEvents(Breaknes::BoardEvent* events, size_t max_count)
+	{
+		if (board != nullptr && board->GetEvents() != nullptr)
+		{
+			return board->GetEvents()->Read(events, max_count);
+		}
+		else
+		{
+			return 0;
+		}
+	}
+
+	DLL_EXPORT uint64_t GetLostEventCount()
+	{
+		if (board != nullptr && board->GetEvents() != nullptr)
+		{
+			return board->GetEvents()->GetLost();
+		}
+		else
+		{
+			return 0;
+		}
+	}
+
+	DLL_EXPORT size_t StepUntilEvent(size_t max_steps)
+	{
+		if (board == nullptr)
+			return 0;
+
+		Breaknes::BoardEvents* events = board->GetEvents();
+		size_t steps = 0;
+
+		while (steps < max_steps && (events == nullptr || events->GetCount() == 0))
+		{
+			board->Step();
+			board->TreatAudioFilter();
+			board->TreatSignalRecorder();
+			board->TreatDebugSnapshot();
+			board->TreatInputMovie();
+			steps++;
+		}
+
+		return steps;
+	}
+
+	DLL_EXPORT void EnableDebugSnapshot(int cadence, size_t period, bool with_memory)
+	{
+		if (board != nullptr)
+		{
+			board->EnableDebugSnapshot((Breaknes::DebugSnapshotCadence)cadence, period, with_memory);
+		}
+	}
+
+	DLL_EXPORT uint64_t AcquireDebugSnapshot(uint64_t* phi)
+	{
+		if (board != nullptr && board->GetDebugSnapshot() != nullptr)
+		{
+			return board->GetDebugSnapshot()->Acquire(phi);
+		}
+		else
+		{
+			return 0;
+		}
+	}
+
+	DLL_EXPORT size_t SnapshotGetDebugInfo(DebugInfoType type, DebugInfoEntry* entries)
+	{
+		if (board != nullptr && board->GetDebugSnapshot() != nullptr)
+		{
+			return board->GetDebugSnapshot()->GetDebugInfo(type, entries);
+		}
+		else
+		{
+			return 0;
+		}
+	}
+
+	DLL_EXPORT size_t SnapshotDumpMem(size_t descrID, uint8_t* ptr)
+	{
+		if (board != nullptr && board->GetDebugSnapshot() != nullptr)
+		{
+			return board->GetDebugSnapshot()->DumpMem(descrID, ptr);
+		}
+		else
+		{
+			return 0;
+		}
+	}
+
+	DLL_EXPORT int SnapshotGetAllCoreDebugInfo(M6502Core::DebugInfo* info)
+	{
+		if (board != nullptr && board->GetDebugSnapshot() != nullptr)
+		{
+			return board->GetDebugSnapshot()->GetCoreDebugInfo(info) ? 0 : -1;
+		}
+		else
+		{
+			return -1;
+		}
+	}
+
+	DLL_EXPORT int StartInputRecording(char* filename)
+	{
+		if (board != nullptr)
+		{
+			printf("StartInputRecording: %s\n", filename);
+			return board->StartInputMovie(true, filename);
+		}
+		else
+		{
+			return -1;
+		}
+	}
+
+	DLL_EXPORT int StartInputPlayback(char* filename)
+	{
+		if (board != nullptr)
+		{
+			printf("StartInputPlayback: %s\n", filename);
+			return board->StartInputMovie(false, filename);
+		}
+		else
+		{
+			return -1;
+		}
+	}
+
+	DLL_EXPORT void StopInputMovie()
+	{
+		if (board != nullptr)
+		{
+			board->StopInputMovie();
+		}
+	}
+
+	DLL_EXPORT int GetInputMovieState(uint64_t* phi, uint64_t* entries, uint64_t* dropped)
+	{
+		if (board != nullptr && board->GetInputMovie() != nullptr)
+		{
+			Breaknes::InputMovie* movie = board->GetInputMovie();
+			*phi = movie->GetTime();
+			*entries = movie->GetEntryCount();
+			*dropped = movie->GetDroppedCount();
+			return (int)movie->GetMode();
+		}
+		else
+		{
+			*phi = 0;
+			*entries = 0;
+			*dropped = 0;
+			return 0;
+		}
+	}
+
 	DLL_EXPORT void EnablePpuRegDump(bool enable, char* regdump_dir)
 	{
 		if (board != nullptr)
@@ -139,6 +391,34 @@ extern "C"
 		}
 	}
 
+	DLL_EXPORT void SetRegDumpKeyframeInterval(size_t frames)
+	{
+		if (board != nullptr)
+		{
+			board->SetRegDumpKeyframeInterval(frames);
+		}
+	}
+
+	DLL_EXPORT void SetRegDumpFormat(int format, bool drop_when_full)
+	{
+		if (board != nullptr)
+		{
+			board->SetRegDumpFormat((RegDumpFormat)format, drop_when_full);
+		}
+	}
+
+	DLL_EXPORT int GetRegDumpStats(bool ppu_dump, RegDumpStats* stats)
+	{
+		if (board != nullptr)
+		{
+			return board->GetRegDumpStats(ppu_dump, stats) ? 1 : 0;
+		}
+		else
+		{
+			return 0;
+		}
+	}
+
 	DLL_EXPORT void GetApuSignalFeatures(APUSim::AudioSignalFeatures* features)
 	{
 		if (board != nullptr)
@@ -309,7 +589,20 @@ extern "C"
 		if (board != nullptr && board->io != nullptr)
 		{
 			printf("IOSetState: handle: %d, io_state: %d, value: 0x%08X\n", (int)handle, (int)io_state, value);
-			board->io->SetState((int)handle, io_state, value);
+
+			// With a movie the change goes through it, to be applied (and recorded) between the half cycles
+
+			if (board->GetInputMovie() != nullptr)
+			{
+				if (!board->GetInputMovie()->SetState((int)handle, io_state, value))
+				{
+					printf("IOSetState: dropped by the input movie (playback, or the simulation does not run)\n");
+				}
+			}
+			else
+			{
+				board->io->SetState((int)handle, io_state, value);
+			}
 		}
 	}
 
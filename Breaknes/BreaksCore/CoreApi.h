@@ -70,13 +70,152 @@ extern "C"
 	/// <returns></returns>
 	DLL_EXPORT void SampleAudioSignal(float* sample);
 
+	/// <summary>
+	/// Enable the board filters (HPF/LPF) for the audio signal. The set of filters depends on the board (NES/Famicom).
+	/// </summary>
+	/// <param name="placement">Where the filters are applied</param>
+	/// <param name="output_sample_rate">The rate at which the consumer takes samples (used only for PostResample placement)</param>
+	DLL_EXPORT void SetAudioFilter(Breaknes::AudioFilterPlacement placement, int32_t output_sample_rate);
+
 	/// <summary>
 	/// Load APU/PPU registers dump (APUPlayer/PPUPlayer only)
 	/// </summary>
-	/// <param name="data">RegDumpEntry records</param>
+	/// <param name="data">RegDumpEntry records (old format) or the indexed regdump</param>
 	/// <param name="data_size">Dump size (bytes)</param>
 	DLL_EXPORT void LoadRegDump(uint8_t* data, size_t data_size);
 
+	/// <summary>
+	/// Play APU/PPU registers dump directly from the file (APUPlayer/PPUPlayer only). The file is memory-mapped, not loaded, so it can be of any size.
+	/// </summary>
+	/// <returns>1: OK; 0: the file cannot be mapped</returns>
+	DLL_EXPORT int MapRegDump(char* filename);
+
+	/// <summary>
+	/// Approximate seek: rewind the loaded regdump to the nearest keyframe before the specified frame (APUPlayer/PPUPlayer only, indexed regdump only).
+	/// The keyframe holds only the memories and registers visible through DebugHub, not the full chip state.
+	/// </summary>
+	/// <returns>The frame from which the playback resumes, or -1 if the regdump does not support seeking</returns>
+	DLL_EXPORT int SeekRegDump(size_t frame);
+
+	/// <summary>
+	/// Create/delete the signal recorder of the board. The recorder samples the selected signals every CLK half cycle and keeps the changes in a ring.
+	/// </summary>
+	/// <param name="enable">true: create the recorder (the previous recording is discarded)</param>
+	/// <param name="capacity">Ring size (in signal changes)</param>
+	DLL_EXPORT void EnableSignalRecorder(bool enable, size_t capacity);
+
+	/// <summary>
+	/// Add a signal to the recording (before the first Step after EnableSignalRecorder).
+	/// </summary>
+	/// <param name="category">Signal category (as in DebugInfo)</param>
+	/// <param name="name">Signal name (as in DebugInfo)</param>
+	/// <returns>Signal index or -1</returns>
+	DLL_EXPORT int AddRecorderSignal(char* category, char* name);
+
+	/// <summary>
+	/// Get the time range available in the recorder ring (in CLK half cycles).
+	/// </summary>
+	DLL_EXPORT void GetRecorderTimeRange(uint64_t* oldest, uint64_t* now);
+
+	/// <summary>
+	/// Save the window of the recording in VCD format.
+	/// </summary>
+	/// <returns>1: OK; 0: no recorder, empty window or the file cannot be created</returns>
+	DLL_EXPORT int ExportSignalRecording(char* filename, uint64_t from, uint64_t to);
+
+	/// <summary>
+	/// Subscribe to the board events (see BoardEventType). The events are collected into a ring and read with ReadEvents.
+	/// Without a subscription the events are not checked at all.
+	/// </summary>
+	/// <param name="mask">Combination of BOARD_EVENT_BIT(BoardEventType). 0: unsubscribe</param>
+	/// <param name="capacity">Ring size (in events). When the ring is full, the new events are lost.</param>
+	DLL_EXPORT void SubscribeEvents(uint32_t mask, size_t capacity);
+
+	/// <summary>
+	/// Number of the events waiting in the ring.
+	/// </summary>
+	DLL_EXPORT size_t GetEventCount();
+
+	/// <summary>
+	/// Take the oldest events out of the ring.
+	/// </summary>
+	/// <returns>Number of events copied</returns>
+	DLL_EXPORT size_t ReadEvents(Breaknes::BoardEvent* events, size_t max_count);
+
+	/// <summary>
+	/// Number of the events lost because the ring was full.
+	/// </summary>
+	DLL_EXPORT uint64_t GetLostEventCount();
+
+	/// <summary>
+	/// Same as Step, but repeated until there is an event in the ring (or max_steps half cycles are simulated).
+	/// Saves the frontend from checking the counters after every half cycle.
+	/// </summary>
+	/// <returns>Number of the half cycles simulated</returns>
+	DLL_EXPORT size_t StepUntilEvent(size_t max_steps);
+
+	/// <summary>
+	/// Enable the DebugHub snapshots (see Breaknes::DebugSnapshotCadence). The simulation thread takes the snapshot of all DebugInfo entries (and memory regions) at the specified cadence;
+	/// the GUI thread reads the latest snapshot without stopping the simulation and without torn values.
+	/// </summary>
+	/// <param name="cadence">0: disabled, 1: every PPU field, 2: every `period` CLK half cycles</param>
+	/// <param name="period">CLK half cycles between the snapshots (cadence 2)</param>
+	/// <param name="with_memory">true: the snapshot also includes all memory regions</param>
+	DLL_EXPORT void EnableDebugSnapshot(int cadence, size_t period, bool with_memory);
+
+	/// <summary>
+	/// Take the latest snapshot. The following Snapshot* calls read it until the next AcquireDebugSnapshot.
+	/// </summary>
+	/// <param name="phi">The 6502 core cycle counter at the time of the snapshot</param>
+	/// <returns>Sequence number of the snapshot (increases with each snapshot taken); 0: there is no snapshot yet</returns>
+	DLL_EXPORT uint64_t AcquireDebugSnapshot(uint64_t* phi);
+
+	/// <summary>
+	/// Same as GetDebugInfo, but the values are taken from the acquired snapshot.
+	/// </summary>
+	/// <returns>Number of the values taken from the snapshot</returns>
+	DLL_EXPORT size_t SnapshotGetDebugInfo(DebugInfoType type, DebugInfoEntry* entries);
+
+	/// <summary>
+	/// Same as DumpMem, but from the acquired snapshot (if it was enabled with memory regions).
+	/// </summary>
+	/// <returns>Number of bytes copied</returns>
+	DLL_EXPORT size_t SnapshotDumpMem(size_t descrID, uint8_t* ptr);
+
+	/// <summary>
+	/// Same as GetAllCoreDebugInfo, but from the acquired snapshot.
+	/// </summary>
+	/// <returns>0: OK; -1: no snapshot or the board has no 6502 core</returns>
+	DLL_EXPORT int SnapshotGetAllCoreDebugInfo(M6502Core::DebugInfo* info);
+
+	/// <summary>
+	/// Start recording the IO state changes (IOSetState) to the movie file. Each change is applied between two CLK half cycles and saved with the board time (PHI counter and the CLK half cycle within the PHI cycle).
+	/// For the playback to repeat the run exactly, start recording right after Reset, with the IO devices already created and attached.
+	/// </summary>
+	/// <returns>0: OK; -1: the file cannot be created</returns>
+	DLL_EXPORT int StartInputRecording(char* filename);
+
+	/// <summary>
+	/// Play back the movie: the recorded IO state changes are applied at the same board time (PHI counter, CLK half cycle). IOSetState is ignored (dropped) during playback.
+	/// Requires the same ROM, board and IO devices (created and attached in the same order) as the recording.
+	/// </summary>
+	/// <returns>0: OK; -1: the file cannot be opened or it is not a movie</returns>
+	DLL_EXPORT int StartInputPlayback(char* filename);
+
+	/// <summary>
+	/// Stop recording/playback. The recording is closed.
+	/// </summary>
+	DLL_EXPORT void StopInputMovie();
+
+	/// <summary>
+	/// Get the state of the movie.
+	/// </summary>
+	/// <param name="phi">PHI cycles since the start</param>
+	/// <param name="entries">IO state changes recorded/played so far</param>
+	/// <param name="dropped">IOSetState calls dropped: during playback, or when the queue to the simulation thread was full (the simulation is paused or stepping)</param>
+	/// <returns>Breaknes::InputMovieMode (0: no movie, 1: recording, 2: playback, 3: playback finished)</returns>
+	DLL_EXPORT int GetInputMovieState(uint64_t* phi, uint64_t* entries, uint64_t* dropped);
+
 	/// <summary>
 	/// Enable/disable saving the history of PPU register accesses.
 	/// </summary>
@@ -87,6 +226,24 @@ extern "C"
 	/// </summary>
 	DLL_EXPORT void EnableApuRegDump(bool enable, char* regdump_dir);
 
+	/// <summary>
+	/// Save a keyframe (DebugHub memories and registers only) to the regdumps every N frames (0: no keyframes). Call before enabling the regdumps.
+	/// </summary>
+	DLL_EXPORT void SetRegDumpKeyframeInterval(size_t frames);
+
+	/// <summary>
+	/// Select the regdump format: 0 - indexed, 1 - indexed with packed register operations, 2 - old format (bare RegDumpEntry stream). Call before enabling the regdumps.
+	/// </summary>
+	/// <param name="drop_when_full">Drop the register operations instead of waiting when the writer cannot keep up (indexed formats only)</param>
+	DLL_EXPORT void SetRegDumpFormat(int format, bool drop_when_full);
+
+	/// <summary>
+	/// Get the counters of the regdump being saved (entries, bytes written, drops, stalls).
+	/// </summary>
+	/// <param name="ppu_dump">true: PPU regdump, false: APU regdump</param>
+	/// <returns>1: OK; 0: the regdump is not enabled</returns>
+	DLL_EXPORT int GetRegDumpStats(bool ppu_dump, RegDumpStats* stats);
+
 	/// <summary>
 	/// Get audio signal settings that help with its rendering on the consumer side.
 	/// </summary>
@@ -12,6 +12,7 @@ DebugHub::~DebugHub()
 {
 	DisposeDebugInfo();
 	DisposeMemMap();
+	delete[] memIndex;
 }
 
 void DebugHub::AddDebugInfo(DebugInfoType type, DebugInfoEntry* entry, 
@@ -66,6 +67,52 @@ void DebugHub::AddDebugInfo(DebugInfoType type, DebugInfoEntry* entry,
 	}
 }
 
+std::list<DebugInfoProvider>* DebugHub::GetDebugInfoList(DebugInfoType type)
+{
+	std::list<DebugInfoProvider> * info_list = nullptr;
+
+	switch (type)
+	{
+		case DebugInfoType::DebugInfoType_Test:
+			info_list = &testInfo;
+			break;
+
+		case DebugInfoType::DebugInfoType_Core:
+			info_list = &coreInfo;
+			break;
+
+		case DebugInfoType::DebugInfoType_CoreRegs:
+			info_list = &coreRegsInfo;
+			break;
+
+		case DebugInfoType::DebugInfoType_APU:
+			info_list = &apuInfo;
+			break;
+
+		case DebugInfoType::DebugInfoType_APURegs:
+			info_list = &apuRegsInfo;
+			break;
+
+		case DebugInfoType::DebugInfoType_PPU:
+			info_list = &ppuInfo;
+			break;
+
+		case DebugInfoType::DebugInfoType_PPURegs:
+			info_list = &ppuRegsInfo;
+			break;
+
+		case DebugInfoType::DebugInfoType_Board:
+			info_list = &boardInfo;
+			break;
+
+		case DebugInfoType::DebugInfoType_Cart:
+			info_list = &cartInfo;
+			break;
+	}
+
+	return info_list;
+}
+
 void DebugHub::DisposeDebugInfo()
 {
 	for (auto it = testInfo.begin(); it != testInfo.end(); ++it)
@@ -132,7 +179,8 @@ void DebugHub::DisposeCartDebugInfo()
 	cartInfo.clear();
 }
 
-void DebugHub::AddMemRegion(MemDesciptor* descr, uint8_t(*ReadByte)(void* opaque, size_t addr), void(*WriteByte)(void* opaque, size_t addr, uint8_t data), void* opaque, bool cartRelated)
+void DebugHub::AddMemRegion(MemDesciptor* descr, uint8_t(*ReadByte)(void* opaque, size_t addr), void(*WriteByte)(void* opaque, size_t addr, uint8_t data), void* opaque, bool cartRelated,
+	uint8_t* (*GetSpan)(void* opaque), void (*ReadBlock)(void* opaque, uint8_t* ptr, size_t size))
 {
 	MemProvider prov{};
 	prov.descr = descr;
@@ -140,7 +188,55 @@ void DebugHub::AddMemRegion(MemDesciptor* descr, uint8_t(*ReadByte)(void* opaque
 	prov.WriteByte = WriteByte;
 	prov.opaque = opaque;
 	prov.cartRelated = cartRelated;
+	prov.GetSpan = GetSpan;
+	prov.ReadBlock = ReadBlock;
 	memMap.push_back(prov);
+	RebuildMemIndex();
+}
+
+void DebugHub::RebuildMemIndex()
+{
+	delete[] memIndex;
+	memIndex = nullptr;
+	memIndexSize = memMap.size();
+
+	if (memIndexSize == 0)
+		return;
+
+	memIndex = new MemProvider * [memIndexSize];
+
+	size_t n = 0;
+	for (auto it = memMap.begin(); it != memMap.end(); ++it)
+	{
+		memIndex[n++] = &(*it);
+	}
+}
+
+MemProvider* DebugHub::GetMemRegion(size_t descrID)
+{
+	return descrID < memIndexSize ? memIndex[descrID] : nullptr;
+}
+
+void DebugHub::ReadMemRegion(MemProvider* prov, uint8_t* ptr)
+{
+	size_t size = prov->descr->size;
+	uint8_t* span = prov->GetSpan != nullptr ? prov->GetSpan(prov->opaque) : nullptr;
+
+	if (span != nullptr)
+	{
+		memcpy(ptr, span, size);
+	}
+	else if (prov->ReadBlock != nullptr)
+	{
+		prov->ReadBlock(prov->opaque, ptr, size);
+	}
+	else
+	{
+		for (size_t addr = 0; addr < size; addr++)
+		{
+			*ptr++ = prov->ReadByte(prov->opaque, addr);
+		}
+	}
 }
 
 void DebugHub::DisposeMemMap()
@@ -150,6 +246,7 @@ void DebugHub::DisposeMemMap()
 		delete it->descr;
 	}
 	memMap.clear();
+	RebuildMemIndex();
 }
 
 void DebugHub::DisposeCartMemMap()
@@ -169,6 +266,8 @@ void DebugHub::DisposeCartMemMap()
 			it++;
 		}
 	}
+
+	RebuildMemIndex();
 }
 
 void CreateDebugHub(bool reopen_stdout)
@@ -308,48 +407,7 @@ extern "C"
 
 	static std::list<DebugInfoProvider>* GetDebugInfoListByType(DebugInfoType type)
 	{
-		std::list<DebugInfoProvider> * info_list = nullptr;
-
-		switch (type)
-		{
-			case DebugInfoType::DebugInfoType_Test:
-				info_list = &dbg_hub->testInfo;
-				break;
-
-			case DebugInfoType::DebugInfoType_Core:
-				info_list = &dbg_hub->coreInfo;
-				break;
-
-			case DebugInfoType::DebugInfoType_CoreRegs:
-				info_list = &dbg_hub->coreRegsInfo;
-				break;
-
-			case DebugInfoType::DebugInfoType_APU:
-				info_list = &dbg_hub->apuInfo;
-				break;
-
-			case DebugInfoType::DebugInfoType_APURegs:
-				info_list = &dbg_hub->apuRegsInfo;
-				break;
-
-			case DebugInfoType::DebugInfoType_PPU:
-				info_list = &dbg_hub->ppuInfo;
-				break;
-
-			case DebugInfoType::DebugInfoType_PPURegs:
-				info_list = &dbg_hub->ppuRegsInfo;
-				break;
-
-			case DebugInfoType::DebugInfoType_Board:
-				info_list = &dbg_hub->boardInfo;
-				break;
-
-			case DebugInfoType::DebugInfoType_Cart:
-				info_list = &dbg_hub->cartInfo;
-				break;
-		}
-
-		return info_list;
+		return dbg_hub->GetDebugInfoList(type);
 	}
 
 	/// <summary>
@@ -435,17 +493,10 @@ extern "C"
 		if (!dbg_hub)
 			return;
 
-		size_t counter = 0;
-
-		for (auto it = dbg_hub->memMap.begin(); it != dbg_hub->memMap.end(); ++it)
+		MemProvider* prov = dbg_hub->GetMemRegion(descrID);
+		if (prov != nullptr)
 		{
-			if (counter == descrID)
-			{
-				memcpy(descr, it->descr, sizeof(MemDesciptor));
-				break;
-			}
-
-			counter++;
+			memcpy(descr, prov->descr, sizeof(MemDesciptor));
 		}
 	}
 
@@ -460,29 +511,10 @@ extern "C"
 		if (!dbg_hub)
 			return;
 
-		MemProvider prov;
-		bool provFound = false;
-
-		size_t counter = 0;
-
-		for (auto it = dbg_hub->memMap.begin(); it != dbg_hub->memMap.end(); ++it)
-		{
-			if (counter == descrID)
-			{
-				prov = *it;
-				provFound = true;
-				break;
-			}
-
-			counter++;
-		}
-
-		if (provFound)
+		MemProvider* prov = dbg_hub->GetMemRegion(descrID);
+		if (prov != nullptr)
 		{
-			for (size_t addr = 0; addr < prov.descr->size; addr++)
-			{
-				*ptr++ = prov.ReadByte(prov.opaque, addr);
-			}
+			dbg_hub->ReadMemRegion(prov, ptr);
 		}
 	}
 
@@ -497,28 +529,12 @@ extern "C"
 		if (!dbg_hub)
 			return;
 
-		MemProvider prov;
-		bool provFound = false;
-
-		size_t counter = 0;
-
-		for (auto it = dbg_hub->memMap.begin(); it != dbg_hub->memMap.end(); ++it)
-		{
-			if (counter == descrID)
-			{
-				prov = *it;
-				provFound = true;
-				break;
-			}
-
-			counter++;
-		}
-
-		if (provFound)
+		MemProvider* prov = dbg_hub->GetMemRegion(descrID);
+		if (prov != nullptr)
 		{
-			for (size_t addr = 0; addr < prov.descr->size; addr++)
+			for (size_t addr = 0; addr < prov->descr->size; addr++)
 			{
-				prov.WriteByte(prov.opaque, addr, *ptr++);
+				prov->WriteByte(prov->opaque, addr, *ptr++);
 			}
 		}
 	}
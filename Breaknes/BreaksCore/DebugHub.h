@@ -56,10 +56,18 @@ struct MemProvider
 	void(*WriteByte)(void* opaque, size_t addr, uint8_t data);
 	void* opaque;
 	bool cartRelated;
+	uint8_t* (*GetSpan)(void* opaque);		// Optional: direct pointer to the whole region (plain memories)
+	void (*ReadBlock)(void* opaque, uint8_t* ptr, size_t size);		// Optional: copy out the whole region at once (memories that need masking, e.g. OAM)
 };
 
 class DebugHub
 {
+	// Index of memMap by descriptor ID (the list elements do not move)
+	MemProvider** memIndex = nullptr;
+	size_t memIndexSize = 0;
+
+	void RebuildMemIndex();
+
 public:
 
 	std::list<DebugInfoProvider> testInfo;
@@ -90,6 +98,11 @@ public:
 		void (*SetValue)(void* opaque, DebugInfoEntry* entry, uint32_t value),
 		void* opaque);
 
+	/// <summary>
+	/// Get the list of handlers of the specified type (nullptr: unknown type)
+	/// </summary>
+	std::list<DebugInfoProvider>* GetDebugInfoList(DebugInfoType type);
+
 	/// <summary>
 	/// Delete all debugging information handlers
 	/// </summary>
@@ -108,7 +121,20 @@ public:
 	/// <param name="WriteByte">Delegate to write one byte</param>
 	/// <param name="opaque">Transparent pointer to pass to the delegate (usually `this`)</param>
 	/// <param name="cartRelated">true: The memory region refers to the external cartridge.</param>
-	void AddMemRegion(MemDesciptor* descr, uint8_t (*ReadByte)(void* opaque, size_t addr), void(*WriteByte)(void* opaque, size_t addr, uint8_t data), void* opaque, bool cartRelated);
+	/// <param name="GetSpan">Optional delegate to get the pointer to the whole region (may return nullptr, then the bytes are read one by one)</param>
+	/// <param name="ReadBlock">Optional delegate to copy out the whole region (if there is no span)</param>
+	void AddMemRegion(MemDesciptor* descr, uint8_t (*ReadByte)(void* opaque, size_t addr), void(*WriteByte)(void* opaque, size_t addr, uint8_t data), void* opaque, bool cartRelated,
+		uint8_t* (*GetSpan)(void* opaque) = nullptr, void (*ReadBlock)(void* opaque, uint8_t* ptr, size_t size) = nullptr);
+
+	/// <summary>
+	/// Get the memory region by descriptor ID (nullptr: no such region).
+	/// </summary>
+	MemProvider* GetMemRegion(size_t descrID);
+
+	/// <summary>
+	/// Copy the whole memory region (descr->size bytes), in the fastest way the provider supports.
+	/// </summary>
+	void ReadMemRegion(MemProvider* prov, uint8_t* ptr);
 
 	/// <summary>
 	/// Clear MemLayout.
@@ -0,0 +1,270 @@
+// Consistent snapshots of the DebugHub state, taken by the simulation thread for the GUI thread.
+
+#include "pch.h"
+
+namespace Breaknes
+{
+	DebugSnapshot::DebugSnapshot(DebugSnapshotCadence _cadence, size_t _period, bool _with_memory)
+	{
+		cadence = _cadence;
+		period = _period != 0 ? _period : 1;
+		with_memory = _with_memory;
+		countdown = period;
+	}
+
+	DebugSnapshot::~DebugSnapshot()
+	{
+		for (size_t n = 0; n < 3; n++)
+		{
+			delete[] buffers[n].data;
+		}
+	}
+
+	void DebugSnapshot::Reserve(Buffer& buf, size_t size)
+	{
+		if (buf.size + size <= buf.capacity)
+			return;
+
+		size_t capacity = std::max(buf.capacity * 2, buf.size + size);
+		uint8_t* mem = new uint8_t[capacity];
+		if (buf.data != nullptr)
+		{
+			memcpy(mem, buf.data, buf.size);
+		}
+		delete[] buf.data;
+		buf.data = mem;
+		buf.capacity = capacity;
+	}
+
+	void DebugSnapshot::Append(Buffer& buf, const void* data, size_t size)
+	{
+		Reserve(buf, size);
+		memcpy(buf.data + buf.size, data, size);
+		buf.size += size;
+	}
+
+	void DebugSnapshot::Treat(M6502Core::M6502* core, PPUSim::PPU* ppu, uint64_t phi)
+	{
+		clk++;
+
+		switch (cadence)
+		{
+			case DebugSnapshotCadence::Field:
+				if (ppu != nullptr)
+				{
+					size_t v = ppu->GetVCounter();
+					if (v == 0 && prev_v != 0)
+					{
+						Capture(core, phi);
+					}
+					prev_v = v;
+				}
+				break;
+
+			case DebugSnapshotCadence::Cycles:
+				if (--countdown == 0)
+				{
+					Capture(core, phi);
+					countdown = period;
+				}
+				break;
+
+			default:
+				break;
+		}
+	}
+
+	/// <summary>
+	/// Collect everything into the back buffer (owned by the simulation thread) and publish it.
+	/// The buffer grows if the DebugHub has more entries than before (e.g. another cartridge).
+	/// </summary>
+	void DebugSnapshot::Capture(M6502Core::M6502* core, uint64_t phi)
+	{
+		if (dbg_hub == nullptr)
+			return;
+
+		Buffer& buf = buffers[back];
+		buf.size = 0;
+
+		Header header{};
+		header.sequence = ++sequence;
+		header.phi = phi;
+		header.clk = clk;
+		header.has_core = core != nullptr ? 1 : 0;
+
+		for (size_t type = 0; type < NumInfoTypes; type++)
+		{
+			auto info_list = dbg_hub->GetDebugInfoList((DebugInfoType)type);
+			header.info_count[type] = info_list != nullptr ? (uint32_t)info_list->size() : 0;
+		}
+		header.mem_count = with_memory ? (uint32_t)dbg_hub->memMap.size() : 0;
+
+		Append(buf, &header, sizeof(header));
+
+		if (core != nullptr)
+		{
+			M6502Core::DebugInfo info{};
+			core->getDebug(&info);
+			Append(buf, &info, sizeof(info));
+		}
+
+		for (size_t type = 0; type < NumInfoTypes; type++)
+		{
+			auto info_list = dbg_hub->GetDebugInfoList((DebugInfoType)type);
+			if (info_list == nullptr)
+				continue;
+
+			for (auto it = info_list->begin(); it != info_list->end(); ++it)
+			{
+				uint32_t value = it->GetValue(it->opaque, it->entry);
+				Append(buf, &value, sizeof(value));
+			}
+		}
+
+		if (with_memory)
+		{
+			for (auto it = dbg_hub->memMap.begin(); it != dbg_hub->memMap.end(); ++it)
+			{
+				int32_t size = it->descr->size;
+				Append(buf, &size, sizeof(size));
+
+				Reserve(buf, size);
+				dbg_hub->ReadMemRegion(&(*it), buf.data + buf.size);
+				buf.size += size;
+			}
+		}
+
+		Publish();
+	}
+
+	void DebugSnapshot::Publish()
+	{
+		uint32_t prev = middle.exchange(back | FreshBit, std::memory_order_acq_rel);
+		back = prev & ~FreshBit;
+	}
+
+	uint64_t DebugSnapshot::Acquire(uint64_t* phi)
+	{
+		if (middle.load(std::memory_order_acquire) & FreshBit)
+		{
+			uint32_t prev = middle.exchange(front, std::memory_order_acq_rel);
+			front = prev & ~FreshBit;
+		}
+
+		Buffer& buf = buffers[front];
+		if (buf.size == 0)
+		{
+			if (phi != nullptr)
+				*phi = 0;
+			return 0;
+		}
+
+		Header* header = (Header*)buf.data;
+		if (phi != nullptr)
+			*phi = header->phi;
+		return header->sequence;
+	}
+
+	/// <summary>
+	/// Pointer to the values of the specified type in the front buffer.
+	/// </summary>
+	uint8_t* DebugSnapshot::FrontValues(DebugInfoType type, size_t* count)
+	{
+		Buffer& buf = buffers[front];
+		*count = 0;
+
+		if (buf.size == 0 || (size_t)type >= NumInfoTypes)
+			return nullptr;
+
+		Header* header = (Header*)buf.data;
+		uint8_t* ptr = buf.data + sizeof(Header);
+
+		if (header->has_core)
+		{
+			ptr += sizeof(M6502Core::DebugInfo);
+		}
+
+		for (size_t n = 0; n < (size_t)type; n++)
+		{
+			ptr += header->info_count[n] * sizeof(uint32_t);
+		}
+
+		*count = header->info_count[type];
+		return ptr;
+	}
+
+	size_t DebugSnapshot::GetDebugInfo(DebugInfoType type, DebugInfoEntry* entries)
+	{
+		if (dbg_hub == nullptr)
+			return 0;
+
+		auto info_list = dbg_hub->GetDebugInfoList(type);
+		if (info_list == nullptr)
+			return 0;
+
+		size_t count;
+		uint8_t* values = FrontValues(type, &count);
+		DebugInfoEntry* ptr = entries;
+		size_t n = 0;
+
+		for (auto it = info_list->begin(); it != info_list->end(); ++it)
+		{
+			memcpy(ptr->category, it->entry->category, sizeof(ptr->category));
+			memcpy(ptr->name, it->entry->name, sizeof(ptr->name));
+			ptr->bits = it->entry->bits;
+			ptr->value = 0;
+			if (n < count)
+			{
+				memcpy(&ptr->value, values + n * sizeof(uint32_t), sizeof(uint32_t));
+			}
+			ptr++;
+			n++;
+		}
+
+		return std::min(n, count);
+	}
+
+	size_t DebugSnapshot::DumpMem(size_t descrID, uint8_t* ptr)
+	{
+		size_t count;
+		uint8_t* mem = FrontValues((DebugInfoType)(NumInfoTypes - 1), &count);
+		if (mem == nullptr)
+			return 0;
+
+		Header* header = (Header*)buffers[front].data;
+		if (descrID >= header->mem_count)
+			return 0;
+
+		mem += count * sizeof(uint32_t);
+
+		for (size_t n = 0; n < header->mem_count; n++)
+		{
+			int32_t size;
+			memcpy(&size, mem, sizeof(size));
+			mem += sizeof(size);
+
+			if (n == descrID)
+			{
+				memcpy(ptr, mem, size);
+				return size;
+			}
+			mem += size;
+		}
+
+		return 0;
+	}
+
+	bool DebugSnapshot::GetCoreDebugInfo(M6502Core::DebugInfo* info)
+	{
+		Buffer& buf = buffers[front];
+		if (buf.size == 0)
+			return false;
+
+		Header* header = (Header*)buf.data;
+		if (!header->has_core)
+			return false;
+
+		memcpy(info, buf.data + sizeof(Header), sizeof(M6502Core::DebugInfo));
+		return true;
+	}
+}
@@ -0,0 +1,109 @@
+// Consistent snapshots of the DebugHub state, taken by the simulation thread for the GUI thread.
+
+#pragma once
+
+namespace Breaknes
+{
+	/// <summary>
+	/// When the simulation thread takes the snapshot.
+	/// </summary>
+	enum class DebugSnapshotCadence
+	{
+		Disabled = 0,
+		Field,				// At the beginning of each PPU field (V counter wraps to 0)
+		Cycles,				// Every N CLK half cycles
+	};
+
+	/// <summary>
+	/// The values of all DebugInfo entries, the 6502 core debug info and (optionally) all memory regions of the DebugHub, taken at one CLK half cycle.
+	/// The simulation thread writes the snapshot into a triple buffer; the reader takes the latest one without locks and without waiting for the simulation (and vice versa).
+	/// There is one writer (the simulation thread) and one reader (the GUI thread).
+	/// </summary>
+	class DebugSnapshot
+	{
+		// DebugInfoType_Unknown...DebugInfoType_Cart
+		static const size_t NumInfoTypes = DebugInfoType_Cart + 1;
+
+		/// <summary>
+		/// The beginning of each buffer. Then follow: M6502Core::DebugInfo (if has_core), the values of the DebugInfo entries (uint32_t, by type, in the order of the DebugHub lists),
+		/// then the memory regions (int32_t size + the bytes, in the order of the DebugHub memMap).
+		/// </summary>
+		struct Header
+		{
+			uint64_t sequence;
+			uint64_t phi;
+			uint64_t clk;
+			uint32_t info_count[NumInfoTypes];
+			uint32_t mem_count;
+			uint32_t has_core;
+		};
+
+		struct Buffer
+		{
+			uint8_t* data;
+			size_t size;
+			size_t capacity;
+		};
+
+		// The buffer index + FreshBit (the buffer in the middle is newer than the reader has)
+		static const uint32_t FreshBit = 4;
+
+		Buffer buffers[3]{};
+		uint32_t back = 0;					// Written by the simulation thread
+		uint32_t front = 1;					// Read by the GUI thread
+		std::atomic<uint32_t> middle{ 2 };
+
+		DebugSnapshotCadence cadence = DebugSnapshotCadence::Disabled;
+		size_t period = 0;
+		bool with_memory = false;
+
+		uint64_t sequence = 0;
+		uint64_t clk = 0;
+		size_t countdown = 0;
+		size_t prev_v = 0;
+
+		void Reserve(Buffer& buf, size_t size);
+		void Append(Buffer& buf, const void* data, size_t size);
+		void Capture(M6502Core::M6502* core, uint64_t phi);
+		void Publish();
+		uint8_t* FrontValues(DebugInfoType type, size_t* count);
+
+	public:
+		DebugSnapshot(DebugSnapshotCadence cadence, size_t period, bool with_memory);
+		~DebugSnapshot();
+
+		/// <summary>
+		/// Called by the simulation thread after each simulated half cycle. Takes the snapshot when it is due.
+		/// </summary>
+		/// <param name="core">6502 core of the board (nullptr: the board does not have it)</param>
+		/// <param name="ppu">PPU of the board, for the Field cadence (nullptr: the board does not have it, the snapshot is never taken)</param>
+		/// <param name="phi">6502 core cycle counter</param>
+		void Treat(M6502Core::M6502* core, PPUSim::PPU* ppu, uint64_t phi);
+
+		/// <summary>
+		/// Take the latest published snapshot (GUI thread). If there is no newer one, the previous snapshot remains.
+		/// </summary>
+		/// <param name="phi">The 6502 core cycle counter at the time of the snapshot</param>
+		/// <returns>Sequence number of the snapshot (starting from 1); 0: no snapshot has been published yet</returns>
+		uint64_t Acquire(uint64_t* phi);
+
+		/// <summary>
+		/// Get the entries of the specified type from the acquired snapshot. The names are taken from the DebugHub, so `entries` has GetDebugInfoEntryCount(type) records.
+		/// The entries that were added after the snapshot was taken get the value 0.
+		/// </summary>
+		/// <returns>Number of the values taken from the snapshot</returns>
+		size_t GetDebugInfo(DebugInfoType type, DebugInfoEntry* entries);
+
+		/// <summary>
+		/// Get the memory region from the acquired snapshot.
+		/// </summary>
+		/// <returns>Number of bytes copied (0: the snapshot has no memory regions or no such region)</returns>
+		size_t DumpMem(size_t descrID, uint8_t* ptr);
+
+		/// <summary>
+		/// Get the 6502 core debug info from the acquired snapshot.
+		/// </summary>
+		/// <returns>false: there is no core in the snapshot</returns>
+		bool GetCoreDebugInfo(M6502Core::DebugInfo* info);
+	};
+}
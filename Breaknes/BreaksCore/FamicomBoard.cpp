@@ -20,6 +20,7 @@ namespace Breaknes
 		vram = new BaseBoard::SRAM("VRAM", vram_bits);
 
 		apu->SetNormalizedOutput(true);
+		audio_preset = AudioFilterPreset::Famicom;
 
 		io = new FamicomBoardIO(this);
 
@@ -56,28 +57,28 @@ namespace Breaknes
 
 		// APU (aka CPU)
 
-		TriState inputs[(size_t)APUSim::APU_Input::Max]{};
-		TriState outputs[(size_t)APUSim::APU_Output::Max]{};
+		Pins32 inputs{};
+		Pins32 outputs{};
 
-		inputs[(size_t)APUSim::APU_Input::CLK] = CLK;
-		inputs[(size_t)APUSim::APU_Input::n_NMI] = nNMI;
-		inputs[(size_t)APUSim::APU_Input::n_IRQ] = nIRQ;
-		inputs[(size_t)APUSim::APU_Input::n_RES] = nRST;
-		inputs[(size_t)APUSim::APU_Input::DBG] = TriState::Zero;	// aka TST
+		inputs.set((size_t)APUSim::APU_Input::CLK, CLK);
+		inputs.set((size_t)APUSim::APU_Input::n_NMI, nNMI);
+		inputs.set((size_t)APUSim::APU_Input::n_IRQ, nIRQ);
+		inputs.set((size_t)APUSim::APU_Input::n_RES, nRST);
+		inputs.set((size_t)APUSim::APU_Input::DBG, TriState::Zero);	// aka TST
 
 		apu->sim(inputs, outputs, &data_bus, &addr_bus, aux);
 
-		CPU_RnW = outputs[(size_t)APUSim::APU_Output::RnW];
-		M2 = outputs[(size_t)APUSim::APU_Output::M2];
+		CPU_RnW = outputs.get((size_t)APUSim::APU_Output::RnW);
+		M2 = outputs.get((size_t)APUSim::APU_Output::M2);
 
 		// Accesses by the embedded core to APU registers are still broadcast to the address bus via the multiplexer.
 		TreatCoreForRegdump(addr_bus, data_bus, apu->GetPHI2(), CPU_RnW);
 
-		nRDP0 = outputs[(size_t)APUSim::APU_Output::n_IN0];
-		nRDP1 = outputs[(size_t)APUSim::APU_Output::n_IN1];
-		OUT_0 = outputs[(size_t)APUSim::APU_Output::OUT_0];
-		OUT_1 = outputs[(size_t)APUSim::APU_Output::OUT_1];
-		OUT_2 = outputs[(size_t)APUSim::APU_Output::OUT_2];
+		nRDP0 = outputs.get((size_t)APUSim::APU_Output::n_IN0);
+		nRDP1 = outputs.get((size_t)APUSim::APU_Output::n_IN1);
+		OUT_0 = outputs.get((size_t)APUSim::APU_Output::OUT_0);
+		OUT_1 = outputs.get((size_t)APUSim::APU_Output::OUT_1);
+		OUT_2 = outputs.get((size_t)APUSim::APU_Output::OUT_2);
 
 		// IO
 
@@ -112,23 +113,21 @@ namespace Breaknes
 
 		// PPU
 
-		TriState ppu_inputs[(size_t)PPUSim::InputPad::Max]{};
-		TriState ppu_outputs[(size_t)PPUSim::OutputPad::Max]{};
+		Pins32 ppu_inputs{};
+		Pins32 ppu_outputs{};
 
-		ppu_inputs[(size_t)PPUSim::InputPad::CLK] = CLK;
-		ppu_inputs[(size_t)PPUSim::InputPad::n_RES] = vdd;		// Famicom Board specific ⚠️
-		ppu_inputs[(size_t)PPUSim::InputPad::RnW] = CPU_RnW;
-		ppu_inputs[(size_t)PPUSim::InputPad::RS0] = FromByte((addr_bus >> 0) & 1);
-		ppu_inputs[(size_t)PPUSim::InputPad::RS1] = FromByte((addr_bus >> 1) & 1);
-		ppu_inputs[(size_t)PPUSim::InputPad::RS2] = FromByte((addr_bus >> 2) & 1);
-		ppu_inputs[(size_t)PPUSim::InputPad::n_DBE] = PPU_nCE;
+		ppu_inputs.set((size_t)PPUSim::InputPad::CLK, CLK);
+		ppu_inputs.set((size_t)PPUSim::InputPad::n_RES, vdd);		// Famicom Board specific ⚠️
+		ppu_inputs.set((size_t)PPUSim::InputPad::RnW, CPU_RnW);
+		ppu_inputs.set_bus((size_t)PPUSim::InputPad::RS0, 3, addr_bus);		// CPU A0-A2
+		ppu_inputs.set((size_t)PPUSim::InputPad::n_DBE, PPU_nCE);
 
 		ppu->sim(ppu_inputs, ppu_outputs, &ext_bus, &data_bus, &ad_bus, &pa8_13, vidSample);
 
-		PPU_ALE = ppu_outputs[(size_t)PPUSim::OutputPad::ALE];
-		PPU_nRD = ppu_outputs[(size_t)PPUSim::OutputPad::n_RD];
-		PPU_nWR = ppu_outputs[(size_t)PPUSim::OutputPad::n_WR];
-		nNMI = ppu_outputs[(size_t)PPUSim::OutputPad::n_INT];
+		PPU_ALE = ppu_outputs.get((size_t)PPUSim::OutputPad::ALE);
+		PPU_nRD = ppu_outputs.get((size_t)PPUSim::OutputPad::n_RD);
+		PPU_nWR = ppu_outputs.get((size_t)PPUSim::OutputPad::n_WR);
+		nNMI = ppu_outputs.get((size_t)PPUSim::OutputPad::n_INT);
 
 		// Cartridge In
 
@@ -138,21 +137,22 @@ namespace Breaknes
 		ppu_addr = ((uint16_t)pa8_13 << 8) | LatchedAddr;
 		PPU_nA13 = NOT(FromByte((ppu_addr >> 13) & 1));
 
-		// Cartridge Port
+		// Cartridge Port. While both buses are idle the cartridge is not simulated and its outputs keep the last values (the memories do nothing without /RD, /WR)
 
-		if (cart != nullptr)
+		if (cart != nullptr && CartBusActive(nROMSEL, PPU_nRD, PPU_nWR))
 		{
-			TriState cart_in[(size_t)Mappers::CartInput::Max]{};
-			TriState cart_out[(size_t)Mappers::CartOutput::Max];
+			Pins32 cart_in{};
+			Pins32 cart_out{};
+			cart_out.float_bus(0, (size_t)Mappers::CartOutput::Max);		// What the cartridge does not drive remains `z`
 
 			bool unused;
 
-			cart_in[(size_t)Mappers::CartInput::nRD] = PPU_nRD;
-			cart_in[(size_t)Mappers::CartInput::nWR] = PPU_nWR;
-			cart_in[(size_t)Mappers::CartInput::nPA13] = PPU_nA13;
-			cart_in[(size_t)Mappers::CartInput::M2] = M2;
-			cart_in[(size_t)Mappers::CartInput::nROMSEL] = nROMSEL;
-			cart_in[(size_t)Mappers::CartInput::RnW] = CPU_RnW;
+			cart_in.set((size_t)Mappers::CartInput::nRD, PPU_nRD);
+			cart_in.set((size_t)Mappers::CartInput::nWR, PPU_nWR);
+			cart_in.set((size_t)Mappers::CartInput::nPA13, PPU_nA13);
+			cart_in.set((size_t)Mappers::CartInput::M2, M2);
+			cart_in.set((size_t)Mappers::CartInput::nROMSEL, nROMSEL);
+			cart_in.set((size_t)Mappers::CartInput::RnW, CPU_RnW);
 
 			CartridgeConnectorSimFailure1();
 
@@ -169,10 +169,10 @@ namespace Breaknes
 
 			CartridgeConnectorSimFailure2();
 
-			VRAM_nCE = cart_out[(size_t)Mappers::CartOutput::VRAM_nCS];
-			VRAM_A10 = cart_out[(size_t)Mappers::CartOutput::VRAM_A10];
+			VRAM_nCE = cart_out.get((size_t)Mappers::CartOutput::VRAM_nCS);
+			VRAM_A10 = cart_out.get((size_t)Mappers::CartOutput::VRAM_A10);
 		}
-		else
+		else if (cart == nullptr)
 		{
 			// No cartridge in the slot means 'z' on these signals.
 			// Simulate this situation in the most painless way possible.
@@ -195,6 +195,11 @@ namespace Breaknes
 		WRAM_Addr = addr_bus & (wram_size - 1);
 		wram->sim(WRAM_nCE, CPU_RnW, TriState::Zero, &WRAM_Addr, &data_bus, data_bus_dirty);
 
+		if (events)
+		{
+			TreatEvents(apu->GetPHI2(), CPU_RnW, nNMI, nIRQ);
+		}
+
 		// Tick
 
 		CLK = NOT(CLK);
@@ -212,6 +217,7 @@ namespace Breaknes
 	void FamicomBoard::Reset()
 	{
 		pendingReset = true;
+		ResetCartBus();
 
 		// See NESBoard for the additional info
 
@@ -223,44 +229,42 @@ namespace Breaknes
 		return pendingReset;
 	}
 
-	void FamicomBoard::SampleAudioSignal(float* sample)
+	float FamicomBoard::MixAudio()
 	{
 		// We do everything the same as in the base class, but with the sound from the cartridge taken into account.
 
 		// TODO: Mike
 		// TODO: Expansion port sound
 
-		if (sample != nullptr)
-		{
-			*sample = (
-				aux.normalized.a * 0.4f /* 20k resistor */ + 
-				aux.normalized.b /* 12k resistor */ + 
-				cart_snd.normalized /* levels pls, someone? */) / 3.0f;
-		}
+		return (
+			aux.normalized.a * 0.4f /* 20k resistor */ + 
+			aux.normalized.b /* 12k resistor */ + 
+			cart_snd.normalized /* levels pls, someone? */) / 3.0f;
 	}
 
 	void FamicomBoard::IOBinding()
 	{
 		// First you need to simulate 368s in the direction CPU->Ports
 
-		p4_inputs[(size_t)BaseBoard::LS368_Input::n_G1] = nRDP0;
-		p4_inputs[(size_t)BaseBoard::LS368_Input::n_G2] = vdd;
-		p4_inputs[(size_t)BaseBoard::LS368_Input::A1] = gnd;
-		p4_inputs[(size_t)BaseBoard::LS368_Input::A2] = gnd;
-		p4_inputs[(size_t)BaseBoard::LS368_Input::A3] = M2;
-		p4_inputs[(size_t)BaseBoard::LS368_Input::A4] = gnd;
+		p4_inputs.set((size_t)BaseBoard::LS368_Input::n_G1, nRDP0);
+		p4_inputs.set((size_t)BaseBoard::LS368_Input::n_G2, vdd);
+		p4_inputs.set((size_t)BaseBoard::LS368_Input::A1, gnd);
+		p4_inputs.set((size_t)BaseBoard::LS368_Input::A2, gnd);
+		p4_inputs.set((size_t)BaseBoard::LS368_Input::A3, M2);
+		p4_inputs.set((size_t)BaseBoard::LS368_Input::A4, gnd);
 		P4_IO.sim(p4_inputs, p4_outputs);
 
-		p5_inputs[(size_t)BaseBoard::LS368_Input::n_G1] = nRDP1;
-		p5_inputs[(size_t)BaseBoard::LS368_Input::n_G2] = vdd;	// not yet
-		p5_inputs[(size_t)BaseBoard::LS368_Input::A1] = M2;
-		p5_inputs[(size_t)BaseBoard::LS368_Input::A2] = gnd;
-		p5_inputs[(size_t)BaseBoard::LS368_Input::A3] = gnd;
-		p5_inputs[(size_t)BaseBoard::LS368_Input::A4] = gnd;
+		p5_inputs.set((size_t)BaseBoard::LS368_Input::n_G1, nRDP1);
+		p5_inputs.set((size_t)BaseBoard::LS368_Input::n_G2, vdd);	// not yet
+		p5_inputs.set((size_t)BaseBoard::LS368_Input::A1, M2);
+		p5_inputs.set((size_t)BaseBoard::LS368_Input::A2, gnd);
+		p5_inputs.set((size_t)BaseBoard::LS368_Input::A3, gnd);
+		p5_inputs.set((size_t)BaseBoard::LS368_Input::A4, gnd);
 		P5_IO.sim(p5_inputs, p5_outputs);
 
 		// Call the IO subsystem and it will simulate the controllers and other I/O devices if they are connected
 
+		io->ProcessMailbox();
 		io->sim(0);
 		io->sim(1);
 
@@ -268,37 +272,37 @@ namespace Breaknes
 
 		Pullup(p4016_d0);
 		Pullup(p2_4016_data);
-		p4_inputs[(size_t)BaseBoard::LS368_Input::n_G1] = nRDP0;
-		p4_inputs[(size_t)BaseBoard::LS368_Input::n_G2] = vdd;
-		p4_inputs[(size_t)BaseBoard::LS368_Input::A1] = p4016_d0;	// d0
-		p4_inputs[(size_t)BaseBoard::LS368_Input::A2] = p2_4016_data;	// d1
-		p4_inputs[(size_t)BaseBoard::LS368_Input::A3] = M2;
+		p4_inputs.set((size_t)BaseBoard::LS368_Input::n_G1, nRDP0);
+		p4_inputs.set((size_t)BaseBoard::LS368_Input::n_G2, vdd);
+		p4_inputs.set((size_t)BaseBoard::LS368_Input::A1, p4016_d0);	// d0
+		p4_inputs.set((size_t)BaseBoard::LS368_Input::A2, p2_4016_data);	// d1
+		p4_inputs.set((size_t)BaseBoard::LS368_Input::A3, M2);
 		// TODO: It is not very clear how to convert the Mic signal level into a logical value, for now I will do it like this
-		p4_inputs[(size_t)BaseBoard::LS368_Input::A4] = mic_level > 0.5f ? TriState::One : TriState::Zero;	// d2
+		p4_inputs.set((size_t)BaseBoard::LS368_Input::A4, mic_level > 0.5f ? TriState::One : TriState::Zero);	// d2
 		P4_IO.sim(p4_inputs, p4_outputs);
-		SetDataBusIfNotFloating(0, p4_outputs[(size_t)BaseBoard::LS368_Output::n_Y1]);
-		SetDataBusIfNotFloating(1, p4_outputs[(size_t)BaseBoard::LS368_Output::n_Y2]);
-		SetDataBusIfNotFloating(2, p4_outputs[(size_t)BaseBoard::LS368_Output::n_Y4]);
+		SetDataBusIfNotFloating(0, p4_outputs.get((size_t)BaseBoard::LS368_Output::n_Y1));
+		SetDataBusIfNotFloating(1, p4_outputs.get((size_t)BaseBoard::LS368_Output::n_Y2));
+		SetDataBusIfNotFloating(2, p4_outputs.get((size_t)BaseBoard::LS368_Output::n_Y4));
 
 		Pullup(p2_4017_data[0]);
 		Pullup(p2_4017_data[1]);
 		Pullup(p2_4017_data[2]);
 		Pullup(p2_4017_data[3]);
 		Pullup(p4017_d0);
-		p5_inputs[(size_t)BaseBoard::LS368_Input::n_G1] = nRDP1;
-		p5_inputs[(size_t)BaseBoard::LS368_Input::n_G2] = nRDP1;
-		p5_inputs[(size_t)BaseBoard::LS368_Input::A1] = M2;
-		p5_inputs[(size_t)BaseBoard::LS368_Input::A2] = p2_4017_data[0];	// d1
-		p5_inputs[(size_t)BaseBoard::LS368_Input::A3] = p2_4017_data[2];	// d3
-		p5_inputs[(size_t)BaseBoard::LS368_Input::A4] = p2_4017_data[3];	// d4
-		p5_inputs[(size_t)BaseBoard::LS368_Input::A5] = p2_4017_data[1];	// d2
-		p5_inputs[(size_t)BaseBoard::LS368_Input::A6] = p4017_d0;	// d0
+		p5_inputs.set((size_t)BaseBoard::LS368_Input::n_G1, nRDP1);
+		p5_inputs.set((size_t)BaseBoard::LS368_Input::n_G2, nRDP1);
+		p5_inputs.set((size_t)BaseBoard::LS368_Input::A1, M2);
+		p5_inputs.set((size_t)BaseBoard::LS368_Input::A2, p2_4017_data[0]);	// d1
+		p5_inputs.set((size_t)BaseBoard::LS368_Input::A3, p2_4017_data[2]);	// d3
+		p5_inputs.set((size_t)BaseBoard::LS368_Input::A4, p2_4017_data[3]);	// d4
+		p5_inputs.set((size_t)BaseBoard::LS368_Input::A5, p2_4017_data[1]);	// d2
+		p5_inputs.set((size_t)BaseBoard::LS368_Input::A6, p4017_d0);	// d0
 		P5_IO.sim(p5_inputs, p5_outputs);
-		SetDataBusIfNotFloating(0, p5_outputs[(size_t)BaseBoard::LS368_Output::n_Y6]);
-		SetDataBusIfNotFloating(1, p5_outputs[(size_t)BaseBoard::LS368_Output::n_Y2]);
-		SetDataBusIfNotFloating(2, p5_outputs[(size_t)BaseBoard::LS368_Output::n_Y5]);
-		SetDataBusIfNotFloating(3, p5_outputs[(size_t)BaseBoard::LS368_Output::n_Y3]);
-		SetDataBusIfNotFloating(4, p5_outputs[(size_t)BaseBoard::LS368_Output::n_Y4]);
+		SetDataBusIfNotFloating(0, p5_outputs.get((size_t)BaseBoard::LS368_Output::n_Y6));
+		SetDataBusIfNotFloating(1, p5_outputs.get((size_t)BaseBoard::LS368_Output::n_Y2));
+		SetDataBusIfNotFloating(2, p5_outputs.get((size_t)BaseBoard::LS368_Output::n_Y5));
+		SetDataBusIfNotFloating(3, p5_outputs.get((size_t)BaseBoard::LS368_Output::n_Y3));
+		SetDataBusIfNotFloating(4, p5_outputs.get((size_t)BaseBoard::LS368_Output::n_Y4));
 	}
 
 	void FamicomBoard::SetDataBusIfNotFloating(size_t n, BaseLogic::TriState val)
@@ -371,43 +375,38 @@ namespace Breaknes
 
 	void FamicomBoardIO::sim(int port)
 	{
-		for (auto it = devices.begin(); it != devices.end(); ++it) {
-
-			IO::IOMapped* mapped = *it;
+		// Assign input signals to the simulated IO device
 
-			if (mapped->port == port && mapped->handle >= 0) {
+		TriState inputs[2]{};
+		TriState outputs[1]{};
 
-				// Assign input signals to the simulated IO device
+		if (port == 0) {
 
-				TriState inputs[2]{};
-				TriState outputs[1]{};
-
-				if (port == 0) {
+			inputs[0] = base->p4_outputs.get((size_t)BaseBoard::LS368_Output::n_Y3);
+			Pullup(inputs[0]);	// RM1
+			inputs[1] = base->OUT_0;
+		}
+		else if (port == 1) {
 
-					inputs[0] = base->p4_outputs[(size_t)BaseBoard::LS368_Output::n_Y3];
-					Pullup(inputs[0]);	// RM1
-					inputs[1] = base->OUT_0;
-				}
-				else if (port == 1) {
+			inputs[0] = base->p5_outputs.get((size_t)BaseBoard::LS368_Output::n_Y1);
+			Pullup(inputs[0]);	// RM1
+			inputs[1] = base->OUT_0;
+		}
 
-					inputs[0] = base->p5_outputs[(size_t)BaseBoard::LS368_Output::n_Y1];
-					Pullup(inputs[0]);	// RM1
-					inputs[1] = base->OUT_0;
-				}
+		// The microphone level (analog output of the 2nd controller) is kept by the board between the device simulations
 
-				mapped->device->sim(inputs, outputs, &base->mic_level);
+		if (!SimPort(port, inputs, 2, outputs, 1, &base->mic_level))
+			return;
 
-				// Process the output signals from the device and distribute them across the board
+		// Process the output signals from the device and distribute them across the board
 
-				if (port == 0) {
+		if (port == 0) {
 
-					base->p4016_d0 = outputs[0];
-				}
-				else if (port == 1) {
+			base->p4016_d0 = outputs[0];
+		}
+		else if (port == 1) {
 
-					base->p4017_d0 = outputs[0];
-				}
-			}
+			base->p4017_d0 = outputs[0];
 		}
 	}
 
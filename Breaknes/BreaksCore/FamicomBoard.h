@@ -84,10 +84,10 @@ namespace Breaknes
 		BaseLogic::TriState OUT_0 = BaseLogic::TriState::X;
 		BaseLogic::TriState OUT_1 = BaseLogic::TriState::X;
 		BaseLogic::TriState OUT_2 = BaseLogic::TriState::X;
-		BaseLogic::TriState p4_inputs[(size_t)BaseBoard::LS368_Input::Max]{};
-		BaseLogic::TriState p4_outputs[(size_t)BaseBoard::LS368_Output::Max]{};
-		BaseLogic::TriState p5_inputs[(size_t)BaseBoard::LS368_Input::Max]{};
-		BaseLogic::TriState p5_outputs[(size_t)BaseBoard::LS368_Output::Max]{};
+		BaseLogic::Pins32 p4_inputs{};
+		BaseLogic::Pins32 p4_outputs{};
+		BaseLogic::Pins32 p5_inputs{};
+		BaseLogic::Pins32 p5_outputs{};
 		BaseLogic::TriState p4016_d0 = BaseLogic::TriState::Z;
 		BaseLogic::TriState p4017_d0 = BaseLogic::TriState::Z;
 		bool io_enabled = true;
@@ -111,6 +111,6 @@ namespace Breaknes
 
 		bool InResetState() override;
 
-		void SampleAudioSignal(float* sample);
+		float MixAudio() override;
 	};
 }
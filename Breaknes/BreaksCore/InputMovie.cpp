@@ -0,0 +1,219 @@
+// Recording and playback of the IO state changes (movie), for reproducible runs.
+
+#include "pch.h"
+
+namespace Breaknes
+{
+	InputMovie::InputMovie()
+	{
+	}
+
+	InputMovie::~InputMovie()
+	{
+		if (movieFile != nullptr)
+		{
+			WriteHeader();
+			fclose(movieFile);
+		}
+
+		delete[] entries;
+	}
+
+	int InputMovie::StartRecording(char* filename, uint64_t phi_now)
+	{
+		movieFile = fopen(filename, "wb");
+		if (movieFile == nullptr)
+			return -1;
+
+		start_phi = phi_now;
+		phi = phi_now;
+		last_phi = phi_now;
+
+		// The header is overwritten with the actual numbers at the end
+
+		WriteHeader();
+
+		mode = InputMovieMode::Recording;
+		return 0;
+	}
+
+	int InputMovie::StartPlayback(char* filename, uint64_t phi_now)
+	{
+		FILE* f = fopen(filename, "rb");
+		if (f == nullptr)
+			return -1;
+
+		InputMovieHeader header{};
+		fseek(f, 0, SEEK_END);
+		long file_size = ftell(f);
+		fseek(f, 0, SEEK_SET);
+
+		if (file_size < (long)sizeof(header) || fread(&header, 1, sizeof(header), f) != sizeof(header) ||
+			memcmp(header.magic, INPUT_MOVIE_MAGIC, sizeof(header.magic)) != 0 || header.version != INPUT_MOVIE_VERSION)
+		{
+			fclose(f);
+			return -1;
+		}
+
+		// The number of entries is taken from the file size, so that the movie that was not closed properly can still be played
+
+		num_entries = (file_size - sizeof(header)) / sizeof(InputMovieEntry);
+		entries = new InputMovieEntry[num_entries != 0 ? num_entries : 1];
+		num_entries = fread(entries, sizeof(InputMovieEntry), num_entries, f);
+		fclose(f);
+
+		start_phi = header.start_phi;
+		end_phi = header.end_phi;
+		phi = phi_now;
+		next_entry = 0;
+		next_phi = start_phi;
+		NextPlaybackTime();
+
+		mode = InputMovieMode::Playback;
+		return 0;
+	}
+
+	void InputMovie::WriteHeader()
+	{
+		InputMovieHeader header{};
+		memcpy(header.magic, INPUT_MOVIE_MAGIC, sizeof(header.magic));
+		header.version = INPUT_MOVIE_VERSION;
+		header.num_entries = num_entries;
+		header.start_phi = start_phi;
+		header.end_phi = phi;
+
+		fseek(movieFile, 0, SEEK_SET);
+		fwrite(&header, 1, sizeof(header), movieFile);
+		fseek(movieFile, 0, SEEK_END);
+	}
+
+	InputMovieMode InputMovie::GetMode()
+	{
+		return mode;
+	}
+
+	uint64_t InputMovie::GetTime()
+	{
+		return phi - start_phi;
+	}
+
+	uint64_t InputMovie::GetEntryCount()
+	{
+		return mode == InputMovieMode::Recording ? num_entries : next_entry;
+	}
+
+	uint64_t InputMovie::GetDroppedCount()
+	{
+		return dropped.load(std::memory_order_relaxed);
+	}
+
+	bool InputMovie::SetState(int handle, size_t io_state, uint32_t value)
+	{
+		size_t slot = produced.load(std::memory_order_relaxed);
+
+		if (mode != InputMovieMode::Recording || slot - consumed.load(std::memory_order_acquire) == QueueDepth)
+		{
+			dropped.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+
+		Change* change = &queue[slot % QueueDepth];
+		change->handle = handle;
+		change->io_state = io_state;
+		change->value = value;
+
+		produced.store(slot + 1, std::memory_order_release);
+		return true;
+	}
+
+	void InputMovie::AddEntry(int handle, size_t io_state, uint32_t value)
+	{
+		uint64_t delta = phi - last_phi;
+
+		while (delta > 0xffffffff)
+		{
+			InputMovieEntry marker{};
+			marker.phiDelta = 0xffffffff;
+			marker.handle = TimeMarker;
+			fwrite(&marker, 1, sizeof(marker), movieFile);
+			delta -= 0xffffffff;
+		}
+
+		InputMovieEntry entry{};
+		entry.phiDelta = (uint32_t)delta;
+		entry.halfCycle = half_cycle;
+		entry.handle = (uint8_t)handle;
+		entry.io_state = (uint8_t)io_state;
+		entry.value = value;
+		fwrite(&entry, 1, sizeof(entry), movieFile);
+
+		last_phi = phi;
+		num_entries++;
+	}
+
+	/// <summary>
+	/// Skip the time markers and get the time of the next entry.
+	/// </summary>
+	void InputMovie::NextPlaybackTime()
+	{
+		while (next_entry < num_entries)
+		{
+			next_phi += entries[next_entry].phiDelta;
+			if (entries[next_entry].handle != TimeMarker)
+				break;
+			next_entry++;
+		}
+	}
+
+	void InputMovie::Treat(IO::IOSubsystem* io, uint64_t phi_now)
+	{
+		if (phi_now != phi)
+		{
+			phi = phi_now;
+			half_cycle = 0;
+		}
+		else
+		{
+			half_cycle++;
+		}
+
+		if (mode == InputMovieMode::Recording)
+		{
+			size_t slot = consumed.load(std::memory_order_relaxed);
+
+			while (slot != produced.load(std::memory_order_acquire))
+			{
+				Change* change = &queue[slot % QueueDepth];
+
+				if (io != nullptr)
+				{
+					io->ApplyState(change->handle, change->io_state, change->value);
+				}
+				AddEntry(change->handle, change->io_state, change->value);
+
+				slot++;
+				consumed.store(slot, std::memory_order_release);
+			}
+		}
+		else if (mode == InputMovieMode::Playback)
+		{
+			while (next_entry < num_entries &&
+				(next_phi < phi || (next_phi == phi && entries[next_entry].halfCycle <= half_cycle)))
+			{
+				InputMovieEntry* entry = &entries[next_entry++];
+
+				if (io != nullptr)
+				{
+					io->ApplyState(entry->handle, entry->io_state, entry->value);
+				}
+
+				NextPlaybackTime();
+			}
+
+			if (next_entry >= num_entries && phi >= end_phi)
+			{
+				mode = InputMovieMode::PlaybackFinished;
+			}
+		}
+	}
+}
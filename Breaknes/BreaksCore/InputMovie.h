@@ -0,0 +1,144 @@
+// Recording and playback of the IO state changes (movie), for reproducible runs.
+
+#pragma once
+
+#define INPUT_MOVIE_MAGIC "BNMV"
+#define INPUT_MOVIE_VERSION 2
+
+namespace Breaknes
+{
+#pragma pack(push, 1)
+	/// <summary>
+	/// The beginning of the movie file. It is followed by InputMovieEntry records.
+	/// </summary>
+	struct InputMovieHeader
+	{
+		char magic[4];
+		uint32_t version;
+		uint64_t num_entries;
+		uint64_t start_phi;			// Board PHI counter (GetPHICounter) at the start of the recording
+		uint64_t end_phi;			// Board PHI counter at the end of the recording
+	};
+
+	/// <summary>
+	/// One IO state change. The time is the board PHI counter, stored as a delta of the previous change (the first one: of start_phi),
+	/// and the CLK half cycle within that PHI cycle.
+	/// </summary>
+	struct InputMovieEntry
+	{
+		uint32_t phiDelta;
+		uint32_t halfCycle;			// CLK half cycles since the PHI counter took its value
+		uint8_t handle;				// IO device handle (IOCreateInstance); TimeMarker: the record only advances the time
+		uint8_t io_state;
+		uint16_t padding;
+		uint32_t value;
+	};
+#pragma pack(pop)
+
+	/// <summary>
+	/// What the movie is doing.
+	/// </summary>
+	enum class InputMovieMode
+	{
+		None = 0,
+		Recording,
+		Playback,
+		PlaybackFinished,
+	};
+
+	/// <summary>
+	/// Records the IO state changes with the board time (PHI counter + CLK half cycle within the PHI cycle) at which they were applied, and applies them at the same time on playback.
+	/// The PHI counter starts from Reset, so to get the same run the movie must be played after the same Reset (e.g. right after it) as it was recorded,
+	/// with the same ROM, board and IO devices (created and attached in the same order, so that the handles match). The changes that are already due when the playback starts are applied at once.
+	/// The frontend changes the IO states from its own thread: while the movie exists, the changes are passed to the simulation thread through a queue and applied between half cycles.
+	/// The frontend is never blocked: the changes that do not fit into the queue (the simulation is paused or stepping) or come during playback are dropped and counted.
+	/// </summary>
+	class InputMovie
+	{
+		static const uint8_t TimeMarker = 0xff;
+		static const size_t QueueDepth = 256;
+
+		struct Change
+		{
+			int handle;
+			size_t io_state;
+			uint32_t value;
+		};
+
+		InputMovieMode mode = InputMovieMode::None;
+		FILE* movieFile = nullptr;
+
+		// Board time
+
+		uint64_t start_phi = 0;
+		uint64_t phi = 0;
+		uint32_t half_cycle = 0;
+		uint64_t last_phi = 0;			// Time of the previous entry
+		uint64_t num_entries = 0;
+
+		// Playback
+
+		InputMovieEntry* entries = nullptr;
+		uint64_t next_entry = 0;
+		uint64_t next_phi = 0;
+		uint64_t end_phi = 0;
+
+		// IO state changes from the frontend thread (recording only)
+
+		Change queue[QueueDepth]{};
+		std::atomic<size_t> produced{ 0 };
+		std::atomic<size_t> consumed{ 0 };
+		std::atomic<uint64_t> dropped{ 0 };
+
+		void AddEntry(int handle, size_t io_state, uint32_t value);
+		void WriteHeader();
+		void NextPlaybackTime();
+
+	public:
+		InputMovie();
+		~InputMovie();
+
+		/// <summary>
+		/// Create the movie file and start recording.
+		/// </summary>
+		/// <param name="phi_now">Board PHI counter</param>
+		/// <returns>0: OK; -1: the file cannot be created</returns>
+		int StartRecording(char* filename, uint64_t phi_now);
+
+		/// <summary>
+		/// Load the movie file and start playback.
+		/// </summary>
+		/// <param name="phi_now">Board PHI counter</param>
+		/// <returns>0: OK; -1: the file cannot be opened or it is not a movie</returns>
+		int StartPlayback(char* filename, uint64_t phi_now);
+
+		InputMovieMode GetMode();
+
+		/// <summary>
+		/// PHI cycles since the start of the recording/playback.
+		/// </summary>
+		uint64_t GetTime();
+
+		/// <summary>
+		/// Number of the IO state changes recorded/played so far.
+		/// </summary>
+		uint64_t GetEntryCount();
+
+		/// <summary>
+		/// Number of the IO state changes from the frontend that were dropped (queue full or playback).
+		/// </summary>
+		uint64_t GetDroppedCount();
+
+		/// <summary>
+		/// The frontend changes the IO state (any thread). Recording: the change is queued for the simulation thread. Playback: the change is ignored, the movie drives the IO devices.
+		/// </summary>
+		/// <returns>false: the change is dropped (playback, or the queue is full because the simulation does not run)</returns>
+		bool SetState(int handle, size_t io_state, uint32_t value);
+
+		/// <summary>
+		/// Called by the simulation thread after each simulated half cycle. Applies the queued/recorded IO state changes.
+		/// </summary>
+		/// <param name="phi_now">Board PHI counter</param>
+		void Treat(IO::IOSubsystem* io, uint64_t phi_now);
+	};
+}
@@ -84,10 +84,10 @@ namespace Breaknes
 		BaseLogic::TriState OUT_0 = BaseLogic::TriState::X;
 		BaseLogic::TriState OUT_1 = BaseLogic::TriState::X;
 		BaseLogic::TriState OUT_2 = BaseLogic::TriState::X;
-		BaseLogic::TriState p4_inputs[(size_t)BaseBoard::LS368_Input::Max]{};
-		BaseLogic::TriState p4_outputs[(size_t)BaseBoard::LS368_Output::Max]{};
-		BaseLogic::TriState p5_inputs[(size_t)BaseBoard::LS368_Input::Max]{};
-		BaseLogic::TriState p5_outputs[(size_t)BaseBoard::LS368_Output::Max]{};
+		BaseLogic::Pins32 p4_inputs{};
+		BaseLogic::Pins32 p4_outputs{};
+		BaseLogic::Pins32 p5_inputs{};
+		BaseLogic::Pins32 p5_outputs{};
 		BaseLogic::TriState p4016_data[5]{};	// 4:0
 		BaseLogic::TriState p4017_data[5]{};	// 4:0
 		bool io_enabled = true;
@@ -111,6 +111,11 @@ namespace Breaknes
 		static uint8_t DumpOAM(void* opaque, size_t addr);
 		static uint8_t DumpTempOAM(void* opaque, size_t addr);
 
+		static uint8_t* SpanWRAM(void* opaque);
+		static uint8_t* SpanVRAM(void* opaque);
+		static void DumpOAMBlock(void* opaque, uint8_t* ptr, size_t size);
+		static void DumpTempOAMBlock(void* opaque, uint8_t* ptr, size_t size);
+
 		static void WriteWRAM(void* opaque, size_t addr, uint8_t data);
 		static void WriteVRAM(void* opaque, size_t addr, uint8_t data);
 		static void WriteCRAM(void* opaque, size_t addr, uint8_t data);
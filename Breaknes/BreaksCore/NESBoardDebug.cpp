@@ -22,7 +22,7 @@ namespace Breaknes
 		memset(wramRegion, 0, sizeof(MemDesciptor));
 		strcpy(wramRegion->name, WRAM_NAME);
 		wramRegion->size = (int32_t)wram->Dbg_GetSize();
-		dbg_hub->AddMemRegion(wramRegion, DumpWRAM, WriteWRAM, this, false);
+		dbg_hub->AddMemRegion(wramRegion, DumpWRAM, WriteWRAM, this, false, SpanWRAM);
 
 		// VRAM
 
@@ -30,7 +30,7 @@ namespace Breaknes
 		memset(vramRegion, 0, sizeof(MemDesciptor));
 		strcpy(vramRegion->name, VRAM_NAME);
 		vramRegion->size = (int32_t)vram->Dbg_GetSize();
-		dbg_hub->AddMemRegion(vramRegion, DumpVRAM, WriteVRAM, this, false);
+		dbg_hub->AddMemRegion(vramRegion, DumpVRAM, WriteVRAM, this, false, SpanVRAM);
 
 		// CRAM
 
@@ -46,7 +46,7 @@ namespace Breaknes
 		memset(oamRegion, 0, sizeof(MemDesciptor));
 		strcpy(oamRegion->name, OAM_NAME);
 		oamRegion->size = OAM_SIZE;
-		dbg_hub->AddMemRegion(oamRegion, DumpOAM, WriteOAM, this, false);
+		dbg_hub->AddMemRegion(oamRegion, DumpOAM, WriteOAM, this, false, nullptr, DumpOAMBlock);
 
 		// Temp OAM
 
@@ -54,7 +54,7 @@ namespace Breaknes
 		memset(oam2Region, 0, sizeof(MemDesciptor));
 		strcpy(oam2Region->name, OAM2_NAME);
 		oam2Region->size = OAM2_SIZE;
-		dbg_hub->AddMemRegion(oam2Region, DumpTempOAM, WriteTempOAM, this, false);
+		dbg_hub->AddMemRegion(oam2Region, DumpTempOAM, WriteTempOAM, this, false, nullptr, DumpTempOAMBlock);
 	}
 
 	static SignalOffsetPair board_signals[] = {
@@ -409,6 +409,30 @@ namespace Breaknes
 		return board->ppu->Dbg_TempOAMReadByte(addr);
 	}
 
+	uint8_t* NESBoard::SpanWRAM(void* opaque)
+	{
+		NESBoard* board = (NESBoard*)opaque;
+		return board->wram->Dbg_GetMemory();
+	}
+
+	uint8_t* NESBoard::SpanVRAM(void* opaque)
+	{
+		NESBoard* board = (NESBoard*)opaque;
+		return board->vram->Dbg_GetMemory();
+	}
+
+	void NESBoard::DumpOAMBlock(void* opaque, uint8_t* ptr, size_t size)
+	{
+		NESBoard* board = (NESBoard*)opaque;
+		board->ppu->Dbg_OAMReadBlock(ptr, size);
+	}
+
+	void NESBoard::DumpTempOAMBlock(void* opaque, uint8_t* ptr, size_t size)
+	{
+		NESBoard* board = (NESBoard*)opaque;
+		board->ppu->Dbg_TempOAMReadBlock(ptr, size);
+	}
+
 	void NESBoard::WriteWRAM(void* opaque, size_t addr, uint8_t data)
 	{
 		NESBoard* board = (NESBoard*)opaque;
@@ -78,6 +78,12 @@ namespace Breaknes
 
 		SimCoreDivider();
 
+		if (IsNegedge(PrevPHI0, PHI0))
+		{
+			phi_counter++;
+		}
+		PrevPHI0 = PHI0;
+
 		// Simulate Core
 
 		TriState core_inputs[(size_t)M6502Core::InputPad::Max]{};
@@ -111,23 +117,21 @@ namespace Breaknes
 
 		// Simulate PPU
 
-		TriState ppu_inputs[(size_t)PPUSim::InputPad::Max]{};
-		TriState ppu_outputs[(size_t)PPUSim::OutputPad::Max]{};
+		Pins32 ppu_inputs{};
+		Pins32 ppu_outputs{};
 
-		ppu_inputs[(size_t)PPUSim::InputPad::CLK] = CLK;
-		ppu_inputs[(size_t)PPUSim::InputPad::n_RES] = pendingReset ? TriState::Zero : TriState::One;
-		ppu_inputs[(size_t)PPUSim::InputPad::RnW] = pendingWrite ? TriState::Zero : TriState::One;
-		ppu_inputs[(size_t)PPUSim::InputPad::RS0] = pendingCpuOperation ? ((ppuRegId & 1) ? TriState::One : TriState::Zero) : TriState::Zero;
-		ppu_inputs[(size_t)PPUSim::InputPad::RS1] = pendingCpuOperation ? ((ppuRegId & 2) ? TriState::One : TriState::Zero) : TriState::Zero;
-		ppu_inputs[(size_t)PPUSim::InputPad::RS2] = pendingCpuOperation ? ((ppuRegId & 4) ? TriState::One : TriState::Zero) : TriState::Zero;
-		ppu_inputs[(size_t)PPUSim::InputPad::n_DBE] = pendingCpuOperation ? TriState::Zero : TriState::One;
+		ppu_inputs.set((size_t)PPUSim::InputPad::CLK, CLK);
+		ppu_inputs.set((size_t)PPUSim::InputPad::n_RES, pendingReset ? TriState::Zero : TriState::One);
+		ppu_inputs.set((size_t)PPUSim::InputPad::RnW, pendingWrite ? TriState::Zero : TriState::One);
+		ppu_inputs.set_bus((size_t)PPUSim::InputPad::RS0, 3, pendingCpuOperation ? (uint32_t)ppuRegId : 0);
+		ppu_inputs.set((size_t)PPUSim::InputPad::n_DBE, pendingCpuOperation ? TriState::Zero : TriState::One);
 
 		ppu->sim(ppu_inputs, ppu_outputs, &ext_bus, &data_bus, &ad_bus, &pa8_13, vidSample);
 
-		ALE = ppu_outputs[(size_t)PPUSim::OutputPad::ALE];
-		n_RD = ppu_outputs[(size_t)PPUSim::OutputPad::n_RD];
-		n_WR = ppu_outputs[(size_t)PPUSim::OutputPad::n_WR];
-		n_INT = ppu_outputs[(size_t)PPUSim::OutputPad::n_INT];
+		ALE = ppu_outputs.get((size_t)PPUSim::OutputPad::ALE);
+		n_RD = ppu_outputs.get((size_t)PPUSim::OutputPad::n_RD);
+		n_WR = ppu_outputs.get((size_t)PPUSim::OutputPad::n_WR);
+		n_INT = ppu_outputs.get((size_t)PPUSim::OutputPad::n_INT);
 
 		Pullup(n_INT);
 
@@ -139,17 +143,20 @@ namespace Breaknes
 		ppu_addr = ((uint16_t)pa8_13 << 8) | LatchedAddress;
 		n_PA13 = NOT(FromByte((ppu_addr >> 13) & 1));
 
-		if (cart != nullptr)
+		// While the PPU bus is idle the cartridge is not simulated and its outputs keep the last values
+
+		if (cart != nullptr && CartBusActive(TriState::One, n_RD, n_WR))
 		{
-			TriState cart_in[(size_t)Mappers::CartInput::Max]{};
-			TriState cart_out[(size_t)Mappers::CartOutput::Max];
+			Pins32 cart_in{};
+			Pins32 cart_out{};
+			cart_out.float_bus(0, (size_t)Mappers::CartOutput::Max);		// What the cartridge does not drive remains `z`
 
 			bool unused;
 
-			cart_in[(size_t)Mappers::CartInput::nRD] = n_RD;
-			cart_in[(size_t)Mappers::CartInput::nWR] = n_WR;
-			cart_in[(size_t)Mappers::CartInput::nPA13] = n_PA13;
-			cart_in[(size_t)Mappers::CartInput::nROMSEL] = TriState::One;
+			cart_in.set((size_t)Mappers::CartInput::nRD, n_RD);
+			cart_in.set((size_t)Mappers::CartInput::nWR, n_WR);
+			cart_in.set((size_t)Mappers::CartInput::nPA13, n_PA13);
+			cart_in.set((size_t)Mappers::CartInput::nROMSEL, TriState::One);
 
 			cart->sim (
 				cart_in,
@@ -161,10 +168,10 @@ namespace Breaknes
 				nullptr,
 				nullptr, unused );
 
-			n_VRAM_CS = cart_out[(size_t)Mappers::CartOutput::VRAM_nCS];
-			VRAM_A10 = cart_out[(size_t)Mappers::CartOutput::VRAM_A10];
+			n_VRAM_CS = cart_out.get((size_t)Mappers::CartOutput::VRAM_nCS);
+			VRAM_A10 = cart_out.get((size_t)Mappers::CartOutput::VRAM_A10);
 		}
-		else
+		else if (cart == nullptr)
 		{
 			// No cartridge in the slot means 'z' on these signals.
 			// Simulate this situation in the most painless way possible.
@@ -181,6 +188,11 @@ namespace Breaknes
 		bool dz = (n_RD == TriState::One && n_WR == TriState::One);
 		vram->sim(n_VRAM_CS, n_WR, n_RD, &VRAM_Addr, &ad_bus, dz);
 
+		if (events)
+		{
+			TreatEvents(Core_PHI2, Core_RnW, n_INT, TriState::One);
+		}
+
 		// Tick
 
 		CLK = NOT(CLK);
@@ -191,6 +203,18 @@ namespace Breaknes
 			if (resetHalfClkCounter == 0)
 			{
 				pendingReset = false;
+
+				if (pendingSeek)
+				{
+					uint8_t* state = nullptr;
+					size_t state_size = 0;
+					core->SeekRegDump(seekFrame, &state, &state_size);
+					if (state != nullptr)
+					{
+						LoadRegDumpState(state, state_size);
+					}
+					pendingSeek = false;
+				}
 			}
 		}
 	}
@@ -201,6 +225,7 @@ namespace Breaknes
 	void PPUPlayerBoard::Reset()
 	{
 		pendingReset = true;
+		ResetCartBus();
 		resetHalfClkCounter = 64;
 	}
 
@@ -222,4 +247,33 @@ namespace Breaknes
 			core->SetRegDump(data, data_size);
 		}
 	}
+
+	bool PPUPlayerBoard::MapRegDump(const char* filename)
+	{
+		CPUOpsProcessed = 0;
+		prev_pendingCpuOperation = false;
+		return core->MapRegDump(filename);
+	}
+
+	size_t PPUPlayerBoard::GetPHICounter()
+	{
+		return phi_counter;
+	}
+
+	/// <summary>
+	/// The PPU is reset first, the regdump is rewound and the keyframe is loaded at the end of the reset, so that the frame starts together with the PPU counters.
+	/// </summary>
+	int PPUPlayerBoard::SeekRegDump(size_t frame)
+	{
+		int resume_frame = core->GetRegDumpSeekFrame(frame);
+		if (resume_frame < 0)
+			return -1;
+
+		CPUOpsProcessed = 0;
+		prev_pendingCpuOperation = false;
+		seekFrame = frame;
+		pendingSeek = true;
+		Reset();
+		return resume_frame;
+	}
 }
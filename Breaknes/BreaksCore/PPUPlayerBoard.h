@@ -50,6 +50,9 @@ namespace Breaknes
 		bool pendingReset = false;
 		int resetHalfClkCounter = 0;
 
+		bool pendingSeek = false;		// Rewind the regdump and load the keyframe when the reset is over
+		size_t seekFrame = 0;
+
 		BaseLogic::TriState n_INT = BaseLogic::TriState::X;
 		BaseLogic::TriState n_VRAM_CS = BaseLogic::TriState::X;
 		BaseLogic::TriState VRAM_A10 = BaseLogic::TriState::X;
@@ -66,6 +69,10 @@ namespace Breaknes
 		static uint8_t DumpOAM(void* opaque, size_t addr);
 		static uint8_t DumpTempOAM(void* opaque, size_t addr);
 
+		static uint8_t* SpanVRAM(void* opaque);
+		static void DumpOAMBlock(void* opaque, uint8_t* ptr, size_t size);
+		static void DumpTempOAMBlock(void* opaque, uint8_t* ptr, size_t size);
+
 		static void WriteVRAM(void* opaque, size_t addr, uint8_t data);
 		static void WriteCRAM(void* opaque, size_t addr, uint8_t data);
 		static void WriteOAM(void* opaque, size_t addr, uint8_t data);
@@ -89,6 +96,8 @@ namespace Breaknes
 		DIV_SRBit div[6]{};
 
 		BaseLogic::TriState PHI0 = BaseLogic::TriState::X;
+		BaseLogic::TriState PrevPHI0 = BaseLogic::TriState::X;
+		size_t phi_counter = 0;			// There is no APU on the board to count the core cycles
 
 		bool prev_pendingCpuOperation = false;
 		uint32_t CPUOpsProcessed = 0;
@@ -104,5 +113,11 @@ namespace Breaknes
 		bool InResetState() override;
 
 		void LoadRegDump(uint8_t* data, size_t data_size) override;
+
+		bool MapRegDump(const char* filename) override;
+
+		int SeekRegDump(size_t frame) override;
+
+		size_t GetPHICounter() override;
 	};
 }
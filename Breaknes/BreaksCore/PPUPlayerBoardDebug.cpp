@@ -20,7 +20,7 @@ namespace Breaknes
 		memset(vramRegion, 0, sizeof(MemDesciptor));
 		strcpy(vramRegion->name, VRAM_NAME);
 		vramRegion->size = (int32_t)vram->Dbg_GetSize();
-		dbg_hub->AddMemRegion(vramRegion, DumpVRAM, WriteVRAM, this, false);
+		dbg_hub->AddMemRegion(vramRegion, DumpVRAM, WriteVRAM, this, false, SpanVRAM);
 
 		// CRAM
 
@@ -36,7 +36,7 @@ namespace Breaknes
 		memset(oamRegion, 0, sizeof(MemDesciptor));
 		strcpy(oamRegion->name, OAM_NAME);
 		oamRegion->size = OAM_SIZE;
-		dbg_hub->AddMemRegion(oamRegion, DumpOAM, WriteOAM, this, false);
+		dbg_hub->AddMemRegion(oamRegion, DumpOAM, WriteOAM, this, false, nullptr, DumpOAMBlock);
 
 		// Temp OAM
 
@@ -44,7 +44,7 @@ namespace Breaknes
 		memset(oam2Region, 0, sizeof(MemDesciptor));
 		strcpy(oam2Region->name, OAM2_NAME);
 		oam2Region->size = OAM2_SIZE;
-		dbg_hub->AddMemRegion(oam2Region, DumpTempOAM, WriteTempOAM, this, false);
+		dbg_hub->AddMemRegion(oam2Region, DumpTempOAM, WriteTempOAM, this, false, nullptr, DumpTempOAMBlock);
 	}
 
 	static SignalOffsetPair board_signals[] = {
@@ -247,6 +247,24 @@ namespace Breaknes
 		return board->ppu->Dbg_TempOAMReadByte(addr);
 	}
 
+	uint8_t* PPUPlayerBoard::SpanVRAM(void* opaque)
+	{
+		PPUPlayerBoard* board = (PPUPlayerBoard*)opaque;
+		return board->vram->Dbg_GetMemory();
+	}
+
+	void PPUPlayerBoard::DumpOAMBlock(void* opaque, uint8_t* ptr, size_t size)
+	{
+		PPUPlayerBoard* board = (PPUPlayerBoard*)opaque;
+		board->ppu->Dbg_OAMReadBlock(ptr, size);
+	}
+
+	void PPUPlayerBoard::DumpTempOAMBlock(void* opaque, uint8_t* ptr, size_t size)
+	{
+		PPUPlayerBoard* board = (PPUPlayerBoard*)opaque;
+		board->ppu->Dbg_TempOAMReadBlock(ptr, size);
+	}
+
 	void PPUPlayerBoard::WriteVRAM(void* opaque, size_t addr, uint8_t data)
 	{
 		PPUPlayerBoard* board = (PPUPlayerBoard*)opaque;
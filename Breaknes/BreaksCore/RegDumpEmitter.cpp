@@ -1,45 +1,227 @@
 #include "pch.h"
 
-RegDumper::RegDumper(const char* target, uint64_t phi_counter_now, char* filename)
+RegDumper::RegDumper(const char* target, uint64_t phi_counter_now, char* filename, RegDumpFormat _format, bool _drop_when_full)
 {
 	regLogFile = fopen(filename, "wb");
 	SavedPHICounter = phi_counter_now;
+	StartPHICounter = phi_counter_now;
+	block_phi = phi_counter_now;
 	strcpy(regdump_target, target);
+	format = _format;
+	drop_when_full = _drop_when_full;
+
+	block = new RegDumpEntry[BlockEntries];
+
+	fill.data = new uint8_t[ChunkSize];
+	fill.capacity = ChunkSize;
+	for (size_t n = 0; n < QueueDepth; n++)
+	{
+		queue[n].data = new uint8_t[ChunkSize];
+		queue[n].capacity = ChunkSize;
+	}
+
+	if (regLogFile != nullptr)
+	{
+		// The header is overwritten with the actual index location at the end
+
+		if (format != RegDumpFormat::Legacy)
+		{
+			BaseBoard::RegDumpHeader header{};
+			memcpy(header.magic, REGDUMP_MAGIC, sizeof(header.magic));
+			header.version = REGDUMP_VERSION;
+			Append(&header, sizeof(header));
+		}
+
+		writer = new std::thread(&RegDumper::WriterThread, this);
+	}
 }
 
 RegDumper::~RegDumper()
 {
-	fflush(regLogFile);
-	fclose(regLogFile);
+	if (regLogFile != nullptr)
+	{
+		FlushBlock();
+		Publish(true);
+
+		stop.store(true, std::memory_order_release);
+		writer->join();
+		delete writer;
+
+		// The writer is gone, the rest is written directly
+
+		if (format != RegDumpFormat::Legacy)
+		{
+			BaseBoard::RegDumpHeader header{};
+			memcpy(header.magic, REGDUMP_MAGIC, sizeof(header.magic));
+			header.version = REGDUMP_VERSION;
+			header.num_blocks = (uint32_t)index.size();
+			header.index_offset = file_offset;
+
+			for (auto it = index.begin(); it != index.end(); ++it)
+			{
+				fwrite(&(*it), 1, sizeof(BaseBoard::RegDumpIndexEntry), regLogFile);
+			}
+
+			fseek(regLogFile, 0, SEEK_SET);
+			fwrite(&header, 1, sizeof(header), regLogFile);
+		}
+
+		fflush(regLogFile);
+		fclose(regLogFile);
+	}
+
+	delete[] block;
+	delete[] fill.data;
+	for (size_t n = 0; n < QueueDepth; n++)
+	{
+		delete[] queue[n].data;
+	}
 }
 
-void RegDumper::LogRegRead(uint64_t phi_counter_now, uint8_t regnum)
+void RegDumper::Reserve(size_t size)
 {
-	if (regLogFile != nullptr)
+	if (fill.size + size <= fill.capacity)
+		return;
+
+	size_t capacity = std::max(fill.capacity * 2, fill.size + size);
+	uint8_t* data = new uint8_t[capacity];
+	memcpy(data, fill.data, fill.size);
+	delete[] fill.data;
+	fill.data = data;
+	fill.capacity = capacity;
+}
+
+void RegDumper::Append(const void* data, size_t size)
+{
+	Reserve(size);
+	memcpy(fill.data + fill.size, data, size);
+	fill.size += size;
+	file_offset += size;
+}
+
+/// <summary>
+/// Pass the chunk being filled to the writer.
+/// If the queue is full, the simulation waits for the writer; in the drop mode the chunk is discarded instead (the blocks are removed from the index, the playback resumes at the next block).
+/// The old format has no blocks to resume at, so it always waits.
+/// The final chunk (destructor, Flush) is published with `force`: it always waits, so the requested data is never dropped.
+/// </summary>
+void RegDumper::Publish(bool force)
+{
+	if (fill.size == 0)
+		return;
+
+	size_t slot = produced.load(std::memory_order_relaxed);
+
+	if (slot - consumed.load(std::memory_order_acquire) == QueueDepth)
 	{
-		RegDumpEntry entry{};
+		if (drop_when_full && format != RegDumpFormat::Legacy && !force)
+		{
+			stat_drops += fill.entries;
 
-		if (first_access) {
-			printf("First %s access, clk_counter: 0x%llx\n", regdump_target, phi_counter_now);
-			first_access = false;
+			while (index.size() > fill_index)
+			{
+				index.pop_back();
+			}
+			file_offset = fill_offset;
+			fill.size = 0;
+			fill.entries = 0;
+			return;
 		}
 
-		uint64_t delta = phi_counter_now - SavedPHICounter;
-		if (delta > 0xffffffff)
+		stat_stalls++;
+		while (slot - consumed.load(std::memory_order_acquire) == QueueDepth)
 		{
-			printf("Clock Delta exceeds the allowable limit. Read skipped.\n");
-			SavedPHICounter = phi_counter_now;
-			return;
+			std::this_thread::yield();
+		}
+	}
+
+	// The slot was written out by the writer; the buffers are swapped instead of copied
+
+	std::swap(queue[slot % QueueDepth], fill);
+	fill.size = 0;
+	fill.entries = 0;
+	produced.store(slot + 1, std::memory_order_release);
+
+	fill_offset = file_offset;
+	fill_index = index.size();
+}
+
+void RegDumper::WriterThread()
+{
+	while (true)
+	{
+		// `stop` is checked before `produced`: the last chunk is published before the stop flag is set
+
+		bool stopping = stop.load(std::memory_order_acquire);
+		size_t slot = consumed.load(std::memory_order_relaxed);
+
+		if (slot == produced.load(std::memory_order_acquire))
+		{
+			if (stopping)
+				break;
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			continue;
 		}
 
-		entry.clkDelta = (uint32_t)delta;
-		entry.reg = regnum | 0x80;
-		entry.value = 0;
-		entry.padding = 0;
+		Chunk* chunk = &queue[slot % QueueDepth];
+		size_t written = fwrite(chunk->data, 1, chunk->size, regLogFile);
+		stat_bytes += written;
+		if (written != chunk->size)
+		{
+			stat_drops += chunk->entries;
+		}
+		chunk->size = 0;
 
+		consumed.store(slot + 1, std::memory_order_release);
+	}
+}
+
+/// <summary>
+/// Wait until the writer has written everything passed to it.
+/// </summary>
+void RegDumper::Drain()
+{
+	while (consumed.load(std::memory_order_acquire) != produced.load(std::memory_order_relaxed))
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+}
+
+void RegDumper::AddEntry(uint64_t phi_counter_now, uint8_t reg, uint8_t val)
+{
+	if (first_access) {
+		printf("First %s access, clk_counter: 0x%llx\n", regdump_target, phi_counter_now);
+		first_access = false;
+	}
+
+	uint64_t delta = phi_counter_now - SavedPHICounter;
+	if (delta > 0xffffffff)
+	{
+		printf("Clock Delta exceeds the allowable limit. Register operation skipped.\n");
 		SavedPHICounter = phi_counter_now;
+		return;
+	}
+
+	RegDumpEntry* entry = &block[block_entries++];
+	entry->clkDelta = (uint32_t)delta;
+	entry->reg = reg;
+	entry->value = val;
+	entry->padding = 0;
 
-		fwrite(&entry, 1, sizeof(entry), regLogFile);
+	SavedPHICounter = phi_counter_now;
+	stat_entries++;
+
+	if (block_entries == BlockEntries)
+	{
+		FlushBlock();
+	}
+}
+
+void RegDumper::LogRegRead(uint64_t phi_counter_now, uint8_t regnum)
+{
+	if (regLogFile != nullptr)
+	{
+		AddEntry(phi_counter_now, regnum | 0x80, 0);
 	}
 }
 
@@ -47,35 +229,172 @@ void RegDumper::LogRegWrite(uint64_t phi_counter_now, uint8_t regnum, uint8_t va
 {
 	if (regLogFile != nullptr)
 	{
-		RegDumpEntry entry{};
+		AddEntry(phi_counter_now, regnum, val);
+	}
+}
 
-		if (first_access) {
-			printf("First %s access, clk_counter: 0x%llx\n", regdump_target, phi_counter_now);
-			first_access = false;
-		}
+void RegDumper::AddBlockToIndex(BaseBoard::RegDumpBlockHeader& header)
+{
+	BaseBoard::RegDumpIndexEntry rec{};
+	rec.offset = file_offset;
+	rec.phi = header.phi;
+	rec.frame = header.frame;
+	rec.type = header.type;
+	index.push_back(rec);
+}
 
-		uint64_t delta = phi_counter_now - SavedPHICounter;
-		if (delta > 0xffffffff)
-		{
-			printf("Clock Delta exceeds the allowable limit. Write skipped.\n");
-			SavedPHICounter = phi_counter_now;
+/// <summary>
+/// Write the collected entries as one block. The next block continues from the time of the last entry.
+/// </summary>
+void RegDumper::FlushBlock()
+{
+	if (regLogFile == nullptr)
+		return;
+
+	if (format == RegDumpFormat::Legacy)
+	{
+		Append(block, block_entries * sizeof(RegDumpEntry));
+	}
+	else
+	{
+		if (block_entries == 0 && !frame_start)
 			return;
+
+		if (format == RegDumpFormat::IndexedPacked)
+		{
+			PackBlock();
 		}
+		else
+		{
+			BaseBoard::RegDumpBlockHeader header{};
+			header.type = REGDUMP_BLOCK_OPS;
+			header.size = (uint32_t)block_entries;
+			header.phi = block_phi - StartPHICounter;
+			header.frame = frame;
 
-		entry.clkDelta = (uint32_t)delta;
-		entry.reg = regnum;
-		entry.value = val;
-		entry.padding = 0;
+			AddBlockToIndex(header);
+			Append(&header, sizeof(header));
+			Append(block, block_entries * sizeof(RegDumpEntry));
+		}
+	}
 
-		SavedPHICounter = phi_counter_now;
+	fill.entries += block_entries;
+	block_entries = 0;
+	block_phi = SavedPHICounter;
+	frame_start = false;
 
-		fwrite(&entry, 1, sizeof(entry), regLogFile);
+	if (fill.size >= ChunkSize)
+	{
+		Publish(false);
 	}
 }
 
+/// <summary>
+/// Packed block: clkDelta as a variable-length number (7 bits per byte, the least significant first, msb - more bytes follow), then the register; the value only for writing.
+/// </summary>
+void RegDumper::PackBlock()
+{
+	BaseBoard::RegDumpBlockHeader header{};
+	header.type = REGDUMP_BLOCK_PACKED_OPS;
+	header.size = (uint32_t)block_entries;
+	header.phi = block_phi - StartPHICounter;
+	header.frame = frame;
+
+	AddBlockToIndex(header);
+
+	size_t header_pos = fill.size;
+	Append(&header, sizeof(header));
+
+	// No more than 5 bytes of delta + register + value per entry
+
+	Reserve(block_entries * 7);
+	uint8_t* start = fill.data + fill.size;
+	uint8_t* ptr = start;
+
+	for (size_t n = 0; n < block_entries; n++)
+	{
+		uint32_t delta = block[n].clkDelta;
+		while (delta >= 0x80)
+		{
+			*ptr++ = (uint8_t)(delta | 0x80);
+			delta >>= 7;
+		}
+		*ptr++ = (uint8_t)delta;
+
+		*ptr++ = block[n].reg;
+		if ((block[n].reg & 0x80) == 0)
+		{
+			*ptr++ = block[n].value;
+		}
+	}
+
+	size_t packed_size = ptr - start;
+	fill.size += packed_size;
+	file_offset += packed_size;
+
+	((BaseBoard::RegDumpBlockHeader*)(fill.data + header_pos))->packed_size = (uint32_t)packed_size;
+}
+
 void RegDumper::Flush()
 {
 	if (regLogFile != nullptr) {
+		FlushBlock();
+		Publish(true);
+		Drain();
 		fflush(regLogFile);
 	}
 }
+
+void RegDumper::MarkFrame(uint64_t phi_counter_now)
+{
+	// The old format is a continuous stream of deltas
+
+	if (format == RegDumpFormat::Legacy)
+		return;
+
+	FlushBlock();
+
+	frame++;
+	frame_start = true;
+	block_phi = phi_counter_now;
+	SavedPHICounter = phi_counter_now;
+}
+
+void RegDumper::SetKeyframeInterval(size_t frames)
+{
+	keyframe_interval = frames;
+}
+
+bool RegDumper::KeyframeDue()
+{
+	return regLogFile != nullptr && format != RegDumpFormat::Legacy && keyframe_interval != 0 && (frame % keyframe_interval) == 0;
+}
+
+void RegDumper::AddKeyframe(uint64_t phi_counter_now, uint8_t* state, size_t state_size)
+{
+	if (regLogFile == nullptr || format == RegDumpFormat::Legacy)
+		return;
+
+	BaseBoard::RegDumpBlockHeader header{};
+	header.type = REGDUMP_BLOCK_KEYFRAME;
+	header.size = (uint32_t)state_size;
+	header.phi = phi_counter_now - StartPHICounter;
+	header.frame = frame;
+
+	AddBlockToIndex(header);
+	Append(&header, sizeof(header));
+	Append(state, state_size);
+
+	if (fill.size >= ChunkSize)
+	{
+		Publish(false);
+	}
+}
+
+void RegDumper::GetStats(RegDumpStats* stats)
+{
+	stats->entries = stat_entries;
+	stats->bytes = stat_bytes.load(std::memory_order_relaxed);
+	stats->drops = stat_drops.load(std::memory_order_relaxed);
+	stats->stalls = stat_stalls;
+}
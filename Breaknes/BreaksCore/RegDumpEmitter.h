@@ -12,18 +12,126 @@ struct RegDumpEntry
 };
 #pragma pack(pop)
 
+/// <summary>
+/// The layout of the regdump file.
+/// </summary>
+enum class RegDumpFormat
+{
+	Indexed = 0,		// Indexed regdump, the register operations are RegDumpEntry records (see BaseBoard::RegDumpHeader)
+	IndexedPacked,		// Indexed regdump, the register operations are packed (REGDUMP_BLOCK_PACKED_OPS, about half the size)
+	Legacy,				// Bare stream of RegDumpEntry records (old format: no frames, keyframes or index)
+};
+
+/// <summary>
+/// Regdump counters.
+/// </summary>
+struct RegDumpStats
+{
+	uint64_t entries;		// Register operations logged
+	uint64_t bytes;			// Bytes written to the file
+	uint64_t drops;			// Register operations lost (the queue was full in the drop mode, or the file write failed)
+	uint64_t stalls;		// Times the simulation waited for the writer because the queue was full
+};
+
+/// <summary>
+/// Writes the regdump. The entries are collected into blocks, one block per frame (or more, if the frame has many register operations).
+/// The blocks are gathered into large chunks that are passed through a single producer/single consumer queue to a background thread, which writes them to the file.
+/// The simulation thread does not take any locks and does not wait for the disk unless the whole queue is full.
+/// The index of the blocks is written at the end of the file when the dumper is deleted (after the queue is drained).
+/// </summary>
 class RegDumper
 {
+	static const size_t BlockEntries = 0x1000;
+	static const size_t ChunkSize = 0x40000;		// The chunk is passed to the writer as soon as it reaches this size
+	static const size_t QueueDepth = 16;
+
+	struct Chunk
+	{
+		uint8_t* data;
+		size_t size;
+		size_t capacity;
+		uint64_t entries;			// Register operations in the chunk (for the drop counter)
+	};
+
 	uint64_t SavedPHICounter;
 	FILE* regLogFile;
 	char regdump_target[32];
 	bool first_access = true;
 
+	RegDumpFormat format = RegDumpFormat::Indexed;
+	bool drop_when_full = false;
+
+	uint64_t StartPHICounter;			// The PHI counter value at the beginning of the dump
+	uint64_t file_offset = 0;			// File offset of the end of the data passed to the queue
+
+	RegDumpEntry* block = nullptr;
+	size_t block_entries = 0;
+	uint64_t block_phi = 0;
+	bool frame_start = true;			// The block begins a new frame (written even if empty, so that the frame can be found in the index)
+	uint32_t frame = 0;
+
+	size_t keyframe_interval = 0;
+
+	std::list<BaseBoard::RegDumpIndexEntry> index;
+
+	// Filled by the simulation thread; the queue slots are swapped with it
+
+	Chunk fill{};
+	uint64_t fill_offset = 0;			// File offset of the beginning of the chunk being filled
+	size_t fill_index = 0;				// Number of index records before the chunk being filled
+
+	Chunk queue[QueueDepth]{};
+	std::atomic<size_t> produced{ 0 };
+	std::atomic<size_t> consumed{ 0 };
+	std::atomic<bool> stop{ false };
+	std::thread* writer = nullptr;
+
+	uint64_t stat_entries = 0;
+	uint64_t stat_stalls = 0;
+	std::atomic<uint64_t> stat_bytes{ 0 };
+	std::atomic<uint64_t> stat_drops{ 0 };
+
+	void AddEntry(uint64_t phi_counter_now, uint8_t reg, uint8_t val);
+	void FlushBlock();
+	void PackBlock();
+	void AddBlockToIndex(BaseBoard::RegDumpBlockHeader& header);
+	void Append(const void* data, size_t size);
+	void Reserve(size_t size);
+	void Publish(bool force);
+	void Drain();
+	void WriterThread();
+
 public:
-	RegDumper(const char* target, uint64_t phi_counter_now, char* filename);
+	RegDumper(const char* target, uint64_t phi_counter_now, char* filename, RegDumpFormat format = RegDumpFormat::Indexed, bool drop_when_full = false);
 	~RegDumper();
 
 	void LogRegRead(uint64_t phi_counter_now, uint8_t regnum);
 	void LogRegWrite(uint64_t phi_counter_now, uint8_t regnum, uint8_t val);
+
+	/// <summary>
+	/// Pass the collected entries to the writer and wait until everything is written to the file.
+	/// </summary>
 	void Flush();
+
+	/// <summary>
+	/// Start a new frame (called when the PPU begins a new field).
+	/// </summary>
+	void MarkFrame(uint64_t phi_counter_now);
+
+	/// <summary>
+	/// Save a keyframe every N frames (0: do not save keyframes). The old format does not have keyframes.
+	/// </summary>
+	void SetKeyframeInterval(size_t frames);
+
+	/// <summary>
+	/// The current frame requires a keyframe.
+	/// </summary>
+	bool KeyframeDue();
+
+	/// <summary>
+	/// Save the state of the board at the beginning of the current frame (records of BaseBoard::RegDumpStateRecord).
+	/// </summary>
+	void AddKeyframe(uint64_t phi_counter_now, uint8_t* state, size_t state_size);
+
+	void GetStats(RegDumpStats* stats);
 };
@@ -0,0 +1,390 @@
+// Signal waveform recorder (export to VCD for GTKWave and similar viewers).
+
+#include "pch.h"
+
+namespace Breaknes
+{
+	struct SignalCategory
+	{
+		const char* category;
+		SignalOffsetPair* signals;
+		size_t* count;
+		int source;
+	};
+
+	// The categories that can be recorded. The source numbers correspond to SignalRecorder::SignalSource.
+
+	static SignalCategory recorder_categories[] = {
+		CORE_BRK_CATEGORY, core_brk_wires, &core_brk_wires_count, 0,
+		CORE_DISP_CATEGORY, core_disp_wires, &core_disp_wires_count, 0,
+		CORE_ALU_CATEGORY, core_alu_wires, &core_alu_wires_count, 0,
+		CORE_BOPS_CATEGORY, core_bops_wires, &core_bops_wires_count, 0,
+		CORE_FOPS_CATEGORY, core_fops_wires, &core_fops_wires_count, 0,
+		CORE_REGS_CATEGORY, core_regs, &core_regs_count, 1,
+
+		APU_CLKS_CATEGORY, apu_clks_wires, &apu_clks_wires_count, 2,
+		APU_CORE_CATEGORY, apu_core_wires, &apu_core_wires_count, 2,
+		APU_DMA_CATEGORY, apu_dma_wires, &apu_dma_wires_count, 2,
+		APU_REGOPS_CATEGORY, apu_regops_wires, &apu_regops_wires_count, 2,
+		APU_LC_CATEGORY, apu_lc_wires, &apu_lc_wires_count, 2,
+		APU_WIRES_CATEGORY, apu_wires, &apu_wires_count, 2,
+		APU_REGS_CATEGORY, apu_regs, &apu_regs_count, 3,
+
+		PPU_CLKS_CATEGORY, ppu_clks_signals, &ppu_clks_signals_count, 4,
+		PPU_CPU_CATEGORY, ppu_cpu_signals, &ppu_cpu_signals_count, 4,
+		PPU_CTRL_CATEGORY, ppu_ctrl_signals, &ppu_ctrl_signals_count, 4,
+		PPU_HV_CATEGORY, ppu_hv_signals, &ppu_hv_signals_count, 4,
+		PPU_MUX_CATEGORY, ppu_mux_signals, &ppu_mux_signals_count, 4,
+		PPU_SPG_CATEGORY, ppu_spg_signals, &ppu_spg_signals_count, 4,
+		PPU_CRAM_CATEGORY, ppu_cram_signals, &ppu_cram_signals_count, 4,
+		PPU_VRAM_CATEGORY, ppu_vram_signals, &ppu_vram_signals_count, 4,
+		PPU_FSM_CATEGORY, ppu_fsm_signals, &ppu_fsm_signals_count, 4,
+		PPU_EVAL_CATEGORY, ppu_eval_signals, &ppu_eval_signals_count, 4,
+		PPU_WIRES_CATEGORY, ppu_wires, &ppu_wires_count, 4,
+		PPU_REGS_CATEGORY, ppu_regs, &ppu_regs_count, 5,
+	};
+	static size_t recorder_categories_count = sizeof(recorder_categories) / sizeof(recorder_categories[0]);
+
+	SignalRecorder::SignalRecorder(M6502Core::M6502* _core, APUSim::APU* _apu, PPUSim::PPU* _ppu, size_t capacity, double clk_freq)
+	{
+		core = _core;
+		apu = _apu;
+		ppu = _ppu;
+
+		half_period_ps = 1e12 / (2.0 * clk_freq);
+
+		ring_size = capacity != 0 ? capacity : 1;
+		ring = new SignalChange[ring_size];
+	}
+
+	SignalRecorder::~SignalRecorder()
+	{
+		delete[] ring;
+	}
+
+	int SignalRecorder::AddSignal(const char* category, const char* name)
+	{
+		if (num_signals >= MaxSignals || now != 0)
+			return -1;
+
+		for (size_t c = 0; c < recorder_categories_count; c++)
+		{
+			SignalCategory* cat = &recorder_categories[c];
+
+			if (strcmp(cat->category, category))
+				continue;
+
+			SignalSource source = (SignalSource)cat->source;
+
+			switch (source)
+			{
+				case SignalSource::CoreWires:
+				case SignalSource::CoreRegs:
+					if (core == nullptr)
+						return -1;
+					break;
+
+				case SignalSource::APUWires:
+				case SignalSource::APURegs:
+					if (apu == nullptr)
+						return -1;
+					break;
+
+				case SignalSource::PPUWires:
+				case SignalSource::PPURegs:
+					if (ppu == nullptr)
+						return -1;
+					break;
+			}
+
+			for (size_t n = 0; n < *cat->count; n++)
+			{
+				SignalOffsetPair* sp = &cat->signals[n];
+
+				if (!strcmp(sp->name, name))
+				{
+					Signal* sig = &signals[num_signals];
+					sig->category = cat->category;
+					sig->name = sp->name;
+					sig->source = source;
+					sig->offset = sp->offset;
+					sig->bits = sp->bits;
+
+					need_apu_wires |= source == SignalSource::APUWires;
+					need_ppu_wires |= source == SignalSource::PPUWires;
+
+					return (int)num_signals++;
+				}
+			}
+		}
+
+		return -1;
+	}
+
+	size_t SignalRecorder::GetSignalCount()
+	{
+		return num_signals;
+	}
+
+	void SignalRecorder::Sample()
+	{
+		// The APU/PPU wires are taken in one go (there is no getter for a single wire), the rest is read one by one
+
+		APUSim::APU_Interconnects apu_wires{};
+		PPUSim::PPU_Interconnects ppu_wires{};
+
+		if (need_apu_wires)
+			apu->GetDebugInfo_Wires(apu_wires);
+		if (need_ppu_wires)
+			ppu->GetDebugInfo_Wires(ppu_wires);
+
+		for (size_t n = 0; n < num_signals; n++)
+		{
+			Signal* sig = &signals[n];
+			uint16_t value = 0;
+
+			switch (sig->source)
+			{
+				case SignalSource::CoreWires:
+					value = core->getDebugSingle((int)sig->offset);
+					break;
+				case SignalSource::CoreRegs:
+					value = core->getUserRegSingle((int)sig->offset);
+					break;
+				case SignalSource::APUWires:
+					value = ((uint8_t*)&apu_wires)[sig->offset];
+					break;
+				case SignalSource::APURegs:
+					value = (uint16_t)apu->GetDebugInfo_Reg((int)sig->offset);
+					break;
+				case SignalSource::PPUWires:
+					value = ((uint8_t*)&ppu_wires)[sig->offset];
+					break;
+				case SignalSource::PPURegs:
+					value = (uint16_t)ppu->Dbg_ReadRegister((int)sig->offset);
+					break;
+			}
+
+			if (now == 0)
+			{
+				// The first sample gives the initial values
+
+				prev_values[n] = value;
+				tail_values[n] = value;
+			}
+			else if (value != prev_values[n])
+			{
+				PushChange(n, value);
+				prev_values[n] = value;
+			}
+		}
+
+		now++;
+	}
+
+	void SignalRecorder::PushChange(size_t signal, uint16_t value)
+	{
+		uint64_t delta = now - last_change_time;
+
+		while (delta > UINT32_MAX)
+		{
+			if (ring_count == ring_size)
+				DropOldest();
+
+			SignalChange* marker = &ring[ring_head];
+			marker->delta = UINT32_MAX;
+			marker->signal = TimeMarker;
+			marker->value = 0;
+			ring_head = (ring_head + 1) % ring_size;
+			ring_count++;
+
+			delta -= UINT32_MAX;
+		}
+
+		if (ring_count == ring_size)
+			DropOldest();
+
+		SignalChange* change = &ring[ring_head];
+		change->delta = (uint32_t)delta;
+		change->signal = (uint16_t)signal;
+		change->value = value;
+		ring_head = (ring_head + 1) % ring_size;
+		ring_count++;
+
+		last_change_time = now;
+	}
+
+	void SignalRecorder::DropOldest()
+	{
+		SignalChange* oldest = &ring[(ring_head + ring_size - ring_count) % ring_size];
+
+		tail_time += oldest->delta;
+		if (oldest->signal != TimeMarker)
+		{
+			tail_values[oldest->signal] = oldest->value;
+		}
+
+		ring_count--;
+	}
+
+	uint64_t SignalRecorder::GetTime()
+	{
+		return now;
+	}
+
+	uint64_t SignalRecorder::GetOldestTime()
+	{
+		return tail_time;
+	}
+
+	void SignalRecorder::WriteVCDTime(FILE* f, uint64_t t)
+	{
+		// The half period is more than 1 ps, so different half cycles never get the same timestamp.
+		fprintf(f, "#%llu\n", (unsigned long long)((double)t * half_period_ps + 0.5));
+	}
+
+	void SignalRecorder::WriteVCDValue(FILE* f, Signal& sig, uint16_t value, const char* id)
+	{
+		if (sig.bits == 1)
+		{
+			char bit;
+			switch (value)
+			{
+				case BaseLogic::TriState::Zero: bit = '0'; break;
+				case BaseLogic::TriState::One: bit = '1'; break;
+				case BaseLogic::TriState::Z: bit = 'z'; break;
+				default: bit = 'x'; break;
+			}
+			fprintf(f, "%c%s\n", bit, id);
+		}
+		else
+		{
+			char bin[17]{};
+			for (size_t n = 0; n < sig.bits; n++)
+			{
+				bin[n] = (value >> (sig.bits - 1 - n)) & 1 ? '1' : '0';
+			}
+			fprintf(f, "b%s %s\n", bin, id);
+		}
+	}
+
+	bool SignalRecorder::ExportVCD(const char* filename, uint64_t from, uint64_t to)
+	{
+		if (now == 0 || num_signals == 0)
+			return false;
+
+		if (from < tail_time)
+			from = tail_time;
+		if (to > now - 1)
+			to = now - 1;
+		if (from > to)
+			return false;
+
+		FILE* f = fopen(filename, "wt");
+		if (f == nullptr)
+			return false;
+
+		// VCD identifiers are made up of the printable characters '!'...'~'
+
+		char ids[MaxSignals][4]{};
+		for (size_t n = 0; n < num_signals; n++)
+		{
+			size_t v = n;
+			size_t p = 0;
+			do
+			{
+				ids[n][p++] = (char)('!' + v % 94);
+				v /= 94;
+			} while (v != 0);
+		}
+
+		fprintf(f, "$comment Breaknes signal recording. One CLK half cycle is %.3f ns. $end\n", half_period_ps / 1000.0);
+		fprintf(f, "$timescale 1 ps $end\n");
+
+		const char* scope = nullptr;
+		for (size_t n = 0; n < num_signals; n++)
+		{
+			Signal& sig = signals[n];
+
+			if (scope == nullptr || strcmp(scope, sig.category))
+			{
+				if (scope != nullptr)
+					fprintf(f, "$upscope $end\n");
+
+				char scope_name[sizeof(DebugInfoEntry::category)]{};
+				strncpy(scope_name, sig.category, sizeof(scope_name) - 1);
+				for (char* p = scope_name; *p; p++)
+				{
+					if (*p == ' ')
+						*p = '_';
+				}
+
+				fprintf(f, "$scope module %s $end\n", scope_name);
+				scope = sig.category;
+			}
+
+			if (sig.bits == 1)
+				fprintf(f, "$var wire 1 %s %s $end\n", ids[n], sig.name);
+			else
+				fprintf(f, "$var wire %d %s %s [%d:0] $end\n", sig.bits, ids[n], sig.name, sig.bits - 1);
+		}
+		fprintf(f, "$upscope $end\n");
+		fprintf(f, "$enddefinitions $end\n");
+
+		// Bring the values from the beginning of the ring to the beginning of the window
+
+		uint16_t values[MaxSignals]{};
+		memcpy(values, tail_values, sizeof(values));
+
+		size_t idx = (ring_head + ring_size - ring_count) % ring_size;
+		size_t left = ring_count;
+		uint64_t t = tail_time;
+
+		while (left != 0 && t + ring[idx].delta <= from)
+		{
+			t += ring[idx].delta;
+			if (ring[idx].signal != TimeMarker)
+			{
+				values[ring[idx].signal] = ring[idx].value;
+			}
+			idx = (idx + 1) % ring_size;
+			left--;
+		}
+
+		WriteVCDTime(f, from);
+		fprintf(f, "$dumpvars\n");
+		for (size_t n = 0; n < num_signals; n++)
+		{
+			WriteVCDValue(f, signals[n], values[n], ids[n]);
+		}
+		fprintf(f, "$end\n");
+
+		// Changes within the window
+
+		uint64_t last_written = from;
+
+		while (left != 0 && t + ring[idx].delta <= to)
+		{
+			t += ring[idx].delta;
+			if (ring[idx].signal != TimeMarker)
+			{
+				if (t != last_written)
+				{
+					WriteVCDTime(f, t);
+					last_written = t;
+				}
+				WriteVCDValue(f, signals[ring[idx].signal], ring[idx].value, ids[ring[idx].signal]);
+			}
+			idx = (idx + 1) % ring_size;
+			left--;
+		}
+
+		if (last_written != to)
+		{
+			WriteVCDTime(f, to);
+		}
+
+		fclose(f);
+		return true;
+	}
+}
@@ -0,0 +1,123 @@
+// Signal waveform recorder (export to VCD for GTKWave and similar viewers).
+
+#pragma once
+
+namespace Breaknes
+{
+	/// <summary>
+	/// Recorder of the selected signals (by the names from SignalDefs) at CLK half cycle resolution.
+	/// Only the changes are stored, into a ring of fixed size. When the ring is full, the oldest changes are folded into the initial values of the ring.
+	/// </summary>
+	class SignalRecorder
+	{
+		/// <summary>
+		/// Where the signal value comes from.
+		/// </summary>
+		enum class SignalSource
+		{
+			CoreWires = 0,
+			CoreRegs,
+			APUWires,
+			APURegs,
+			PPUWires,
+			PPURegs,
+		};
+
+		struct Signal
+		{
+			const char* category;
+			const char* name;
+			SignalSource source;
+			size_t offset;
+			uint8_t bits;
+		};
+
+#pragma pack(push, 1)
+		/// <summary>
+		/// One change of the signal value. The time is stored as a delta of the previous change (CLK half cycles).
+		/// </summary>
+		struct SignalChange
+		{
+			uint32_t delta;
+			uint16_t signal;
+			uint16_t value;
+		};
+#pragma pack(pop)
+
+		// The delta did not fit into 32 bits; the record only advances the time.
+		static const uint16_t TimeMarker = 0xffff;
+
+		static const size_t MaxSignals = 256;
+		Signal signals[MaxSignals]{};
+		size_t num_signals = 0;
+
+		uint16_t prev_values[MaxSignals]{};	// The values at the time of the last sample
+		uint16_t tail_values[MaxSignals]{};	// The values at the time `tail_time` (the beginning of the ring)
+
+		SignalChange* ring = nullptr;
+		size_t ring_size = 0;
+		size_t ring_head = 0;				// Where the next change goes
+		size_t ring_count = 0;
+
+		uint64_t now = 0;					// Number of samples taken
+		uint64_t tail_time = 0;				// The time of the beginning of the ring
+
+		double half_period_ps = 0;			// Duration of one CLK half cycle (ps)
+		uint64_t last_change_time = 0;		// The time of the newest change in the ring
+
+		bool need_apu_wires = false;
+		bool need_ppu_wires = false;
+
+		M6502Core::M6502* core = nullptr;
+		APUSim::APU* apu = nullptr;
+		PPUSim::PPU* ppu = nullptr;
+
+		void PushChange(size_t signal, uint16_t value);
+		void DropOldest();
+
+		void WriteVCDValue(FILE* f, Signal& sig, uint16_t value, const char* id);
+		void WriteVCDTime(FILE* f, uint64_t t);
+
+	public:
+		/// <summary>
+		/// Create the recorder.
+		/// </summary>
+		/// <param name="clk_freq">Master clock (CLK) frequency of the board, Hz. Only used to convert the time to seconds in the VCD file.</param>
+		SignalRecorder(M6502Core::M6502* core, APUSim::APU* apu, PPUSim::PPU* ppu, size_t capacity, double clk_freq);
+		~SignalRecorder();
+
+		/// <summary>
+		/// Add a signal to the recording. The set of signals can only be changed before the first sample.
+		/// </summary>
+		/// <param name="category">Category from SignalDefs.h (e.g. "PPU H/V")</param>
+		/// <param name="name">Signal name within the category</param>
+		/// <returns>Signal index or -1 if there is no such signal on the board</returns>
+		int AddSignal(const char* category, const char* name);
+
+		size_t GetSignalCount();
+
+		/// <summary>
+		/// Take one sample of all selected signals. Called after each simulated half cycle.
+		/// </summary>
+		void Sample();
+
+		/// <summary>
+		/// The time of the current sample (in CLK half cycles since the recorder was created).
+		/// </summary>
+		uint64_t GetTime();
+
+		/// <summary>
+		/// The oldest time that is still present in the ring.
+		/// </summary>
+		uint64_t GetOldestTime();
+
+		/// <summary>
+		/// Save the window of the recording in VCD format. The window is given in CLK half cycles; the file uses picoseconds.
+		/// </summary>
+		/// <param name="filename">VCD file name</param>
+		/// <param name="from">Beginning of the window (clamped to the oldest time)</param>
+		/// <param name="to">End of the window (clamped to the current time)</param>
+		/// <returns>true: OK</returns>
+		bool ExportVCD(const char* filename, uint64_t from, uint64_t to);
+	};
+}
@@ -4,6 +4,10 @@
 #include <string>
 #include <list>
 #include <map>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include <chrono>
 #include <cassert>
 #include <memory.h>
 #include <cstddef>
@@ -53,6 +57,11 @@
 
 #include "RegDumpEmitter.h"
 #include "SignalDefs.h"
+#include "AudioFilter.h"
+#include "SignalRecorder.h"
+#include "BoardEvents.h"
+#include "DebugSnapshot.h"
+#include "InputMovie.h"
 #include "AbstractBoard.h"
 #include "BogusBoard.h"
 #include "NESBoard.h"
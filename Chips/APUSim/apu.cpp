@@ -11,71 +11,59 @@ namespace APUSim
 		rev = _rev;
 		fx = features;
 
-		core_int = new CoreBinding(this);
-		clkgen = new CLKGen(this);
-		lc[0] = new LengthCounter(this);
-		lc[1] = new LengthCounter(this);
-		lc[2] = new LengthCounter(this);
-		lc[3] = new LengthCounter(this);
-		dpcm = new DpcmChan(this);
-		noise = new NoiseChan(this);
-		square[0] = new SquareChan(this, SquareChanCarryIn::Vdd);
-		square[1] = new SquareChan(this, SquareChanCarryIn::Inc);
-		tri = new TriangleChan(this);
-		regs = new RegsDecoder(this);
-		dma = new DMA(this);
-		pads = new Pads(this);
-		dac = new DAC(this);
+		pads = arena.New<Pads>(this);
+		dpcm = arena.New<DpcmChan>(this);
+		dma = arena.New<DMA>(this);
+		core_int = arena.New<CoreBinding>(this);
+		clkgen = arena.New<CLKGen>(this);
+		regs = arena.New<RegsDecoder>(this);
+		square[0] = arena.New<SquareChan>(this, SquareChanCarryIn::Vdd);
+		square[1] = arena.New<SquareChan>(this, SquareChanCarryIn::Inc);
+		tri = arena.New<TriangleChan>(this);
+		noise = arena.New<NoiseChan>(this);
+		lc[0] = arena.New<LengthCounter>(this);
+		lc[1] = arena.New<LengthCounter>(this);
+		lc[2] = arena.New<LengthCounter>(this);
+		lc[3] = arena.New<LengthCounter>(this);
+		dac = arena.New<DAC>(this);
 
 		wire.RDY2 = TriState::One;
 	}
 
 	APU::~APU()
 	{
-		delete core_int;
-		delete clkgen;
-		delete lc[0];
-		delete lc[1];
-		delete lc[2];
-		delete lc[3];
-		delete dpcm;
-		delete noise;
-		delete square[0];
-		delete square[1];
-		delete tri;
-		delete regs;
-		delete dma;
-		delete pads;
-		delete dac;
-	}
-
-	void APU::sim(TriState inputs[], TriState outputs[], uint8_t* data, uint16_t* addr, AudioOutSignal& AUX)
-	{
-		pads->sim_InputPads(inputs);
+		// The modules are destroyed together with the arena.
+	}
+
+	void APU::sim(Pins32& inputs, Pins32& outputs, uint8_t* data, uint16_t* addr, AudioOutSignal& AUX)
+	{
+		PROFILE_SCOPE("APU");
+
+		PROFILE_STAGE("pads->sim_InputPads", pads->sim_InputPads(inputs));
 		pads->sim_DataBusInput(data);
 
-		dpcm->sim();
+		PROFILE_STAGE("dpcm->sim", dpcm->sim());
 
-		dma->sim();
-		dma->sim_DMA_Buffer();
-		dma->sim_AddressMux();
+		PROFILE_STAGE("dma->sim", dma->sim());
+		PROFILE_STAGE("dma->sim_DMA_Buffer", dma->sim_DMA_Buffer());
+		PROFILE_STAGE("dma->sim_AddressMux", dma->sim_AddressMux());
 
-		sim_CoreIntegration();
+		PROFILE_STAGE("sim_CoreIntegration", sim_CoreIntegration());
 
-		sim_SoundGenerators();
+		PROFILE_STAGE("sim_SoundGenerators", sim_SoundGenerators());
 
-		pads->sim_OutputPads(outputs, addr);
+		PROFILE_STAGE("pads->sim_OutputPads", pads->sim_OutputPads(outputs, addr));
 		pads->sim_DataBusOutput(data);
-		dac->sim(AUX);
+		PROFILE_STAGE("dac->sim", dac->sim(AUX));
 	}
 
 	void APU::sim_CoreIntegration()
 	{
 		// Core & stuff
 
-		core_int->sim();
-		clkgen->sim();
-		regs->sim();
+		PROFILE_STAGE("core_int->sim", core_int->sim());
+		PROFILE_STAGE("clkgen->sim", clkgen->sim());
+		PROFILE_STAGE("regs->sim", regs->sim());
 		regs->sim_DebugRegisters();
 	}
 
@@ -95,15 +83,15 @@ namespace APUSim
 		wire.TRI_LC = tri->get_LC();
 		wire.RND_LC = noise->get_LC();
 
-		lc[0]->sim(0, wire.W4003, wire.SQA_LC, wire.NOSQA);
-		lc[1]->sim(1, wire.W4007, wire.SQB_LC, wire.NOSQB);
-		lc[2]->sim(2, wire.W400B, wire.TRI_LC, wire.NOTRI);
-		lc[3]->sim(3, wire.W400F, wire.RND_LC, wire.NORND);
+		PROFILE_STAGE("lc[0]->sim", lc[0]->sim(0, wire.W4003, wire.SQA_LC, wire.NOSQA));
+		PROFILE_STAGE("lc[1]->sim", lc[1]->sim(1, wire.W4007, wire.SQB_LC, wire.NOSQB));
+		PROFILE_STAGE("lc[2]->sim", lc[2]->sim(2, wire.W400B, wire.TRI_LC, wire.NOTRI));
+		PROFILE_STAGE("lc[3]->sim", lc[3]->sim(3, wire.W400F, wire.RND_LC, wire.NORND));
 
-		square[0]->sim(wire.W4000, wire.W4001, wire.W4002, wire.W4003, wire.NOSQA, SQA_Out);
-		square[1]->sim(wire.W4004, wire.W4005, wire.W4006, wire.W4007, wire.NOSQB, SQB_Out);
-		tri->sim();
-		noise->sim();
+		PROFILE_STAGE("square[0]->sim", square[0]->sim(wire.W4000, wire.W4001, wire.W4002, wire.W4003, wire.NOSQA, SQA_Out));
+		PROFILE_STAGE("square[1]->sim", square[1]->sim(wire.W4004, wire.W4005, wire.W4006, wire.W4007, wire.NOSQB, SQB_Out));
+		PROFILE_STAGE("tri->sim", tri->sim());
+		PROFILE_STAGE("noise->sim", noise->sim());
 	}
 
 	TriState APU::GetDBBit(size_t n)
@@ -132,6 +120,16 @@ namespace APUSim
 		dac->SetNormalizedOutput(enable);
 	}
 
+	void APU::EnableFastForward(bool enable)
+	{
+		dpcm->EnableFastForward(enable);
+	}
+
+	void APU::EnableWordLevelLFSR(bool enable)
+	{
+		clkgen->SetWordLevel(enable);
+	}
+
 	size_t APU::GetACLKCounter()
 	{
 		return aclk_counter;
@@ -166,4 +164,9 @@ namespace APUSim
 	{
 		return wire.PHI2;
 	}
+
+	TriState APU::GetNOSPR()
+	{
+		return dma->Get_NOSPR();
+	}
 }
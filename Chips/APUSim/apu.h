@@ -236,6 +236,11 @@ namespace APUSim
 		// Instances of internal APU modules, including the core
 
 		M6502Core::M6502* core = nullptr;
+
+		// All modules are placed in the arena in the order in which they are simulated.
+
+		BaseLogic::Arena arena{};
+
 		CoreBinding* core_int = nullptr;
 		CLKGen* clkgen = nullptr;
 		RegsDecoder* regs = nullptr;
@@ -288,7 +293,9 @@ namespace APUSim
 		/// <summary>
 		/// Simulate one half cycle
 		/// </summary>
-		void sim(BaseLogic::TriState inputs[], BaseLogic::TriState outputs[], uint8_t *data, uint16_t* addr, AudioOutSignal& AUX);
+		/// <param name="inputs">Input pads (see `APU_Input`)</param>
+		/// <param name="outputs">Output pads (see `APU_Output`)</param>
+		void sim(BaseLogic::Pins32& inputs, BaseLogic::Pins32& outputs, uint8_t *data, uint16_t* addr, AudioOutSignal& AUX);
 
 		/// <summary>
 		/// Get the values of internal connections for debugging.
@@ -338,6 +345,21 @@ namespace APUSim
 		/// <param name="enable"></param>
 		void SetNormalizedOutput(bool enable);
 
+		/// <summary>
+		/// Skip the repeated evaluations of the DPCM channel while its inputs and state do not change (enabled by default).
+		/// Only the DPCM channel is fast-forwarded. There is no closed-form advance of the square, triangle and noise channels or the envelopes: they are still simulated on every PHI edge.
+		/// </summary>
+		/// <param name="enable"></param>
+		void EnableFastForward(bool enable);
+
+		/// <summary>
+		/// Simulate the SoftCLK LFSR as a whole word with the PLA table instead of individual cells (enabled by default).
+		/// Can be switched at any time, the state is carried over.
+		/// This is the only cell-level switch: the registers and counters of the sound channels, length counters and DMA are always simulated as words (RegisterWord, CounterWord, etc.).
+		/// </summary>
+		/// <param name="enable"></param>
+		void EnableWordLevelLFSR(bool enable);
+
 		/// <summary>
 		/// Get the value of the ACLK cycle counter (PHI/2)
 		/// </summary>
@@ -367,5 +389,10 @@ namespace APUSim
 		void GetSignalFeatures(AudioSignalFeatures& features);
 
 		BaseLogic::TriState GetPHI2();
+
+		/// <summary>
+		/// 0: OAM DMA is in progress (including the cycles stolen by the DPCM DMA).
+		/// </summary>
+		BaseLogic::TriState GetNOSPR();
 	};
 }
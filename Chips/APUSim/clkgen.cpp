@@ -6,9 +6,16 @@ using namespace BaseLogic;
 
 namespace APUSim
 {
+	uint8_t CLKGen::pla_lut[2][1 << CLKGen::lfsr_bits];
+
 	CLKGen::CLKGen(APU* parent)
 	{
 		apu = parent;
+
+		// The first instance builds the table (the initialization of a local static is thread-safe)
+
+		static const bool lut_ready = BuildLUT();
+		(void)lut_ready;
 	}
 
 	CLKGen::~CLKGen()
@@ -102,6 +109,17 @@ namespace APUSim
 
 	void CLKGen::sim_SoftCLK_PLA()
 	{
+		if (word_level)
+		{
+			uint8_t outputs = pla_lut[mode == TriState::One ? 1 : 0][~lfsr_out & lfsr_mask];
+
+			for (size_t n = 0; n < 6; n++)
+			{
+				pla[n] = FromByte((outputs >> n) & 1);
+			}
+			return;
+		}
+
 		BaseLogic::TriState s[15]{};
 		BaseLogic::TriState ns[15]{};
 
@@ -111,18 +129,53 @@ namespace APUSim
 			ns[n] = lfsr[n].get_nsout();
 		}
 
-		pla[0] = NOR15(ns[0], s[1], s[2], s[3], s[4], ns[5], ns[6], s[7], s[8], s[9], s[10], s[11], ns[12], s[13], s[14]);
-		pla[1] = NOR15(ns[0], ns[1], s[2], s[3], s[4], s[5], s[6], s[7], s[8], ns[9], ns[10], s[11], ns[12], ns[13], s[14]);
-		pla[2] = NOR15(ns[0], ns[1], s[2], s[3], ns[4], s[5], ns[6], ns[7], s[8], s[9], ns[10], ns[11], s[12], ns[13], s[14]);
-		pla[3] = NOR16(ns[0], ns[1], ns[2], ns[3], ns[4], s[5], s[6], s[7], s[8], ns[9], s[10], ns[11], s[12], s[13], s[14], mode);	// ⚠️
-		pla[4] = NOR15(ns[0], s[1], ns[2], s[3], s[4], s[5], s[6], ns[7], ns[8], s[9], s[10], s[11], ns[12], ns[13], ns[14]);
-		pla[5] = NOR15(s[0], s[1], s[2], s[3], s[4], s[5], s[6], s[7], s[8], s[9], s[10], s[11], s[12], s[13], s[14]);
+		DecodePLA(s, ns, mode, pla);
+	}
+
+	void CLKGen::DecodePLA(TriState s[], TriState ns[], TriState md, TriState outputs[])
+	{
+		outputs[0] = NOR15(ns[0], s[1], s[2], s[3], s[4], ns[5], ns[6], s[7], s[8], s[9], s[10], s[11], ns[12], s[13], s[14]);
+		outputs[1] = NOR15(ns[0], ns[1], s[2], s[3], s[4], s[5], s[6], s[7], s[8], ns[9], ns[10], s[11], ns[12], ns[13], s[14]);
+		outputs[2] = NOR15(ns[0], ns[1], s[2], s[3], ns[4], s[5], ns[6], ns[7], s[8], s[9], ns[10], ns[11], s[12], ns[13], s[14]);
+		outputs[3] = NOR16(ns[0], ns[1], ns[2], ns[3], ns[4], s[5], s[6], s[7], s[8], ns[9], s[10], ns[11], s[12], s[13], s[14], md);	// ⚠️
+		outputs[4] = NOR15(ns[0], s[1], ns[2], s[3], s[4], s[5], s[6], ns[7], ns[8], s[9], s[10], s[11], ns[12], ns[13], ns[14]);
+		outputs[5] = NOR15(s[0], s[1], s[2], s[3], s[4], s[5], s[6], s[7], s[8], s[9], s[10], s[11], s[12], s[13], s[14]);
 	}
 
 	void CLKGen::sim_SoftCLK_LFSR()
 	{
 		TriState ACLK1 = apu->wire.ACLK1;
 
+		if (word_level)
+		{
+			uint32_t sout = ~lfsr_out & lfsr_mask;
+
+			// Feedback
+
+			TriState C13 = FromByte((sout >> 13) & 1);
+			TriState C14 = FromByte((sout >> 14) & 1);
+			uint32_t fb = ToByte(NOR(AND(C13, C14), NOR3(C13, C14, pla[5])));
+
+			// SR15. When ACLK1 is active at the same time as the shift (possible only during reset), the value ripples through all the bits at once, as it does in the cells.
+
+			if (F2 == TriState::One)
+			{
+				lfsr_in = ACLK1 == TriState::One ? (fb ? lfsr_mask : 0) : ((sout << 1) | fb) & lfsr_mask;
+			}
+			else if (F1 == TriState::One)
+			{
+				lfsr_in = lfsr_mask;
+			}
+
+			if (ACLK1 == TriState::One)
+			{
+				lfsr_out = ~lfsr_in & lfsr_mask;
+			}
+
+			shift_in = FromByte((~lfsr_out >> 14) & 1);
+			return;
+		}
+
 		// Feedback
 
 		TriState C13 = lfsr[13].get_sout();
@@ -154,8 +207,75 @@ namespace APUSim
 		return out_latch.get();
 	}
 
+	TriState SoftCLK_SRBit::get_in()
+	{
+		return in_latch.get();
+	}
+
+	void SoftCLK_SRBit::set(TriState in, TriState out)
+	{
+		in_latch.set(in, TriState::One);
+		out_latch.set(out, TriState::One);
+	}
+
 	TriState CLKGen::GetINTFF()
 	{
 		return int_ff.get();
 	}
+
+	bool CLKGen::BuildLUT()
+	{
+		TriState s[lfsr_bits]{};
+		TriState ns[lfsr_bits]{};
+		TriState outputs[6]{};
+
+		for (size_t md = 0; md < 2; md++)
+		{
+			for (uint32_t sout = 0; sout <= lfsr_mask; sout++)
+			{
+				for (size_t n = 0; n < lfsr_bits; n++)
+				{
+					s[n] = FromByte((sout >> n) & 1);
+					ns[n] = NOT(s[n]);
+				}
+
+				DecodePLA(s, ns, FromByte(md), outputs);
+
+				uint8_t packed = 0;
+				for (size_t n = 0; n < 6; n++)
+				{
+					packed |= ToByte(outputs[n]) << n;
+				}
+				pla_lut[md][sout] = packed;
+			}
+		}
+
+		return true;
+	}
+
+	void CLKGen::SetWordLevel(bool enable)
+	{
+		if (enable == word_level)
+			return;
+
+		if (enable)
+		{
+			lfsr_in = 0;
+			lfsr_out = 0;
+			for (size_t n = 0; n < lfsr_bits; n++)
+			{
+				lfsr_in |= ToByte(lfsr[n].get_in()) << n;
+				lfsr_out |= ToByte(lfsr[n].get_nsout()) << n;
+			}
+		}
+		else
+		{
+			for (size_t n = 0; n < lfsr_bits; n++)
+			{
+				lfsr[n].set(FromByte((lfsr_in >> n) & 1), FromByte((lfsr_out >> n) & 1));
+			}
+		}
+
+		word_level = enable;
+	}
 }
@@ -14,6 +14,9 @@ namespace APUSim
 
 		BaseLogic::TriState get_sout();
 		BaseLogic::TriState get_nsout();
+
+		BaseLogic::TriState get_in();
+		void set(BaseLogic::TriState in, BaseLogic::TriState out);
 	};
 
 	class CLKGen
@@ -43,6 +46,21 @@ namespace APUSim
 
 		SoftCLK_SRBit lfsr[15]{};
 
+		// Word-level LFSR: bit n holds the value of the input/output latch of the n-th shift register bit.
+		// The PLA outputs are a pure function of the LFSR outputs and the mode, so they are precomputed for every combination.
+		// PLA LUT index: [mode][sout], the outputs are packed as bits (bit n = pla[n]). The table (64 KB) is shared by all instances and is built once.
+
+		static const size_t lfsr_bits = 15;
+		static const uint32_t lfsr_mask = (1 << lfsr_bits) - 1;
+
+		bool word_level = true;
+		uint32_t lfsr_in = 0;
+		uint32_t lfsr_out = 0;
+		static uint8_t pla_lut[2][1 << lfsr_bits];
+
+		static bool BuildLUT();
+		static void DecodePLA(BaseLogic::TriState s[], BaseLogic::TriState ns[], BaseLogic::TriState md, BaseLogic::TriState outputs[]);
+
 		RegisterBit reg_mode{};
 		RegisterBit reg_mask{};
 
@@ -59,5 +77,12 @@ namespace APUSim
 		void sim();
 
 		BaseLogic::TriState GetINTFF();
+
+		/// <summary>
+		/// Simulate the SoftCLK LFSR as an integer with a precomputed PLA table instead of individual shift register cells (enabled by default).
+		/// The LFSR state is carried over when switching.
+		/// </summary>
+		/// <param name="enable"></param>
+		void SetWordLevel(bool enable);
 	};
 }
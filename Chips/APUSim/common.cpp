@@ -113,6 +113,16 @@ namespace APUSim
 		transp_latch.set(val, TriState::One);
 	}
 
+	TriState CounterBit::get_cg()
+	{
+		return cg_latch.get();
+	}
+
+	void CounterBit::set_cg(BaseLogic::TriState val)
+	{
+		cg_latch.set(val, TriState::One);
+	}
+
 	TriState DownCounterBit::sim(TriState Carry, TriState Clear, TriState Load, TriState Step, TriState ACLK1, TriState val)
 	{
 		TriState latch_in =
@@ -146,6 +156,16 @@ namespace APUSim
 		transp_latch.set(val, TriState::One);
 	}
 
+	TriState DownCounterBit::get_cg()
+	{
+		return cg_latch.get();
+	}
+
+	void DownCounterBit::set_cg(BaseLogic::TriState val)
+	{
+		cg_latch.set(val, TriState::One);
+	}
+
 	TriState RevCounterBit::sim(TriState Carry, TriState Dec, TriState Clear, TriState Load, TriState Step, TriState ACLK1, TriState val)
 	{
 		TriState latch_in =
@@ -178,4 +198,209 @@ namespace APUSim
 	{
 		transp_latch.set(val, TriState::One);
 	}
+
+	TriState RevCounterBit::get_cg()
+	{
+		return cg_latch.get();
+	}
+
+	void RevCounterBit::set_cg(BaseLogic::TriState val)
+	{
+		cg_latch.set(val, TriState::One);
+	}
+
+	RegisterWord::RegisterWord(size_t _bits)
+	{
+		bits = _bits;
+		mask = (1 << bits) - 1;
+	}
+
+	void RegisterWord::sim(TriState ACLK1, TriState Enable, uint32_t value)
+	{
+		if ((ACLK1 & 1) == 0 && (Enable & 1) != 0)
+		{
+			val = value & mask;
+		}
+	}
+
+	uint32_t RegisterWord::get()
+	{
+		return val;
+	}
+
+	void RegisterWord::set(uint32_t value)
+	{
+		val = value & mask;
+	}
+
+	RegisterResWord::RegisterResWord(size_t _bits)
+	{
+		bits = _bits;
+		mask = (1 << bits) - 1;
+	}
+
+	void RegisterResWord::sim(TriState ACLK1, TriState Enable, uint32_t value, TriState Res)
+	{
+		if ((ACLK1 & 1) == 0 && (Enable & 1) != 0)
+		{
+			val = value & mask;
+		}
+
+		if (Res == TriState::One)
+		{
+			val = 0;
+		}
+	}
+
+	uint32_t RegisterResWord::get()
+	{
+		return val;
+	}
+
+	void RegisterResWord::set(uint32_t value)
+	{
+		val = value & mask;
+	}
+
+	CounterWord::CounterWord(size_t _bits)
+	{
+		bits = _bits;
+		mask = (1 << bits) - 1;
+		step_val = mask;		// cg latches are reset
+	}
+
+	TriState CounterWord::sim(TriState Carry, TriState Clear, TriState Load, TriState Step, TriState ACLK1, uint32_t value)
+	{
+		uint32_t cin = Carry & 1;
+
+		if ((Load & 1) != 0)
+		{
+			val = value & mask;
+		}
+		else if ((Clear & 1) != 0)
+		{
+			val = 0;
+		}
+		else if ((Step & 1) != 0)
+		{
+			val = step_val;
+		}
+
+		if (ACLK1 == TriState::One)
+		{
+			step_val = (val + cin) & mask;
+		}
+
+		return (cin != 0 && val == mask) ? TriState::One : TriState::Zero;
+	}
+
+	uint32_t CounterWord::get()
+	{
+		return val;
+	}
+
+	void CounterWord::set(uint32_t value)
+	{
+		val = value & mask;
+	}
+
+	uint32_t CounterWord::get_cg()
+	{
+		return step_val;
+	}
+
+	DownCounterWord::DownCounterWord(size_t _bits)
+	{
+		bits = _bits;
+		mask = (1 << bits) - 1;
+		step_val = mask;		// cg latches are reset
+	}
+
+	TriState DownCounterWord::sim(TriState Carry, TriState Clear, TriState Load, TriState Step, TriState ACLK1, uint32_t value)
+	{
+		uint32_t cin = Carry & 1;
+
+		if ((Load & 1) != 0)
+		{
+			val = value & mask;
+		}
+		else if ((Clear & 1) != 0)
+		{
+			val = 0;
+		}
+		else if ((Step & 1) != 0)
+		{
+			val = step_val;
+		}
+
+		if (ACLK1 == TriState::One)
+		{
+			step_val = (val - cin) & mask;
+		}
+
+		return (cin != 0 && val == 0) ? TriState::One : TriState::Zero;
+	}
+
+	uint32_t DownCounterWord::get()
+	{
+		return val;
+	}
+
+	void DownCounterWord::set(uint32_t value)
+	{
+		val = value & mask;
+	}
+
+	uint32_t DownCounterWord::get_cg()
+	{
+		return step_val;
+	}
+
+	RevCounterWord::RevCounterWord(size_t _bits)
+	{
+		bits = _bits;
+		mask = (1 << bits) - 1;
+		step_val = mask;		// cg latches are reset
+	}
+
+	TriState RevCounterWord::sim(TriState Carry, TriState Dec, TriState Clear, TriState Load, TriState Step, TriState ACLK1, uint32_t value)
+	{
+		uint32_t cin = Carry & 1;
+		bool dec = (Dec & 1) != 0;
+
+		if ((Load & 1) != 0)
+		{
+			val = value & mask;
+		}
+		else if ((Clear & 1) != 0)
+		{
+			val = 0;
+		}
+		else if ((Step & 1) != 0)
+		{
+			val = step_val;
+		}
+
+		if (ACLK1 == TriState::One)
+		{
+			step_val = (dec ? val - cin : val + cin) & mask;
+		}
+
+		return (cin != 0 && val == (dec ? 0 : mask)) ? TriState::One : TriState::Zero;
+	}
+
+	uint32_t RevCounterWord::get()
+	{
+		return val;
+	}
+
+	void RevCounterWord::set(uint32_t value)
+	{
+		val = value & mask;
+	}
+
+	uint32_t RevCounterWord::get_cg()
+	{
+		return step_val;
+	}
 }
@@ -53,6 +53,8 @@ namespace APUSim
 		BaseLogic::TriState get();
 		BaseLogic::TriState nget();
 		void set(BaseLogic::TriState val);
+		BaseLogic::TriState get_cg();
+		void set_cg(BaseLogic::TriState val);
 	};
 
 	class DownCounterBit
@@ -71,6 +73,8 @@ namespace APUSim
 		BaseLogic::TriState get();
 		BaseLogic::TriState nget();
 		void set(BaseLogic::TriState val);
+		BaseLogic::TriState get_cg();
+		void set_cg(BaseLogic::TriState val);
 	};
 
 	class RevCounterBit
@@ -90,5 +94,107 @@ namespace APUSim
 		BaseLogic::TriState get();
 		BaseLogic::TriState nget();
 		void set(BaseLogic::TriState val);
+		BaseLogic::TriState get_cg();
+		void set_cg(BaseLogic::TriState val);
+	};
+
+	/// <summary>
+	/// Word-level versions of the register and counter cells. A word behaves exactly like an array of the corresponding cells
+	/// (bit 0 is the first in the carry chain), but all bits are simulated at once.
+	/// </summary>
+
+	class RegisterWord
+	{
+		size_t bits = 0;
+		uint32_t mask = 0;
+		uint32_t val = 0;
+
+	public:
+		RegisterWord(size_t bits);
+
+		void sim(BaseLogic::TriState ACLK1, BaseLogic::TriState Enable, uint32_t value);
+		uint32_t get();
+		void set(uint32_t value);
+	};
+
+	class RegisterResWord
+	{
+		size_t bits = 0;
+		uint32_t mask = 0;
+		uint32_t val = 0;
+
+	public:
+		RegisterResWord(size_t bits);
+
+		void sim(BaseLogic::TriState ACLK1, BaseLogic::TriState Enable, uint32_t value, BaseLogic::TriState Res);
+		uint32_t get();
+		void set(uint32_t value);
+	};
+
+	class CounterWord
+	{
+		size_t bits = 0;
+		uint32_t mask = 0;
+		uint32_t val = 0;
+		uint32_t step_val = 0;		// The value loaded on Step (the cg latches)
+
+	public:
+		CounterWord(size_t bits);
+
+		BaseLogic::TriState sim(
+			BaseLogic::TriState Carry,
+			BaseLogic::TriState Clear,
+			BaseLogic::TriState Load,
+			BaseLogic::TriState Step,
+			BaseLogic::TriState ACLK1,
+			uint32_t value);
+		uint32_t get();
+		void set(uint32_t value);
+		uint32_t get_cg();
+	};
+
+	class DownCounterWord
+	{
+		size_t bits = 0;
+		uint32_t mask = 0;
+		uint32_t val = 0;
+		uint32_t step_val = 0;		// The value loaded on Step (the cg latches)
+
+	public:
+		DownCounterWord(size_t bits);
+
+		BaseLogic::TriState sim(
+			BaseLogic::TriState Carry,
+			BaseLogic::TriState Clear,
+			BaseLogic::TriState Load,
+			BaseLogic::TriState Step,
+			BaseLogic::TriState ACLK1,
+			uint32_t value);
+		uint32_t get();
+		void set(uint32_t value);
+		uint32_t get_cg();
+	};
+
+	class RevCounterWord
+	{
+		size_t bits = 0;
+		uint32_t mask = 0;
+		uint32_t val = 0;
+		uint32_t step_val = 0;		// The value loaded on Step (the cg latches)
+
+	public:
+		RevCounterWord(size_t bits);
+
+		BaseLogic::TriState sim(
+			BaseLogic::TriState Carry,
+			BaseLogic::TriState Dec,
+			BaseLogic::TriState Clear,
+			BaseLogic::TriState Load,
+			BaseLogic::TriState Step,
+			BaseLogic::TriState ACLK1,
+			uint32_t value);
+		uint32_t get();
+		void set(uint32_t value);
+		uint32_t get_cg();
 	};
 }
@@ -213,6 +213,8 @@ namespace APUSim
 
 	void APU::SetDebugInfo_Wire(int ofs, uint8_t val)
 	{
+		dpcm->InvalidateFastForward();
+
 		switch (ofs)
 		{
 			case offsetof(APU_Interconnects, n_CLK): wire.n_CLK = FromByte(val); break;
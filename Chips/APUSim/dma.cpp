@@ -29,31 +29,17 @@ namespace APUSim
 
 		// Low
 
-		TriState carry = TriState::One;
-		for (size_t n = 0; n < 8; n++)
-		{
-			carry = spr_lo[n].sim(carry, RES, W4014, SPRS, ACLK1, TriState::Zero);
-		}
-		SPRE = carry;
+		SPRE = spr_lo.sim(TriState::One, RES, W4014, SPRS, ACLK1, 0);
 
 		spre_latch.set(SPRE, ACLK1);
 
 		// High
 
-		for (size_t n = 0; n < 8; n++)
-		{
-			spr_hi[n].sim(ACLK1, W4014, apu->GetDBBit(n));
-		}
+		spr_hi.sim(ACLK1, W4014, apu->DB);
 
 		// SPR_Addr
 
-		apu->SPR_Addr = 0;
-
-		for (size_t n = 0; n < 8; n++)
-		{
-			apu->SPR_Addr |= ((spr_lo[n].get() == TriState::One ? 1 : 0) << n);
-			apu->SPR_Addr |= ((spr_hi[n].get() == TriState::One ? 1 : 0) << (8 + n));
-		}
+		apu->SPR_Addr = (uint16_t)(spr_lo.get() | (spr_hi.get() << 8));
 	}
 
 	void DMA::sim_DMA_Control()
@@ -145,14 +131,12 @@ namespace APUSim
 
 	uint32_t DMA::Get_DMAAddress()
 	{
-		TriState val_lo[8]{};
-		TriState val_hi[8]{};
-		for (size_t n = 0; n < 8; n++)
-		{
-			val_lo[n] = spr_lo[n].get();
-			val_hi[n] = spr_hi[n].get();
-		}
-		return (Pack(val_lo)) | ((uint32_t)Pack(val_hi) << 8);
+		return spr_lo.get() | (spr_hi.get() << 8);
+	}
+
+	TriState DMA::Get_NOSPR()
+	{
+		return NOSPR;
 	}
 
 	void DMA::Set_DMABuffer(uint32_t value)
@@ -167,15 +151,8 @@ namespace APUSim
 
 	void DMA::Set_DMAAddress(uint32_t value)
 	{
-		TriState val_lo[8]{};
-		TriState val_hi[8]{};
-		Unpack(value, val_lo);
-		Unpack(value >> 8, val_hi);
-		for (size_t n = 0; n < 8; n++)
-		{
-			spr_lo[n].set(val_lo[n]);
-			spr_hi[n].set(val_hi[n]);
-		}
+		spr_lo.set(value);
+		spr_hi.set(value >> 8);
 	}
 
 #pragma endregion "Debug"
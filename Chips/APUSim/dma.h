@@ -11,8 +11,8 @@ namespace APUSim
 
 		static const uint16_t PPU_Addr = 0x2004;
 
-		CounterBit spr_lo[8]{};
-		RegisterBit spr_hi[8]{};
+		CounterWord spr_lo{ 8 };
+		RegisterWord spr_hi{ 8 };
 
 		BaseLogic::DLatch spre_latch{};
 		BaseLogic::DLatch nospr_latch{};
@@ -43,6 +43,7 @@ namespace APUSim
 
 		uint32_t Get_DMABuffer();
 		uint32_t Get_DMAAddress();
+		BaseLogic::TriState Get_NOSPR();
 
 		void Set_DMABuffer(uint32_t value);
 		void Set_DMAAddress(uint32_t value);
@@ -19,6 +19,20 @@ namespace APUSim
 
 	void DpcmChan::sim()
 	{
+		// The channel is simulated on every CLK half-cycle, but its inputs only change a few times per PHI.
+
+		uint64_t inputs = 0;
+
+		if (FastForward)
+		{
+			inputs = PackInputs();
+			if (settled && inputs == settled_inputs)
+			{
+				return;
+			}
+			PackState(state_snapshot);
+		}
+
 		ACLK2 = NOT(apu->wire.nACLK2);
 
 		sim_SampleCounterReg();
@@ -43,6 +57,104 @@ namespace APUSim
 		sim_AddressReg();
 		sim_AddressCounter();
 		sim_Output();
+
+		if (FastForward)
+		{
+			// While $4015 is being read the channel drives the data bus, which is overwritten by the pads on the next CLK.
+
+			DpcmState state;
+			PackState(state);
+			settled = apu->wire.n_R4015 == TriState::One && SameState(state_snapshot, state);
+			settled_inputs = inputs;
+		}
+	}
+
+	uint64_t DpcmChan::PackInputs()
+	{
+		// All values of TriState (including Z and X) are distinguishable by the two lower bits.
+
+		TriState in[] = {
+			apu->wire.ACLK1, apu->wire.nACLK2, apu->wire.PHI1, apu->wire.RnW, apu->wire.RES, apu->wire.LOCK, apu->wire.n_DMC_AB,
+			apu->wire.W4010, apu->wire.W4011, apu->wire.W4012, apu->wire.W4013, apu->wire.W4015, apu->wire.n_R4015,
+		};
+
+		uint64_t val = apu->DB;
+		for (size_t n = 0; n < sizeof(in); n++)
+		{
+			val |= (uint64_t)(in[n] & 3) << (8 + 2 * n);
+		}
+		return val;
+	}
+
+	void DpcmChan::PackState(DpcmState& state)
+	{
+		uint32_t regs[] = { freq_reg.get(), scnt_reg.get(), buf_reg.get(), addr_reg.get() };
+
+		uint32_t counters[][2] = {
+			{ scnt.get(), scnt.get_cg() },
+			{ sbcnt.get(), sbcnt.get_cg() },
+			{ addr_lo.get(), addr_lo.get_cg() },
+			{ addr_hi.get(), addr_hi.get_cg() },
+			{ out_cnt.get(), out_cnt.get_cg() },
+		};
+
+		TriState wires[] = {
+			LOOPMode, n_IRQEN, DSLOAD, DSSTEP, BLOAD, BSTEP, NSTEP, DSTEP, PCM, DOUT, n_NOUT, SOUT, DFLOAD, n_BOUT,
+			Fx[0], Fx[1], Fx[2], Fx[3],
+			FR[0], FR[1], FR[2], FR[3], FR[4], FR[5], FR[6], FR[7], FR[8],
+			Dec1_out[0], Dec1_out[1], Dec1_out[2], Dec1_out[3], Dec1_out[4], Dec1_out[5], Dec1_out[6], Dec1_out[7],
+			Dec1_out[8], Dec1_out[9], Dec1_out[10], Dec1_out[11], Dec1_out[12], Dec1_out[13], Dec1_out[14], Dec1_out[15],
+			ED1, ED2, DMC1, DMC2, CTRL1, CTRL2, ACLK2,
+		};
+
+		TriState latches[] = {
+			int_ff.get(), sout_latch.get(), ena_ff.get(), run_latch1.get(), run_latch2.get(), start_ff.get(), rdy_ff.get(),
+			en_latch1.get(), en_latch2.get(), en_latch3.get(), step_ff.get(), stop_ff.get(), pcm_ff.get(),
+			dout_latch.get(), dstep_latch.get(), stop_latch.get(), pcm_latch.get(), nout_latch.get(),
+			loop_reg.get(), irq_reg.get(), out_reg.get(),
+		};
+
+		static_assert(sizeof(regs) == sizeof(state.regs), "DpcmState::regs");
+		static_assert(sizeof(counters) == sizeof(state.counters), "DpcmState::counters");
+		static_assert(sizeof(wires) == sizeof(state.wires), "DpcmState::wires");
+		static_assert(sizeof(latches) == sizeof(state.latches), "DpcmState::latches");
+
+		memcpy(state.regs, regs, sizeof(regs));
+		memcpy(state.counters, counters, sizeof(counters));
+		memcpy(state.wires, wires, sizeof(wires));
+		memcpy(state.latches, latches, sizeof(latches));
+
+		for (size_t n = 0; n < 9; n++)
+		{
+			state.lfsr[n] = lfsr[n].get_state();
+		}
+
+		for (size_t n = 0; n < 8; n++)
+		{
+			state.shift_reg[n] = shift_reg[n].get_state();
+		}
+	}
+
+	bool DpcmChan::SameState(DpcmState& a, DpcmState& b)
+	{
+		return
+			memcmp(a.regs, b.regs, sizeof(a.regs)) == 0 &&
+			memcmp(a.counters, b.counters, sizeof(a.counters)) == 0 &&
+			memcmp(a.wires, b.wires, sizeof(a.wires)) == 0 &&
+			memcmp(a.latches, b.latches, sizeof(a.latches)) == 0 &&
+			memcmp(a.lfsr, b.lfsr, sizeof(a.lfsr)) == 0 &&
+			memcmp(a.shift_reg, b.shift_reg, sizeof(a.shift_reg)) == 0;
+	}
+
+	void DpcmChan::EnableFastForward(bool enable)
+	{
+		FastForward = enable;
+		settled = false;
+	}
+
+	void DpcmChan::InvalidateFastForward()
+	{
+		settled = false;
 	}
 
 #pragma region "DPCM Control"
@@ -52,11 +164,8 @@ namespace APUSim
 		TriState ACLK1 = apu->wire.ACLK1;
 		TriState W4010 = apu->wire.W4010;
 
-		for (size_t n = 0; n < 4; n++)
-		{
-			freq_reg[n].sim(ACLK1, W4010, apu->GetDBBit(n));
-			Fx[n] = freq_reg[n].get();
-		}
+		freq_reg.sim(ACLK1, W4010, apu->DB);
+		UnpackNibble((uint8_t)freq_reg.get(), Fx);
 
 		loop_reg.sim(ACLK1, W4010, apu->GetDBBit(6));
 		LOOPMode = loop_reg.get();
@@ -262,15 +371,17 @@ namespace APUSim
 		return out_latch.nget();
 	}
 
+	uint8_t DPCM_LFSRBit::get_state()
+	{
+		return (uint8_t)((in_latch.get() & 3) | ((out_latch.get() & 3) << 2));
+	}
+
 	void DpcmChan::sim_SampleCounterReg()
 	{
 		TriState ACLK1 = apu->wire.ACLK1;
 		TriState W4013 = apu->wire.W4013;
 
-		for (size_t n = 0; n < 8; n++)
-		{
-			scnt_reg[n].sim(ACLK1, W4013, apu->GetDBBit(n));
-		}
+		scnt_reg.sim(ACLK1, W4013, apu->DB);
 	}
 
 	void DpcmChan::sim_SampleCounter()
@@ -278,14 +389,7 @@ namespace APUSim
 		TriState ACLK1 = apu->wire.ACLK1;
 		TriState RES = apu->wire.RES;
 
-		TriState carry = TriState::One;
-
-		for (size_t n = 0; n < 12; n++)
-		{
-			carry = scnt[n].sim(carry, RES, DSLOAD, DSSTEP, ACLK1, n < 4 ? TriState::Zero : scnt_reg[n - 4].get());
-		}
-
-		SOUT = carry;
+		SOUT = scnt.sim(TriState::One, RES, DSLOAD, DSSTEP, ACLK1, scnt_reg.get() << 4);
 	}
 
 	void DpcmChan::sim_SampleBitCounter()
@@ -293,12 +397,7 @@ namespace APUSim
 		TriState ACLK1 = apu->wire.ACLK1;
 		TriState RES = apu->wire.RES;
 
-		TriState carry = TriState::One;
-
-		for (size_t n = 0; n < 3; n++)
-		{
-			carry = sbcnt[n].sim(carry, RES, RES, NSTEP, ACLK1, TriState::Zero);
-		}
+		TriState carry = sbcnt.sim(TriState::One, RES, RES, NSTEP, ACLK1, 0);
 
 		nout_latch.set(carry, ACLK1);
 		n_NOUT = nout_latch.nget();
@@ -309,16 +408,14 @@ namespace APUSim
 		TriState ACLK1 = apu->wire.ACLK1;
 		TriState RES = apu->wire.RES;
 
-		for (size_t n = 0; n < 8; n++)
-		{
-			buf_reg[n].sim(ACLK1, PCM, apu->GetDBBit(n));
-		}
+		buf_reg.sim(ACLK1, PCM, apu->DB);
+		uint32_t n_buf = ~buf_reg.get();
 
 		TriState shift_in = TriState::Zero;
 
 		for (int n = 7; n >= 0; n--)
 		{
-			shift_reg[n].sim(ACLK1, RES, BLOAD, BSTEP, buf_reg[n].nget(), shift_in);
+			shift_reg[n].sim(ACLK1, RES, BLOAD, BSTEP, FromByte((n_buf >> n) & 1), shift_in);
 			shift_in = shift_reg[n].get_sout();
 		}
 
@@ -344,6 +441,11 @@ namespace APUSim
 		return out_latch.nget();
 	}
 
+	uint8_t DPCM_SRBit::get_state()
+	{
+		return (uint8_t)((in_latch.get() & 3) | ((out_latch.get() & 3) << 2));
+	}
+
 #pragma endregion "DPCM Sampling"
 
 #pragma region "DPCM Addressing & Output"
@@ -353,10 +455,7 @@ namespace APUSim
 		TriState ACLK1 = apu->wire.ACLK1;
 		TriState W4012 = apu->wire.W4012;
 
-		for (size_t n = 0; n < 8; n++)
-		{
-			addr_reg[n].sim(ACLK1, W4012, apu->GetDBBit(n));
-		}
+		addr_reg.sim(ACLK1, W4012, apu->DB);
 	}
 
 	void DpcmChan::sim_AddressCounter()
@@ -364,28 +463,14 @@ namespace APUSim
 		TriState ACLK1 = apu->wire.ACLK1;
 		TriState RES = apu->wire.RES;
 
-		TriState carry = TriState::One;
+		// The sample address is %11AAAAAA.AA000000
 
-		for (size_t n = 0; n < 8; n++)
-		{
-			carry = addr_lo[n].sim(carry, RES, DSLOAD, DSSTEP, ACLK1, n < 6 ? TriState::Zero : addr_reg[n - 6].get());
-		}
+		uint32_t addr = addr_reg.get();
 
-		for (size_t n = 0; n < 7; n++)
-		{
-			carry = addr_hi[n].sim(carry, RES, DSLOAD, DSSTEP, ACLK1, n < 6 ? addr_reg[n + 2].get() : TriState::One);
-		}
+		TriState carry = addr_lo.sim(TriState::One, RES, DSLOAD, DSSTEP, ACLK1, (addr & 3) << 6);
+		addr_hi.sim(carry, RES, DSLOAD, DSSTEP, ACLK1, (addr >> 2) | 0x40);
 
-		apu->DMC_Addr = 0;
-		for (size_t n = 0; n < 8; n++)
-		{
-			apu->DMC_Addr |= (addr_lo[n].get() == TriState::One ? 1 : 0) << n;
-			if (n < 7)
-			{
-				apu->DMC_Addr |= (addr_hi[n].get() == TriState::One ? 1 : 0) << (8 + n);
-			}
-		}
-		apu->DMC_Addr |= 0x8000;
+		apu->DMC_Addr = (uint16_t)(addr_lo.get() | (addr_hi.get() << 8) | 0x8000);
 	}
 
 	void DpcmChan::sim_Output()
@@ -395,21 +480,15 @@ namespace APUSim
 		TriState W4011 = apu->wire.W4011;
 		TriState CountDown = n_BOUT;
 
-		TriState carry = TriState::One;
-
-		for (size_t n = 0; n < 6; n++)
-		{
-			carry = out_cnt[n].sim(carry, CountDown, RES, W4011, DSTEP, ACLK1, apu->GetDBBit(n + 1));
-		}
-
-		DOUT = carry;
+		DOUT = out_cnt.sim(TriState::One, CountDown, RES, W4011, DSTEP, ACLK1, apu->DB >> 1);
 
 		out_reg.sim(ACLK1, W4011, apu->GetDBBit(0));
 
 		apu->DMC_Out[0] = out_reg.get();
+		uint32_t out = out_cnt.get();
 		for (size_t n = 0; n < 6; n++)
 		{
-			apu->DMC_Out[n + 1] = out_cnt[n].get();
+			apu->DMC_Out[n + 1] = FromByte((out >> n) & 1);
 		}
 	}
 
@@ -419,189 +498,92 @@ namespace APUSim
 
 	uint32_t DpcmChan::Get_FreqReg()
 	{
-		TriState val_lo[8]{};
-		for (size_t n = 0; n < 4; n++)
-		{
-			val_lo[n] = freq_reg[n].get();
-		}
-		return PackNibble(val_lo);
+		return freq_reg.get();
 	}
 
 	uint32_t DpcmChan::Get_SampleReg()
 	{
-		TriState val_lo[8]{};
-		for (size_t n = 0; n < 8; n++)
-		{
-			val_lo[n] = scnt_reg[n].get();
-		}
-		return Pack(val_lo);
+		return scnt_reg.get();
 	}
 
 	uint32_t DpcmChan::Get_SampleCounter()
 	{
-		TriState val_lo[8]{};
-		TriState val_hi[8]{};
-		for (size_t n = 0; n < 8; n++)
-		{
-			val_lo[n] = scnt[n].get();
-		}
-		for (size_t n = 0; n < 4; n++)
-		{
-			val_hi[n] = scnt[n + 8].get();
-		}
-		return Pack(val_lo) | ((uint32_t)PackNibble(val_hi) << 8);
+		return scnt.get();
 	}
 
 	uint32_t DpcmChan::Get_SampleBuffer()
 	{
-		TriState val_lo[8]{};
-		for (size_t n = 0; n < 8; n++)
-		{
-			val_lo[n] = buf_reg[n].get();
-		}
-		return Pack(val_lo);
+		return buf_reg.get();
 	}
 
 	uint32_t DpcmChan::Get_SampleBitCounter()
 	{
-		TriState val_lo[8]{};
-		for (size_t n = 0; n < 3; n++)
-		{
-			val_lo[n] = sbcnt[n].get();
-		}
-		val_lo[3] = TriState::Zero;
-		return PackNibble(val_lo);
+		return sbcnt.get();
 	}
 
 	uint32_t DpcmChan::Get_AddressReg()
 	{
-		TriState val_lo[8]{};
-		for (size_t n = 0; n < 8; n++)
-		{
-			val_lo[n] = addr_reg[n].get();
-		}
-		return Pack(val_lo);
+		return addr_reg.get();
 	}
 
 	uint32_t DpcmChan::Get_AddressCounter()
 	{
-		TriState val_lo[8]{};
-		TriState val_hi[8]{};
-		for (size_t n = 0; n < 8; n++)
-		{
-			val_lo[n] = addr_lo[n].get();
-		}
-		for (size_t n = 0; n < 7; n++)
-		{
-			val_hi[n] = addr_hi[n].get();
-		}
-		val_hi[7] = TriState::One;
-		return Pack(val_lo) | ((uint32_t)Pack(val_hi) << 8);
+		return addr_lo.get() | (addr_hi.get() << 8) | 0x8000;
 	}
 
 	uint32_t DpcmChan::Get_Output()
 	{
-		TriState val_lo[8]{};
-		val_lo[0] = out_reg.get();
-		for (size_t n = 0; n < 6; n++)
-		{
-			val_lo[n + 1] = out_cnt[n].get();
-		}
-		val_lo[7] = TriState::Zero;
-		return Pack(val_lo);
+		return (out_reg.get() == TriState::One ? 1 : 0) | (out_cnt.get() << 1);
 	}
 
 	void DpcmChan::Set_FreqReg(uint32_t value)
 	{
-		TriState val_lo[8]{};
-		UnpackNibble(value, val_lo);
-		for (size_t n = 0; n < 4; n++)
-		{
-			freq_reg[n].set(val_lo[n]);
-		}
+		settled = false;
+		freq_reg.set(value);
 	}
 
 	void DpcmChan::Set_SampleReg(uint32_t value)
 	{
-		TriState val_lo[8]{};
-		Unpack(value, val_lo);
-		for (size_t n = 0; n < 8; n++)
-		{
-			scnt_reg[n].set(val_lo[n]);
-		}
+		settled = false;
+		scnt_reg.set(value);
 	}
 
 	void DpcmChan::Set_SampleCounter(uint32_t value)
 	{
-		TriState val_lo[8]{};
-		TriState val_hi[8]{};
-		Unpack(value, val_lo);
-		UnpackNibble(value >> 8, val_hi);
-		for (size_t n = 0; n < 8; n++)
-		{
-			scnt[n].set(val_lo[n]);
-		}
-		for (size_t n = 0; n < 4; n++)
-		{
-			scnt[n + 8].set(val_hi[n]);
-		}
+		settled = false;
+		scnt.set(value);
 	}
 
 	void DpcmChan::Set_SampleBuffer(uint32_t value)
 	{
-		TriState val_lo[8]{};
-		Unpack(value, val_lo);
-		for (size_t n = 0; n < 8; n++)
-		{
-			buf_reg[n].set(val_lo[n]);
-		}
+		settled = false;
+		buf_reg.set(value);
 	}
 
 	void DpcmChan::Set_SampleBitCounter(uint32_t value)
 	{
-		TriState val_lo[8]{};
-		UnpackNibble(value, val_lo);
-		for (size_t n = 0; n < 3; n++)
-		{
-			sbcnt[n].set(val_lo[n]);
-		}
+		settled = false;
+		sbcnt.set(value);
 	}
 
 	void DpcmChan::Set_AddressReg(uint32_t value)
 	{
-		TriState val_lo[8]{};
-		Unpack(value, val_lo);
-		for (size_t n = 0; n < 8; n++)
-		{
-			addr_reg[n].set(val_lo[n]);
-		}
+		settled = false;
+		addr_reg.set(value);
 	}
 
 	void DpcmChan::Set_AddressCounter(uint32_t value)
 	{
-		TriState val_lo[8]{};
-		TriState val_hi[8]{};
-		Unpack(value, val_lo);
-		Unpack(value >> 8, val_hi);
-		for (size_t n = 0; n < 8; n++)
-		{
-			addr_lo[n].set(val_lo[n]);
-		}
-		for (size_t n = 0; n < 7; n++)
-		{
-			addr_hi[n].set(val_hi[n]);
-		}
+		settled = false;
+		addr_lo.set(value);
+		addr_hi.set(value >> 8);
 	}
 
 	void DpcmChan::Set_Output(uint32_t value)
 	{
-		TriState val_lo[8]{};
-		Unpack(value, val_lo);
-		out_reg.set(val_lo[0]);
-		for (size_t n = 0; n < 6; n++)
-		{
-			out_cnt[n].set(val_lo[n + 1]);
-		}
+		settled = false;
+		out_reg.set(FromByte(value & 1));
+		out_cnt.set(value >> 1);
 	}
 
 	bool DpcmChan::GetDpcmEnable()
@@ -611,6 +593,7 @@ namespace APUSim
 
 	void DpcmChan::SetDpcmEnable(bool enable)
 	{
+		settled = false;
 		ena_ff.set(enable ? TriState::One : TriState::Zero);
 	}
 
@@ -12,6 +12,7 @@ namespace APUSim
 	public:
 		void sim(BaseLogic::TriState ACLK1, BaseLogic::TriState load, BaseLogic::TriState step, BaseLogic::TriState val, BaseLogic::TriState shift_in);
 		BaseLogic::TriState get_sout();
+		uint8_t get_state();
 	};
 
 	class DPCM_SRBit
@@ -22,6 +23,20 @@ namespace APUSim
 	public:
 		void sim(BaseLogic::TriState ACLK1, BaseLogic::TriState clear, BaseLogic::TriState load, BaseLogic::TriState step, BaseLogic::TriState n_val, BaseLogic::TriState shift_in);
 		BaseLogic::TriState get_sout();
+		uint8_t get_state();
+	};
+
+	/// <summary>
+	/// The channel state compared by the fast-forward. The fields are filled one by one in DpcmChan::PackState, a new member of the channel must be added there.
+	/// </summary>
+	struct DpcmState
+	{
+		uint32_t regs[4];				// freq_reg, scnt_reg, buf_reg, addr_reg
+		uint32_t counters[5][2];		// scnt, sbcnt, addr_lo, addr_hi, out_cnt: value and cg latches
+		BaseLogic::TriState wires[50];
+		BaseLogic::TriState latches[21];
+		uint8_t lfsr[9];
+		uint8_t shift_reg[8];
 	};
 
 	class DpcmChan
@@ -30,6 +45,18 @@ namespace APUSim
 
 		APU* apu = nullptr;
 
+		// Fast-forward. The channel state depends only on its previous state and a few input wires,
+		// so when an evaluation left the state unchanged, repeating it with the same inputs is a no-op.
+
+		bool FastForward = true;
+		bool settled = false;
+		uint64_t settled_inputs = 0;
+		DpcmState state_snapshot{};
+
+		uint64_t PackInputs();
+		void PackState(DpcmState& state);
+		bool SameState(DpcmState& a, DpcmState& b);
+
 		BaseLogic::TriState LOOPMode = BaseLogic::TriState::X;	// 1: DPCM looped playback
 		BaseLogic::TriState n_IRQEN = BaseLogic::TriState::X;	// 0: Enable interrupt from DPCM
 		BaseLogic::TriState DSLOAD = BaseLogic::TriState::X;	// Load value into Sample Counter and simultaneously into DPCM Address Counter
@@ -76,19 +103,19 @@ namespace APUSim
 		BaseLogic::DLatch pcm_latch{};
 		BaseLogic::DLatch nout_latch{};
 
-		RegisterBit freq_reg[4]{};
+		RegisterWord freq_reg{ 4 };
 		RegisterBit loop_reg{};
 		RegisterBit irq_reg{};
 		DPCM_LFSRBit lfsr[9]{};
-		RegisterBit scnt_reg[8]{};
-		DownCounterBit scnt[12]{};
-		CounterBit sbcnt[3]{};
-		RegisterBit buf_reg[8]{};
+		RegisterWord scnt_reg{ 8 };
+		DownCounterWord scnt{ 12 };
+		CounterWord sbcnt{ 3 };
+		RegisterWord buf_reg{ 8 };
 		DPCM_SRBit shift_reg[8]{};
-		RegisterBit addr_reg[8]{};
-		CounterBit addr_lo[8]{};
-		CounterBit addr_hi[7]{};
-		RevCounterBit out_cnt[6]{};
+		RegisterWord addr_reg{ 8 };
+		CounterWord addr_lo{ 8 };
+		CounterWord addr_hi{ 7 };
+		RevCounterWord out_cnt{ 6 };
 		RegisterBit out_reg{};
 
 		void sim_ControlReg();
@@ -140,5 +167,8 @@ namespace APUSim
 
 		bool GetDpcmEnable();
 		void SetDpcmEnable(bool enable);
+
+		void EnableFastForward(bool enable);
+		void InvalidateFastForward();
 	};
 }
@@ -36,16 +36,9 @@ namespace APUSim
 		envdis_reg.sim(ACLK1, WR_Reg, apu->GetDBBit(4));
 		lc_reg.sim(ACLK1, WR_Reg, apu->GetDBBit(5));
 
-		TriState RCO{};
-		TriState ECO{};
-		RCO = TriState::One;
-		ECO = TriState::One;
-		for (size_t n = 0; n < 4; n++)
-		{
-			vol_reg[n].sim(ACLK1, WR_Reg, apu->GetDBBit(n));
-			RCO = decay_cnt[n].sim(RCO, RES, RLOAD, RSTEP, ACLK1, vol_reg[n].get());
-			ECO = env_cnt[n].sim(ECO, RES, ERES, ESTEP, ACLK1, EIN);
-		}
+		vol_reg.sim(ACLK1, WR_Reg, apu->DB);
+		TriState RCO = decay_cnt.sim(TriState::One, RES, RLOAD, RSTEP, ACLK1, vol_reg.get());
+		TriState ECO = env_cnt.sim(TriState::One, RES, ERES, ESTEP, ACLK1, EIN == TriState::One ? 0xf : 0);
 
 		EnvReload.set(NOR(NOR(EnvReload.get(), NOR(n_LFO1, erld_latch.get())), WR_LC));
 		TriState RELOAD = EnvReload.nget();
@@ -56,10 +49,7 @@ namespace APUSim
 		eco_latch.set(AND(ECO, NOT(RELOAD)), ACLK1);
 
 		TriState ENVDIS = envdis_reg.get();
-		for (size_t n = 0; n < 4; n++)
-		{
-			V[n] = MUX(ENVDIS, env_cnt[n].get(), vol_reg[n].get());
-		}
+		UnpackNibble(ENVDIS == TriState::One ? vol_reg.get() : env_cnt.get(), V);
 	}
 
 	TriState EnvelopeUnit::get_LC()
@@ -76,61 +66,31 @@ namespace APUSim
 
 	uint32_t EnvelopeUnit::Debug_Get_VolumeReg()
 	{
-		TriState val[4]{};
-		for (size_t n = 0; n < 4; n++)
-		{
-			val[n] = vol_reg[n].get();
-		}
-		return PackNibble(val);
+		return vol_reg.get();
 	}
 
 	uint32_t EnvelopeUnit::Debug_Get_DecayCounter()
 	{
-		TriState val[4]{};
-		for (size_t n = 0; n < 4; n++)
-		{
-			val[n] = decay_cnt[n].get();
-		}
-		return PackNibble(val);
+		return decay_cnt.get();
 	}
 
 	uint32_t EnvelopeUnit::Debug_Get_EnvCounter()
 	{
-		TriState val[4]{};
-		for (size_t n = 0; n < 4; n++)
-		{
-			val[n] = env_cnt[n].get();
-		}
-		return PackNibble(val);
+		return env_cnt.get();
 	}
 
 	void EnvelopeUnit::Debug_Set_VolumeReg(uint32_t val)
 	{
-		TriState unpacked[4]{};
-		UnpackNibble(val, unpacked);
-		for (size_t n = 0; n < 4; n++)
-		{
-			vol_reg[n].set(unpacked[n]);
-		}
+		vol_reg.set(val);
 	}
 
 	void EnvelopeUnit::Debug_Set_DecayCounter(uint32_t val)
 	{
-		TriState unpacked[4]{};
-		UnpackNibble(val, unpacked);
-		for (size_t n = 0; n < 4; n++)
-		{
-			decay_cnt[n].set(unpacked[n]);
-		}
+		decay_cnt.set(val);
 	}
 
 	void EnvelopeUnit::Debug_Set_EnvCounter(uint32_t val)
 	{
-		TriState unpacked[4]{};
-		UnpackNibble(val, unpacked);
-		for (size_t n = 0; n < 4; n++)
-		{
-			env_cnt[n].set(unpacked[n]);
-		}
+		env_cnt.set(val);
 	}
 }
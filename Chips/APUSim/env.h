@@ -12,9 +12,9 @@ namespace APUSim
 
 		RegisterBit envdis_reg{};
 		RegisterBit lc_reg{};
-		RegisterBit vol_reg[4]{};
-		DownCounterBit decay_cnt[4]{};
-		DownCounterBit env_cnt[4]{};
+		RegisterWord vol_reg{ 4 };
+		DownCounterWord decay_cnt{ 4 };
+		DownCounterWord env_cnt{ 4 };
 		BaseLogic::FF EnvReload{};
 		BaseLogic::DLatch erld_latch{};
 		BaseLogic::DLatch reload_latch{};
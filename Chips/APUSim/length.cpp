@@ -149,39 +149,20 @@ namespace APUSim
 	{
 		TriState ACLK1 = apu->wire.ACLK1;
 		TriState RES = apu->wire.RES;
-		TriState carry = LC_CarryIn;
 
-		for (size_t n = 0; n < 8; n++)
-		{
-			carry = cnt[n].sim(carry, RES, WriteEn, STEP, ACLK1, LC[n]);
-		}
-
-		carry_out = carry;
+		carry_out = cnt.sim(LC_CarryIn, RES, WriteEn, STEP, ACLK1, Pack(LC));
 	}
 
 #pragma region "Debug"
 
 	uint8_t LengthCounter::Debug_GetCnt()
 	{
-		TriState cnt_out[8]{};
-
-		for (size_t n = 0; n < 8; n++)
-		{
-			cnt_out[n] = cnt[n].get();
-		}
-
-		return Pack(cnt_out);
+		return (uint8_t)cnt.get();
 	}
 
 	void LengthCounter::Debug_SetCnt(uint8_t value)
 	{
-		TriState cnt_out[8]{};
-		Unpack(value, cnt_out);
-
-		for (size_t n = 0; n < 8; n++)
-		{
-			cnt[n].set(cnt_out[n]);
-		}
+		cnt.set(value);
 	}
 
 	bool LengthCounter::Debug_GetEnable()
@@ -20,7 +20,7 @@ namespace APUSim
 		BaseLogic::TriState Dec1_out[32]{};
 
 		BaseLogic::TriState LC[8]{};
-		DownCounterBit cnt[8]{};
+		DownCounterWord cnt{ 8 };
 		BaseLogic::TriState carry_out{};
 
 		void sim_Control(size_t bit_ena, BaseLogic::TriState WriteEn, BaseLogic::TriState& LC_NoCount);
@@ -9,12 +9,11 @@ namespace APUSim
 	NoiseChan::NoiseChan(APU* parent)
 	{
 		apu = parent;
-		env_unit = new EnvelopeUnit(apu);
+		env_unit = apu->arena.New<EnvelopeUnit>(apu);
 	}
 
 	NoiseChan::~NoiseChan()
 	{
-		delete env_unit;
 	}
 
 	void NoiseChan::sim()
@@ -38,10 +37,7 @@ namespace APUSim
 		TriState W400E = apu->wire.W400E;
 		TriState RES = apu->wire.RES;
 
-		for (size_t n = 0; n < 4; n++)
-		{
-			freq_reg[n].sim(ACLK1, W400E, apu->GetDBBit(n), RES);
-		}
+		freq_reg.sim(ACLK1, W400E, apu->DB, RES);
 	}
 
 	void NoiseChan::sim_Decoder1()
@@ -49,10 +45,10 @@ namespace APUSim
 		TriState F[4]{};
 		TriState nF[4]{};
 
+		UnpackNibble((uint8_t)freq_reg.get(), F);
 		for (size_t n = 0; n < 4; n++)
 		{
-			F[n] = freq_reg[n].get();
-			nF[n] = NOT(freq_reg[n].get());
+			nF[n] = NOT(F[n]);
 		}
 
 		sim_Decoder1_Calc(F, nF);
@@ -188,23 +184,12 @@ namespace APUSim
 
 	uint32_t NoiseChan::Get_FreqReg()
 	{
-		TriState val[4]{};
-
-		for (size_t n = 0; n < 4; n++)
-		{
-			val[n] = freq_reg[n].get();
-		}
-		return PackNibble(val);
+		return freq_reg.get();
 	}
 
 	void NoiseChan::Set_FreqReg(uint32_t value)
 	{
-		TriState val[4]{};
-		UnpackNibble(value, val);
-		for (size_t n = 0; n < 4; n++)
-		{
-			freq_reg[n].set(val[n]);
-		}
+		freq_reg.set(value);
 	}
 
 #pragma endregion "Debug"
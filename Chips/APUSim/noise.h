@@ -37,7 +37,7 @@ namespace APUSim
 		BaseLogic::TriState Vol[4]{};
 		BaseLogic::TriState Dec1_out[16]{};
 
-		RegisterBitRes freq_reg[4]{};
+		RegisterResWord freq_reg{ 4 };
 		FreqLFSRBit freq_lfsr[11]{};
 		RegisterBit rmod_reg{};
 		RandomLFSRBit rnd_lfsr[15]{};
@@ -15,46 +15,54 @@ namespace APUSim
 	{
 	}
 
-	void Pads::sim_InputPads(TriState inputs[])
+	void Pads::sim_InputPads(Pins32& inputs)
 	{
-		apu->wire.n_CLK = NOT(inputs[(size_t)APU_Input::CLK]);
-		apu->wire.DBG = inputs[(size_t)APU_Input::DBG];
-		apu->wire.RES = NOT(inputs[(size_t)APU_Input::n_RES]);
+		apu->wire.n_CLK = NOT(inputs.get((size_t)APU_Input::CLK));
+		apu->wire.DBG = inputs.get((size_t)APU_Input::DBG);
+		apu->wire.RES = NOT(inputs.get((size_t)APU_Input::n_RES));
 		
 		// In the original #NMI and #IRQ terminals overuse the BIDIR terminal circuit.
 		// In order to avoid all sorts of gimmicks, let's just do a pass-through.
 
-		apu->wire.n_NMI = inputs[(size_t)APU_Input::n_NMI];
+		apu->wire.n_NMI = inputs.get((size_t)APU_Input::n_NMI);
 		//n_nmi.sim(inputs[(size_t)APU_Input::n_NMI], TriState::One,
 		//	apu->wire.n_NMI, unused, TriState::One, TriState::Zero);
 
-		apu->wire.n_IRQ = inputs[(size_t)APU_Input::n_IRQ];
+		apu->wire.n_IRQ = inputs.get((size_t)APU_Input::n_IRQ);
 		//n_irq.sim(inputs[(size_t)APU_Input::n_IRQ], TriState::One,
 		//	apu->wire.n_IRQ, unused, TriState::One, TriState::Zero);
 	}
 
-	void Pads::sim_OutputPads(TriState outputs[], uint16_t* addr)
+	void Pads::sim_OutputPads(Pins32& outputs, uint16_t* addr)
 	{
 		TriState NotDBG_RES = NOR(apu->wire.DBG, NOT(apu->wire.RES));
-		outputs[(size_t)APU_Output::M2] = NOT(NotDBG_RES) == TriState::One ? NOR(apu->wire.n_M2, NotDBG_RES) : TriState::Z;
+		outputs.set((size_t)APU_Output::M2, NOT(NotDBG_RES) == TriState::One ? NOR(apu->wire.n_M2, NotDBG_RES) : TriState::Z);
 
 		if (apu->wire.RES == TriState::Zero)
 		{
 			*addr = apu->Ax;
 		}
 
-		outputs[(size_t)APU_Output::RnW] = NOT(apu->wire.RES) == TriState::One ? NOT(NOR(apu->wire.RW, apu->wire.RES)) : TriState::Z;
+		outputs.set((size_t)APU_Output::RnW, NOT(apu->wire.RES) == TriState::One ? NOT(NOR(apu->wire.RW, apu->wire.RES)) : TriState::Z);
 
 		// I/O
 
 		sim_OutReg();
 
-		n_in[0].sim(unused, apu->wire.n_R4016, unused, outputs[(size_t)APU_Output::n_IN0], apu->wire.RES, TriState::One);
-		n_in[1].sim(unused, apu->wire.n_R4017, unused, outputs[(size_t)APU_Output::n_IN1], apu->wire.RES, TriState::One);
+		TriState pad_out[5]{};
 
-		out[0].sim(unused, OUT_Signal[0], unused, outputs[(size_t)APU_Output::OUT_0], apu->wire.RES, TriState::One);
-		out[1].sim(unused, OUT_Signal[1], unused, outputs[(size_t)APU_Output::OUT_1], apu->wire.RES, TriState::One);
-		out[2].sim(unused, OUT_Signal[2], unused, outputs[(size_t)APU_Output::OUT_2], apu->wire.RES, TriState::One);
+		n_in[0].sim(unused, apu->wire.n_R4016, unused, pad_out[0], apu->wire.RES, TriState::One);
+		n_in[1].sim(unused, apu->wire.n_R4017, unused, pad_out[1], apu->wire.RES, TriState::One);
+
+		out[0].sim(unused, OUT_Signal[0], unused, pad_out[2], apu->wire.RES, TriState::One);
+		out[1].sim(unused, OUT_Signal[1], unused, pad_out[3], apu->wire.RES, TriState::One);
+		out[2].sim(unused, OUT_Signal[2], unused, pad_out[4], apu->wire.RES, TriState::One);
+
+		outputs.set((size_t)APU_Output::n_IN0, pad_out[0]);
+		outputs.set((size_t)APU_Output::n_IN1, pad_out[1]);
+		outputs.set((size_t)APU_Output::OUT_0, pad_out[2]);
+		outputs.set((size_t)APU_Output::OUT_1, pad_out[3]);
+		outputs.set((size_t)APU_Output::OUT_2, pad_out[4]);
 	}
 
 	/// <summary>
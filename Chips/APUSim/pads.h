@@ -47,8 +47,8 @@ namespace APUSim
 		Pads(APU* parent);
 		~Pads();
 
-		void sim_InputPads(BaseLogic::TriState inputs[]);
-		void sim_OutputPads(BaseLogic::TriState outputs[], uint16_t* addr);
+		void sim_InputPads(BaseLogic::Pins32& inputs);
+		void sim_OutputPads(BaseLogic::Pins32& outputs, uint16_t* addr);
 
 		void sim_DataBusInput(uint8_t* data);
 		void sim_DataBusOutput(uint8_t* data);
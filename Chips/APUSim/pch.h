@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <cstddef>
 #include <cstdio>
+#include <cstring>
 
 #include "../../Common/BaseLogicLib/BaseLogic.h"
 #include "../../Chips/M6502Core/core.h"
@@ -10,12 +10,11 @@ namespace APUSim
 	{
 		apu = parent;
 		cin_type = carry_routing;
-		env_unit = new EnvelopeUnit(apu);
+		env_unit = apu->arena.New<EnvelopeUnit>(apu);
 	}
 
 	SquareChan::~SquareChan()
 	{
-		delete env_unit;
 	}
 
 	void SquareChan::sim(TriState WR0, TriState WR1, TriState WR2, TriState WR3, TriState NOSQ, TriState* SQ_Out)
@@ -44,33 +43,36 @@ namespace APUSim
 
 		TriState ACLK3 = NOT(nACLK2);
 
+		uint32_t WR = (WR2 == TriState::One ? 0xff : 0) | (WR3 == TriState::One ? 0x700 : 0);
+		uint32_t DB_in = apu->DB | ((uint32_t)(apu->DB & 7) << 8);
+
+		uint32_t sum = 0;
 		for (size_t n = 0; n < 11; n++)
 		{
-			freq_reg[n].sim(ACLK3, ACLK1,
-				n < 8 ? WR2 : WR3,
-				n < 8 ? apu->GetDBBit(n) : apu->GetDBBit(n - 8), DO_SWEEP, n_sum[n]);
+			sum |= (uint32_t)(n_sum[n] & 1) << n;
 		}
+
+		freq_reg.sim(ACLK3, ACLK1, WR, DB_in, DO_SWEEP, sum);
 	}
 
 	void SquareChan::sim_ShiftReg(TriState WR1)
 	{
 		TriState ACLK1 = apu->wire.ACLK1;
 
-		for (size_t n = 0; n < 3; n++)
-		{
-			sr_reg[n].sim(ACLK1, WR1, apu->GetDBBit(n));
-			SR[n] = sr_reg[n].get();
-		}
+		sr_reg.sim(ACLK1, WR1, apu->DB);
+		Unpack3((uint8_t)sr_reg.get(), SR);
 	}
 
 	void SquareChan::sim_BarrelShifter()
 	{
 		TriState q1[11]{};
 		TriState q2[11]{};
+		uint32_t Fx = freq_reg.get_Fx(DO_SWEEP);
+		uint32_t nFx = freq_reg.get_nFx(DO_SWEEP);
 
 		for (size_t n = 0; n < 11; n++)
 		{
-			BS[n] = MUX(DEC, freq_reg[n].get_Fx(DO_SWEEP), freq_reg[n].get_nFx(DO_SWEEP));
+			BS[n] = MUX(DEC, FromByte((Fx >> n) & 1), FromByte((nFx >> n) & 1));
 		}
 		BS[11] = DEC;
 
@@ -95,11 +97,13 @@ namespace APUSim
 		TriState n_carry = cin_type == SquareChanCarryIn::Vdd ? TriState::One : INC;
 		TriState carry = NOT(n_carry);
 		TriState Fx[11]{};
+		uint32_t Fx_word = freq_reg.get_Fx(DO_SWEEP);
+		uint32_t nFx_word = freq_reg.get_nFx(DO_SWEEP);
 
 		for (size_t n = 0; n < 11; n++)
 		{
-			Fx[n] = freq_reg[n].get_Fx(DO_SWEEP);
-			adder[n].sim(Fx[n], freq_reg[n].get_nFx(DO_SWEEP),
+			Fx[n] = FromByte((Fx_word >> n) & 1);
+			adder[n].sim(Fx[n], FromByte((nFx_word >> n) & 1),
 				S[n], NOT(S[n]),
 				carry, n_carry,
 				carry, n_carry, n_sum[n]);
@@ -118,14 +122,9 @@ namespace APUSim
 		FLOAD = NOR(nACLK2, fco_latch.nget());
 		TriState FSTEP = NOR(nACLK2, NOT(fco_latch.nget()));
 
-		TriState carry = TriState::One;
+		uint32_t Fx = freq_reg.get_Fx(DO_SWEEP);
 
-		for (size_t n = 0; n < 11; n++)
-		{
-			carry = freq_cnt[n].sim(carry, RES, FLOAD, FSTEP, ACLK1, freq_reg[n].get_Fx(DO_SWEEP));
-		}
-
-		FCO = carry;
+		FCO = freq_cnt.sim(TriState::One, RES, FLOAD, FSTEP, ACLK1, Fx);
 		fco_latch.set(FCO, ACLK1);
 	}
 
@@ -141,21 +140,13 @@ namespace APUSim
 		swdis_reg.sim(ACLK1, WR1, apu->GetDBBit(7));
 		TriState SWDIS = swdis_reg.nget();
 
-		for (size_t n = 0; n < 3; n++)
-		{
-			sweep_reg[n].sim(ACLK1, WR1, apu->GetDBBit(n + 4));
-		}
+		sweep_reg.sim(ACLK1, WR1, apu->DB >> 4);
 
 		TriState temp_reload = NOR(reload_latch.nget(), sco_latch.get());
 		TriState SSTEP = NOR(n_LFO2, NOT(temp_reload));
 		TriState SLOAD = NOR(n_LFO2, temp_reload);
 
-		TriState SCO{};
-		SCO = TriState::One;
-		for (size_t n = 0; n < 3; n++)
-		{
-			SCO = sweep_cnt[n].sim(SCO, RES, SLOAD, SSTEP, ACLK1, sweep_reg[n].get());
-		}
+		TriState SCO = sweep_cnt.sim(TriState::One, RES, SLOAD, SSTEP, ACLK1, sweep_reg.get());
 
 		sco_latch.set(SCO, ACLK1);
 
@@ -170,23 +161,14 @@ namespace APUSim
 		TriState RES = apu->wire.RES;
 		TriState DT[3]{};
 
-		for (size_t n = 0; n < 2; n++)
-		{
-			duty_reg[n].sim(ACLK1, WR0, apu->GetDBBit(n + 6));
-		}
+		duty_reg.sim(ACLK1, WR0, apu->DB >> 6);
 
-		TriState carry = FCO;
-		for (size_t n = 0; n < 3; n++)
-		{
-			carry = duty_cnt[n].sim(carry, RES, WR3, FLOAD, ACLK1, TriState::Zero);
-		}
-		DT[0] = duty_cnt[0].get();
-		DT[1] = duty_cnt[1].get();
-		DT[2] = duty_cnt[2].get();
+		duty_cnt.sim(FCO, RES, WR3, FLOAD, ACLK1, 0);
+		Unpack3((uint8_t)duty_cnt.get(), DT);
 
 		TriState sel[2]{};
-		sel[0] = duty_reg[0].get();
-		sel[1] = duty_reg[1].get();
+		sel[0] = FromByte(duty_reg.get() & 1);
+		sel[1] = FromByte((duty_reg.get() >> 1) & 1);
 
 		TriState in[4]{};
 		in[3] = NAND(DT[1], DT[2]);
@@ -239,6 +221,39 @@ namespace APUSim
 		transp_latch.set(value, TriState::One);
 	}
 
+	void FreqRegWord::sim(TriState ACLK3, TriState ACLK1, uint32_t WR, uint32_t DB_in, TriState ADDOUT, uint32_t n_sum_in)
+	{
+		// Without WR and ACLK3 the latch input is floating and the value is kept
+
+		uint32_t d = ACLK3 == TriState::One ? get_Fx(ADDOUT) : val;
+		val = ((DB_in & WR) | (d & ~WR)) & mask;
+
+		if (ACLK1 == TriState::One)
+		{
+			n_sum = n_sum_in & mask;
+		}
+	}
+
+	uint32_t FreqRegWord::get_nFx(TriState ADDOUT)
+	{
+		return (ADDOUT == TriState::One ? ~(~n_sum | val) : ~val) & mask;
+	}
+
+	uint32_t FreqRegWord::get_Fx(TriState ADDOUT)
+	{
+		return (ADDOUT == TriState::One ? ~n_sum : val) & mask;
+	}
+
+	uint32_t FreqRegWord::get()
+	{
+		return val;
+	}
+
+	void FreqRegWord::set(uint32_t value)
+	{
+		val = value & mask;
+	}
+
 	void AdderBit::sim(TriState F, TriState nF, TriState S, TriState nS, TriState C, TriState nC,
 		TriState& cout, TriState& n_cout, TriState& n_sum)
 	{
@@ -256,150 +271,62 @@ namespace APUSim
 
 	uint32_t SquareChan::Get_FreqReg()
 	{
-		TriState val[4]{};
-		TriState val_byte[8]{};
-		for (size_t n = 0; n < 8; n++)
-		{
-			val_byte[n] = freq_reg[n].get();
-		}
-		for (size_t n = 0; n < 3; n++)
-		{
-			val[n] = freq_reg[n + 8].get();
-		}
-		val[3] = TriState::Zero;
-		return Pack(val_byte) | ((uint32_t)PackNibble(val) << 8);
+		return freq_reg.get();
 	}
 
 	uint32_t SquareChan::Get_ShiftReg()
 	{
-		TriState val[4]{};
-		for (size_t n = 0; n < 3; n++)
-		{
-			val[n] = sr_reg[n].get();
-		}
-		val[3] = TriState::Zero;
-		return PackNibble(val);
+		return sr_reg.get();
 	}
 
 	uint32_t SquareChan::Get_FreqCounter()
 	{
-		TriState val[4]{};
-		TriState val_byte[8]{};
-		for (size_t n = 0; n < 8; n++)
-		{
-			val_byte[n] = freq_cnt[n].get();
-		}
-		for (size_t n = 0; n < 3; n++)
-		{
-			val[n] = freq_cnt[n + 8].get();
-		}
-		val[3] = TriState::Zero;
-		return Pack(val_byte) | ((uint32_t)PackNibble(val) << 8);
+		return freq_cnt.get();
 	}
 
 	uint32_t SquareChan::Get_SweepReg()
 	{
-		TriState val[4]{};
-		for (size_t n = 0; n < 3; n++)
-		{
-			val[n] = sweep_reg[n].get();
-		}
-		val[3] = TriState::Zero;
-		return PackNibble(val);
+		return sweep_reg.get();
 	}
 
 	uint32_t SquareChan::Get_SweepCounter()
 	{
-		TriState val[4]{};
-		for (size_t n = 0; n < 3; n++)
-		{
-			val[n] = sweep_cnt[n].get();
-		}
-		val[3] = TriState::Zero;
-		return PackNibble(val);
+		return sweep_cnt.get();
 	}
 
 	uint32_t SquareChan::Get_DutyCounter()
 	{
-		TriState val[4]{};
-		for (size_t n = 0; n < 3; n++)
-		{
-			val[n] = duty_cnt[n].get();
-		}
-		val[3] = TriState::Zero;
-		return PackNibble(val);
+		return duty_cnt.get();
 	}
 
 	void SquareChan::Set_FreqReg(uint32_t value)
 	{
-		TriState val[4]{};
-		TriState val_byte[8]{};
-		Unpack(value, val_byte);
-		UnpackNibble(value >> 8, val);
-		for (size_t n = 0; n < 8; n++)
-		{
-			freq_reg[n].set(val_byte[n]);
-		}
-		for (size_t n = 0; n < 3; n++)
-		{
-			freq_reg[n + 8].set(val[n]);
-		}
+		freq_reg.set(value);
 	}
 
 	void SquareChan::Set_ShiftReg(uint32_t value)
 	{
-		TriState val[4]{};
-		UnpackNibble(value, val);
-		for (size_t n = 0; n < 3; n++)
-		{
-			sr_reg[n].set(val[n]);
-		}
+		sr_reg.set(value);
 	}
 
 	void SquareChan::Set_FreqCounter(uint32_t value)
 	{
-		TriState val[4]{};
-		TriState val_byte[8]{};
-		Unpack(value, val_byte);
-		UnpackNibble(value >> 8, val);
-		for (size_t n = 0; n < 8; n++)
-		{
-			freq_cnt[n].set(val_byte[n]);
-		}
-		for (size_t n = 0; n < 3; n++)
-		{
-			freq_cnt[n + 8].set(val[n]);
-		}
+		freq_cnt.set(value);
 	}
 
 	void SquareChan::Set_SweepReg(uint32_t value)
 	{
-		TriState val[4]{};
-		UnpackNibble(value, val);
-		for (size_t n = 0; n < 3; n++)
-		{
-			sweep_reg[n].set(val[n]);
-		}
+		sweep_reg.set(value);
 	}
 
 	void SquareChan::Set_SweepCounter(uint32_t value)
 	{
-		TriState val[4]{};
-		UnpackNibble(value, val);
-		for (size_t n = 0; n < 3; n++)
-		{
-			sweep_cnt[n].set(val[n]);
-		}
+		sweep_cnt.set(value);
 	}
 
 	void SquareChan::Set_DutyCounter(uint32_t value)
 	{
-		TriState val[4]{};
-		UnpackNibble(value, val);
-		for (size_t n = 0; n < 3; n++)
-		{
-			duty_cnt[n].set(val[n]);
-		}
+		duty_cnt.set(value);
 	}
 
 #pragma endregion "Debug"
@@ -29,6 +29,24 @@ namespace APUSim
 		void set(BaseLogic::TriState value);
 	};
 
+	/// <summary>
+	/// Word-level version of the 11 FreqRegBit cells. `WR` is a mask of the bits written from `DB_in` (the low 8 bits by $4002/$4006, the high 3 bits by $4003/$4007).
+	/// Note that /Fx is not always the inverse of Fx: while ADDOUT = 1 it is NOR(sum, reg).
+	/// </summary>
+	class FreqRegWord
+	{
+		static const uint32_t mask = 0x7ff;
+		uint32_t val = 0;			// transp latches
+		uint32_t n_sum = 0;			// sum latches (inverted adder sum)
+
+	public:
+		void sim(BaseLogic::TriState ACLK3, BaseLogic::TriState ACLK1, uint32_t WR, uint32_t DB_in, BaseLogic::TriState ADDOUT, uint32_t n_sum_in);
+		uint32_t get_nFx(BaseLogic::TriState ADDOUT);
+		uint32_t get_Fx(BaseLogic::TriState ADDOUT);
+		uint32_t get();
+		void set(uint32_t value);
+	};
+
 	class AdderBit
 	{
 	public:
@@ -60,19 +78,19 @@ namespace APUSim
 		BaseLogic::TriState Vol[4]{};
 
 		RegisterBit dir_reg{};
-		FreqRegBit freq_reg[11]{};
-		RegisterBit sr_reg[3]{};
+		FreqRegWord freq_reg{};
+		RegisterWord sr_reg{ 3 };
 		AdderBit adder[11]{};
 		BaseLogic::DLatch fco_latch{};
-		DownCounterBit freq_cnt[11]{};
+		DownCounterWord freq_cnt{ 11 };
 		RegisterBit swdis_reg{};
 		BaseLogic::DLatch reload_latch{};
 		BaseLogic::DLatch sco_latch{};
 		BaseLogic::FF reload_ff{};
-		RegisterBit sweep_reg[3]{};
-		DownCounterBit sweep_cnt[3]{};
-		RegisterBit duty_reg[2]{};
-		DownCounterBit duty_cnt[3]{};
+		RegisterWord sweep_reg{ 3 };
+		DownCounterWord sweep_cnt{ 3 };
+		RegisterWord duty_reg{ 2 };
+		DownCounterWord duty_cnt{ 3 };
 		BaseLogic::DLatch sqo_latch{};
 
 		EnvelopeUnit* env_unit = nullptr;
@@ -54,10 +54,7 @@ namespace APUSim
 		TriState ACLK1 = apu->wire.ACLK1;
 		TriState W4008 = apu->wire.W4008;
 
-		for (size_t n = 0; n < 7; n++)
-		{
-			lin_reg[n].sim(ACLK1, W4008, apu->GetDBBit(n));
-		}
+		lin_reg.sim(ACLK1, W4008, apu->DB);
 	}
 
 	void TriangleChan::sim_LinearCounter()
@@ -65,14 +62,7 @@ namespace APUSim
 		TriState ACLK1 = apu->wire.ACLK1;
 		TriState RES = apu->wire.RES;
 
-		TriState carry = TriState::One;
-
-		for (size_t n = 0; n < 7; n++)
-		{
-			carry = lin_cnt[n].sim(carry, RES, LOAD, STEP, ACLK1, lin_reg[n].get());
-		}
-
-		TCO = carry;
+		TCO = lin_cnt.sim(TriState::One, RES, LOAD, STEP, ACLK1, lin_reg.get());
 	}
 
 	void TriangleChan::sim_FreqReg()
@@ -81,10 +71,12 @@ namespace APUSim
 		TriState W400A = apu->wire.W400A;
 		TriState W400B = apu->wire.W400B;
 
-		for (size_t n = 0; n < 11; n++)
-		{
-			freq_reg[n].sim(PHI1, n < 8 ? W400A : W400B, n < 8 ? apu->GetDBBit(n) : apu->GetDBBit(n - 8));
-		}
+		// The low and high parts of the register are written separately. The bits that are not written keep their value.
+
+		uint32_t val = freq_reg.get();
+		freq_reg.sim(PHI1, W400A, (val & ~0xff) | apu->DB);
+		val = freq_reg.get();
+		freq_reg.sim(PHI1, W400B, (val & 0xff) | ((uint32_t)apu->DB << 8));
 	}
 
 	void TriangleChan::sim_FreqCounter()
@@ -92,14 +84,10 @@ namespace APUSim
 		TriState PHI1 = apu->wire.PHI1;
 		TriState RES = apu->wire.RES;
 
-		TriState carry = TriState::One;
 		TriState FLOAD = NOR(PHI1, n_FOUT);
 		TriState FSTEP = NOR(PHI1, NOT(n_FOUT));
 
-		for (size_t n = 0; n < 11; n++)
-		{
-			carry = freq_cnt[n].sim(carry, RES, FLOAD, FSTEP, PHI1, freq_reg[n].get());
-		}
+		TriState carry = freq_cnt.sim(TriState::One, RES, FLOAD, FSTEP, PHI1, freq_reg.get());
 
 		fout_latch.set(carry, PHI1);
 	}
@@ -109,27 +97,15 @@ namespace APUSim
 		TriState PHI1 = apu->wire.PHI1;
 		TriState RES = apu->wire.RES;
 		TriState W401A = apu->wire.W401A;
-		TriState T[5]{};
-		TriState nT[5]{};
-
-		TriState carry{};
 
 		// The developers decided to use PHI1 for the triangle channel instead of ACLK to smooth out the "stepped" signal.
 
-		carry = TriState::One;
-		for (size_t n = 0; n < 5; n++)
-		{
-			carry = out_cnt[n].sim(carry, RES, W401A, TSTEP, PHI1 /* !!! */, apu->GetDBBit(n));
-		}
+		out_cnt.sim(TriState::One, RES, W401A, TSTEP, PHI1 /* !!! */, apu->DB);
 
-		TriState T4 = out_cnt[4].get();
+		uint32_t T = out_cnt.get();
+		uint32_t T4 = (T >> 4) & 1;
 
-		for (size_t n = 0; n < 4; n++)
-		{
-			T[n] = out_cnt[n].get();
-			nT[n] = out_cnt[n].nget();
-			apu->TRI_Out[n] = NOT(MUX(T4, T[n], nT[n]));
-		}
+		UnpackNibble((uint8_t)(T4 ? T : ~T), apu->TRI_Out);
 	}
 
 	TriState TriangleChan::get_LC()
@@ -141,131 +117,52 @@ namespace APUSim
 
 	uint32_t TriangleChan::Get_LinearReg()
 	{
-		TriState val_lo[8]{};
-		for (size_t n = 0; n < 7; n++)
-		{
-			val_lo[n] = lin_reg[n].get();
-		}
-		val_lo[7] = TriState::Zero;
-		return Pack(val_lo);
+		return lin_reg.get();
 	}
 
 	uint32_t TriangleChan::Get_LinearCounter()
 	{
-		TriState val_lo[8]{};
-		for (size_t n = 0; n < 7; n++)
-		{
-			val_lo[n] = lin_cnt[n].get();
-		}
-		val_lo[7] = TriState::Zero;
-		return Pack(val_lo);
+		return lin_cnt.get();
 	}
 
 	uint32_t TriangleChan::Get_FreqReg()
 	{
-		TriState val_lo[8]{};
-		TriState val_hi[4]{};
-		for (size_t n = 0; n < 8; n++)
-		{
-			val_lo[n] = freq_reg[n].get();
-		}
-		for (size_t n = 0; n < 3; n++)
-		{
-			val_hi[n] = freq_reg[n + 8].get();
-		}
-		val_hi[3] = TriState::Zero;
-		return Pack(val_lo) | ((uint32_t)PackNibble(val_hi) << 8);
+		return freq_reg.get();
 	}
 
 	uint32_t TriangleChan::Get_FreqCounter()
 	{
-		TriState val_lo[8]{};
-		TriState val_hi[4]{};
-		for (size_t n = 0; n < 8; n++)
-		{
-			val_lo[n] = freq_cnt[n].get();
-		}
-		for (size_t n = 0; n < 3; n++)
-		{
-			val_hi[n] = freq_cnt[n + 8].get();
-		}
-		val_hi[3] = TriState::Zero;
-		return Pack(val_lo) | ((uint32_t)PackNibble(val_hi) << 8);
+		return freq_cnt.get();
 	}
 
 	uint32_t TriangleChan::Get_OutputCounter()
 	{
-		TriState val_lo[8]{};
-		for (size_t n = 0; n < 5; n++)
-		{
-			val_lo[n] = out_cnt[n].get();
-		}
-		val_lo[5] = TriState::Zero;
-		val_lo[6] = TriState::Zero;
-		val_lo[7] = TriState::Zero;
-		return Pack(val_lo);
+		return out_cnt.get();
 	}
 
 	void TriangleChan::Set_LinearReg(uint32_t value)
 	{
-		TriState val_lo[8]{};
-		Unpack(value, val_lo);
-		for (size_t n = 0; n < 7; n++)
-		{
-			lin_reg[n].set(val_lo[n]);
-		}
+		lin_reg.set(value);
 	}
 
 	void TriangleChan::Set_LinearCounter(uint32_t value)
 	{
-		TriState val_lo[8]{};
-		Unpack(value, val_lo);
-		for (size_t n = 0; n < 7; n++)
-		{
-			lin_cnt[n].set(val_lo[n]);
-		}
+		lin_cnt.set(value);
 	}
 
 	void TriangleChan::Set_FreqReg(uint32_t value)
 	{
-		TriState val_lo[8]{};
-		TriState val_hi[4]{};
-		Unpack(value, val_lo);
-		UnpackNibble(value >> 8, val_hi);
-		for (size_t n = 0; n < 8; n++)
-		{
-			freq_reg[n].set(val_lo[n]);
-		}
-		for (size_t n = 0; n < 3; n++)
-		{
-			freq_reg[n + 8].set(val_hi[n]);
-		}
+		freq_reg.set(value);
 	}
 
 	void TriangleChan::Set_FreqCounter(uint32_t value)
 	{
-		TriState val_lo[8]{};
-		TriState val_hi[4]{};
-		Unpack(value, val_lo);
-		UnpackNibble(value >> 8, val_hi);
-		for (size_t n = 0; n < 8; n++)
-		{
-			freq_cnt[n].set(val_lo[n]);
-		}
-		for (size_t n = 0; n < 3; n++)
-		{
-			freq_cnt[n + 8].set(val_hi[n]);
-		}
+		freq_cnt.set(value);
 	}
 
 	void TriangleChan::Set_OutputCounter(uint32_t value)
 	{
-		TriState val_lo[8]{};
-		Unpack(value, val_lo);
-		for (size_t n = 0; n < 5; n++)
-		{
-			out_cnt[n].set(val_lo[n]);
-		}
+		out_cnt.set(value);
 	}
 
 #pragma endregion "Debug"
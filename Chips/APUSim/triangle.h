@@ -22,12 +22,12 @@ namespace APUSim
 		BaseLogic::DLatch reload_latch2{};
 		BaseLogic::DLatch tco_latch{};
 
-		RegisterBit lin_reg[7]{};
-		DownCounterBit lin_cnt[7]{};
-		RegisterBit freq_reg[11]{};
-		DownCounterBit freq_cnt[11]{};
+		RegisterWord lin_reg{ 7 };
+		DownCounterWord lin_cnt{ 7 };
+		RegisterWord freq_reg{ 11 };
+		DownCounterWord freq_cnt{ 11 };
 		BaseLogic::DLatch fout_latch{};
-		CounterBit out_cnt[5]{};
+		CounterWord out_cnt{ 5 };
 
 		void sim_Control();
 		void sim_LinearReg();
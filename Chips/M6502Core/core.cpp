@@ -8,41 +8,31 @@ namespace M6502Core
 	{
 		HLE_Mode = HLE;
 
-		decoder = new Decoder;
-		predecode = new PreDecode(this);
-		ir = new IR(this);
-		ext = new ExtraCounter(this);
-		brk = new BRKProcessing(this);
-		disp = new Dispatcher(this);
-		random = new RandomLogic(this);
-
-		addr_bus = new AddressBus(this);
-		regs = new Regs(this);
-		alu = new ALU(this);
+		decoder = arena.New<Decoder>();
+		predecode = arena.New<PreDecode>(this);
+		ir = arena.New<IR>(this);
+		ext = arena.New<ExtraCounter>(this);
+		brk = arena.New<BRKProcessing>(this);
+		disp = arena.New<Dispatcher>(this);
+		random = arena.New<RandomLogic>(this);
+
+		addr_bus = arena.New<AddressBus>(this);
+		regs = arena.New<Regs>(this);
+		alu = arena.New<ALU>(this);
 		alu->SetBCDHack(BCD_Hack);
-		pc = new ProgramCounter(this, HLE_Mode);
-		data_bus = new DataBus(this);
+		pc = arena.New<ProgramCounter>(this, HLE_Mode);
+		data_bus = arena.New<DataBus>(this);
 	}
 
 	M6502::~M6502()
 	{
-		delete decoder;
-		delete predecode;
-		delete ir;
-		delete ext;
-		delete brk;
-		delete disp;
-		delete random;
-
-		delete addr_bus;
-		delete regs;
-		delete alu;
-		delete pc;
-		delete data_bus;
+		// The modules are destroyed together with the arena.
 	}
 
 	void M6502::sim_Top(TriState inputs[], uint8_t* data_bus)
 	{
+		PROFILE_SCOPE("sim_Top");
+
 		wire.n_NMI = inputs[(size_t)InputPad::n_NMI];
 		wire.n_IRQ = inputs[(size_t)InputPad::n_IRQ];
 		wire.n_RES = inputs[(size_t)InputPad::n_RES];
@@ -145,7 +135,7 @@ namespace M6502Core
 		TxBits |= ((size_t)wire.n_T4 << 4);
 		TxBits |= ((size_t)wire.n_T5 << 5);
 
-		decoder->sim(decoder_in.packed_bits, &decoder_out);
+		PROFILE_STAGE("Decoder::sim", decoder->sim(decoder_in.packed_bits, &decoder_out));
 
 		// Interrupt handling
 
@@ -155,7 +145,7 @@ namespace M6502Core
 
 		disp->sim_BeforeRandomLogic();
 
-		random->sim();
+		PROFILE_STAGE("random->sim", random->sim());
 
 		brk->sim_AfterRandom();
 
@@ -164,6 +154,8 @@ namespace M6502Core
 
 	void M6502::sim_Bottom(TriState inputs[], TriState outputs[], uint16_t* ext_addr_bus, uint8_t* ext_data_bus)
 	{
+		PROFILE_SCOPE("sim_Bottom");
+
 		// Bottom Part
 
 		// When you simulate the lower part, you have to turn on the man in you to the fullest and imagine that you are possessed by Chuck Peddle.
@@ -258,6 +250,8 @@ namespace M6502Core
 
 	void M6502::sim(TriState inputs[], TriState outputs[], uint16_t* addr_bus, uint8_t* data_bus)
 	{
+		PROFILE_SCOPE("6502");
+
 		TriState PHI0 = inputs[(size_t)InputPad::PHI0];
 		TriState PHI2 = PHI0;
 
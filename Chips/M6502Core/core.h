@@ -101,6 +101,9 @@ namespace M6502Core
 		bool ADL_Dirty = false;
 		bool ADH_Dirty = false;
 
+		// All modules are placed in the arena in the order in which they are simulated.
+		BaseLogic::Arena arena{};
+
 		Decoder* decoder = nullptr;
 		PreDecode* predecode = nullptr;
 		IR* ir = nullptr;
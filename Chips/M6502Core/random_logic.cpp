@@ -7,24 +7,17 @@ namespace M6502Core
 	RandomLogic::RandomLogic(M6502* parent)
 	{
 		core = parent;
-		regs_control = new RegsControl(core);
-		alu_control = new ALUControl(core);
-		pc_control = new PC_Control(core);
-		bus_control = new BusControl(core);
-		flags_control = new FlagsControl(core);
-		flags = new Flags(core);
-		branch_logic = new BranchLogic(core);
+		regs_control = core->arena.New<RegsControl>(core);
+		alu_control = core->arena.New<ALUControl>(core);
+		pc_control = core->arena.New<PC_Control>(core);
+		bus_control = core->arena.New<BusControl>(core);
+		flags_control = core->arena.New<FlagsControl>(core);
+		flags = core->arena.New<Flags>(core);
+		branch_logic = core->arena.New<BranchLogic>(core);
 	}
 
 	RandomLogic::~RandomLogic()
 	{
-		delete regs_control;
-		delete alu_control;
-		delete pc_control;
-		delete bus_control;
-		delete flags_control;
-		delete flags;
-		delete branch_logic;
 	}
 
 	void RandomLogic::sim()
@@ -57,11 +57,11 @@ namespace PPUSim
 				// TBD: Check how things are in other RGB PPUs.
 
 				case Revision::RP2C04_0003:
-					cb[n] = new CBBit_RGB(ppu);
+					cb[n] = ppu->arena.New<CBBit_RGB>(ppu);
 					break;
 
 				default:
-					cb[n] = new CBBit(ppu);
+					cb[n] = ppu->arena.New<CBBit>(ppu);
 					break;
 			}
 		}
@@ -69,10 +69,6 @@ namespace PPUSim
 
 	CRAM::~CRAM()
 	{
-		for (size_t n = 0; n < 6; n++)
-		{
-			delete cb[n];
-		}
 	}
 
 	void CRAM::sim()
@@ -89,26 +85,20 @@ namespace PPUSim
 		TriState TH_MUX = ppu->wire.TH_MUX;
 		TriState n_PICTURE = ppu->fsm.n_PICTURE;
 
-		switch (ppu->rev)
-		{
-			// TBD: Add the remaining RGB PPUs
-
-			case Revision::RP2C04_0003:
-			{
-				dbpar_latch.set(ppu->wire.DB_PAR, ppu->wire.PCLK);
-				ppu->wire.n_BW = NOR(n_PICTURE, ppu->wire.BnW);
-				ppu->wire.n_DB_CB = NAND(dbpar_latch.get(), TH_MUX);
-			}
-			break;
+		// TBD: Add the remaining RGB PPUs
 
-			default:
-			{
-				dbpar_latch.set(ppu->wire.DB_PAR, ppu->wire.PCLK);
-				ppu->wire.n_CB_DB = NOT(NOR3(n_R7, n_DBE, NOT(TH_MUX)));
-				ppu->wire.n_BW = NOR(AND(ppu->wire.n_CB_DB, n_PICTURE), ppu->wire.BnW);
-				ppu->wire.n_DB_CB = NAND(dbpar_latch.get(), TH_MUX);
-			}
-			break;
+		if (ppu->traits.RGB)
+		{
+			dbpar_latch.set(ppu->wire.DB_PAR, ppu->wire.PCLK);
+			ppu->wire.n_BW = NOR(n_PICTURE, ppu->wire.BnW);
+			ppu->wire.n_DB_CB = NAND(dbpar_latch.get(), TH_MUX);
+		}
+		else
+		{
+			dbpar_latch.set(ppu->wire.DB_PAR, ppu->wire.PCLK);
+			ppu->wire.n_CB_DB = NOT(NOR3(n_R7, n_DBE, NOT(TH_MUX)));
+			ppu->wire.n_BW = NOR(AND(ppu->wire.n_CB_DB, n_PICTURE), ppu->wire.BnW);
+			ppu->wire.n_DB_CB = NAND(dbpar_latch.get(), TH_MUX);
 		}
 	}
 
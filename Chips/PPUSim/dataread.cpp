@@ -10,18 +10,14 @@ namespace PPUSim
 	{
 		ppu = parent;
 
-		patgen = new PATGen(ppu);
-		par = new PAR(ppu);
-		sccx = new ScrollRegs(ppu);
-		bgcol = new BGCol(ppu);
+		patgen = ppu->arena.New<PATGen>(ppu);
+		par = ppu->arena.New<PAR>(ppu);
+		sccx = ppu->arena.New<ScrollRegs>(ppu);
+		bgcol = ppu->arena.New<BGCol>(ppu);
 	}
 
 	DataReader::~DataReader()
 	{
-		delete patgen;
-		delete par;
-		delete sccx;
-		delete bgcol;
 	}
 
 	void DataReader::sim()
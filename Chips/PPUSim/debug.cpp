@@ -234,6 +234,16 @@ namespace PPUSim
 		oam->Dbg_TempOAMWriteByte(addr, val);
 	}
 
+	void PPU::Dbg_OAMReadBlock(uint8_t* ptr, size_t size)
+	{
+		oam->Dbg_OAMReadBlock(ptr, size);
+	}
+
+	void PPU::Dbg_TempOAMReadBlock(uint8_t* ptr, size_t size)
+	{
+		oam->Dbg_TempOAMReadBlock(ptr, size);
+	}
+
 	uint8_t PPU::Dbg_CRAMReadByte(size_t addr)
 	{
 		return cram->Dbg_CRAMReadByte(addr);
@@ -276,6 +286,27 @@ namespace PPUSim
 		regs->Debug_RenderAlwaysEnabled(enable);
 	}
 
+	void PPU::Dbg_EnableFastPath(bool enable)
+	{
+		regs->Debug_EnableFastPath(enable);
+	}
+
+	void PPU::Dbg_EnableIdleGating(bool enable)
+	{
+		fifo->Debug_EnableIdleGating(enable);
+	}
+
+	void PPU::Dbg_VerifyFastPath(bool enable)
+	{
+		regs->Debug_VerifyFastPath(enable);
+		fifo->Debug_VerifyIdleGating(enable);
+	}
+
+	size_t PPU::Dbg_GetFastPathMismatches()
+	{
+		return regs->Debug_GetFastPathMismatches() + fifo->Debug_GetIdleMismatches();
+	}
+
 	void PPU::GetDebugInfo_OAMEval(OAMEvalWires& wires)
 	{
 		eval->GetDebugInfo(wires);
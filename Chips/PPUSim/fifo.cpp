@@ -12,16 +12,30 @@ namespace PPUSim
 
 		for (size_t n = 0; n < 8; n++)
 		{
-			lane[n] = new FIFOLane(ppu);
+			lane[n] = ppu->arena.New<FIFOLane>(ppu);
+		}
+
+		for (size_t n = 0; n < 256; n++)
+		{
+			TriState bits[8]{};
+			Unpack((uint8_t)n, bits);
+			BitRev(bits);
+			bitrev[n] = Pack(bits);
+
+			first_lane[n] = 8;
+			for (uint8_t run = 0; run < 8; run++)
+			{
+				if (n & (1 << run))
+				{
+					first_lane[n] = run;
+					break;
+				}
+			}
 		}
 	}
 
 	FIFO::~FIFO()
 	{
-		for (size_t n = 0; n < 8; n++)
-		{
-			delete lane[n];
-		}
 	}
 
 	void FIFO::sim()
@@ -36,11 +50,112 @@ namespace PPUSim
 		ppu->wire.n_ZH = zh_latch3.nget();
 
 		sim_HInv();
-		BitRev(n_TX);
+
+		if (sim_Idle())
+		{
+			return;
+		}
+
 		sim_Lanes();
 		sim_Prio();
 	}
 
+	/// <summary>
+	/// Check whether the lanes and the priority circuit can be skipped.
+	/// The lanes are skipped only after they have stayed unchanged for both PCLK phases under the idle conditions.
+	/// The lane select latches keep following H (their outputs are closed by /SHx), so they are simulated anyway and are not counted as a change.
+	/// </summary>
+	/// <returns>true: the lanes have already been processed or can be skipped</returns>
+	bool FIFO::sim_Idle()
+	{
+		bool idle_conditions =
+			ppu->fsm.nVIS == TriState::One &&
+			ppu->wire.n_SH2 == TriState::One &&
+			ppu->wire.n_SH3 == TriState::One &&
+			ppu->wire.n_SH5 == TriState::One &&
+			ppu->wire.n_SH7 == TriState::One &&
+			ppu->wire.CLPO == TriState::One &&
+			ppu->wire.n_ZH == TriState::One;
+
+		if (!IdleGating || !idle_conditions)
+		{
+			idle_evals = 0;
+			return false;
+		}
+
+		FIFOState before, after;
+
+		sim_LaneSelect();
+
+		if (idle_evals < 2)
+		{
+			PackState(before);
+			sim_Lanes();
+			sim_Prio();
+			PackState(after);
+			bool same_phase = idle_evals != 0 && ppu->wire.PCLK == idle_phase;
+			idle_evals = SameState(before, after) ? (same_phase ? idle_evals : idle_evals + 1) : 0;
+			idle_phase = ppu->wire.PCLK;
+			return true;
+		}
+
+		if (VerifyIdle)
+		{
+			PackState(before);
+			sim_Lanes();
+			sim_Prio();
+			PackState(after);
+			if (!SameState(before, after))
+			{
+				idleMismatches++;
+			}
+		}
+
+		return true;
+	}
+
+	void FIFO::PackState(FIFOState& state)
+	{
+		for (size_t n = 0; n < 8; n++)
+		{
+			state.lane[n] = lane[n]->PackState();
+		}
+
+		uint64_t wires = 0;
+		wires |= (uint64_t)(ppu->wire.n_ZCOL0 & 1) << 0;
+		wires |= (uint64_t)(ppu->wire.n_ZCOL1 & 1) << 1;
+		wires |= (uint64_t)(ppu->wire.ZCOL2 & 1) << 2;
+		wires |= (uint64_t)(ppu->wire.ZCOL3 & 1) << 3;
+		wires |= (uint64_t)(ppu->wire.n_ZPRIO & 1) << 4;
+		wires |= (uint64_t)(ppu->wire.n_SPR0HIT & 1) << 5;
+		wires |= (uint64_t)col2_latch << 6;
+		wires |= (uint64_t)col3_latch << 7;
+		wires |= (uint64_t)prio_latch << 8;
+		state.wires = wires;
+	}
+
+	bool FIFO::SameState(FIFOState& a, FIFOState& b)
+	{
+		return memcmp(&a, &b, sizeof(FIFOState)) == 0;
+	}
+
+	void FIFO::Debug_EnableIdleGating(bool enable)
+	{
+		IdleGating = enable;
+		idle_evals = 0;
+	}
+
+	void FIFO::Debug_VerifyIdleGating(bool enable)
+	{
+		VerifyIdle = enable;
+		idleMismatches = 0;
+	}
+
+	size_t FIFO::Debug_GetIdleMismatches()
+	{
+		return idleMismatches;
+	}
+
 	void FIFO::sim_HInv()
 	{
 		TriState n_PCLK = ppu->wire.n_PCLK;
@@ -52,16 +167,36 @@ namespace PPUSim
 
 		auto HINV = HINV_FF.get();
 
-		for (size_t n = 0; n < 8; n++)
+		if (n_PCLK == TriState::One)
 		{
-			tout_latch[n].set(MUX(HINV, ppu->GetPDBit(n), ppu->GetPDBit(7 - n)), n_PCLK);
-			n_TX[n] = NAND(tout_latch[n].get(), PD_FIFO);
+			tout_latch = (HINV & 1) ? bitrev[ppu->PD] : ppu->PD;
 		}
+
+		// The outputs are bit-reversed on their way to the lanes
+
+		packed_nTX = bitrev[(PD_FIFO & 1) ? (uint8_t)~tout_latch : 0xff];
 	}
 
 	/// <summary>
 	/// Generate LaneOut outputs for the priority circuit.
 	/// </summary>
+	void FIFO::sim_LaneSelect()
+	{
+		TriState in[3]{};
+		TriState HSel[8];
+
+		in[0] = ppu->wire.H3_Dash2;
+		in[1] = ppu->wire.H4_Dash2;
+		in[2] = ppu->wire.H5_Dash2;
+
+		DMX3(in, HSel);
+
+		for (size_t n = 0; n < 8; n++)
+		{
+			lane[n]->sim_Select(HSel[n]);
+		}
+	}
+
 	void FIFO::sim_Lanes()
 	{
 		TriState in[3]{};
@@ -73,142 +208,63 @@ namespace PPUSim
 
 		DMX3(in, HSel);
 
+		uint8_t OB = Pack(ppu->wire.OB);
+
 		for (size_t n = 0; n < 8; n++)
 		{
-			lane[n]->sim(HSel[n], n_TX, packed_nTX, LaneOut[n]);
+			lane[n]->sim(HSel[n], packed_nTX, OB, LaneOut[n]);
 		}
 	}
 
 	/// <summary>
 	/// Based on the priorities, select one of the LaneOut values.
+	/// The NOR chain of the priority circuit selects the lowest numbered lane that has an opaque pixel,
+	/// so all lane outputs are packed into words and the winner is found by lookup.
 	/// </summary>
 	void FIFO::sim_Prio()
 	{
 		TriState PCLK = ppu->wire.PCLK;
 		TriState CLPO = ppu->wire.CLPO;
-		TriState Z[8]{};
-		TriState in[10]{};
 
-		Z[0] = NOR3(AND(get_nZCOL0(0), get_nZCOL1(0)), CLPO, get_nxEN(0));
+		// Bit 8 holds the value used when no lane is active: `/ZCOL0/1` are forcibly set to `1` (there is a corresponding nor),
+		// the rest are taken from the hidden latches, which are between FIFO and MUX.
 
-		// You can get the `/SPR0HIT` signal immediately
+		uint16_t col0 = 0x100;
+		uint16_t col1 = 0x100;
+		uint16_t col2 = col2_latch << 8;
+		uint16_t col3 = col3_latch << 8;
+		uint16_t prio = prio_latch << 8;
+		uint8_t n_xen = 0;
 
-		s0_latch.set(Z[0], PCLK);
-		ppu->wire.n_SPR0HIT = s0_latch.nget();
-
-		in[0] = AND(get_nZCOL0(1), get_nZCOL1(1));
-		in[1] = CLPO;
-		in[2] = get_nxEN(1);
-		in[3] = Z[0];
-		Z[1] = NOR4(in);
-
-		in[0] = AND(get_nZCOL0(2), get_nZCOL1(2));
-		in[1] = CLPO;
-		in[2] = get_nxEN(2);
-		in[3] = Z[0];
-		in[4] = Z[1];
-		Z[2] = NOR5(in);
-
-		in[0] = AND(get_nZCOL0(3), get_nZCOL1(3));
-		in[1] = CLPO;
-		in[2] = get_nxEN(3);
-		in[3] = Z[0];
-		in[4] = Z[1];
-		in[5] = Z[2];
-		Z[3] = NOR6(in);
-
-		in[0] = AND(get_nZCOL0(4), get_nZCOL1(4));
-		in[1] = CLPO;
-		in[2] = get_nxEN(4);
-		in[3] = Z[0];
-		in[4] = Z[1];
-		in[5] = Z[2];
-		in[6] = Z[3];
-		Z[4] = NOR7(in);
-
-		in[0] = AND(get_nZCOL0(5), get_nZCOL1(5));
-		in[1] = CLPO;
-		in[2] = get_nxEN(5);
-		in[3] = Z[0];
-		in[4] = Z[1];
-		in[5] = Z[2];
-		in[6] = Z[3];
-		in[7] = Z[4];
-		Z[5] = NOR8(in);
-
-		in[0] = AND(get_nZCOL0(6), get_nZCOL1(6));
-		in[1] = CLPO;
-		in[2] = get_nxEN(6);
-		in[3] = Z[0];
-		in[4] = Z[1];
-		in[5] = Z[2];
-		in[6] = Z[3];
-		in[7] = Z[4];
-		in[8] = Z[5];
-		Z[6] = NOR9(in);
-
-		in[0] = AND(get_nZCOL0(7), get_nZCOL1(7));
-		in[1] = CLPO;
-		in[2] = get_nxEN(7);
-		in[3] = Z[0];
-		in[4] = Z[1];
-		in[5] = Z[2];
-		in[6] = Z[3];
-		in[7] = Z[4];
-		in[8] = Z[5];
-		in[9] = Z[6];
-		Z[7] = NOR10(in);
-
-		// The multiplexer locomotive is simulated by the ordinary for-loop.
-
-		size_t run = 0;
-
-		for (run = 0; run < 8; run++)
+		for (size_t n = 0; n < 8; n++)
 		{
-			if (Z[run] == TriState::One)
-			{
-				ppu->wire.n_ZCOL0 = get_nZCOL0(run);
-				ppu->wire.n_ZCOL1 = get_nZCOL1(run);
-				ppu->wire.ZCOL2 = LaneOut[run].Z_COL2;
-				ppu->wire.ZCOL3 = LaneOut[run].Z_COL3;
-				ppu->wire.n_ZPRIO = LaneOut[run].nZ_PRIO;
-
-				break;
-			}
+			col0 |= (LaneOut[n].nZ_COL0 & 1) << n;
+			col1 |= (LaneOut[n].nZ_COL1 & 1) << n;
+			col2 |= (LaneOut[n].Z_COL2 & 1) << n;
+			col3 |= (LaneOut[n].Z_COL3 & 1) << n;
+			prio |= (LaneOut[n].nZ_PRIO & 1) << n;
+			n_xen |= (LaneOut[n].n_xEN & 1) << n;
 		}
 
-		// When no Z is active, hidden latches are activated, which are between FIFO and MUX.
-		// `/ZCOL0/1` are forcibly set to `1` (there is a corresponding nor).
+		uint8_t active = ~(col0 & col1) & ~n_xen & ((CLPO & 1) ? 0 : 0xff);
+		size_t run = first_lane[active];
 
-		if (run == 8)
-		{
-			ppu->wire.n_ZCOL0 = TriState::One;
-			ppu->wire.n_ZCOL1 = TriState::One;
-			ppu->wire.ZCOL2 = col2_latch.get();
-			ppu->wire.ZCOL3 = col3_latch.get();
-			ppu->wire.n_ZPRIO = prio_latch.get();
-		}
-		else
-		{
-			col2_latch.set(ppu->wire.ZCOL2, TriState::One);
-			col3_latch.set(ppu->wire.ZCOL3, TriState::One);
-			prio_latch.set(ppu->wire.n_ZPRIO, TriState::One);
-		}
-	}
+		// You can get the `/SPR0HIT` signal immediately
 
-	TriState FIFO::get_nZCOL0(size_t lane)
-	{
-		return LaneOut[lane].nZ_COL0;
-	}
+		s0_latch.set((TriState)(active & 1), PCLK);
+		ppu->wire.n_SPR0HIT = s0_latch.nget();
 
-	TriState FIFO::get_nZCOL1(size_t lane)
-	{
-		return LaneOut[lane].nZ_COL1;
-	}
+		ppu->wire.n_ZCOL0 = (TriState)((col0 >> run) & 1);
+		ppu->wire.n_ZCOL1 = (TriState)((col1 >> run) & 1);
+		ppu->wire.ZCOL2 = (TriState)((col2 >> run) & 1);
+		ppu->wire.ZCOL3 = (TriState)((col3 >> run) & 1);
+		ppu->wire.n_ZPRIO = (TriState)((prio >> run) & 1);
 
-	TriState FIFO::get_nxEN(size_t lane)
-	{
-		return LaneOut[lane].n_xEN;
+		// When no lane is active the hidden latches simply keep their value.
+
+		col2_latch = ppu->wire.ZCOL2;
+		col3_latch = ppu->wire.ZCOL3;
+		prio_latch = ppu->wire.n_ZPRIO;
 	}
 
 	void FIFO::sim_SpriteH()
@@ -249,6 +305,11 @@ namespace PPUSim
 	{
 	}
 
+	void FIFOLane::sim_Select(TriState HSel)
+	{
+		hsel_latch.set(HSel, ppu->wire.n_PCLK);
+	}
+
 	void FIFOLane::sim_LaneControl(TriState HSel)
 	{
 		TriState n_PCLK = ppu->wire.n_PCLK;
@@ -287,28 +348,28 @@ namespace PPUSim
 	}
 
 	/// <summary>
-	/// The optimized carry chain IS used.
+	/// The whole 8-bit counter is simulated at once.
+	/// The step latches of each bit store the inverted value that the bit takes on STEP: the bit is toggled when all lower bits are 0.
+	/// Thus on UPD the step latches actually capture the decremented counter value.
 	/// </summary>
-	/// <returns></returns>
-	TriState FIFOLane::sim_Counter()
+	/// <returns>Carry out of the highest bit (the counter is 0)</returns>
+	TriState FIFOLane::sim_Counter(uint8_t OB)
 	{
-		TriState carry = TriState::One;
-		TriState val_out[5]{};
-		TriState unused{};
-
-		for (size_t n = 0; n < 5; n++)
+		if (STEP & 1)
 		{
-			carry = down_cnt[n].sim(UPD, LOAD, STEP, ppu->wire.OB[n], carry, val_out[n]);
+			cnt_keep = cnt_step;
+		}
+		else if (LOAD & 1)
+		{
+			cnt_keep = OB;
 		}
 
-		carry = NOR5(val_out);
-
-		for (size_t n = 5; n < 8; n++)
+		if (UPD == TriState::One)
 		{
-			carry = down_cnt[n].sim(UPD, LOAD, STEP, ppu->wire.OB[n], carry, unused);
+			cnt_step = cnt_keep - 1;
 		}
 
-		return carry;
+		return cnt_keep == 0 ? TriState::One : TriState::Zero;
 	}
 
 	/// <summary>
@@ -334,34 +395,48 @@ namespace PPUSim
 		SR_EN = NOR(n_PCLK, n_EN);
 	}
 
-	void FIFOLane::sim_PairedSR(TriState n_TX[8], uint8_t packed_nTX)
+	/// <summary>
+	/// Both shift registers are simulated as bytes. 
+	/// During shifting (SR_EN) the input latch of each stage receives the output of the previous stage, `1` is shifted into the highest stage.
+	/// </summary>
+	/// <param name="packed_nTX"></param>
+	void FIFOLane::sim_PairedSR(uint8_t packed_nTX)
 	{
 		TriState n_PCLK = ppu->wire.n_PCLK;
-		TriState shift_out[2]{};
+		TriState T_SR[2] = { T_SR0, T_SR1 };
 
-		shift_out[0] = TriState::One;
-		shift_out[1] = TriState::One;
-
-		for (int n = 7; n >= 0; n--)
+		for (size_t n = 0; n < 2; n++)
 		{
-			shift_out[0] = paired_sr[0][n].sim(n_PCLK, T_SR0, SR_EN, n_TX[n], shift_out[0]);
-			shift_out[1] = paired_sr[1][n].sim(n_PCLK, T_SR1, SR_EN, n_TX[n], shift_out[1]);
+			if (SR_EN & 1)
+			{
+				// The stages are chained through the output latches; if they are open, the ones shifted into the highest stage pass through the entire register.
+				sr_in[n] = n_PCLK == TriState::One ? 0xff : (uint8_t)((~sr_out[n] >> 1) | 0x80);
+			}
+			else if (T_SR[n] & 1)
+			{
+				sr_in[n] = packed_nTX;
+			}
+
+			if (n_PCLK == TriState::One)
+			{
+				sr_out[n] = ~sr_in[n];
+			}
 		}
 
-		nZ_COL0 = shift_out[0];
-		nZ_COL1 = shift_out[1];
+		nZ_COL0 = (TriState)(~sr_out[0] & 1);
+		nZ_COL1 = (TriState)(~sr_out[1] & 1);
 	}
 
-	void FIFOLane::sim(TriState HSel, TriState n_TX[8], uint8_t packed_nTX, FIFOLaneOutput& ZOut)
+	void FIFOLane::sim(TriState HSel, uint8_t packed_nTX, uint8_t OB, FIFOLaneOutput& ZOut)
 	{
 		sim_LaneControl(HSel);
 		sim_CounterControl();
 
-		auto CarryOut = sim_Counter();
+		auto CarryOut = sim_Counter(OB);
 		sim_CounterCarry(CarryOut);
 
 		sim_PairedSREnable();
-		sim_PairedSR(n_TX, packed_nTX);
+		sim_PairedSR(packed_nTX);
 
 		ZOut.nZ_COL0 = nZ_COL0;
 		ZOut.nZ_COL1 = nZ_COL1;
@@ -373,41 +448,34 @@ namespace PPUSim
 
 	size_t FIFOLane::get_Counter()
 	{
-		size_t val = 0;
-		for (size_t n = 0; n < 8; n++)
-		{
-			val |= ((down_cnt[n].get() == TriState::One) ? 1ULL : 0) << n;
-		}
-		return val;
-	}
-
-	TriState FIFO_CounterBit::sim(
-		TriState Clock, TriState Load, TriState Step,
-		TriState val_in,
-		TriState carry_in,
-		TriState& val_out)
-	{
-		keep_ff.set(MUX(Step, 
-			MUX(Load, MUX(Clock, TriState::Z, keep_ff.get()), val_in),
-			step_latch.nget()));
-		step_latch.set(MUX(carry_in, keep_ff.nget(), keep_ff.get()), Clock);
-		TriState carry_out = NOR(keep_ff.get(), NOT(carry_in));
-		val_out = keep_ff.get();
-		return carry_out;
+		return cnt_keep;
 	}
 
-	TriState FIFO_CounterBit::get()
+	uint64_t FIFOLane::PackState()
 	{
-		return keep_ff.get();
-	}
-
-	TriState FIFO_SRBit::sim(TriState n_PCLK, TriState T_SR, TriState SR_EN,
-		TriState nTx, TriState shift_in)
-	{
-		in_latch.set(MUX(SR_EN, MUX(T_SR, TriState::Z, nTx), shift_in), TriState::One);
-		out_latch.set(in_latch.nget(), n_PCLK);
-		TriState shift_out = out_latch.nget();
-		return shift_out;
+		uint64_t val = 0;
+		val |= (uint64_t)sr_in[0] << 0;
+		val |= (uint64_t)sr_in[1] << 8;
+		val |= (uint64_t)sr_out[0] << 16;
+		val |= (uint64_t)sr_out[1] << 24;
+		val |= (uint64_t)cnt_keep << 32;
+		val |= (uint64_t)cnt_step << 40;
+		val |= (uint64_t)(ZH_FF.get() & 1) << 48;
+		val |= (uint64_t)(en_latch.get() & 1) << 49;
+		val |= (uint64_t)(ob0_latch[0].get() & 1) << 50;
+		val |= (uint64_t)(ob1_latch[0].get() & 1) << 51;
+		val |= (uint64_t)(ob5_latch[0].get() & 1) << 52;
+		val |= (uint64_t)(ob0_latch[1].get() & 1) << 53;
+		val |= (uint64_t)(ob1_latch[1].get() & 1) << 54;
+		val |= (uint64_t)(ob5_latch[1].get() & 1) << 55;
+		val |= (uint64_t)(hsel_latch.get() & 1) << 56;
+		val |= (uint64_t)(nZ_COL0 & 1) << 57;
+		val |= (uint64_t)(nZ_COL1 & 1) << 58;
+		val |= (uint64_t)(Z_COL2 & 1) << 59;
+		val |= (uint64_t)(Z_COL3 & 1) << 60;
+		val |= (uint64_t)(nZ_PRIO & 1) << 61;
+		val |= (uint64_t)(n_EN & 1) << 62;
+		return val;
 	}
 
 #pragma endregion "FIFO Lane"
@@ -4,29 +4,6 @@
 
 namespace PPUSim
 {
-	class FIFO_CounterBit
-	{
-		BaseLogic::FF keep_ff;
-		BaseLogic::DLatch step_latch;
-
-	public:
-		BaseLogic::TriState sim(BaseLogic::TriState Clock, BaseLogic::TriState Load, BaseLogic::TriState Step,
-			BaseLogic::TriState val_in,
-			BaseLogic::TriState carry_in,
-			BaseLogic::TriState& val_out);
-		BaseLogic::TriState get();
-	};
-
-	class FIFO_SRBit
-	{
-		BaseLogic::DLatch in_latch;
-		BaseLogic::DLatch out_latch;
-
-	public:
-		BaseLogic::TriState sim(BaseLogic::TriState n_PCLK, BaseLogic::TriState T_SR, BaseLogic::TriState SR_EN,
-			BaseLogic::TriState nTx, BaseLogic::TriState shift_in);
-	};
-
 	struct FIFOLaneOutput
 	{
 		BaseLogic::TriState nZ_COL0;
@@ -37,13 +14,28 @@ namespace PPUSim
 		BaseLogic::TriState n_xEN;
 	};
 
+	/// <summary>
+	/// The exact state of the lanes and the priority circuit, used by the idle gating to detect changes.
+	/// </summary>
+	struct FIFOState
+	{
+		uint64_t lane[8];
+		uint64_t wires;
+	};
+
 	class FIFOLane
 	{
 		friend PPUSimUnitTest::UnitTest;
 		PPU* ppu = nullptr;
 
-		FIFO_SRBit paired_sr[2][8]{};
-		FIFO_CounterBit down_cnt[8]{};
+		// Paired shift registers. Bit n of each byte corresponds to the stage n of the register (stage 0 is the output).
+		// `sr_in` - input latches (written when T_SR or SR_EN), `sr_out` - output latches (written when /PCLK, stored inverted).
+		uint8_t sr_in[2]{};
+		uint8_t sr_out[2]{};
+
+		// 8-bit down counter. `cnt_step` is the value which the counter takes on the next STEP (the decremented value, captured on UPD).
+		uint8_t cnt_keep = 0;
+		uint8_t cnt_step = 0xff;
 
 		BaseLogic::DLatch ob0_latch[2];
 		BaseLogic::DLatch ob1_latch[2];
@@ -70,10 +62,10 @@ namespace PPUSim
 
 		void sim_LaneControl(BaseLogic::TriState HSel);
 		void sim_CounterControl();
-		BaseLogic::TriState sim_Counter();
+		BaseLogic::TriState sim_Counter(uint8_t OB);
 		void sim_CounterCarry(BaseLogic::TriState Carry);
 		void sim_PairedSREnable();
-		void sim_PairedSR(BaseLogic::TriState n_TX[8], uint8_t packed_nTX);
+		void sim_PairedSR(uint8_t packed_nTX);
 
 		size_t get_Counter();
 
@@ -81,7 +73,10 @@ namespace PPUSim
 		FIFOLane(PPU* parent);
 		~FIFOLane();
 
-		void sim(BaseLogic::TriState HSel, BaseLogic::TriState n_TX[8], uint8_t packed_nTX, FIFOLaneOutput& ZOut);
+		void sim(BaseLogic::TriState HSel, uint8_t packed_nTX, uint8_t OB, FIFOLaneOutput& ZOut);
+		void sim_Select(BaseLogic::TriState HSel);
+
+		uint64_t PackState();
 	};
 
 	class FIFO
@@ -96,9 +91,9 @@ namespace PPUSim
 		BaseLogic::DLatch zh_latch3;
 
 		BaseLogic::FF HINV_FF;
-		BaseLogic::DLatch tout_latch[8];
-		BaseLogic::TriState n_TX[8]{};
+		uint8_t tout_latch = 0;
 		uint8_t packed_nTX = 0;
+		uint8_t bitrev[256]{};			// Horizontal flip lookup
 
 		BaseLogic::DLatch sh2_latch;
 		BaseLogic::DLatch sh3_latch;
@@ -106,19 +101,34 @@ namespace PPUSim
 		BaseLogic::DLatch sh7_latch;
 
 		BaseLogic::DLatch s0_latch;
-		BaseLogic::DLatch col2_latch;
-		BaseLogic::DLatch col3_latch;
-		BaseLogic::DLatch prio_latch;
+
+		// Hidden latches between FIFO and MUX
+		uint8_t col2_latch = 0;
+		uint8_t col3_latch = 0;
+		uint8_t prio_latch = 0;
+
+		uint8_t first_lane[256]{};		// Number of the lowest active lane (8: none)
 
 		FIFOLaneOutput LaneOut[8]{};
 
 		void sim_HInv();
+		void sim_LaneSelect();
 		void sim_Lanes();
 		void sim_Prio();
 
-		BaseLogic::TriState get_nZCOL0(size_t lane);
-		BaseLogic::TriState get_nZCOL1(size_t lane);
-		BaseLogic::TriState get_nxEN(size_t lane);
+		// Idle gating. Outside the visible part (and when rendering is disabled) the sprite H counters are not loaded, the shift registers are not enabled
+		// and CLPO closes the priority circuit, so once the counters have run out the lanes no longer change their state.
+		// Disabled by default; enable it with PPU::Dbg_EnableIdleGating and check it with PPU::Dbg_VerifyFastPath.
+
+		bool IdleGating = false;
+		bool VerifyIdle = false;
+		size_t idle_evals = 0;
+		BaseLogic::TriState idle_phase = BaseLogic::TriState::X;
+		size_t idleMismatches = 0;
+
+		bool sim_Idle();
+		void PackState(FIFOState& state);
+		bool SameState(FIFOState& a, FIFOState& b);
 
 	public:
 		FIFO(PPU* parent);
@@ -130,5 +140,9 @@ namespace PPUSim
 		/// You can call right after the FSM.
 		/// </summary>
 		void sim_SpriteH();
+
+		void Debug_EnableIdleGating(bool enable);
+		void Debug_VerifyIdleGating(bool enable);
+		size_t Debug_GetIdleMismatches();
 	};
 }
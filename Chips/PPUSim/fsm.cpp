@@ -225,9 +225,9 @@ namespace PPUSim
 	/// </summary>
 	void FSM::sim_EvenOdd(TriState* HPLA, TriState *VPLA)
 	{
-		switch (ppu->rev)
+		switch (ppu->traits.EvenOdd)
 		{
-			case Revision::RP2C02G:
+			case EvenOddCircuit::NTSC:
 			{
 				TriState V8 = ppu->v->getBit(8);
 				TriState RES = ppu->wire.RES;
@@ -241,7 +241,7 @@ namespace PPUSim
 				break;
 			}
 
-			case Revision::RP2C07_0:
+			case EvenOddCircuit::PAL:
 			{
 				TriState n_PCLK = ppu->wire.n_PCLK;
 				TriState PCLK = ppu->wire.PCLK;
@@ -259,18 +259,16 @@ namespace PPUSim
 
 			// TBD: Only RP2C04-0003 has a photo so far. The Even/Odd circuit is obviously switched off, as the Dot Crawl is not required.
 			// In other RGB PPU probably similar, but until there is no photo, we will not engage in speculation.
+			// UMC UA6538 also has no Even/Odd circuit.
 
-			case Revision::RP2C04_0003:
+			case EvenOddCircuit::Off:
 			{
 				ppu->wire.EvenOddOut = TriState::Zero;
 				break;
 			}
 
-			case Revision::UMC_UA6538:
-			{
-				ppu->wire.EvenOddOut = TriState::Zero;
+			default:
 				break;
-			}
 		}
 	}
 
@@ -279,24 +277,17 @@ namespace PPUSim
 		TriState n_PCLK = ppu->wire.n_PCLK;
 		TriState EvenOddOut = ppu->wire.EvenOddOut;
 
-		switch (ppu->rev)
-		{
-			// PAL PPU does not use EvenOddOut.
-
-			case Revision::RP2C07_0:
-			case Revision::UMC_UA6538:
-			{
-				ctrl_latch1.set(NOT(HPLA[23]), n_PCLK);
-				ctrl_latch2.set(VPLA[8], n_PCLK);
-			}
-			break;
+		// PAL PPU does not use EvenOddOut.
 
-			default:
-			{
-				ctrl_latch1.set(NOR(HPLA[23], EvenOddOut), n_PCLK);
-				ctrl_latch2.set(VPLA[2], n_PCLK);
-			}
-			break;
+		if (ppu->traits.PAL)
+		{
+			ctrl_latch1.set(NOT(HPLA[23]), n_PCLK);
+			ctrl_latch2.set(VPLA[8], n_PCLK);
+		}
+		else
+		{
+			ctrl_latch1.set(NOR(HPLA[23], EvenOddOut), n_PCLK);
+			ctrl_latch2.set(VPLA[2], n_PCLK);
 		}
 
 		ppu->wire.HC = ctrl_latch1.nget();
@@ -317,6 +308,14 @@ namespace PPUSim
 		return NOT(VB_FF.nget());
 	}
 
+	/// <summary>
+	/// 1: the vertical sync lines (the VSYNC pulses are suppressed). Used only for the board events.
+	/// </summary>
+	TriState FSM::get_VSYNC_FF()
+	{
+		return VSYNC_FF.get();
+	}
+
 	TriState FSM::get_BLNK(TriState BLACK)
 	{
 		return NAND(NOT(BLNK_FF.get()), NOT(BLACK));
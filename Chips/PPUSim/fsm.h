@@ -110,6 +110,7 @@ namespace PPUSim
 
 		void sim_RESCL_early();
 		BaseLogic::TriState get_VB();
+		BaseLogic::TriState get_VSYNC_FF();
 		BaseLogic::TriState get_BLNK(BaseLogic::TriState BLACK);
 	};
 }
@@ -6,83 +6,54 @@ using namespace BaseLogic;
 
 namespace PPUSim
 {
-	TriState HVCounterBit::sim(TriState Carry, TriState CLR)
-	{
-		// The CLR actually makes sense as `Load`. But in the PPU all the inputs for the `Load` equivalent are connected to Vss, so we use the name CLR.
-
-		ff.set( MUX(ppu->wire.PCLK, NOR(NOT(ff.get()), ppu->wire.RES), NOR(latch.get(), CLR)) );
-		latch.set(MUX(Carry, NOT(ff.get()), ff.get()), NOT(ppu->wire.PCLK));
-		TriState CarryOut = NOR(NOT(ff.get()), NOT(Carry));
-		return CarryOut;
-	}
-
-	TriState HVCounterBit::getOut()
-	{
-		TriState out = NOR(NOT(ff.get()), ppu->wire.RES);
-		return out;
-	}
-
-	void HVCounterBit::set(TriState val)
-	{
-		ff.set(val);
-	}
-
 	HVCounter::HVCounter(PPU* parent, size_t bits)
 	{
 		assert(bits <= bitCountMax);
 
 		ppu = parent;
 		bitCount = bits;
+		mask = (1ULL << bitCount) - 1;
 
-		for (size_t n = 0; n < bitCount; n++)
-		{
-			bit[n] = new HVCounterBit(parent);
-		}
+		// All latches are initially `0`.
+
+		n_latch = mask;
 	}
 
 	HVCounter::~HVCounter()
 	{
-		for (size_t n = 0; n < bitCount; n++)
-		{
-			delete bit[n];
-		}
 	}
 
 	void HVCounter::sim(TriState Carry, TriState CLR)
 	{
-		for (size_t n = 0; n < bitCount; n++)
+		// The CLR actually makes sense as `Load`. But in the PPU all the inputs for the `Load` equivalent are connected to Vss, so we use the name CLR.
+
+		if (ppu->wire.PCLK & 1)
 		{
-			Carry = bit[n]->sim(Carry, CLR);
+			ff = (CLR & 1) ? 0 : n_latch;
 		}
-	}
-
-	size_t HVCounter::get()
-	{
-		size_t val = 0;
-
-		for (size_t n = 0; n < bitCount; n++)
+		else
 		{
-			auto bitVal = bit[n]->getOut();
-			if (bitVal == TriState::One)
+			if (ppu->wire.RES & 1)
 			{
-				val |= (1ULL << n);
+				ff = 0;
 			}
+
+			n_latch = (ff + (Carry & 1)) & mask;
 		}
+	}
 
-		return val;
+	size_t HVCounter::get()
+	{
+		return (ppu->wire.RES & 1) ? 0 : ff;
 	}
 
 	void HVCounter::set(size_t val)
 	{
-		for (size_t n = 0; n < bitCount; n++)
-		{
-			auto bitVal = (val >> n) & 1 ? TriState::One : TriState::Zero;
-			bit[n]->set(bitVal);
-		}
+		ff = val & mask;
 	}
 
 	TriState HVCounter::getBit(size_t n)
 	{
-		return bit[n]->getOut();
+		return (TriState)((get() >> n) & 1);
 	}
 }
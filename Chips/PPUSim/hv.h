@@ -4,26 +4,10 @@
 
 namespace PPUSim
 {
-	/// <summary>
-	/// One stage of H/V counters.
-	/// </summary>
-	class HVCounterBit
-	{
-		PPU* ppu = nullptr;
-
-		BaseLogic::FF ff;
-		BaseLogic::DLatch latch;
-
-	public:
-		HVCounterBit(PPU* parent) { ppu = parent; }
-
-		BaseLogic::TriState sim(BaseLogic::TriState Carry, BaseLogic::TriState CLR);
-		BaseLogic::TriState getOut();
-		void set(BaseLogic::TriState val);
-	};
-
 	/// <summary>
 	/// Implementation of a full counter (H or V).
+	/// All stages of the counter are simulated at once: the FF of each stage is a bit of `ff`, the latch of each stage is a bit of `n_latch` (stored inverted).
+	/// Each latch captures `FF ^ CarryIn` of its stage, so all the latches together hold the incremented counter value.
 	/// This does not simulate the propagation delay carry optimization for the low-order bits of the counter, as is done in the real circuit.
 	/// The `bits` constructor parameter specifies the bits of the counter.
 	/// </summary>
@@ -31,10 +15,12 @@ namespace PPUSim
 	{
 		PPU* ppu = nullptr;
 
-		// To simplify, we reserve space for the maximum number of CounterBit instances.
 		static const size_t bitCountMax = 16;
-		HVCounterBit* bit[bitCountMax] = { 0 };
 		size_t bitCount = 0;
+		size_t mask = 0;
+
+		size_t ff = 0;
+		size_t n_latch = 0;
 
 	public:
 		HVCounter(PPU* parent, size_t bits);
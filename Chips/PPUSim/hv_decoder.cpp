@@ -198,6 +198,8 @@ namespace PPUSim
 		{
 			vpla->SetMatrix(v_bitmask);
 		}
+
+		BuildLUT();
 	}
 
 	HVDecoder::~HVDecoder()
@@ -206,58 +208,89 @@ namespace PPUSim
 		delete vpla;
 	}
 
+	void HVDecoder::BuildLUT()
+	{
+		for (size_t n = 0; n < hpla_lut_size; n++)
+		{
+			HDecoderInput input{};
+			size_t H = n & 0x1ff;
+
+			input.H8 = (H >> 8) & 1;
+			input.n_H8 = ~(H >> 8) & 1;
+			input.H7 = (H >> 7) & 1;
+			input.n_H7 = ~(H >> 7) & 1;
+			input.H6 = (H >> 6) & 1;
+			input.n_H6 = ~(H >> 6) & 1;
+			input.H5 = (H >> 5) & 1;
+			input.n_H5 = ~(H >> 5) & 1;
+			input.H4 = (H >> 4) & 1;
+			input.n_H4 = ~(H >> 4) & 1;
+			input.H3 = (H >> 3) & 1;
+			input.n_H3 = ~(H >> 3) & 1;
+			input.H2 = (H >> 2) & 1;
+			input.n_H2 = ~(H >> 2) & 1;
+			input.H1 = (H >> 1) & 1;
+			input.n_H1 = ~(H >> 1) & 1;
+			input.H0 = H & 1;
+			input.n_H0 = ~H & 1;
+
+			input.VB = (n >> 9) & 1;
+			input.BLNK = (n >> 10) & 1;
+
+			TriState* outputs;
+			hpla->sim(input.packed_bits, &outputs);
+
+			for (size_t i = 0; i < hpla_outputs; i++)
+			{
+				hpla_lut[n][i] = outputs[i];
+			}
+		}
+
+		for (size_t n = 0; n < vpla_lut_size; n++)
+		{
+			VDecoderInput input{};
+			size_t V = n;
+
+			input.V8 = (V >> 8) & 1;
+			input.n_V8 = ~(V >> 8) & 1;
+			input.V7 = (V >> 7) & 1;
+			input.n_V7 = ~(V >> 7) & 1;
+			input.V6 = (V >> 6) & 1;
+			input.n_V6 = ~(V >> 6) & 1;
+			input.V5 = (V >> 5) & 1;
+			input.n_V5 = ~(V >> 5) & 1;
+			input.V4 = (V >> 4) & 1;
+			input.n_V4 = ~(V >> 4) & 1;
+			input.V3 = (V >> 3) & 1;
+			input.n_V3 = ~(V >> 3) & 1;
+			input.V2 = (V >> 2) & 1;
+			input.n_V2 = ~(V >> 2) & 1;
+			input.V1 = (V >> 1) & 1;
+			input.n_V1 = ~(V >> 1) & 1;
+			input.V0 = V & 1;
+			input.n_V0 = ~V & 1;
+
+			TriState* outputs;
+			vpla->sim(input.packed_bits, &outputs);
+
+			for (size_t i = 0; i < vpla_outputs; i++)
+			{
+				vpla_lut[n][i] = outputs[i];
+			}
+		}
+	}
+
 	void HVDecoder::sim_HDecoder(TriState VB, TriState BLNK, TriState** outputs)
 	{
-		HDecoderInput input{};
-
-		input.H8 = ppu->h->getBit(8);
-		input.n_H8 = NOT(ppu->h->getBit(8));
-		input.H7 = ppu->h->getBit(7);
-		input.n_H7 = NOT(ppu->h->getBit(7));
-		input.H6 = ppu->h->getBit(6);
-		input.n_H6 = NOT(ppu->h->getBit(6));
-		input.H5 = ppu->h->getBit(5);
-		input.n_H5 = NOT(ppu->h->getBit(5));
-		input.H4 = ppu->h->getBit(4);
-		input.n_H4 = NOT(ppu->h->getBit(4));
-		input.H3 = ppu->h->getBit(3);
-		input.n_H3 = NOT(ppu->h->getBit(3));
-		input.H2 = ppu->h->getBit(2);
-		input.n_H2 = NOT(ppu->h->getBit(2));
-		input.H1 = ppu->h->getBit(1);
-		input.n_H1 = NOT(ppu->h->getBit(1));
-		input.H0 = ppu->h->getBit(0);
-		input.n_H0 = NOT(ppu->h->getBit(0));
-
-		input.VB = VB == TriState::One ? 1 : 0;
-		input.BLNK = BLNK == TriState::One ? 1 : 0;
-
-		hpla->sim(input.packed_bits, outputs);
+		size_t n = ppu->h->get();
+		n |= (VB == TriState::One ? 1ULL : 0) << 9;
+		n |= (BLNK == TriState::One ? 1ULL : 0) << 10;
+
+		*outputs = hpla_lut[n];
 	}
 
 	void HVDecoder::sim_VDecoder(TriState** outputs)
 	{
-		VDecoderInput input{};
-
-		input.V8 = ppu->v->getBit(8);
-		input.n_V8 = NOT(ppu->v->getBit(8));
-		input.V7 = ppu->v->getBit(7);
-		input.n_V7 = NOT(ppu->v->getBit(7));
-		input.V6 = ppu->v->getBit(6);
-		input.n_V6 = NOT(ppu->v->getBit(6));
-		input.V5 = ppu->v->getBit(5);
-		input.n_V5 = NOT(ppu->v->getBit(5));
-		input.V4 = ppu->v->getBit(4);
-		input.n_V4 = NOT(ppu->v->getBit(4));
-		input.V3 = ppu->v->getBit(3);
-		input.n_V3 = NOT(ppu->v->getBit(3));
-		input.V2 = ppu->v->getBit(2);
-		input.n_V2 = NOT(ppu->v->getBit(2));
-		input.V1 = ppu->v->getBit(1);
-		input.n_V1 = NOT(ppu->v->getBit(1));
-		input.V0 = ppu->v->getBit(0);
-		input.n_V0 = NOT(ppu->v->getBit(0));
-
-		vpla->sim(input.packed_bits, outputs);
+		*outputs = vpla_lut[ppu->v->get()];
 	}
 }
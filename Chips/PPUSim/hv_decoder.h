@@ -75,6 +75,18 @@ namespace PPUSim
 		BaseLogic::PLA* hpla = nullptr;
 		BaseLogic::PLA* vpla = nullptr;
 
+		// The PLA outputs are a pure function of the counter values (and VB/BLNK for HPLA), so they are precomputed for every counter value.
+		// HPLA index: H | (VB << 9) | (BLNK << 10), VPLA index: V.
+
+		static const size_t hpla_lut_size = 1 << 11;
+		static const size_t vpla_lut_size = 1 << 9;
+		static const size_t vpla_outputs_max = 10;
+
+		BaseLogic::TriState hpla_lut[hpla_lut_size][24]{};
+		BaseLogic::TriState vpla_lut[vpla_lut_size][vpla_outputs_max]{};
+
+		void BuildLUT();
+
 	public:
 		HVDecoder(PPU* parent);
 		~HVDecoder();
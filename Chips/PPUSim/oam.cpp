@@ -10,69 +10,60 @@ namespace PPUSim
 	{
 		ppu = parent;
 
-		for (size_t n = 0; n < 8; n++)
+		switch (ppu->rev)
 		{
-			switch (ppu->rev)
-			{
-				// TBD: Check how things are in other RGB PPUs.
+			// TBD: Check how things are in other RGB PPUs.
 
-				case Revision::RP2C04_0003:
-					ob[n] = new OAMBufferBit_RGB(ppu);
-					break;
+			case Revision::RP2C04_0003:
+				write_only = true;
+				break;
 
-				default:
-					ob[n] = new OAMBufferBit(ppu);
-					break;
-			}
+			default:
+				break;
 		}
 
-		for (size_t n = 0; n < num_lanes; n++)
+		for (size_t n = 0; n < OAMCells::total_size; n++)
 		{
-			lane[n] = new OAMLane(ppu, n == 2 || n == 6);
+			// A cell that was never written does not decay (the same as the baseline OAMCell: savedPclk = -1 and pclksToDecay = 0 until the first write).
+
+			cells.decayAt[n] = (size_t)-1;
+
+			// Skip unused bits 2-4 for rows 2/6, which correspond to the attribute byte.
+
+			size_t row = n & 7;
+			if (n < OAMCells::oam_size && (row == 2 || row == 6))
+			{
+				cells.missing[n] = 0b00011100;
+			}
 		}
 	}
 
 	OAM::~OAM()
 	{
-		for (size_t n = 0; n < 8; n++)
-		{
-			delete ob[n];
-		}
-
-		for (size_t n = 0; n < num_lanes; n++)
-		{
-			delete lane[n];
-		}
 	}
 
 	void OAM::sim()
 	{
-		OAMLane* lane = sim_AddressDecoder();
+		bool precharge = false;
+		size_t cell = sim_AddressDecoder(precharge);
 		sim_OBControl();
-		sim_OB(lane);
+		sim_OB(cell, precharge);
 	}
 
 	/// <summary>
-	/// From the input OAM address (n_OAM0-7 + OAM8) determines the row (lane) and column number (COL).
-	/// During PCLK the precharge is made and all COLx outputs are 0. This situation is handled by returning nullptr instead of lane.
+	/// From the input OAM address (n_OAM0-7 + OAM8) determines the row (lane) and column number (COL) and returns the index of the cell.
+	/// During PCLK the precharge is made and all COLx outputs are 0. This situation is handled by setting `precharge`.
 	/// </summary>
 	/// <returns></returns>
-	OAMLane* OAM::sim_AddressDecoder()
+	size_t OAM::sim_AddressDecoder(bool& precharge)
 	{
 		size_t row = 0;
 
-		if (ppu->wire.OAM8 == TriState::One)
-		{
-			row = 8;
-		}
-		else
+		for (size_t n = 0; n < 3; n++)
 		{
-			for (size_t n = 0; n < 3; n++)
+			if (ppu->wire.n_OAM[n] == TriState::Zero)
 			{
-				if (ppu->wire.n_OAM[n] == TriState::Zero)
-				{
-					row |= (1ULL << n);
-				}
+				row |= (1ULL << n);
 			}
 		}
 
@@ -88,7 +79,9 @@ namespace PPUSim
 
 		COL = ColMap(COL);
 
-		return ppu->wire.PCLK == TriState::One ? nullptr : lane[row];
+		precharge = ppu->wire.PCLK == TriState::One;
+
+		return ppu->wire.OAM8 == TriState::One ? (OAMCells::oam_size + COL) : ((COL << 3) | row);
 	}
 
 	void OAM::sim_OBControl()
@@ -118,17 +111,15 @@ namespace PPUSim
 	/// </summary>
 	void OAM::sim_OFETCH()
 	{
-		switch (ppu->rev)
-		{
-			// TBD: Find out how the rest of the RGB PPUs are doing
-
-			case Revision::RP2C04_0003:
-				sim_OFETCH_RGB_PPU();
-				break;
+		// TBD: Find out how the rest of the RGB PPUs are doing
 
-			default:
-				sim_OFETCH_Default();
-				break;
+		if (ppu->traits.RGB)
+		{
+			sim_OFETCH_RGB_PPU();
+		}
+		else
+		{
+			sim_OFETCH_Default();
 		}
 	}
 
@@ -172,168 +163,118 @@ namespace PPUSim
 		OFETCH_FF.set(MUX(PCLK, NOT(NOT(OFETCH_FF.get())), W4_Enable));
 	}
 
-	void OAM::sim_OB(OAMLane* lane)
+	/// <summary>
+	/// OAM Buffer. All 8 bits are processed at once, `zmask` marks the bits for which the cell did not drive the column (`z`).
+	/// </summary>
+	void OAM::sim_OB(size_t cell, bool precharge)
 	{
+		TriState PCLK = ppu->wire.PCLK;
+		TriState n_R4 = ppu->wire.n_R4;
+		TriState n_DBE = ppu->wire.n_DBE;
+		TriState BLNK = ppu->fsm.BLNK;
+		TriState I_OAM2 = ppu->fsm.IOAM2;
 		TriState n_WE = ppu->wire.n_WE;
 
-		for (size_t n = 0; n < 8; n++)
+		uint8_t zmask = 0xff;
+		uint8_t FromOAM = 0;
+		if (!precharge)
 		{
-			ob[n]->sim(lane, COL, n, OB_OAM, n_WE);
+			FromOAM = ReadCell(cell, zmask);
 		}
-	}
-
-	TriState OAMCell::get()
-	{
-		size_t pclkNow = ppu->GetPCLKCounter();
-		if (pclkNow >= (savedPclk + pclksToDecay))
-		{
-			switch (ppu->oam->GetOamDecayBehavior())
-			{
-				case OAMDecayBehavior::Keep:
-					return decay_ff.get();
-
-				case OAMDecayBehavior::ToZero:
-					return TriState::Zero;
-
-				case OAMDecayBehavior::ToOne:
-					return TriState::One;
 
-				case OAMDecayBehavior::Evaporate:
-					return TriState::Z;
+		// The floating input does not change the state of the FF.
 
-				case OAMDecayBehavior::Randomize:
-#ifdef _WIN32
-					// Year 2022. C++ still doesn't contain a standard way to get TimeStamp.
-					return FromByte (__rdtsc() & 1);
-#else
-					// TBD
-					return TriState::Zero;
-#endif
-
-				default:
-					break;
-			}
-
-			return TriState::Z;
+		if (PCLK == TriState::One)
+		{
+			Input_FF = 0;
 		}
 		else
 		{
-			return decay_ff.get();
+			Input_FF = (Input_FF & zmask) | (FromOAM & ~zmask);
+			OB_FF = I_OAM2 == TriState::One ? 0xff : Input_FF;
 		}
-	}
 
-	void OAMCell::set(TriState val)
-	{
-		savedPclk = ppu->GetPCLKCounter();
-		DetermineDecay();
-		decay_ff.set(val);
-	}
+		uint8_t OBOut = OB_FF;
+		Unpack(OBOut, ppu->wire.OB);
 
-	void OAMCell::DetermineDecay()
-	{
-		// TBD: You can tweak individual statistical behavior (PRNG, in range, depending on ambient "temperature", etc.)
-
-		pclksToDecay = 1000000;	// now just a constant
-	}
-
-	void OAMCell::SetTopo(OAMCellTopology place, size_t bank_num)
-	{
-		topo = place;
-		bank = bank_num;
-	}
-
-	void OAMBufferBit::sim(OAMLane* lane, size_t column, size_t bit_num, TriState OB_OAM, TriState n_WE)
-	{
-		TriState PCLK = ppu->wire.PCLK;
-		TriState n_R4 = ppu->wire.n_R4;
-		TriState n_DBE = ppu->wire.n_DBE;
-		TriState BLNK = ppu->fsm.BLNK;
-		TriState I_OAM2 = ppu->fsm.IOAM2;
+		if (!write_only)
+		{
+			if (PCLK == TriState::One)
+			{
+				R4_out_latch = OBOut;
+			}
 
-		auto n_R4_Enable = NOT(NOR(n_R4, n_DBE));
+			if (NOR(n_R4, n_DBE) == TriState::One)
+			{
+				ppu->DB = R4_out_latch;
+			}
+		}
 
-		TriState FromOAM = TriState::Z;
-		if (lane != nullptr)
+		if (BLNK == TriState::One)
 		{
-			lane->sim(column, bit_num, FromOAM);
+			out_latch = ppu->DB;
 		}
-
-		Input_FF.set(MUX(PCLK, FromOAM, TriState::Zero));
-		OB_FF.set(NOT(MUX(PCLK, NOR(I_OAM2, Input_FF.get()), NOT(OB_FF.get()))));
-		auto OBOut = OB_FF.get();
-		ppu->wire.OB[bit_num] = OBOut;
-		R4_out_latch.set(OBOut, PCLK);
-		ppu->SetDBBit(bit_num, MUX(NOT(n_R4_Enable), TriState::Z, R4_out_latch.get()));
-		out_latch.set(MUX(BLNK, MUX(OB_OAM, TriState::Z, OBOut), ppu->GetDBBit(bit_num)), TriState::One);
-
-		if (lane != nullptr)
+		else if (OB_OAM == TriState::One)
 		{
-			TriState val_out = MUX(NOT(n_WE), TriState::Z, out_latch.get());
-			lane->sim(column, bit_num, val_out);
+			out_latch = OBOut;
 		}
-	}
 
-	TriState OAMBufferBit::get()
-	{
-		return OB_FF.get();
-	}
-
-	void OAMBufferBit::set(TriState val)
-	{
-		return OB_FF.set(val);
+		if (!precharge && n_WE == TriState::Zero)
+		{
+			WriteCell(cell, out_latch);
+		}
 	}
 
-	OAMLane::OAMLane(PPU* parent, bool SkipAttrBits)
+	/// <summary>
+	/// Read the cell. The bits for which there is no drive on the column (missing or "evaporated" cells) are set in `zmask`.
+	/// </summary>
+	uint8_t OAM::ReadCell(size_t cell, uint8_t& zmask)
 	{
-		ppu = parent;
-		skip_attr_bits = SkipAttrBits;
+		uint8_t val = cells.mem[cell];
+		zmask = cells.missing[cell];
 
-		for (size_t n = 0; n < cells_per_lane; n++)
+		if (ppu->GetPCLKCounter() >= cells.decayAt[cell])
 		{
-			cells[n] = new OAMCell(ppu);
+			switch (decay_behav)
+			{
+				case OAMDecayBehavior::Keep:
+					break;
 
-			size_t bit = n / 8;
-			size_t bank = bit < 4 ? 0 : 1;
+				case OAMDecayBehavior::ToZero:
+					val = 0;
+					break;
 
-			OAMCellTopology topo = OAMCellTopology::Middle;
+				case OAMDecayBehavior::ToOne:
+					val = 0xff;
+					break;
 
-			// TBD: Topology
+				case OAMDecayBehavior::Evaporate:
+					zmask = 0xff;
+					break;
 
-			cells[n]->SetTopo(topo, bank);
-		}
-	}
+				case OAMDecayBehavior::Randomize:
+#ifdef _WIN32
+					// Year 2022. C++ still doesn't contain a standard way to get TimeStamp.
+					val = (uint8_t)__rdtsc();
+#else
+					// TBD
+					val = 0;
+#endif
+					break;
 
-	OAMLane::~OAMLane()
-	{
-		for (size_t n = 0; n < cells_per_lane; n++)
-		{
-			delete cells[n];
+				default:
+					zmask = 0xff;
+					break;
+			}
 		}
+
+		return val & ~zmask;
 	}
 
-	/// <summary>
-	/// Repeats the logic of the real cell.
-	/// If the input is z - place the cell value on it (Read), otherwise - write a new value to the cell (Write).
-	/// </summary>
-	void OAMLane::sim(size_t Column, size_t bit_num, TriState& inOut)
+	void OAM::WriteCell(size_t cell, uint8_t val)
 	{
-		OAMCell* cell = cells[8 * Column + bit_num];
-
-		// Skip unused bits 2-4 for rows 2/6, which correspond to the attribute byte.
-
-		bool skip_bit = skip_attr_bits && (bit_num == 2 || bit_num == 3 || bit_num == 4);
-
-		if (!skip_bit)
-		{
-			if (inOut == TriState::Z)
-			{
-				inOut = cell->get();
-			}
-			else
-			{
-				cell->set(inOut);
-			}
-		}
+		cells.mem[cell] = val & ~cells.missing[cell];
+		cells.decayAt[cell] = ppu->GetPCLKCounter() + pclksToDecay;
 	}
 
 	/// <summary>
@@ -355,79 +296,72 @@ namespace PPUSim
 
 	TriState OAM::get_OB(size_t bit_num)
 	{
-		return ob[bit_num]->get();
+		return (TriState)((OB_FF >> bit_num) & 1);
 	}
 
 	void OAM::set_OB(size_t bit_num, TriState val)
 	{
-		ob[bit_num]->set(val);
+		if (val != TriState::Z)
+		{
+			OB_FF = (OB_FF & ~(1 << bit_num)) | ((val & 1) << bit_num);
+		}
 	}
 
 	uint8_t OAM::Dbg_OAMReadByte(size_t addr)
 	{
-		size_t row = addr & 7;
-		OAMLane* l = lane[row];
-		size_t col = addr >> 3;
-		TriState val[8]{};
+		// Set the unused bits of the attribute byte to 0.
 
-		for (size_t bit_num = 0; bit_num < 8; bit_num++)
-		{
-			val[bit_num] = TriState::Z;
-			l->sim(col, bit_num, val[bit_num]);
+		uint8_t zmask;
+		return ReadCell(addr & 0xff, zmask);
+	}
 
-			// Set the unused bits of the attribute byte to 0.
+	uint8_t OAM::Dbg_TempOAMReadByte(size_t addr)
+	{
+		uint8_t zmask;
+		return ReadCell(OAMCells::oam_size + (addr & 0x1f), zmask);
+	}
 
-			if (val[bit_num] == TriState::Z)
+	/// <summary>
+	/// Copy out the cells as the debugger sees them (same as Dbg_OAMReadByte for each cell).
+	/// While the cells are kept on decay, the packed storage is copied as is and only the missing bits are cleared.
+	/// </summary>
+	void OAM::ReadCells(size_t first, uint8_t* ptr, size_t size)
+	{
+		if (decay_behav != OAMDecayBehavior::Keep)
+		{
+			uint8_t zmask;
+			for (size_t n = 0; n < size; n++)
 			{
-				val[bit_num] = TriState::Zero;
+				ptr[n] = ReadCell(first + n, zmask);
 			}
+			return;
 		}
 
-		return Pack(val);
+		memcpy(ptr, &cells.mem[first], size);
+		for (size_t n = 0; n < size; n++)
+		{
+			ptr[n] &= ~cells.missing[first + n];
+		}
 	}
 
-	uint8_t OAM::Dbg_TempOAMReadByte(size_t addr)
+	void OAM::Dbg_OAMReadBlock(uint8_t* ptr, size_t size)
 	{
-		OAMLane* l = lane[8];
-		size_t col = addr;
-		TriState val[8]{};
-
-		for (size_t bit_num = 0; bit_num < 8; bit_num++)
-		{
-			val[bit_num] = TriState::Z;
-			l->sim(col, bit_num, val[bit_num]);
-		}
+		ReadCells(0, ptr, std::min(size, OAMCells::oam_size));
+	}
 
-		return Pack(val);
+	void OAM::Dbg_TempOAMReadBlock(uint8_t* ptr, size_t size)
+	{
+		ReadCells(OAMCells::oam_size, ptr, std::min(size, OAMCells::temp_oam_size));
 	}
 
 	void OAM::Dbg_OAMWriteByte(size_t addr, uint8_t value)
 	{
-		size_t row = addr & 7;
-		OAMLane* l = lane[row];
-		size_t col = addr >> 3;
-		TriState val[8]{};
-
-		Unpack(value, val);
-
-		for (size_t bit_num = 0; bit_num < 8; bit_num++)
-		{
-			l->sim(col, bit_num, val[bit_num]);
-		}
+		WriteCell(addr & 0xff, value);
 	}
 
 	void OAM::Dbg_TempOAMWriteByte(size_t addr, uint8_t value)
 	{
-		OAMLane* l = lane[8];
-		size_t col = addr;
-		TriState val[8]{};
-
-		Unpack(value, val);
-
-		for (size_t bit_num = 0; bit_num < 8; bit_num++)
-		{
-			l->sim(col, bit_num, val[bit_num]);
-		}
+		WriteCell(OAMCells::oam_size + (addr & 0x1f), value);
 	}
 
 	void OAM::SetOamDecayBehavior(OAMDecayBehavior behavior)
@@ -440,51 +374,13 @@ namespace PPUSim
 		return decay_behav;
 	}
 
-	/// <summary>
-	/// The different version for RGB PPU (the one studied) is that OAM is Write-Only.
-	/// </summary>
-	void OAMBufferBit_RGB::sim(OAMLane* lane, size_t column, size_t bit_num, TriState OB_OAM, TriState n_WE)
-	{
-		TriState PCLK = ppu->wire.PCLK;
-		TriState BLNK = ppu->fsm.BLNK;
-		TriState I_OAM2 = ppu->fsm.IOAM2;
-
-		TriState FromOAM = TriState::Z;
-		if (lane != nullptr)
-		{
-			lane->sim(column, bit_num, FromOAM);
-		}
-
-		Input_FF.set(MUX(PCLK, FromOAM, TriState::Zero));
-		OB_FF.set(NOT(MUX(PCLK, NOR(I_OAM2, Input_FF.get()), NOT(OB_FF.get()))));
-		auto OBOut = OB_FF.get();
-		ppu->wire.OB[bit_num] = OBOut;
-		out_latch.set(MUX(BLNK, MUX(OB_OAM, TriState::Z, OBOut), ppu->GetDBBit(bit_num)), TriState::One);
-
-		if (lane != nullptr)
-		{
-			TriState val_out = MUX(NOT(n_WE), TriState::Z, out_latch.get());
-			lane->sim(column, bit_num, val_out);
-		}
-	}
-
 	uint32_t OAM::Dbg_Get_OAMBuffer()
 	{
-		TriState val_lo[8]{};
-		for (size_t n = 0; n < 8; n++)
-		{
-			val_lo[n] = get_OB(n);
-		}
-		return Pack(val_lo);
+		return OB_FF;
 	}
 
 	void OAM::Dbg_Set_OAMBuffer(uint32_t value)
 	{
-		TriState val_lo[8]{};
-		Unpack(value, val_lo);
-		for (size_t n = 0; n < 8; n++)
-		{
-			set_OB(n, val_lo[n]);
-		}
+		OB_FF = (uint8_t)value;
 	}
-}
+}
\ No newline at end of file
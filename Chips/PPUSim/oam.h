@@ -4,96 +4,25 @@
 
 namespace PPUSim
 {
-	enum class OAMCellTopology
-	{
-		TopLeft = 0,
-		TopRight,
-		BottomLeft,
-		BottomRight,
-		Middle,
-	};
-
 	/// <summary>
-	/// OAM Cell. The decay simulation is done simply by the PCLK counter. 
-	/// If a cell has not been updated for a long time, its value "fades away" (becomes equal to `z`).
+	/// OAM and Temp OAM cells are stored as plain bytes. All 8 bits of a column are always read and written together, so the cell decay bookkeeping is kept per byte.
+	/// The decay simulation is done simply by the PCLK counter. If a cell has not been updated for a long time, its value "fades away" (see OAMDecayBehavior).
 	/// </summary>
-	class OAMCell
-	{
-		PPU* ppu = nullptr;
-		BaseLogic::FF decay_ff;
-
-		// The value of the global PCLK counter at the time of writing to the cell.
-		// Initially, all cells are in limbo, since there is no drive on them.
-		size_t savedPclk = (size_t)-1;
-
-		// Timeout after which the cell value "fades away".
-		size_t pclksToDecay = 0;
-
-		void DetermineDecay();
-
-		// Determines the geometric location of the cell in the bank. May be useful for determining the decay time.
-		OAMCellTopology topo = OAMCellTopology::Middle;
-
-		// Bank number (0: upper OAM bank, 1: lower OAM bank).
-		size_t bank = 0;
-
-	public:
-		OAMCell(PPU* parent) { ppu = parent; }
-		~OAMCell() {}
-
-		BaseLogic::TriState get();
-		void set(BaseLogic::TriState val);
-
-		void SetTopo(OAMCellTopology place, size_t bank_num);
-	};
-
-	class OAMLane
+	struct OAMCells
 	{
-		PPU* ppu = nullptr;
-
-		static const size_t cells_per_lane = 32 * 8;	// 32 Columns x 8 Bits
+		static const size_t oam_size = 256;
+		static const size_t temp_oam_size = 32;
+		static const size_t total_size = oam_size + temp_oam_size;
 
-		OAMCell* cells[cells_per_lane];
+		// Index 0-255: OAM (in the OAM address order, row = addr[0-2], column = addr[3-7]), 256-287: Temp OAM.
+		uint8_t mem[total_size]{};
 
-		bool skip_attr_bits = false;
-
-	public:
-		OAMLane(PPU *parent, bool SkipAttrBits);
-		~OAMLane();
-
-		void sim(size_t Column, size_t bit_num, BaseLogic::TriState& inOut);
-	};
-
-	class OAMBufferBit
-	{
-	protected:
-		PPU* ppu = nullptr;
-
-		BaseLogic::FF Input_FF;
-		BaseLogic::FF OB_FF;
-		BaseLogic::DLatch R4_out_latch;
-		BaseLogic::DLatch out_latch;
-
-	public:
-		OAMBufferBit(PPU* parent) { ppu = parent; }
-		~OAMBufferBit() {}
-
-		virtual void sim(OAMLane *lane, size_t column, size_t bit_num, BaseLogic::TriState OB_OAM, BaseLogic::TriState n_WE);
-
-		BaseLogic::TriState get();
-		void set(BaseLogic::TriState val);
-	};
-
-	/// <summary>
-	/// Special version for RGB PPU.
-	/// </summary>
-	class OAMBufferBit_RGB : public OAMBufferBit
-	{
-	public:
-		OAMBufferBit_RGB(PPU* parent) : OAMBufferBit(parent) {}
-		~OAMBufferBit_RGB() {}
+		// The value of the global PCLK counter after which the cell value "fades away".
+		// Initially, all cells are in limbo, since there is no drive on them.
+		size_t decayAt[total_size];
 
-		virtual void sim(OAMLane* lane, size_t column, size_t bit_num, BaseLogic::TriState OB_OAM, BaseLogic::TriState n_WE);
+		// Cells that are physically missing (unused bits 2-4 of the attribute byte). They always read as `z`.
+		uint8_t missing[total_size]{};
 	};
 
 	class OAM
@@ -101,10 +30,16 @@ namespace PPUSim
 		friend PPUSimUnitTest::UnitTest;
 		PPU* ppu = nullptr;
 
-		static const size_t num_lanes = 8 + 1;	// 0-7: OAM, 8: TempOAM
-		OAMLane* lane[num_lanes];
+		OAMCells cells;
+
+		// OAM Buffer (OB) and its latches, all 8 bits at once.
+		uint8_t Input_FF = 0;
+		uint8_t OB_FF = 0;
+		uint8_t R4_out_latch = 0;
+		uint8_t out_latch = 0;
 
-		OAMBufferBit *ob[8];
+		// RGB PPU (the one studied) has Write-Only OAM: there is no path OB -> DB via $2004.
+		bool write_only = false;
 
 		BaseLogic::FF OFETCH_FF;
 		BaseLogic::FF W4_FF;
@@ -115,14 +50,22 @@ namespace PPUSim
 		// The physical location of the column on the chip.
 		size_t COL = 0;
 
-		OAMLane* sim_AddressDecoder();
+		size_t sim_AddressDecoder(bool& precharge);
 		void sim_OBControl();
-		void sim_OB(OAMLane *lane);
+		void sim_OB(size_t cell, bool precharge);
 
 		size_t ColMap(size_t n);
 
 		OAMDecayBehavior decay_behav = OAMDecayBehavior::Keep;
 
+		// Timeout after which the cell value "fades away".
+		// TBD: You can tweak individual statistical behavior (PRNG, in range, depending on ambient "temperature", etc.)
+		static const size_t pclksToDecay = 1000000;
+
+		uint8_t ReadCell(size_t cell, uint8_t& zmask);
+		void ReadCells(size_t first, uint8_t* ptr, size_t size);
+		void WriteCell(size_t cell, uint8_t val);
+
 		void sim_OFETCH_Default();
 		void sim_OFETCH_RGB_PPU();
 
@@ -141,6 +84,8 @@ namespace PPUSim
 		uint8_t Dbg_TempOAMReadByte(size_t addr);
 		void Dbg_OAMWriteByte(size_t addr, uint8_t val);
 		void Dbg_TempOAMWriteByte(size_t addr, uint8_t val);
+		void Dbg_OAMReadBlock(uint8_t* ptr, size_t size);
+		void Dbg_TempOAMReadBlock(uint8_t* ptr, size_t size);
 
 		void SetOamDecayBehavior(OAMDecayBehavior behavior);
 		OAMDecayBehavior GetOamDecayBehavior();
@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <cassert>
 #include <cstdio>
+#include <cstring>
 #include <random>
 #include <algorithm>
 #ifdef _WIN32
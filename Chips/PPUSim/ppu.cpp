@@ -14,176 +14,145 @@ namespace PPUSim
 	PPU::PPU(Revision _rev, bool VideoGen)
 	{
 		rev = _rev;
+		SetRevisionTraits();
 
 		if (!VideoGen)
 		{
-			regs = new ControlRegs(this);
-			h = new HVCounter(this, 9);
-			v = new HVCounter(this, 9);
-			hv_dec = new HVDecoder(this);
-			hv_fsm = new FSM(this);
-			cram = new CRAM(this);
-			mux = new Mux(this);
-			eval = new OAMEval(this);
-			oam = new OAM(this);
-			fifo = new FIFO(this);
-			data_reader = new DataReader(this);
-			vram_ctrl = new VRAM_Control(this);
+			regs = arena.New<ControlRegs>(this);
+			hv_fsm = arena.New<FSM>(this);
+			hv_dec = arena.New<HVDecoder>(this);
+			h = arena.New<HVCounter>(this, 9);
+			v = arena.New<HVCounter>(this, 9);
+			fifo = arena.New<FIFO>(this);
+			vram_ctrl = arena.New<VRAM_Control>(this);
+			oam = arena.New<OAM>(this);
+			eval = arena.New<OAMEval>(this);
+			data_reader = arena.New<DataReader>(this);
+			mux = arena.New<Mux>(this);
+			cram = arena.New<CRAM>(this);
 		}
 
-		vid_out = new VideoOut(this);
+		vid_out = arena.New<VideoOut>(this);
 	}
 
 	PPU::~PPU()
 	{
-		if (regs)
-			delete regs;
-		if (h)
-			delete h;
-		if (v)
-			delete v;
-		if (hv_dec)
-			delete hv_dec;
-		if (hv_fsm)
-			delete hv_fsm;
-		if (cram)
-			delete cram;
-		if (vid_out)
-			delete vid_out;
-		if (mux)
-			delete mux;
-		if (eval)
-			delete eval;
-		if (oam)
-			delete oam;
-		if (fifo)
-			delete fifo;
-		if (data_reader)
-			delete data_reader;
-		if (vram_ctrl)
-			delete vram_ctrl;
+		// The modules are destroyed together with the arena.
 	}
 
-	void PPU::sim(TriState inputs[], TriState outputs[], uint8_t* ext, uint8_t* data_bus, uint8_t* ad_bus, uint8_t* addrHi_bus, VideoOutSignal& vout)
+	void PPU::sim(Pins32& inputs, Pins32& outputs, uint8_t* ext, uint8_t* data_bus, uint8_t* ad_bus, uint8_t* addrHi_bus, VideoOutSignal& vout)
 	{
+		PROFILE_SCOPE("PPU");
+
 		// Input terminals and binding
 
-		wire.RnW = inputs[(size_t)InputPad::RnW];
-		wire.RS[0] = inputs[(size_t)InputPad::RS0];
-		wire.RS[1] = inputs[(size_t)InputPad::RS1];
-		wire.RS[2] = inputs[(size_t)InputPad::RS2];
-		wire.n_DBE = inputs[(size_t)InputPad::n_DBE];
+		wire.RnW = inputs.get((size_t)InputPad::RnW);
+		wire.RS[0] = inputs.get((size_t)InputPad::RS0);
+		wire.RS[1] = inputs.get((size_t)InputPad::RS1);
+		wire.RS[2] = inputs.get((size_t)InputPad::RS2);
+		wire.n_DBE = inputs.get((size_t)InputPad::n_DBE);
 
-		regs->sim_RWDecoder();
+		PROFILE_STAGE("regs->sim_RWDecoder", regs->sim_RWDecoder());
 
-		wire.RES = NOT(inputs[(size_t)InputPad::n_RES]);
+		wire.RES = NOT(inputs.get((size_t)InputPad::n_RES));
 
 		if (wire.RES == TriState::One)
 		{
 			ResetPCLKCounter();
 		}
 
-		wire.CLK = inputs[(size_t)InputPad::CLK];
+		wire.CLK = inputs.get((size_t)InputPad::CLK);
 		wire.n_CLK = NOT(wire.CLK);
 
-		sim_PCLK();
+		PROFILE_STAGE("sim_PCLK", sim_PCLK());
 
-		hv_fsm->sim_RESCL_early();
+		PROFILE_STAGE("hv_fsm->sim_RESCL_early", hv_fsm->sim_RESCL_early());
 
 		Reset_FF.set(NOR(fsm.RESCL, NOR(wire.RES, Reset_FF.get())));
 		wire.RC = NOT(Reset_FF.nget());
 
-		sim_BusInput(ext, data_bus, ad_bus);
+		PROFILE_STAGE("sim_BusInput", sim_BusInput(ext, data_bus, ad_bus));
 
 		// Regs
 
-		regs->sim();
+		PROFILE_STAGE("regs->sim", regs->sim());
 
 		if (Prev_PCLK != wire.PCLK)
 		{
 			// H/V Control logic
 
 			TriState* HPLA;
-			hv_dec->sim_HDecoder(hv_fsm->get_VB(), hv_fsm->get_BLNK(wire.BLACK), &HPLA);
+			PROFILE_STAGE("hv_dec->sim_HDecoder", hv_dec->sim_HDecoder(hv_fsm->get_VB(), hv_fsm->get_BLNK(wire.BLACK), &HPLA));
 			TriState* VPLA;
-			hv_dec->sim_VDecoder(&VPLA);
+			PROFILE_STAGE("hv_dec->sim_VDecoder", hv_dec->sim_VDecoder(&VPLA));
 
-			hv_fsm->sim(HPLA, VPLA);
+			PROFILE_STAGE("hv_fsm->sim", hv_fsm->sim(HPLA, VPLA));
 
-			h->sim(TriState::One, wire.HC);
+			PROFILE_STAGE("h->sim", h->sim(TriState::One, wire.HC));
 			TriState V_IN = HPLA[23];
-			v->sim(V_IN, wire.VC);
+			PROFILE_STAGE("v->sim", v->sim(V_IN, wire.VC));
 
 			// The other parts
 
-			fifo->sim_SpriteH();
+			PROFILE_STAGE("fifo->sim_SpriteH", fifo->sim_SpriteH());
 
-			regs->sim_CLP();
+			PROFILE_STAGE("regs->sim_CLP", regs->sim_CLP());
 
-			vram_ctrl->sim();
+			PROFILE_STAGE("vram_ctrl->sim", vram_ctrl->sim());
 
-			oam->sim_OFETCH();
+			PROFILE_STAGE("oam->sim_OFETCH", oam->sim_OFETCH());
 
-			eval->sim();
+			PROFILE_STAGE("eval->sim", eval->sim());
 
-			oam->sim();
+			PROFILE_STAGE("oam->sim", oam->sim());
 
-			data_reader->sim();
+			PROFILE_STAGE("data_reader->sim", data_reader->sim());
 
-			fifo->sim();
+			PROFILE_STAGE("fifo->sim", fifo->sim());
 
-			vram_ctrl->sim_TH_MUX();
+			PROFILE_STAGE("vram_ctrl->sim_TH_MUX", vram_ctrl->sim_TH_MUX());
 
-			vram_ctrl->sim_ReadBuffer();
+			PROFILE_STAGE("vram_ctrl->sim_ReadBuffer", vram_ctrl->sim_ReadBuffer());
 
-			mux->sim();
+			PROFILE_STAGE("mux->sim", mux->sim());
 
-			cram->sim();
+			PROFILE_STAGE("cram->sim", cram->sim());
 
 			Prev_PCLK = wire.PCLK;
 		}
 
-		vid_out->sim(vout);
+		PROFILE_STAGE("vid_out->sim", vid_out->sim(vout));
 
 		// Output terminals
 
-		outputs[(size_t)OutputPad::n_INT] = fsm.INT ? TriState::Zero : TriState::Z;
-		outputs[(size_t)OutputPad::ALE] = NOT(wire.n_ALE);
-		outputs[(size_t)OutputPad::n_RD] = NOT(wire.RD);
-		outputs[(size_t)OutputPad::n_WR] = NOT(wire.WR);
+		outputs.set((size_t)OutputPad::n_INT, fsm.INT ? TriState::Zero : TriState::Z);
+		outputs.set((size_t)OutputPad::ALE, NOT(wire.n_ALE));
+		outputs.set((size_t)OutputPad::n_RD, NOT(wire.RD));
+		outputs.set((size_t)OutputPad::n_WR, NOT(wire.WR));
 
-		sim_BusOutput(ext, data_bus, ad_bus, addrHi_bus);
+		PROFILE_STAGE("sim_BusOutput", sim_BusOutput(ext, data_bus, ad_bus, addrHi_bus));
 	}
 
 	void PPU::sim_BusInput(uint8_t* ext, uint8_t* data_bus, uint8_t* ad_bus)
 	{
-		switch (rev)
+		if (traits.ExtPins)
 		{
-			case Revision::RP2C02G:
-			case Revision::RP2C02H:
-			case Revision::RP2C07_0:
-			case Revision::UMC_UA6538:
-			{
-				TriState nSLAVE = regs->get_nSLAVE();
+			TriState nSLAVE = regs->get_nSLAVE();
 
-				for (size_t n = 0; n < 4; n++)
-				{
-					TriState extIn = (((*ext) >> n) & 1) ? TriState::One : TriState::Zero;
-					wire.EXT_In[n] = NOR(NOT(extIn), nSLAVE);
-				}
+			for (size_t n = 0; n < 4; n++)
+			{
+				TriState extIn = (((*ext) >> n) & 1) ? TriState::One : TriState::Zero;
+				wire.EXT_In[n] = NOR(NOT(extIn), nSLAVE);
 			}
-			break;
-
+		}
+		else if (traits.RGB)
+		{
 			// TBD: The other RGB PPU's appear to be similar, but there are no pictures yet, we do not speculate.
 
-			case Revision::RP2C04_0003:
+			for (size_t n = 0; n < 4; n++)
 			{
-				for (size_t n = 0; n < 4; n++)
-				{
-					wire.EXT_In[n] = TriState::Zero;
-				}
+				wire.EXT_In[n] = TriState::Zero;
 			}
-			break;
 		}
 
 		if (wire.n_WR == TriState::Zero)
@@ -198,35 +167,24 @@ namespace PPUSim
 	{
 		TriState n_PCLK = wire.n_PCLK;
 
-		switch (rev)
+		// There are no EXT terminals in the RGB PPUs.
+
+		if (traits.ExtPins)
 		{
-			case Revision::RP2C02G:
-			case Revision::RP2C02H:
-			case Revision::RP2C07_0:
-			case Revision::UMC_UA6538:
+			for (size_t n = 0; n < 4; n++)
 			{
-				for (size_t n = 0; n < 4; n++)
-				{
-					extout_latch[n].set(wire.n_EXT_Out[n], n_PCLK);
-				}
-
-				if (wire.n_SLAVE == TriState::One)
-				{
-					*ext = 0;
-					for (size_t n = 0; n < 4; n++)
-					{
-						TriState extOut = NOR(NOT(wire.n_SLAVE), extout_latch[n].get());
-						(*ext) |= ((extOut == TriState::One) ? 1 : 0) << n;
-					}
-				}
+				extout_latch[n].set(wire.n_EXT_Out[n], n_PCLK);
 			}
-			break;
 
-			case Revision::RP2C04_0003:
+			if (wire.n_SLAVE == TriState::One)
 			{
-				// There are no EXT terminals in the RGB PPUs.
+				*ext = 0;
+				for (size_t n = 0; n < 4; n++)
+				{
+					TriState extOut = NOR(NOT(wire.n_SLAVE), extout_latch[n].get());
+					(*ext) |= ((extOut == TriState::One) ? 1 : 0) << n;
+				}
 			}
-			break;
 		}
 
 		if (wire.n_RD == TriState::Zero)
@@ -252,6 +210,45 @@ namespace PPUSim
 		*addrHi_bus = PATop;
 	}
 
+	void PPU::SetRevisionTraits()
+	{
+		traits = RevisionTraits();
+
+		switch (rev)
+		{
+			case Revision::RP2C02G:
+				traits.NTSC = true;
+				traits.ExtPins = true;
+				traits.EvenOdd = EvenOddCircuit::NTSC;
+				break;
+
+			case Revision::RP2C02H:
+				traits.NTSC = true;
+				traits.ExtPins = true;
+				break;
+
+			case Revision::RP2C04_0003:
+				traits.RGB = true;
+				traits.EvenOdd = EvenOddCircuit::Off;
+				break;
+
+			case Revision::RP2C07_0:
+				traits.PAL = true;
+				traits.ExtPins = true;
+				traits.EvenOdd = EvenOddCircuit::PAL;
+				break;
+
+			case Revision::UMC_UA6538:
+				traits.PAL = true;
+				traits.ExtPins = true;
+				traits.EvenOdd = EvenOddCircuit::Off;
+				break;
+
+			default:
+				break;
+		}
+	}
+
 	size_t PPU::GetPCLKCounter()
 	{
 		return pclk_counter;
@@ -336,6 +333,13 @@ namespace PPUSim
 		return v->get();
 	}
 
+	void PPU::GetFieldSignals(TriState& VSYNC, TriState& n_VSET, TriState& RESCL)
+	{
+		VSYNC = hv_fsm->get_VSYNC_FF();
+		n_VSET = fsm.nVSET;
+		RESCL = fsm.RESCL;
+	}
+
 	void PPU::GetSignalFeatures(VideoSignalFeatures& features)
 	{
 		vid_out->GetSignalFeatures(features);
@@ -152,10 +152,34 @@ namespace PPUSim
 		Max,
 	};
 
+	/// <summary>
+	/// Variants of the Even/Odd circuit (to the right of the V Decoder).
+	/// </summary>
+	enum class EvenOddCircuit
+	{
+		Unknown = 0,		// Not studied, the circuit is not simulated
+		NTSC,				// RP2C02G
+		PAL,				// RP2C07-0. Reused for the ZOMG signal.
+		Off,				// RP2C04-0003, UMC UA6538: EvenOddOut = 0
+	};
+
+	/// <summary>
+	/// Revision-dependent circuit variants.
+	/// They are resolved once when the PPU instance is created, so that the per-half-cycle simulation checks one flag instead of switching on the revision.
+	/// </summary>
+	struct RevisionTraits
+	{
+		bool NTSC = false;			// RP2C02G/H
+		bool PAL = false;			// RP2C07-0, UMC UA6538: PAL PCLK divider, additional delay latches, modified H/V counters control
+		bool RGB = false;			// RP2C04-0003 (TBD: the remaining RGB PPUs): no EXT terminals, no $2004 reading, RGB OFETCH and CRAM control
+		bool ExtPins = false;		// The EXT0-3 terminals are present (NTSC and PAL PPUs)
+		EvenOddCircuit EvenOdd = EvenOddCircuit::Unknown;
+	};
+
 	enum class InputPad
 	{
 		RnW = 0,
-		RS0,
+		RS0,		// RS0-RS2 are consecutive, so the board can pass the register index as a whole (see `Pins32::set_bus`)
 		RS1,
 		RS2,
 		n_DBE,
@@ -177,7 +201,6 @@ namespace PPUSim
 	{
 		friend PPUSimUnitTest::UnitTest;
 		friend ControlRegs;
-		friend HVCounterBit;
 		friend HVCounter;
 		friend HVDecoder;
 		friend FSM;
@@ -187,9 +210,6 @@ namespace PPUSim
 		friend VideoOut;
 		friend Mux;
 		friend OAMEval;
-		friend OAMBufferBit;
-		friend OAMBufferBit_RGB;
-		friend OAMCell;
 		friend OAM;
 		friend FIFOLane;
 		friend FIFO;
@@ -357,6 +377,9 @@ namespace PPUSim
 		} fsm{};
 
 		Revision rev = Revision::Unknown;
+		RevisionTraits traits{};
+
+		void SetRevisionTraits();
 
 		void sim_PCLK();
 
@@ -371,6 +394,10 @@ namespace PPUSim
 		size_t pclk_counter = 0;
 		BaseLogic::TriState Prev_PCLK = BaseLogic::TriState::X;
 
+		// All modules are placed in the arena in the order in which they are simulated.
+
+		BaseLogic::Arena arena{};
+
 		ControlRegs* regs = nullptr;
 		HVCounter* h = nullptr;
 		HVCounter* v = nullptr;
@@ -409,7 +436,7 @@ namespace PPUSim
 		/// <param name="ad_bus">Bidirectional PPU-VRAM data/address bus</param>
 		/// <param name="addrHi_bus">This bus carries the rest of the address lines (output)</param>
 		/// <param name="vout">The output video signal.</param>
-		void sim(BaseLogic::TriState inputs[], BaseLogic::TriState outputs[], uint8_t* ext, uint8_t* data_bus, uint8_t* ad_bus, uint8_t* addrHi_bus, VideoOutSignal& vout);
+		void sim(BaseLogic::Pins32& inputs, BaseLogic::Pins32& outputs, uint8_t* ext, uint8_t* data_bus, uint8_t* ad_bus, uint8_t* addrHi_bus, VideoOutSignal& vout);
 
 		size_t GetPCLKCounter();
 
@@ -436,6 +463,14 @@ namespace PPUSim
 		size_t GetHCounter();
 		size_t GetVCounter();
 
+		/// <summary>
+		/// Get the FSM signals that mark the field and VBlank boundaries (used by the board events).
+		/// </summary>
+		/// <param name="VSYNC">1: vertical sync lines (the state of the VSYNC FF; the VSYNC signal itself pulses in every HBlank outside of them)</param>
+		/// <param name="n_VSET">0: VBlank Set (VBlank period start)</param>
+		/// <param name="RESCL">VBlank Clear (VBlank period end)</param>
+		void GetFieldSignals(BaseLogic::TriState& VSYNC, BaseLogic::TriState& n_VSET, BaseLogic::TriState& RESCL);
+
 		/// <summary>
 		/// Get the video signal properties of the current PPU revision.
 		/// </summary>
@@ -475,12 +510,30 @@ namespace PPUSim
 		uint8_t Dbg_TempOAMReadByte(size_t addr);
 		void Dbg_OAMWriteByte(size_t addr, uint8_t val);
 		void Dbg_TempOAMWriteByte(size_t addr, uint8_t val);
+		void Dbg_OAMReadBlock(uint8_t* ptr, size_t size);
+		void Dbg_TempOAMReadBlock(uint8_t* ptr, size_t size);
 		uint8_t Dbg_CRAMReadByte(size_t addr);
 		void Dbg_CRAMWriteByte(size_t addr, uint8_t val);
 		uint8_t Dbg_GetCRAMAddress();
 		uint16_t Dbg_GetPPUAddress();
 		void Dbg_RenderAlwaysEnabled(bool enable);
 
+		/// <summary>
+		/// Enable the register block fast path while the CPU interface is quiet (enabled by default).
+		/// </summary>
+		void Dbg_EnableFastPath(bool enable);
+
+		/// <summary>
+		/// Skip the sprite FIFO lanes while they are idle (disabled by default).
+		/// </summary>
+		void Dbg_EnableIdleGating(bool enable);
+
+		/// <summary>
+		/// Run the enabled fast paths and the full simulation side by side and count the mismatches.
+		/// </summary>
+		void Dbg_VerifyFastPath(bool enable);
+		size_t Dbg_GetFastPathMismatches();
+
 		uint32_t Dbg_ReadRegister(int ofs);
 		void Dbg_WriteRegister(int ofs, uint32_t val);
 	};
@@ -17,21 +17,103 @@ namespace PPUSim
 
 	void ControlRegs::sim()
 	{
+		if (sim_QuietInterface())
+		{
+			return;
+		}
+
 		sim_RegularRegOps();
 		sim_W56RegOps();
 		sim_FirstSecond_SCCX_Write();
 
 		sim_RegFFs();
 
-		switch (ppu->rev)
+		raw_BLACK = ppu->wire.BLACK;
+		quiet = ppu->wire.n_DBE == TriState::One;
+		quiet_RC = ppu->wire.RC;
+		quiet_select = PackSelect();
+
+		if (ppu->traits.PAL)
 		{
-			case Revision::RP2C07_0:
-			case Revision::UMC_UA6538:
-				sim_PalBLACK();
-				break;
+			sim_PalBLACK();
 		}
 	}
 
+	/// <summary>
+	/// Fast path for the half-cycles when the CPU interface is quiet. The first access (or RC change) falls back to the full simulation.
+	/// In the verification mode both variants are run and the mismatches are counted.
+	/// </summary>
+	/// <returns>true: the registers are already simulated</returns>
+	bool ControlRegs::sim_QuietInterface()
+	{
+		if (!FastPath || !quiet || ppu->wire.n_DBE != TriState::One || ppu->wire.RC != quiet_RC)
+		{
+			return false;
+		}
+
+		if (VerifyFastPath)
+		{
+			uint32_t fast = PackOutputs();
+			quiet = false;
+			sim();
+			if (PackOutputs() != fast)
+			{
+				fastPathMismatches++;
+			}
+			return true;
+		}
+
+		// The decoder outputs are not used while /DBE = 1, but the debugger shows them: follow the CPU address and R/W.
+
+		uint32_t select = PackSelect();
+		if (select != quiet_select)
+		{
+			sim_RegularRegOps();
+			sim_W56RegOps();
+			quiet_select = select;
+		}
+
+		// The PAL BLACK delay circuit is clocked and must be simulated anyway.
+
+		if (ppu->traits.PAL)
+		{
+			ppu->wire.BLACK = raw_BLACK;
+			sim_PalBLACK();
+		}
+
+		return true;
+	}
+
+	uint32_t ControlRegs::PackSelect()
+	{
+		return (uint32_t)ppu->wire.RS[0] | ((uint32_t)ppu->wire.RS[1] << 8) | ((uint32_t)ppu->wire.RS[2] << 16) | ((uint32_t)ppu->wire.RnW << 24);
+	}
+
+	uint32_t ControlRegs::PackOutputs()
+	{
+		uint32_t val = 0;
+
+		val |= (uint32_t)Debug_GetCTRL1() << 0;
+		val |= (uint32_t)(Debug_GetCTRL0() & ~3) << 8;
+		val |= (uint32_t)(SCCX_FF1.get() & 1) << 16;
+		val |= (uint32_t)(SCCX_FF2.get() & 1) << 17;
+		val |= (uint32_t)(ppu->wire.I1_32 & 1) << 18;
+		val |= (uint32_t)(ppu->wire.OBSEL & 1) << 19;
+		val |= (uint32_t)(ppu->wire.BGSEL & 1) << 20;
+		val |= (uint32_t)(ppu->wire.O8_16 & 1) << 21;
+		val |= (uint32_t)(ppu->wire.VBL & 1) << 22;
+		val |= (uint32_t)(ppu->wire.n_BGCLIP & 1) << 23;
+		val |= (uint32_t)(ppu->wire.n_OBCLIP & 1) << 24;
+		val |= (uint32_t)(ppu->wire.BGE & 1) << 25;
+		val |= (uint32_t)(ppu->wire.OBE & 1) << 26;
+		val |= (uint32_t)(raw_BLACK & 1) << 27;
+		val |= (uint32_t)(ppu->wire.n_TR & 1) << 28;
+		val |= (uint32_t)(ppu->wire.n_TG & 1) << 29;
+		val |= (uint32_t)(ppu->wire.n_TB & 1) << 30;
+
+		return val;
+	}
+
 	void ControlRegs::sim_RWDecoder()
 	{
 		TriState RnW = ppu->wire.RnW;
@@ -93,25 +175,15 @@ namespace PPUSim
 		in2[3] = RnW;
 		ppu->wire.n_W0 = NOT(NOR4(in2));
 
-		switch (ppu->rev)
-		{
-			// TBD: Add the remaining RGB PPUs
-
-			case Revision::RP2C04_0003:
-			{
-				// n_R4 is not used.
-			}
-			break;
+		// TBD: Add the remaining RGB PPUs. n_R4 is not used in the RP2C04-0003.
 
-			default:
-			{
-				in2[0] = RS0;
-				in2[1] = RS1;
-				in2[2] = NOT(RS2);
-				in2[3] = NOT(RnW);
-				ppu->wire.n_R4 = NOT(NOR4(in2));
-			}
-			break;
+		if (!ppu->traits.RGB)
+		{
+			in2[0] = RS0;
+			in2[1] = RS1;
+			in2[2] = NOT(RS2);
+			in2[3] = NOT(RnW);
+			ppu->wire.n_R4 = NOT(NOR4(in2));
 		}
 	}
 
@@ -212,19 +284,16 @@ namespace PPUSim
 
 		ppu->wire.n_SLAVE = PPU_CTRL0[6].get();
 
-		switch (ppu->rev)
-		{
-			// The PAL PPU (and derivative) uses a hidden latch for the VBL signal, which is stored between the open transistor and the inverter in the VBlank INT circuit.
+		// The PAL PPU (and derivative) uses a hidden latch for the VBL signal, which is stored between the open transistor and the inverter in the VBlank INT circuit.
 
-			case Revision::RP2C07_0:
-			case Revision::UMC_UA6538:
-				vbl_latch.set(PPU_CTRL0[7].get(), NOT(W0_Enable));
-				ppu->wire.VBL = vbl_latch.get();
-				break;
-
-			default:
-				ppu->wire.VBL = PPU_CTRL0[7].get();
-				break;
+		if (ppu->traits.PAL)
+		{
+			vbl_latch.set(PPU_CTRL0[7].get(), NOT(W0_Enable));
+			ppu->wire.VBL = vbl_latch.get();
+		}
+		else
+		{
+			ppu->wire.VBL = PPU_CTRL0[7].get();
 		}
 
 		// CTRL1
@@ -285,13 +354,36 @@ namespace PPUSim
 	void ControlRegs::Debug_RenderAlwaysEnabled(bool enable)
 	{
 		RenderAlwaysEnabled = enable;
+		quiet = false;
 	}
 
 	void ControlRegs::Debug_ClippingAlwaysDisabled(bool enable)
 	{
 		ClippingAlwaysDisabled = enable;
+		quiet = false;
+	}
+
+	void ControlRegs::Debug_EnableFastPath(bool enable)
+	{
+		FastPath = enable;
+		quiet = false;
+	}
+
+	void ControlRegs::Debug_VerifyFastPath(bool enable)
+	{
+		VerifyFastPath = enable;
+		fastPathMismatches = 0;
 	}
 
+	size_t ControlRegs::Debug_GetFastPathMismatches()
+	{
+		return fastPathMismatches;
+	}
+
+	/// <summary>
+	/// The register decoder is not evaluated on the half-cycles skipped by the fast path, so its outputs are computed here for the debugger.
+	/// The decoder is combinational and its outputs are only used together with /DBE, so this does not affect the simulation.
+	/// </summary>
 	uint8_t ControlRegs::Debug_GetCTRL0()
 	{
 		uint8_t val = 0;
@@ -329,6 +421,8 @@ namespace PPUSim
 			TriState bit_val = FromByte((val >> n) & 1);
 			PPU_CTRL0[n].set(bit_val);
 		}
+
+		quiet = false;
 	}
 
 	void ControlRegs::Debug_SetCTRL1(uint8_t val)
@@ -338,6 +432,8 @@ namespace PPUSim
 			TriState bit_val = FromByte((val >> n) & 1);
 			PPU_CTRL1[n].set(bit_val);
 		}
+
+		quiet = false;
 	}
 
 	/// <summary>
@@ -53,6 +53,22 @@ namespace PPUSim
 
 		void sim_PalBLACK();
 
+		// Quiet CPU interface fast path.
+		// While the CPU does not select the PPU (/DBE = 1) all register write enables are closed, so the register FFs, SCCX FFs and the control latches keep their state
+		// and the outputs of one evaluation do not change on the next. The register decoder is re-evaluated only when RS/RnW change (its outputs are only used together with /DBE, but they are shown by the debugger).
+
+		bool FastPath = true;
+		bool VerifyFastPath = false;
+		bool quiet = false;					// The last evaluation was made with /DBE = 1 and its outputs are stable
+		BaseLogic::TriState quiet_RC = BaseLogic::TriState::X;
+		uint32_t quiet_select = 0;			// RS[0-2] and RnW of the last decoder evaluation
+		BaseLogic::TriState raw_BLACK = BaseLogic::TriState::X;		// BLACK before the PAL delay circuit
+		size_t fastPathMismatches = 0;
+
+		bool sim_QuietInterface();
+		uint32_t PackSelect();
+		uint32_t PackOutputs();
+
 	public:
 		ControlRegs(PPU* parent);
 		~ControlRegs();
@@ -70,5 +86,9 @@ namespace PPUSim
 		void Debug_SetCTRL1(uint8_t val);
 
 		BaseLogic::TriState get_nSLAVE();
+
+		void Debug_EnableFastPath(bool enable);
+		void Debug_VerifyFastPath(bool enable);
+		size_t Debug_GetFastPathMismatches();
 	};
 }
@@ -140,34 +140,29 @@ namespace PPUSim
 		TriState n_DBE = ppu->wire.n_DBE;
 		TriState ZOMG{};
 
-		switch (ppu->rev)
-		{
-			// For the PAL PPU, the $2003 write delay is screwed on. This is most likely how they fight OAM Corruption.
-
-			case Revision::RP2C07_0:
-			case Revision::UMC_UA6538:
-			{
-				auto W3 = NOR(n_W3, n_DBE);
-				W3_FF1.set(NOR(NOR(W3, W3_FF1.get()), w3_latch3.nget()));
-				auto w3_ff1_out = NOR(W3_FF1.nget(), W3);
-				W3_FF2.set(NOT(NOT(MUX(PCLK, W3_FF2.get(), w3_ff1_out))));
-				w3_latch1.set(W3_FF2.nget(), n_PCLK);
-				w3_latch2.set(w3_latch1.nget(), PCLK);
-				w3_latch3.set(w3_latch2.nget(), n_PCLK);
-				w3_latch4.set(w3_latch3.nget(), PCLK);
-				W3_Enable = NOR(w3_latch4.get(), w3_latch2.nget());
-
-				// ZOMG comes from the circuit located in the same place as the EVEN/ODD circuit for the NTSC PPU (to the right of the V Decoder).
-
-				ZOMG = ppu->wire.EvenOddOut;
-				break;
-			}
+		// For the PAL PPU, the $2003 write delay is screwed on. This is most likely how they fight OAM Corruption.
 
-			default:
-				W3_Enable = NOR(n_W3, n_DBE);
-				// In order not to change the logic below the pseudo-ZOMG is made equal to 0 and NOR becomes NOT.
-				ZOMG = TriState::Zero;
-				break;
+		if (ppu->traits.PAL)
+		{
+			auto W3 = NOR(n_W3, n_DBE);
+			W3_FF1.set(NOR(NOR(W3, W3_FF1.get()), w3_latch3.nget()));
+			auto w3_ff1_out = NOR(W3_FF1.nget(), W3);
+			W3_FF2.set(NOT(NOT(MUX(PCLK, W3_FF2.get(), w3_ff1_out))));
+			w3_latch1.set(W3_FF2.nget(), n_PCLK);
+			w3_latch2.set(w3_latch1.nget(), PCLK);
+			w3_latch3.set(w3_latch2.nget(), n_PCLK);
+			w3_latch4.set(w3_latch3.nget(), PCLK);
+			W3_Enable = NOR(w3_latch4.get(), w3_latch2.nget());
+
+			// ZOMG comes from the circuit located in the same place as the EVEN/ODD circuit for the NTSC PPU (to the right of the V Decoder).
+
+			ZOMG = ppu->wire.EvenOddOut;
+		}
+		else
+		{
+			W3_Enable = NOR(n_W3, n_DBE);
+			// In order not to change the logic below the pseudo-ZOMG is made equal to 0 and NOR becomes NOT.
+			ZOMG = TriState::Zero;
 		}
 
 		init_latch.set(NAND(NOR(I_OAM2, n_VIS), H0_DD), n_PCLK);
@@ -310,20 +305,15 @@ namespace PPUSim
 		TriState BLNK = ppu->fsm.BLNK;
 		TriState OAP{};
 
-		switch (ppu->rev)
+		if (ppu->traits.PAL)
 		{
-			case Revision::RP2C07_0:
-			case Revision::UMC_UA6538:
-			{
-				TriState n_PCLK = ppu->wire.n_PCLK;
-				blnk_latch.set(BLNK, n_PCLK);
-				OAP = NAND(OR(n_VIS, H0_DD), blnk_latch.nget());
-				break;
-			}
-
-			default:
-				OAP = NAND(OR(n_VIS, H0_DD), NOT(BLNK));
-				break;
+			TriState n_PCLK = ppu->wire.n_PCLK;
+			blnk_latch.set(BLNK, n_PCLK);
+			OAP = NAND(OR(n_VIS, H0_DD), blnk_latch.nget());
+		}
+		else
+		{
+			OAP = NAND(OR(n_VIS, H0_DD), NOT(BLNK));
 		}
 
 		ppu->wire.OAM8 = NOT(OAP);
@@ -212,40 +212,32 @@ namespace PPUSim
 
 		sr[0].sim(PZ[10], n_CLK, CLK, RES, unused, PZ[12], PZ[11]);
 
-		switch (ppu->rev)
-		{
-			// TBD: Check and add the remaining "composite" PPUs
+		// TBD: Check and add the remaining "composite" PPUs
 
-			case Revision::RP2C02G:
-			case Revision::RP2C02H:
+		if (ppu->traits.NTSC)
+		{
+			n_PR = PZ[0];
+			n_PG = PZ[9];
+			n_PB = PZ[5];
+		}
+		else if (ppu->traits.PAL)
+		{
+			TriState n_PCLK = ppu->wire.n_PCLK;
+			if (ppu->v != nullptr)
 			{
-				n_PR = PZ[0];
-				n_PG = PZ[9];
-				n_PB = PZ[5];
+				v0_latch.set(ppu->v->getBit(0), n_PCLK);
 			}
-			break;
-
-			case Revision::RP2C07_0:
-			case Revision::UMC_UA6538:
+			else
 			{
-				TriState n_PCLK = ppu->wire.n_PCLK;
-				if (ppu->v != nullptr)
-				{
-					v0_latch.set(ppu->v->getBit(0), n_PCLK);
-				}
-				else
-				{
-					// To convert RAW -> Composite, a virtual PPU is created in which there is nothing else but a video generator.
-
-					v0_latch.set(TriState::Zero, n_PCLK);
-				}
-				TriState n_V0D = v0_latch.nget();
-
-				n_PR = NOT(MUX(n_V0D, PZ[7], PZ[2]));
-				n_PG = NOT(MUX(n_V0D, PZ[2], PZ[7]));
-				n_PB = PZ[5];
+				// To convert RAW -> Composite, a virtual PPU is created in which there is nothing else but a video generator.
+
+				v0_latch.set(TriState::Zero, n_PCLK);
 			}
-			break;
+			TriState n_V0D = v0_latch.nget();
+
+			n_PR = NOT(MUX(n_V0D, PZ[7], PZ[2]));
+			n_PG = NOT(MUX(n_V0D, PZ[2], PZ[7]));
+			n_PB = PZ[5];
 		}
 	}
 
@@ -557,14 +549,11 @@ namespace PPUSim
 		TriState n_PCLK = ppu->wire.n_PCLK;
 		TriState n_PICTURE = ppu->fsm.n_PICTURE;
 
-		switch (ppu->rev)
+		if (ppu->traits.PAL)
 		{
-			case Revision::RP2C07_0:
-			case Revision::UMC_UA6538:
-				npicture_latch1.set(NOT(n_PICTURE), n_PCLK);
-				npicture_latch2.set(npicture_latch1.nget(), PCLK);
-				n_PICTURE = npicture_latch2.get();
-				break;
+			npicture_latch1.set(NOT(n_PICTURE), n_PCLK);
+			npicture_latch2.set(npicture_latch1.nget(), PCLK);
+			n_PICTURE = npicture_latch2.get();
 		}
 
 		VidOut_n_PICTURE = n_PICTURE;
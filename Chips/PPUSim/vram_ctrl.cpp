@@ -12,16 +12,12 @@ namespace PPUSim
 
 		for (size_t n = 0; n < 8; n++)
 		{
-			RB[n] = new RB_Bit(ppu);
+			RB[n] = ppu->arena.New<RB_Bit>(ppu);
 		}
 	}
 
 	VRAM_Control::~VRAM_Control()
 	{
-		for (size_t n = 0; n < 8; n++)
-		{
-			delete RB[n];
-		}
 	}
 
 	void VRAM_Control::sim()
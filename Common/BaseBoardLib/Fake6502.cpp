@@ -43,4 +43,19 @@ namespace M6502Core
 	{
 		rp->SetRegDump(ptr, size);
 	}
+
+	bool FakeM6502::MapRegDump(const char* filename)
+	{
+		return rp->MapRegDump(filename);
+	}
+
+	int FakeM6502::GetRegDumpSeekFrame(size_t frame)
+	{
+		return rp->GetSeekFrame(frame);
+	}
+
+	bool FakeM6502::SeekRegDump(size_t frame, uint8_t** state, size_t* state_size)
+	{
+		return rp->Seek(frame, state, state_size);
+	}
 }
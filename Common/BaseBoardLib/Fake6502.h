@@ -17,5 +17,11 @@ namespace M6502Core
 		void sim(BaseLogic::TriState inputs[], BaseLogic::TriState outputs[], uint16_t* addr_bus, uint8_t* data_bus);
 
 		void SetRegDump(void* ptr, size_t size);
+
+		bool MapRegDump(const char* filename);
+
+		int GetRegDumpSeekFrame(size_t frame);
+
+		bool SeekRegDump(size_t frame, uint8_t** state, size_t* state_size);
 	};
 }
@@ -9,35 +9,31 @@ using namespace BaseLogic;
 
 namespace BaseBoard
 {
-	void LS368::sim(TriState inputs[], TriState outputs[])
+	void LS368::sim(Pins32& inputs, Pins32& outputs)
 	{
-		TriState G1 = NOT(inputs[(size_t)LS368_Input::n_G1]);
-		TriState G2 = NOT(inputs[(size_t)LS368_Input::n_G2]);
+		TriState G1 = NOT(inputs.get((size_t)LS368_Input::n_G1));
+		TriState G2 = NOT(inputs.get((size_t)LS368_Input::n_G2));
 
 		if (G1 == TriState::One)
 		{
-			outputs[(size_t)LS368_Output::n_Y1] = NOT(inputs[(size_t)LS368_Input::A1]);
-			outputs[(size_t)LS368_Output::n_Y2] = NOT(inputs[(size_t)LS368_Input::A2]);
-			outputs[(size_t)LS368_Output::n_Y3] = NOT(inputs[(size_t)LS368_Input::A3]);
-			outputs[(size_t)LS368_Output::n_Y4] = NOT(inputs[(size_t)LS368_Input::A4]);
+			outputs.set((size_t)LS368_Output::n_Y1, NOT(inputs.get((size_t)LS368_Input::A1)));
+			outputs.set((size_t)LS368_Output::n_Y2, NOT(inputs.get((size_t)LS368_Input::A2)));
+			outputs.set((size_t)LS368_Output::n_Y3, NOT(inputs.get((size_t)LS368_Input::A3)));
+			outputs.set((size_t)LS368_Output::n_Y4, NOT(inputs.get((size_t)LS368_Input::A4)));
 		}
 		else
 		{
-			outputs[(size_t)LS368_Output::n_Y1] = TriState::Z;
-			outputs[(size_t)LS368_Output::n_Y2] = TriState::Z;
-			outputs[(size_t)LS368_Output::n_Y3] = TriState::Z;
-			outputs[(size_t)LS368_Output::n_Y4] = TriState::Z;
+			outputs.float_bus((size_t)LS368_Output::n_Y1, 4);
 		}
 
 		if (G2 == TriState::One)
 		{
-			outputs[(size_t)LS368_Output::n_Y5] = NOT(inputs[(size_t)LS368_Input::A5]);
-			outputs[(size_t)LS368_Output::n_Y6] = NOT(inputs[(size_t)LS368_Input::A6]);
+			outputs.set((size_t)LS368_Output::n_Y5, NOT(inputs.get((size_t)LS368_Input::A5)));
+			outputs.set((size_t)LS368_Output::n_Y6, NOT(inputs.get((size_t)LS368_Input::A6)));
 		}
 		else
 		{
-			outputs[(size_t)LS368_Output::n_Y5] = TriState::Z;
-			outputs[(size_t)LS368_Output::n_Y6] = TriState::Z;
+			outputs.float_bus((size_t)LS368_Output::n_Y5, 2);
 		}
 	}
 }
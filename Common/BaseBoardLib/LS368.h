@@ -32,6 +32,6 @@ namespace BaseBoard
 	class LS368
 	{
 	public:
-		static void sim(BaseLogic::TriState inputs[], BaseLogic::TriState outputs[]);
+		static void sim(BaseLogic::Pins32& inputs, BaseLogic::Pins32& outputs);
 	};
 }
@@ -0,0 +1,94 @@
+// Read-only memory-mapped file.
+
+#include "pch.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace BaseBoard
+{
+	MappedFile::MappedFile(const char* filename, bool sequential)
+	{
+#ifdef _WIN32
+		HANDLE file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL | (sequential ? FILE_FLAG_SEQUENTIAL_SCAN : 0), NULL);
+		if (file == INVALID_HANDLE_VALUE)
+			return;
+		file_handle = file;
+
+		LARGE_INTEGER file_size{};
+		if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0)
+			return;
+
+		HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (mapping == NULL)
+			return;
+		mapping_handle = mapping;
+
+		data = (uint8_t*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (data != nullptr)
+		{
+			size = (size_t)file_size.QuadPart;
+		}
+#else
+		int fd = open(filename, O_RDONLY);
+		if (fd < 0)
+			return;
+
+		struct stat st {};
+		if (fstat(fd, &st) == 0 && st.st_size != 0)
+		{
+			void* ptr = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+			if (ptr != MAP_FAILED)
+			{
+				data = (uint8_t*)ptr;
+				size = (size_t)st.st_size;
+
+				if (sequential)
+				{
+					madvise(ptr, size, MADV_SEQUENTIAL);
+				}
+			}
+		}
+
+		// The mapping remains valid after the descriptor is closed
+		close(fd);
+#endif
+	}
+
+	MappedFile::~MappedFile()
+	{
+#ifdef _WIN32
+		if (data != nullptr)
+			UnmapViewOfFile(data);
+		if (mapping_handle != nullptr)
+			CloseHandle(mapping_handle);
+		if (file_handle != nullptr)
+			CloseHandle(file_handle);
+#else
+		if (data != nullptr)
+			munmap(data, size);
+#endif
+	}
+
+	bool MappedFile::Valid()
+	{
+		return data != nullptr;
+	}
+
+	uint8_t* MappedFile::GetData()
+	{
+		return data;
+	}
+
+	size_t MappedFile::GetSize()
+	{
+		return size;
+	}
+}
@@ -0,0 +1,35 @@
+// Read-only memory-mapped file.
+
+#pragma once
+
+namespace BaseBoard
+{
+	/// <summary>
+	/// Read-only view of the whole file. The pages are loaded by the OS on access and are shared between all views of the same file (e.g. many boards playing the same regdump).
+	/// </summary>
+	class MappedFile
+	{
+		uint8_t* data = nullptr;
+		size_t size = 0;
+
+#ifdef _WIN32
+		void* file_handle = nullptr;
+		void* mapping_handle = nullptr;
+#endif
+
+	public:
+		/// <summary>
+		/// Map the file.
+		/// </summary>
+		/// <param name="filename">File name</param>
+		/// <param name="sequential">The file is read from the beginning to the end (the OS reads ahead and can drop the pages already passed)</param>
+		MappedFile(const char* filename, bool sequential);
+		~MappedFile();
+
+		bool Valid();
+
+		uint8_t* GetData();
+
+		size_t GetSize();
+	};
+}
@@ -13,10 +13,7 @@ namespace BaseBoard
 
 	RegDumpProcessor::~RegDumpProcessor()
 	{
-		if (regdump != nullptr)
-		{
-			delete[] regdump;
-		}
+		FreeRegDump();
 	}
 
 	void RegDumpProcessor::sim(TriState CLK, TriState n_RES, TriState& RnW, uint16_t* addr_bus, uint8_t* data_bus)
@@ -48,7 +45,7 @@ namespace BaseBoard
 
 		// If regdump is loaded and the cycle counter has reached the value for the next RegOp - execute
 
-		if (regdump != nullptr)
+		if (!finished)
 		{
 			if (clk_counter >= next_clk && CLK == TriState::Zero)
 			{
@@ -88,21 +85,19 @@ namespace BaseBoard
 				hold_entry = *current;
 				hold = true;
 
-				// If the record is the last one - delete regdump
+				// Switch to the next record and wait until the cycle counter reaches the desired value.
+				// The first record of a segment is counted from the beginning of the segment.
 
-				if (regdump_entry >= regdump_entry_max)
+				segment_entry++;
+				if (segment_entry < entries_count)
 				{
-					delete[] regdump;
-					regdump = nullptr;
+					next_clk = clk_counter + GetCurrentEntry()->clkDelta;
 				}
-
-				// Otherwise, switch to the next record and wait until the cycle counter reaches the desired value
-
 				else
 				{
-					regdump_entry++;
-					RegDumpEntry* next = GetCurrentEntry();
-					next_clk = clk_counter + next->clkDelta;
+					// Next segment. After the last record the playback stops (the dump remains loaded for seeking).
+
+					StartSegment(segment + 1);
 				}
 			}
 		}
@@ -117,11 +112,7 @@ namespace BaseBoard
 
 		// Delete the old regdump
 
-		if (regdump != nullptr)
-		{
-			delete[] regdump;
-			regdump = nullptr;
-		}
+		FreeRegDump();
 
 		// Copy regdump to a new buffer
 
@@ -129,21 +120,356 @@ namespace BaseBoard
 		memcpy(regdump, ptr, size);
 		regdump_size = size;
 
-		// Set the initial values of the state logic
+		ParseRegDump(regdump, regdump_size);
+	}
 
-		regdump_entry = 0;
-		regdump_entry_max = regdump_size / sizeof(RegDumpEntry);
+	bool RegDumpProcessor::MapRegDump(const char* filename)
+	{
+		FreeRegDump();
+
+		mapped = new MappedFile(filename, true);
+		if (!mapped->Valid() || mapped->GetSize() < sizeof(RegDumpEntry))
+		{
+			delete mapped;
+			mapped = nullptr;
+			return false;
+		}
 
-		RegDumpEntry* first_entry = (RegDumpEntry*)ptr;
-		next_clk = first_entry->clkDelta;
+		regdump_size = mapped->GetSize();
+		ParseRegDump(mapped->GetData(), regdump_size);
+		return true;
+	}
+
+	void RegDumpProcessor::FreeRegDump()
+	{
+		delete[] regdump;
+		regdump = nullptr;
+		delete mapped;
+		mapped = nullptr;
+		delete[] segments;
+		segments = nullptr;
+		num_segments = 0;
+		delete[] keyframes;
+		keyframes = nullptr;
+		num_keyframes = 0;
+		delete[] unpacked;
+		unpacked = nullptr;
+		unpacked_capacity = 0;
+		entries = nullptr;
+		entries_count = 0;
+		indexed = false;
+		finished = true;
+	}
+
+	/// <summary>
+	/// Make the table of segments (and keyframes) over the dump; the entries themselves are not copied.
+	/// </summary>
+	void RegDumpProcessor::ParseRegDump(uint8_t* ptr, size_t size)
+	{
+		indexed = ParseIndexedRegDump(ptr, size);
+
+		if (!indexed)
+		{
+			// Old format: one segment of the whole dump
+
+			segments = new Segment[1];
+			segments[0].entries = (RegDumpEntry*)ptr;
+			segments[0].count = size / sizeof(RegDumpEntry);
+			segments[0].phi = 0;
+			segments[0].frame = 0;
+			segments[0].packed = nullptr;
+			segments[0].packed_size = 0;
+			num_segments = 1;
+		}
+
+		// Set the initial values of the state logic
 
 		clk_counter = 0;
+		StartSegment(0);
+
+		hold = false;
+		PrevCLK = TriState::X;
+		first_access = true;
+	}
+
+	/// <returns>false: this is not an indexed dump</returns>
+	bool RegDumpProcessor::ParseIndexedRegDump(uint8_t* ptr, size_t size)
+	{
+		if (size < sizeof(RegDumpHeader))
+			return false;
+
+		RegDumpHeader* header = (RegDumpHeader*)ptr;
+		if (memcmp(header->magic, REGDUMP_MAGIC, sizeof(header->magic)) || header->version != REGDUMP_VERSION)
+			return false;
+
+		// Get the index. If it was not written - collect it from the blocks.
+
+		size_t num_blocks = header->num_blocks;
+		RegDumpIndexEntry* index = nullptr;
+
+		if (header->index_offset != 0 && header->index_offset <= size && num_blocks <= (size - header->index_offset) / sizeof(RegDumpIndexEntry))
+		{
+			index = new RegDumpIndexEntry[num_blocks + 1];
+			memcpy(index, ptr + header->index_offset, num_blocks * sizeof(RegDumpIndexEntry));
+
+			// The index is not trusted: each block must be inside the file and be of a known type, otherwise the blocks are scanned
+
+			for (size_t n = 0; n < num_blocks; n++)
+			{
+				if (!CheckBlock(ptr, size, index[n].offset, nullptr) || ((RegDumpBlockHeader*)(ptr + index[n].offset))->type != index[n].type)
+				{
+					delete[] index;
+					index = nullptr;
+					break;
+				}
+			}
+		}
+
+		if (index == nullptr)
+		{
+			num_blocks = 0;
+			ScanBlocks(ptr, size, nullptr, num_blocks);
+			index = new RegDumpIndexEntry[num_blocks + 1];
+			num_blocks = 0;
+			ScanBlocks(ptr, size, index, num_blocks);
+		}
+
+		segments = new Segment[num_blocks + 1];
+		keyframes = new Keyframe[num_blocks + 1];
+
+		for (size_t n = 0; n < num_blocks; n++)
+		{
+			RegDumpBlockHeader* block = (RegDumpBlockHeader*)(ptr + index[n].offset);
+			uint8_t* payload = (uint8_t*)(block + 1);
+
+			if (block->type == REGDUMP_BLOCK_OPS || block->type == REGDUMP_BLOCK_PACKED_OPS)
+			{
+				bool packed = block->type == REGDUMP_BLOCK_PACKED_OPS;
+				Segment* seg = &segments[num_segments++];
+				seg->entries = packed ? nullptr : (RegDumpEntry*)payload;
+				seg->count = block->size;
+				seg->phi = block->phi;
+				seg->frame = block->frame;
+				seg->packed = packed ? payload : nullptr;
+				seg->packed_size = packed ? block->packed_size : 0;
+			}
+			else
+			{
+				Keyframe* kf = &keyframes[num_keyframes++];
+				kf->frame = block->frame;
+				kf->state = payload;
+				kf->size = block->size;
+			}
+		}
+
+		delete[] index;
+		return true;
+	}
+	/// <summary>
+	/// Check that the block at the specified offset is of a known type and fits in the file with its payload.
+	/// </summary>
+	/// <param name="payload">Payload size of the block (optional)</param>
+	bool RegDumpProcessor::CheckBlock(uint8_t* ptr, size_t size, uint64_t offset, size_t* payload)
+	{
+		if (offset < sizeof(RegDumpHeader) || offset > size || size - offset < sizeof(RegDumpBlockHeader))
+			return false;
+
+		RegDumpBlockHeader* block = (RegDumpBlockHeader*)(ptr + offset);
+		uint64_t bytes;
+
+		if (block->type == REGDUMP_BLOCK_OPS)
+			bytes = (uint64_t)block->size * sizeof(RegDumpEntry);
+		else if (block->type == REGDUMP_BLOCK_PACKED_OPS)
+			bytes = block->packed_size;
+		else if (block->type == REGDUMP_BLOCK_KEYFRAME)
+			bytes = block->size;
+		else
+			return false;
+
+		if (bytes > size - offset - sizeof(RegDumpBlockHeader))
+			return false;
+
+		if (payload != nullptr)
+			*payload = (size_t)bytes;
+		return true;
+	}
+
+	/// <summary>
+	/// Walk through the blocks from the beginning of the file and fill in the index (or just count the blocks if index = nullptr).
+	/// The last block can be incomplete if the recording was interrupted, it is discarded.
+	/// </summary>
+	void RegDumpProcessor::ScanBlocks(uint8_t* ptr, size_t size, RegDumpIndexEntry* index, size_t& num_blocks)
+	{
+		size_t offset = sizeof(RegDumpHeader);
+		size_t payload;
+
+		while (CheckBlock(ptr, size, offset, &payload))
+		{
+			RegDumpBlockHeader* block = (RegDumpBlockHeader*)(ptr + offset);
+
+			if (index != nullptr)
+			{
+				RegDumpIndexEntry* rec = &index[num_blocks];
+				rec->offset = offset;
+				rec->phi = block->phi;
+				rec->frame = block->frame;
+				rec->type = block->type;
+			}
+			num_blocks++;
+
+			offset += sizeof(RegDumpBlockHeader) + payload;
+		}
+	}
+
+	RegDumpProcessor::Keyframe* RegDumpProcessor::FindKeyframe(size_t frame)
+	{
+		Keyframe* found = nullptr;
+
+		for (size_t n = 0; n < num_keyframes; n++)
+		{
+			if (keyframes[n].frame > frame)
+				break;
+			found = &keyframes[n];
+		}
+
+		return found;
+	}
+
+	/// <summary>
+	/// Continue the playback from the beginning of the segment (empty segments are skipped).
+	/// </summary>
+	void RegDumpProcessor::StartSegment(size_t seg)
+	{
+		entries_count = 0;
+
+		while (seg < num_segments)
+		{
+			if (segments[seg].packed != nullptr)
+			{
+				entries_count = UnpackSegment(segments[seg]);
+			}
+			else
+			{
+				entries = segments[seg].entries;
+				entries_count = segments[seg].count;
+			}
+
+			if (entries_count != 0)
+				break;
+			seg++;
+		}
+
+		segment = seg;
+		segment_entry = 0;
+		finished = segment >= num_segments;
+
+		if (!finished)
+		{
+			next_clk = segments[segment].phi + GetCurrentEntry()->clkDelta;
+		}
+	}
+
+	/// <summary>
+	/// Unpack the segment into the `unpacked` buffer (see RegDumper::PackBlock). A damaged segment is cut off at the last complete entry.
+	/// </summary>
+	/// <returns>The number of entries unpacked</returns>
+	size_t RegDumpProcessor::UnpackSegment(Segment& seg)
+	{
+		if (seg.count > unpacked_capacity)
+		{
+			delete[] unpacked;
+			unpacked_capacity = seg.count;
+			unpacked = new RegDumpEntry[unpacked_capacity];
+		}
+		entries = unpacked;
+
+		uint8_t* ptr = seg.packed;
+		uint8_t* end = seg.packed + seg.packed_size;
+		size_t count = 0;
+
+		while (count < seg.count && ptr < end)
+		{
+			uint32_t delta = 0;
+			size_t shift = 0;
+			while (ptr < end && (*ptr & 0x80) && shift < 28)
+			{
+				delta |= (uint32_t)(*ptr++ & 0x7f) << shift;
+				shift += 7;
+			}
+			if (ptr >= end)
+				break;
+			delta |= (uint32_t)(*ptr++) << shift;
+
+			if (ptr >= end)
+				break;
+			uint8_t reg = *ptr++;
+			uint8_t value = 0;
+			if ((reg & 0x80) == 0)
+			{
+				if (ptr >= end)
+					break;
+				value = *ptr++;
+			}
+
+			RegDumpEntry* entry = &unpacked[count++];
+			entry->clkDelta = delta;
+			entry->reg = reg;
+			entry->value = value;
+			entry->padding = 0;
+		}
+
+		return count;
+	}
+
+	int RegDumpProcessor::GetSeekFrame(size_t frame)
+	{
+		if (!indexed)
+			return -1;
+
+		Keyframe* kf = FindKeyframe(frame);
+		return kf != nullptr ? (int)kf->frame : 0;
+	}
+
+	bool RegDumpProcessor::Seek(size_t frame, uint8_t** state, size_t* state_size)
+	{
+		if (!indexed)
+			return false;
+
+		Keyframe* kf = FindKeyframe(frame);
+
+		*state = nullptr;
+		*state_size = 0;
+
+		if (kf == nullptr)
+		{
+			// No keyframe before - from the very beginning
+
+			clk_counter = 0;
+			StartSegment(0);
+		}
+		else
+		{
+			size_t seg = 0;
+			while (seg < num_segments && segments[seg].frame < kf->frame)
+			{
+				seg++;
+			}
+
+			clk_counter = seg < num_segments ? segments[seg].phi : 0;
+			StartSegment(seg);
+
+			*state = kf->state;
+			*state_size = kf->size;
+		}
+
+		hold = false;
 		PrevCLK = TriState::X;
 		first_access = true;
+		return true;
 	}
 
 	RegDumpEntry* RegDumpProcessor::GetCurrentEntry()
 	{
-		return (RegDumpEntry*)(regdump + regdump_entry * sizeof(RegDumpEntry));
+		return &entries[segment_entry];
 	}
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "MappedFile.h"
+
 namespace BaseBoard
 {
 #pragma pack(push, 1)
@@ -10,18 +12,95 @@ namespace BaseBoard
 		uint8_t 	value;		// Written value. Not used for reading.
 		uint16_t	padding;	// Not used (yet?)
 	};
+
+	// Indexed regdump (version 2). The old format is a bare array of RegDumpEntry and is still accepted by the player.
+	// File layout: header, a sequence of blocks (register operations of one frame or part of it, keyframes), the index of the blocks at the end.
+
+	#define REGDUMP_MAGIC "REGDUMP2"
+	#define REGDUMP_VERSION 2
+
+	#define REGDUMP_BLOCK_OPS 0x53504f52		// 'ROPS'
+	#define REGDUMP_BLOCK_KEYFRAME 0x4d52464b	// 'KFRM'
+	#define REGDUMP_BLOCK_PACKED_OPS 0x5a504f52	// 'ROPZ': register operations packed by RegDumper (variable-length clkDelta, register, value for writes only)
+
+	struct RegDumpHeader
+	{
+		char		magic[8];		// REGDUMP_MAGIC
+		uint32_t	version;
+		uint32_t	num_blocks;		// Number of the index records
+		uint64_t	index_offset;	// File offset of the index. 0: the index is missing (the recording was interrupted), the blocks are scanned.
+	};
+
+	struct RegDumpBlockHeader
+	{
+		uint32_t	type;			// REGDUMP_BLOCK_OPS / REGDUMP_BLOCK_PACKED_OPS / REGDUMP_BLOCK_KEYFRAME
+		uint32_t	size;			// Number of register operations (ops block) or the size of the state in bytes (keyframe)
+		uint64_t	phi;			// PHI counter value at the beginning of the block, since the beginning of the dump. clkDelta of the first entry is counted from it.
+		uint32_t	frame;			// Number of the frame (PPU field) the block belongs to
+		uint32_t	packed_size;	// Packed ops block: payload size in bytes. 0 for other blocks.
+	};
+
+	struct RegDumpIndexEntry
+	{
+		uint64_t	offset;			// File offset of the block header
+		uint64_t	phi;
+		uint32_t	frame;
+		uint32_t	type;
+	};
+
+	// The keyframe state consists of records: a record header, followed by `size` bytes of the memory region or a 32-bit register value.
+
+	#define REGDUMP_STATE_MEMORY 0
+
+	struct RegDumpStateRecord
+	{
+		uint32_t	type;			// REGDUMP_STATE_MEMORY or the debug info type (registers)
+		char		name[32];		// Memory region / register name
+		uint32_t	size;
+	};
 #pragma pack(pop)
 
 	class RegDumpProcessor
 	{
+		/// <summary>
+		/// A run of entries that is played in place (the old format is a single segment). The first entry is counted from the PHI of the segment.
+		/// Packed segments are unpacked when the playback reaches them.
+		/// </summary>
+		struct Segment
+		{
+			RegDumpEntry* entries;
+			size_t count;
+			size_t phi;
+			size_t frame;
+			uint8_t* packed;		// nullptr: the segment is not packed
+			size_t packed_size;
+		};
+
+		struct Keyframe
+		{
+			size_t frame;
+			uint8_t* state;
+			size_t size;
+		};
+
 		uint16_t regbase = 0x1000;	// e.g. 0x4000 - APU, 0x2000 - PPU
 		uint16_t regmask = 0x7f;			// e.g. 0x1f - APU, 0x7 - PPU
-		uint8_t* regdump = nullptr;
+		uint8_t* regdump = nullptr;		// Own copy of the dump (SetRegDump)
+		MappedFile* mapped = nullptr;	// Or the mapped file (MapRegDump)
 		size_t regdump_size = 0;
-		size_t regdump_entry = 0;
-		size_t regdump_entry_max = 0;
 		size_t clk_counter = 0;
 		size_t next_clk = 0;
+		bool finished = true;			// All the records are executed (or nothing is loaded)
+
+		Segment* segments = nullptr;
+		size_t num_segments = 0;
+		size_t segment = 0;				// Current segment
+		size_t segment_entry = 0;		// Current entry in the segment
+		RegDumpEntry* entries = nullptr;	// Entries of the current segment (in place or unpacked)
+		size_t entries_count = 0;
+
+		RegDumpEntry* unpacked = nullptr;
+		size_t unpacked_capacity = 0;
 
 		bool hold = false;				// Hold the register operation for the rest of the cycle
 		RegDumpEntry hold_entry{};
@@ -37,12 +116,51 @@ namespace BaseBoard
 		char regdump_target[32];
 		bool first_access = true;
 
+		// Indexed dump only
+
+		bool indexed = false;
+		Keyframe* keyframes = nullptr;
+		size_t num_keyframes = 0;
+
+		void FreeRegDump();
+		void ParseRegDump(uint8_t* ptr, size_t size);
+		bool ParseIndexedRegDump(uint8_t* ptr, size_t size);
+		bool CheckBlock(uint8_t* ptr, size_t size, uint64_t offset, size_t* payload);
+		void ScanBlocks(uint8_t* ptr, size_t size, RegDumpIndexEntry* index, size_t& num_blocks);
+		void StartSegment(size_t seg);
+		size_t UnpackSegment(Segment& seg);
+		Keyframe* FindKeyframe(size_t frame);
+
 	public:
 		RegDumpProcessor(const char *target, uint16_t regs_base, uint16_t regs_mask);
 		~RegDumpProcessor();
 
 		void sim(BaseLogic::TriState CLK, BaseLogic::TriState n_RES, BaseLogic::TriState& RnW, uint16_t* addr_bus, uint8_t* data_bus);
 		
+		/// <summary>
+		/// Load the dump from memory (a copy is made).
+		/// </summary>
 		void SetRegDump(void* ptr, size_t size);
+
+		/// <summary>
+		/// Play the dump directly from the file, without loading it into memory. The file is mapped with the sequential access hint.
+		/// </summary>
+		/// <returns>false: the file cannot be mapped</returns>
+		bool MapRegDump(const char* filename);
+
+		/// <summary>
+		/// The frame from which the playback resumes after seeking to the specified frame (the frame of the nearest keyframe before it).
+		/// </summary>
+		/// <returns>-1: the dump does not support seeking (old format or not loaded)</returns>
+		int GetSeekFrame(size_t frame);
+
+		/// <summary>
+		/// Rewind the playback to the nearest keyframe before the specified frame. The cycle counter continues from the PHI value of the keyframe.
+		/// </summary>
+		/// <param name="frame">Desired frame</param>
+		/// <param name="state">The state saved in the keyframe (nullptr: there is no keyframe, the playback starts from the beginning of the dump)</param>
+		/// <param name="state_size">State size in bytes</param>
+		/// <returns>false: the dump does not support seeking</returns>
+		bool Seek(size_t frame, uint8_t** state, size_t* state_size);
 	};
 }
@@ -66,4 +66,9 @@ namespace BaseBoard
 			mem[addr] = data;
 		}
 	}
+
+	uint8_t* SRAM::Dbg_GetMemory()
+	{
+		return mem;
+	}
 }
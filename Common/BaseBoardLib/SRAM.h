@@ -31,5 +31,10 @@ namespace BaseBoard
 		uint8_t Dbg_ReadByte(size_t addr);
 
 		void Dbg_WriteByte(size_t addr, uint8_t data);
+
+		/// <summary>
+		/// Direct access to the whole memory (Dbg_GetSize bytes), for the bulk dumps.
+		/// </summary>
+		uint8_t* Dbg_GetMemory();
 	};
 }
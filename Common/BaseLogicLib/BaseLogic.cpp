@@ -351,7 +351,30 @@ namespace BaseLogic
 		rom = new uint8_t[romSize];
 		memset(rom, 0, romSize);
 		unomptimized_out = new TriState[romOutputs];
-		strcpy(fname, filename);
+		int len;
+		if (cacheDir[0] == 0)
+		{
+			len = snprintf(fname, sizeof(fname), "%s", filename);
+		}
+		else
+		{
+			len = snprintf(fname, sizeof(fname), "%s/%s", cacheDir, filename);
+		}
+
+		// A truncated name would point to some other file, so in this case the matrix is simply not cached.
+
+		if (len < 0 || (size_t)len >= sizeof(fname))
+		{
+			printf("PLA: the cache file name is too long, %s is not cached\n", filename);
+			fname[0] = 0;
+		}
+	}
+
+	char PLA::cacheDir[0x100] = { 0 };
+
+	void PLA::SetCacheDir(const char* dir)
+	{
+		snprintf(cacheDir, sizeof(cacheDir), "%s", dir != nullptr ? dir : "");
 	}
 
 	PLA::~PLA()
@@ -391,7 +414,7 @@ namespace BaseLogic
 
 			size_t maxLane = (1ULL << romInputs);
 
-			FILE* f = fopen(fname, "rb");
+			FILE* f = fname[0] != 0 ? fopen(fname, "rb") : nullptr;
 			if (f)
 			{
 				outs = new TriState[maxLane * romOutputs];
@@ -411,6 +434,9 @@ namespace BaseLogic
 				memcpy(lane, outputs, romOutputs * sizeof(TriState));
 			}
 
+			if (fname[0] == 0)
+				return;
+
 			f = fopen(fname, "wb");
 			if (f)
 			{
@@ -612,4 +638,86 @@ namespace BaseLogic
 			val = TriState::Zero;
 		}
 	}
+
+	Arena::Arena(size_t _chunk_size)
+	{
+		chunk_size = _chunk_size;
+	}
+
+	Arena::~Arena()
+	{
+		while (last != nullptr)
+		{
+			Record* rec = last;
+			last = rec->prev;
+			if (rec->destroy != nullptr)
+			{
+				rec->destroy(rec->obj);
+			}
+			if (rec->large != nullptr)
+			{
+				delete[] (uint8_t*)rec->large;
+			}
+		}
+
+		while (chunk != nullptr)
+		{
+			Chunk* prev = chunk->prev;
+			delete[] (uint8_t*)chunk;
+			chunk = prev;
+		}
+	}
+
+	Arena::Record* Arena::Alloc(size_t size)
+	{
+		const size_t header = (sizeof(Chunk) + align - 1) & ~(align - 1);
+		const size_t rec_size = (sizeof(Record) + align - 1) & ~(align - 1);
+		size_t obj_size = (size + align - 1) & ~(align - 1);
+		bool large = obj_size > chunk_size / 4;
+		size_t need = rec_size + (large ? 0 : obj_size);
+
+		if (chunk == nullptr || chunk->used + need > chunk->size)
+		{
+			// The chunk memory comes from new[] and is aligned at least to the fundamental alignment; the offsets inside are multiples of `align`.
+
+			uint8_t* mem = new uint8_t[header + chunk_size + align];
+			Chunk* next = (Chunk*)mem;
+			next->prev = chunk;
+			next->size = chunk_size;
+			next->used = (align - ((uintptr_t)(mem + header) & (align - 1))) & (align - 1);
+			chunk = next;
+		}
+
+		uint8_t* base = (uint8_t*)chunk + header + chunk->used;
+		chunk->used += need;
+
+		Record* rec = (Record*)base;
+		rec->prev = last;
+		rec->destroy = nullptr;
+		rec->large = nullptr;
+
+		if (large)
+		{
+			uint8_t* mem = new uint8_t[obj_size + align];
+			rec->large = mem;
+			rec->obj = mem + ((align - ((uintptr_t)mem & (align - 1))) & (align - 1));
+		}
+		else
+		{
+			rec->obj = base + rec_size;
+		}
+
+		last = rec;
+		return rec;
+	}
+
+	size_t Arena::GetUsedSize()
+	{
+		size_t total = 0;
+		for (Chunk* c = chunk; c != nullptr; c = c->prev)
+		{
+			total += c->used;
+		}
+		return total;
+	}
 }
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <new>		// placement new for Arena
+#include <utility>	// std::forward for Arena
+
 /// <summary>
 /// Basic logic primitives used in N-MOS chips.
 /// Combinational primitives are implemented using ordinary methods.
@@ -341,10 +344,18 @@ namespace BaseLogic
 		bool Optimize = true;
 		char fname[0x100] = { 0 };
 
+		static char cacheDir[0x100];
+
 	public:
 		PLA(size_t inputs, size_t outputs, char *filename);
 		~PLA();
 
+		/// <summary>
+		/// Set the directory where the optimized decoder matrices are cached (the file name is given in the constructor). Empty string: the current directory.
+		/// Takes effect for the PLAs created afterwards.
+		/// </summary>
+		static void SetCacheDir(const char* dir);
+
 		/// <summary>
 		/// Set the decoder matrix.
 		/// </summary>
@@ -359,6 +370,162 @@ namespace BaseLogic
 		void sim(size_t input_bits, TriState** outputs);
 	};
 
+	/// <summary>
+	/// Contiguous storage for the submodules of a chip.
+	/// The objects are placed one after another in the order of creation, so that the state traversed every half cycle shares as few cache lines as possible.
+	/// Large objects (lookup tables and the like) are allocated separately, so as not to spread the small ones apart.
+	/// This is the only hot/cold split: the fields inside a module keep their declaration order.
+	/// All objects are destroyed (in reverse order) together with the arena.
+	/// </summary>
+	class Arena
+	{
+		struct Chunk
+		{
+			Chunk* prev;
+			size_t size;
+			size_t used;
+		};
+
+		struct Record
+		{
+			Record* prev;
+			void (*destroy)(void* obj);		// Set only after the object is constructed
+			void* obj;
+			void* large;			// Separately allocated memory of a large object
+		};
+
+		static const size_t align = 16;
+
+		size_t chunk_size = 0;
+		Chunk* chunk = nullptr;
+		Record* last = nullptr;
+
+		Record* Alloc(size_t size);
+
+		template <typename T>
+		static void Destroy(void* obj)
+		{
+			static_cast<T*>(obj)->~T();
+		}
+
+	public:
+		Arena(size_t chunk_size = 0x4000);
+		~Arena();
+
+		// The arena owns the objects, copying it would destroy them twice
+
+		Arena(const Arena&) = delete;
+		Arena& operator=(const Arena&) = delete;
+
+		/// <summary>
+		/// Create the object in the arena. The object must not be deleted by `delete`.
+		/// </summary>
+		template <typename T, typename... Args>
+		T* New(Args&&... args)
+		{
+			static_assert(alignof(T) <= align, "Arena: unsupported alignment");
+
+			// The constructor may create other objects in the arena, so the record is kept by pointer and not taken from `last`.
+			// If the constructor throws, the record stays without `destroy` and only the memory is released.
+
+			Record* rec = Alloc(sizeof(T));
+			T* obj = new (rec->obj) T(std::forward<Args>(args)...);
+			rec->destroy = &Destroy<T>;
+			return obj;
+		}
+
+		/// <summary>
+		/// The amount of memory occupied by the small objects (bytes).
+		/// </summary>
+		size_t GetUsedSize();
+	};
+
+	/// <summary>
+	/// A packed set of chip terminals.
+	/// Each pin takes one bit in two bit planes: `val` (level) and `drv` (the pin is driven).
+	/// A driven pin is `0` or `1`; a pin that is not driven is `z` when its level bit is 0 and `x` when it is 1.
+	/// Consecutive pins can be used to pass a bus as a whole word.
+	/// Initially all pins are `0` (the same as a zero-initialized TriState array).
+	/// </summary>
+	template <typename W>
+	class PinBundle
+	{
+		W val = 0;
+		W drv = ~(W)0;
+
+		static W Mask(size_t lsb, size_t width)
+		{
+			W m = width >= sizeof(W) * 8 ? ~(W)0 : (((W)1 << width) - 1);
+			return m << lsb;
+		}
+
+	public:
+		/// <summary>
+		/// Get the pin value.
+		/// </summary>
+		TriState get(size_t n) const
+		{
+			W bit = (W)1 << n;
+			if ((drv & bit) != 0)
+			{
+				return (val & bit) != 0 ? TriState::One : TriState::Zero;
+			}
+			return (val & bit) != 0 ? TriState::X : TriState::Z;
+		}
+
+		/// <summary>
+		/// Set the pin value. All four TriState values are kept.
+		/// </summary>
+		void set(size_t n, TriState v)
+		{
+			W bit = (W)1 << n;
+			W lvl = (v == TriState::One || v == TriState::X) ? bit : 0;
+			W d = (v == TriState::Zero || v == TriState::One) ? bit : 0;
+			val = (val & ~bit) | lvl;
+			drv = (drv & ~bit) | d;
+		}
+
+		/// <summary>
+		/// Get the levels of the bus occupying the pins [lsb, lsb+width). The drive plane is not checked, see `is_driven`.
+		/// </summary>
+		W get_bus(size_t lsb, size_t width) const
+		{
+			return (val & Mask(lsb, width)) >> lsb;
+		}
+
+		/// <summary>
+		/// Drive the bus occupying the pins [lsb, lsb+width) with the value. The extra bits of the value are ignored.
+		/// </summary>
+		void set_bus(size_t lsb, size_t width, W value)
+		{
+			W m = Mask(lsb, width);
+			val = (val & ~m) | ((value << lsb) & m);
+			drv |= m;
+		}
+
+		/// <summary>
+		/// Put the bus occupying the pins [lsb, lsb+width) into the `z` state.
+		/// </summary>
+		void float_bus(size_t lsb, size_t width)
+		{
+			W m = Mask(lsb, width);
+			val &= ~m;
+			drv &= ~m;
+		}
+
+		/// <summary>
+		/// true: all pins [lsb, lsb+width) are driven (`0` or `1`).
+		/// </summary>
+		bool is_driven(size_t lsb, size_t width) const
+		{
+			W m = Mask(lsb, width);
+			return (drv & m) == m;
+		}
+	};
+
+	using Pins32 = PinBundle<uint32_t>;
+	using Pins64 = PinBundle<uint64_t>;
+
 	/// <summary>
 	/// Pack a bit vector into a byte.
 	/// </summary>
@@ -474,3 +641,5 @@ namespace BaseLogic
 	/// </summary>
 	void Pulldown(TriState& val);
 }
+
+#include "Profiler.h"
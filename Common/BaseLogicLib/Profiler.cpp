@@ -0,0 +1,207 @@
+// Sampling profiler of the simulation stages.
+
+#include "pch.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+namespace BaseLogic
+{
+	Profiler::Zone Profiler::zones[Profiler::MaxZones];
+	size_t Profiler::num_zones = 0;
+
+	size_t Profiler::stack[Profiler::MaxDepth];
+	uint64_t Profiler::stack_start[Profiler::MaxDepth];
+	size_t Profiler::depth = 0;
+
+	size_t Profiler::sample_period = 61;
+	bool Profiler::sampling = false;
+
+	size_t Profiler::Register(const char* name)
+	{
+		if (num_zones >= MaxZones)
+		{
+			// All other stages go to the last zone
+			return MaxZones - 1;
+		}
+
+		Zone* zone = &zones[num_zones];
+		memset(zone, 0, sizeof(Zone));
+		zone->name = name;
+		zone->parent = -1;
+		zone->countdown = 1;
+		return num_zones++;
+	}
+
+	void Profiler::Enter(size_t zone)
+	{
+		zones[zone].calls++;
+
+		if (depth == 0)
+		{
+			// The outermost stage decides whether the whole call tree is timed.
+			// Each outermost stage counts its own calls, otherwise the stages called in turn (APU, PPU) would be sampled unevenly.
+
+			Zone* z = &zones[zone];
+			sampling = --z->countdown == 0;
+			if (sampling)
+			{
+				z->countdown = sample_period;
+			}
+		}
+
+		if (depth < MaxDepth)
+		{
+			stack[depth] = zone;
+			if (sampling)
+			{
+				stack_start[depth] = Now();
+			}
+		}
+		depth++;
+	}
+
+	void Profiler::Leave(size_t zone)
+	{
+		depth--;
+
+		if (!sampling || depth >= MaxDepth)
+			return;
+
+		uint64_t elapsed = Now() - stack_start[depth];
+
+		Zone* z = &zones[zone];
+		z->ticks += elapsed;
+		z->sampled_calls++;
+
+		if (depth != 0)
+		{
+			z->parent = (int)stack[depth - 1];
+			zones[stack[depth - 1]].child_ticks += elapsed;
+		}
+	}
+
+	uint64_t Profiler::Now()
+	{
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+		return __rdtsc();
+#else
+		return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+	}
+
+	void Profiler::SetSamplePeriod(size_t period)
+	{
+		sample_period = period != 0 ? period : 1;
+		for (size_t n = 0; n < num_zones; n++)
+		{
+			zones[n].countdown = 1;
+		}
+	}
+
+	void Profiler::Reset()
+	{
+		for (size_t n = 0; n < num_zones; n++)
+		{
+			zones[n].calls = 0;
+			zones[n].sampled_calls = 0;
+			zones[n].ticks = 0;
+			zones[n].child_ticks = 0;
+			zones[n].countdown = 1;
+		}
+	}
+
+	uint64_t Profiler::EstimatedTicks(size_t zone, uint64_t ticks)
+	{
+		Zone* z = &zones[zone];
+		if (z->sampled_calls == 0)
+			return 0;
+		return (uint64_t)((double)ticks * (double)z->calls / (double)z->sampled_calls);
+	}
+
+	void Profiler::GetPath(size_t zone, char* path, size_t path_size)
+	{
+		// Parents first, separated by ';'
+
+		size_t chain[MaxDepth]{};
+		size_t len = 0;
+
+		int n = (int)zone;
+		while (n >= 0 && len < MaxDepth)
+		{
+			chain[len++] = n;
+			n = zones[n].parent;
+		}
+
+		path[0] = 0;
+		for (size_t i = 0; i < len; i++)
+		{
+			if (i != 0)
+				strncat(path, ";", path_size - strlen(path) - 1);
+			strncat(path, zones[chain[len - 1 - i]].name, path_size - strlen(path) - 1);
+		}
+	}
+
+	void Profiler::Report(FILE* f)
+	{
+		uint64_t total = 0;
+		for (size_t n = 0; n < num_zones; n++)
+		{
+			if (zones[n].parent < 0)
+				total += EstimatedTicks(n, zones[n].ticks);
+		}
+
+		// Sort by self cost
+
+		size_t order[MaxZones]{};
+		uint64_t self[MaxZones]{};
+		for (size_t n = 0; n < num_zones; n++)
+		{
+			order[n] = n;
+			self[n] = EstimatedTicks(n, zones[n].ticks - zones[n].child_ticks);
+		}
+		std::sort(order, order + num_zones, [&](size_t a, size_t b) { return self[a] > self[b]; });
+
+		fprintf(f, "%-48s %14s %16s %7s %12s\n", "Stage", "Calls", "Self ticks", "Self %", "Ticks/call");
+
+		for (size_t i = 0; i < num_zones; i++)
+		{
+			size_t n = order[i];
+			char path[0x200]{};
+			GetPath(n, path, sizeof(path));
+
+			double share = total != 0 ? 100.0 * (double)self[n] / (double)total : 0.0;
+			double per_call = zones[n].sampled_calls != 0 ? (double)zones[n].ticks / (double)zones[n].sampled_calls : 0.0;
+
+			fprintf(f, "%-48s %14llu %16llu %6.2f%% %12.1f\n", path,
+				(unsigned long long)zones[n].calls, (unsigned long long)self[n], share, per_call);
+		}
+
+		fprintf(f, "Total: %llu ticks (sample period: %zd)\n", (unsigned long long)total, sample_period);
+	}
+
+	bool Profiler::SaveFolded(const char* filename)
+	{
+		FILE* f = fopen(filename, "wt");
+		if (f == nullptr)
+			return false;
+
+		for (size_t n = 0; n < num_zones; n++)
+		{
+			if (zones[n].sampled_calls == 0)
+				continue;
+
+			char path[0x200]{};
+			GetPath(n, path, sizeof(path));
+			fprintf(f, "%s %llu\n", path, (unsigned long long)EstimatedTicks(n, zones[n].ticks - zones[n].child_ticks));
+		}
+
+		fclose(f);
+		return true;
+	}
+}
@@ -0,0 +1,119 @@
+// Sampling profiler of the simulation stages.
+
+#pragma once
+
+namespace BaseLogic
+{
+	/// <summary>
+	/// Collects the cost (in timestamp counter ticks) and the number of calls of the simulation stages marked with PROFILE_SCOPE/PROFILE_STAGE.
+	/// The marks are compiled in only when BREAKS_PROFILER is defined, otherwise they do not generate any code.
+	/// Only every N-th call of the outermost stage is timed (together with all nested stages), the cost of the rest is extrapolated by the number of calls.
+	/// The profiler is global and not thread-safe, profile single-threaded runs.
+	/// </summary>
+	class Profiler
+	{
+		struct Zone
+		{
+			const char* name;
+			int parent;
+			uint64_t calls;
+			uint64_t sampled_calls;
+			uint64_t ticks;				// Sampled ticks including the nested stages
+			uint64_t child_ticks;		// Sampled ticks of the nested stages
+			size_t countdown;			// Calls left until the next sample (when the stage is the outermost one)
+		};
+
+		static const size_t MaxZones = 256;
+		static const size_t MaxDepth = 32;
+
+		static Zone zones[MaxZones];
+		static size_t num_zones;
+
+		static size_t stack[MaxDepth];
+		static uint64_t stack_start[MaxDepth];
+		static size_t depth;
+
+		static size_t sample_period;
+		static bool sampling;
+
+		static uint64_t EstimatedTicks(size_t zone, uint64_t ticks);
+		static void GetPath(size_t zone, char* path, size_t path_size);
+
+	public:
+
+		/// <summary>
+		/// Register the stage (once per mark).
+		/// </summary>
+		static size_t Register(const char* name);
+
+		static void Enter(size_t zone);
+		static void Leave(size_t zone);
+
+		/// <summary>
+		/// Timestamp counter (rdtsc where available, otherwise a steady clock in ns).
+		/// </summary>
+		static uint64_t Now();
+
+		/// <summary>
+		/// Time every N-th call of the outermost stage (1: time all calls). Default: 61.
+		/// The period should not be a multiple of the clock dividers of the chips (PCLK = CLK/4, PHI = CLK/12), otherwise the stages that run only on the divided clock are sampled always or never.
+		/// </summary>
+		static void SetSamplePeriod(size_t period);
+
+		/// <summary>
+		/// Clear the collected statistics (the registered stages remain).
+		/// </summary>
+		static void Reset();
+
+		/// <summary>
+		/// Print the table of the stages: calls, estimated cost, share of the total cost and cost per call.
+		/// </summary>
+		static void Report(FILE* f);
+
+		/// <summary>
+		/// Save the self cost of the stages in the "folded stacks" format (one `parent;child cost` line per stage), which is accepted by flamegraph.pl and speedscope.
+		/// </summary>
+		static bool SaveFolded(const char* filename);
+	};
+
+	class ProfilerScope
+	{
+		size_t zone;
+
+	public:
+		ProfilerScope(size_t _zone)
+		{
+			zone = _zone;
+			Profiler::Enter(zone);
+		}
+
+		~ProfilerScope()
+		{
+			Profiler::Leave(zone);
+		}
+	};
+}
+
+#define PROFILE_CONCAT2(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT2(a, b)
+
+#ifdef BREAKS_PROFILER
+
+/// <summary>
+/// Time the rest of the enclosing block as the stage `name`.
+/// </summary>
+#define PROFILE_SCOPE(name) \
+	static size_t PROFILE_CONCAT(prof_zone_, __LINE__) = BaseLogic::Profiler::Register(name); \
+	BaseLogic::ProfilerScope PROFILE_CONCAT(prof_scope_, __LINE__)(PROFILE_CONCAT(prof_zone_, __LINE__))
+
+/// <summary>
+/// Time one statement as the stage `name`.
+/// </summary>
+#define PROFILE_STAGE(name, stmt) { PROFILE_SCOPE(name); stmt; }
+
+#else
+
+#define PROFILE_SCOPE(name)
+#define PROFILE_STAGE(name, stmt) stmt
+
+#endif
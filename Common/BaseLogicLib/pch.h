@@ -3,5 +3,6 @@
 #include <stdint.h>
 #include <string.h>
 #include <stdio.h>
+#include <algorithm>
 
 #include "BaseLogic.h"
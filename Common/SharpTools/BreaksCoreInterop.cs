@@ -38,15 +38,147 @@ namespace SharpTools
 		[DllImport("BreaksCore.dll", CallingConvention = CallingConvention.Cdecl)]
 		public static extern void SampleAudioSignal(out float sample);
 
+		/// <summary>
+		/// Where the board audio filters are applied.
+		/// </summary>
+		public enum AudioFilterPlacement
+		{
+			None = 0,
+			ExactRate,
+			PostResample,
+		};
+
+		[DllImport("BreaksCore.dll", CallingConvention = CallingConvention.Cdecl)]
+		public static extern void SetAudioFilter(AudioFilterPlacement placement, int output_sample_rate);
+
 		[DllImport("BreaksCore.dll", CallingConvention = CallingConvention.Cdecl)]
 		public static extern void LoadRegDump([In, Out][MarshalAs(UnmanagedType.LPArray)] byte[] data, int data_size);
 
+		[DllImport("BreaksCore.dll", CallingConvention = CallingConvention.Cdecl)]
+		public static extern int SeekRegDump(long frame);
+
+		[DllImport("BreaksCore.dll", CallingConvention = CallingConvention.Cdecl)]
+		public static extern int MapRegDump(string filename);
+
 		[DllImport("BreaksCore.dll", CallingConvention = CallingConvention.Cdecl)]
 		public static extern void EnablePpuRegDump(bool enable, string regdump_dir);
 
+		[DllImport("BreaksCore.dll", CallingConvention = CallingConvention.Cdecl)]
+		public static extern void EnableSignalRecorder(bool enable, long capacity);
+
+		[DllImport("BreaksCore.dll", CallingConvention = CallingConvention.Cdecl)]
+		public static extern int AddRecorderSignal(string category, string name);
+
+		[DllImport("BreaksCore.dll", CallingConvention = CallingConvention.Cdecl)]
+		public static extern void GetRecorderTimeRange(out UInt64 oldest, out UInt64 now);
+
+		[DllImport("BreaksCore.dll", CallingConvention = CallingConvention.Cdecl)]
+		public static extern int ExportSignalRecording(string filename, UInt64 from, UInt64 to);
+
+		public enum BoardEventType
+		{
+			FieldStart = 0,
+			FieldEnd,
+			VBlankSet,
+			VBlankClear,
+			NMIAssert,
+			NMIRelease,
+			IRQAssert,
+			IRQRelease,
+			OAMDMAStart,
+			OAMDMAEnd,
+			PPURegRead,
+			PPURegWrite,
+			APURegRead,
+			APURegWrite,
+		}
+
+		[StructLayout(LayoutKind.Sequential)]
+		public struct BoardEvent
+		{
+			public UInt64 clk;
+			public UInt64 phi;
+			public UInt32 type;
+			public UInt16 addr;
+			public byte value;
+			public byte reserved;
+		}
+
+		[DllImport("BreaksCore.dll", CallingConvention = CallingConvention.Cdecl)]
+		public static extern void SubscribeEvents(UInt32 mask, long capacity);
+
+		[DllImport("BreaksCore.dll", CallingConvention = CallingConvention.Cdecl)]
+		public static extern long GetEventCount();
+
+		[DllImport("BreaksCore.dll", CallingConvention = CallingConvention.Cdecl)]
+		public static extern long ReadEvents([In, Out][MarshalAs(UnmanagedType.LPArray)] BoardEvent[] events, long max_count);
+
+		[DllImport("BreaksCore.dll", CallingConvention = CallingConvention.Cdecl)]
+		public static extern UInt64 GetLostEventCount();
+
+		[DllImport("BreaksCore.dll", CallingConvention = CallingConvention.Cdecl)]
+		public static extern long StepUntilEvent(long max_steps);
+
+		public enum DebugSnapshotCadence
+		{
+			Disabled = 0,
+			Field,
+			Cycles,
+		}
+
+		[DllImport("BreaksCore.dll", CallingConvention = CallingConvention.Cdecl)]
+		public static extern void EnableDebugSnapshot(DebugSnapshotCadence cadence, long period, bool with_memory);
+
+		[DllImport("BreaksCore.dll", CallingConvention = CallingConvention.Cdecl)]
+		public static extern UInt64 AcquireDebugSnapshot(out UInt64 phi);
+
+		[DllImport("BreaksCore.dll", CallingConvention = CallingConvention.Cdecl)]
+		public static extern long SnapshotDumpMem(long descrID, [In, Out][MarshalAs(UnmanagedType.LPArray)] byte[] ptr);
+
+		[DllImport("BreaksCore.dll", CallingConvention = CallingConvention.Cdecl)]
+		public static extern int SnapshotGetAllCoreDebugInfo(out CpuDebugInfoRaw info);
+
+		public enum InputMovieMode
+		{
+			None = 0,
+			Recording,
+			Playback,
+			PlaybackFinished,
+		}
+
+		[DllImport("BreaksCore.dll", CallingConvention = CallingConvention.Cdecl)]
+		public static extern int StartInputRecording(string filename);
+
+		[DllImport("BreaksCore.dll", CallingConvention = CallingConvention.Cdecl)]
+		public static extern int StartInputPlayback(string filename);
+
+		[DllImport("BreaksCore.dll", CallingConvention = CallingConvention.Cdecl)]
+		public static extern void StopInputMovie();
+
+		[DllImport("BreaksCore.dll", CallingConvention = CallingConvention.Cdecl)]
+		public static extern InputMovieMode GetInputMovieState(out UInt64 phi, out UInt64 entries, out UInt64 dropped);
+
 		[DllImport("BreaksCore.dll", CallingConvention = CallingConvention.Cdecl)]
 		public static extern void EnableApuRegDump(bool enable, string regdump_dir);
 
+		[DllImport("BreaksCore.dll", CallingConvention = CallingConvention.Cdecl)]
+		public static extern void SetRegDumpKeyframeInterval(long frames);
+
+		[DllImport("BreaksCore.dll", CallingConvention = CallingConvention.Cdecl)]
+		public static extern void SetRegDumpFormat(int format, bool drop_when_full);
+
+		[StructLayout(LayoutKind.Sequential)]
+		public struct RegDumpStats
+		{
+			public UInt64 entries;
+			public UInt64 bytes;
+			public UInt64 drops;
+			public UInt64 stalls;
+		}
+
+		[DllImport("BreaksCore.dll", CallingConvention = CallingConvention.Cdecl)]
+		public static extern int GetRegDumpStats(bool ppu_dump, out RegDumpStats stats);
+
 		[StructLayout(LayoutKind.Explicit)]
 		public struct AudioSignalFeatures
 		{
@@ -354,6 +486,9 @@ namespace SharpTools
 		[DllImport("BreaksCore.dll", CallingConvention = CallingConvention.Cdecl)]
 		static extern void GetDebugInfo(DebugInfoType type, IntPtr entries);
 
+		[DllImport("BreaksCore.dll", CallingConvention = CallingConvention.Cdecl)]
+		static extern long SnapshotGetDebugInfo(DebugInfoType type, IntPtr entries);
+
 		[DllImport("BreaksCore.dll", CallingConvention = CallingConvention.Cdecl)]
 		static extern int GetDebugInfoByName(DebugInfoType type, ref DebugInfoEntryRaw entry);
 
@@ -421,7 +556,10 @@ namespace SharpTools
 		}
 
 
-		public static List<DebugInfoEntry> GetDebugInfo(DebugInfoType type)
+		/// <summary>
+		/// Get all entries of the specified type. from_snapshot: take the values from the snapshot acquired by AcquireDebugSnapshot (without stopping the simulation).
+		/// </summary>
+		public static List<DebugInfoEntry> GetDebugInfo(DebugInfoType type, bool from_snapshot = false)
 		{
 			List<DebugInfoEntry> list = new();
 
@@ -435,7 +573,14 @@ namespace SharpTools
 				throw new Exception("AllocHGlobal failed!");
 			}
 
-			BreaksCore.GetDebugInfo(type, ptr);
+			if (from_snapshot)
+			{
+				BreaksCore.SnapshotGetDebugInfo(type, ptr);
+			}
+			else
+			{
+				BreaksCore.GetDebugInfo(type, ptr);
+			}
 
 			IntPtr p = ptr;
 
@@ -70,6 +70,10 @@ namespace IO
 		IOMapped* mapped = GetMappedDeviceByHandle(handle);
 		if (mapped != nullptr) {
 
+			if (mapped->port >= 0 && port_devices[mapped->port] == mapped) {
+				port_devices[mapped->port] = nullptr;
+			}
+
 			if (mapped->device != nullptr) {
 				delete mapped->device;
 			}
@@ -90,9 +94,12 @@ namespace IO
 		return nullptr;
 	}
 
+	/// <summary>
+	/// The port holds one device; the device that was attached to it before is detached.
+	/// </summary>
 	void IOSubsystem::Attach(int port, int handle)
 	{
-		if (handle < 0 || port >= GetPorts() || port < 0)
+		if (handle < 0 || port >= GetPorts() || port < 0 || port >= IO_MaxPorts)
 			return;
 
 		IOMapped* mapped = GetMappedDeviceByHandle(handle);
@@ -107,7 +114,17 @@ namespace IO
 
 				if (*it == (DeviceID)mapped->device->GetID()) {
 
+					if (mapped->port >= 0 && port_devices[mapped->port] == mapped) {
+						port_devices[mapped->port] = nullptr;
+					}
+					if (port_devices[port] != nullptr) {
+						port_devices[port]->port = -1;
+					}
+
 					mapped->port = port;
+					mapped->changed = true;
+					port_devices[port] = mapped;
+					port_cache[port].valid = false;
 					break;
 				}
 			}
@@ -116,17 +133,36 @@ namespace IO
 	
 	void IOSubsystem::Detach(int port, int handle)
 	{
-		if (handle < 0 || port >= GetPorts() || port < 0)
+		if (handle < 0 || port >= GetPorts() || port < 0 || port >= IO_MaxPorts)
 			return;
 
 		IOMapped* mapped = GetMappedDeviceByHandle(handle);
 		if (mapped != nullptr) {
 
+			if (port_devices[port] == mapped) {
+				port_devices[port] = nullptr;
+			}
 			mapped->port = -1;
 		}
 	}
 
 	void IOSubsystem::SetState(int handle, size_t io_state, uint32_t value)
+	{
+		if (handle < 0)
+			return;
+
+		IOMapped* mapped = GetMappedDeviceByHandle(handle);
+		if (mapped != nullptr && mapped->port >= 0 && io_state < IO_MaxStates) {
+
+			// The value goes first, then the flag; the simulation thread takes the flag, then the value
+
+			mapped->mail_value[io_state].store(value, std::memory_order_relaxed);
+			mapped->mail_flag[io_state].store(true, std::memory_order_release);
+			mail_pending.store(true, std::memory_order_release);
+		}
+	}
+
+	void IOSubsystem::ApplyState(int handle, size_t io_state, uint32_t value)
 	{
 		if (handle < 0)
 			return;
@@ -135,8 +171,55 @@ namespace IO
 		if (mapped != nullptr && mapped->port >= 0) {
 
 			mapped->device->SetState(io_state, value);
+			mapped->changed = true;
+		}
+	}
+
+	void IOSubsystem::ProcessMailbox()
+	{
+		if (!mail_pending.load(std::memory_order_acquire))
+			return;
+
+		mail_pending.store(false, std::memory_order_relaxed);
+
+		for (auto it = devices.begin(); it != devices.end(); ++it) {
+
+			IOMapped* mapped = *it;
+			int num_states = mapped->device->GetIOStates();
+
+			for (int n = 0; n < num_states && n < IO_MaxStates; n++) {
+
+				if (mapped->mail_flag[n].exchange(false, std::memory_order_acquire)) {
+
+					mapped->device->SetState(n, mapped->mail_value[n].load(std::memory_order_relaxed));
+					mapped->changed = true;
+				}
+			}
 		}
 	}
+
+	bool IOSubsystem::SimPort(int port, BaseLogic::TriState inputs[], size_t num_inputs, BaseLogic::TriState outputs[], size_t num_outputs, float analog[])
+	{
+		IOMapped* mapped = port_devices[port];
+		if (mapped == nullptr)
+			return false;
+
+		PortCache* cache = &port_cache[port];
+
+		if (cache->valid && !mapped->changed && memcmp(cache->inputs, inputs, num_inputs * sizeof(BaseLogic::TriState)) == 0) {
+
+			memcpy(outputs, cache->outputs, num_outputs * sizeof(BaseLogic::TriState));
+			return true;
+		}
+
+		mapped->device->sim(inputs, outputs, analog);
+
+		memcpy(cache->inputs, inputs, num_inputs * sizeof(BaseLogic::TriState));
+		memcpy(cache->outputs, outputs, num_outputs * sizeof(BaseLogic::TriState));
+		cache->valid = true;
+		mapped->changed = false;
+		return true;
+	}
 	
 	uint32_t IOSubsystem::GetState(int handle, size_t io_state)
 	{
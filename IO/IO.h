@@ -29,11 +29,21 @@ namespace IO
 
 namespace IO
 {
+	#define IO_MaxPorts 8				// Maximum number of motherboard IO ports
+	#define IO_MaxPortSignals 8			// Maximum number of input/output signals of the port
+
 	struct IOMapped
 	{
 		int port;		// -1: detached
 		int handle;		// -1: no handle
 		IODevice* device;
+
+		// Mailbox: the latest IOState values set by the frontend thread, not yet applied by the simulation thread
+
+		std::atomic<uint32_t> mail_value[IO_MaxStates]{};
+		std::atomic<bool> mail_flag[IO_MaxStates]{};
+
+		bool changed = true;	// The device state has changed since the last device simulation
 	};
 
 	/// <summary>
@@ -43,9 +53,31 @@ namespace IO
 	{
 		IOMapped* GetMappedDeviceByHandle(int handle);
 
+		/// <summary>
+		/// Signals of the port at the time of the last device simulation.
+		/// </summary>
+		struct PortCache
+		{
+			bool valid;
+			BaseLogic::TriState inputs[IO_MaxPortSignals];
+			BaseLogic::TriState outputs[IO_MaxPortSignals];
+		};
+
+		IOMapped* port_devices[IO_MaxPorts]{};
+		PortCache port_cache[IO_MaxPorts]{};
+
+		std::atomic<bool> mail_pending{ false };
+
 	protected:
 		std::list<IOMapped*> devices;
 
+		/// <summary>
+		/// Simulate the device attached to the port. The device is simulated only if its input signals or its state have changed since the last time;
+		/// otherwise the outputs of the last simulation are returned (the controllers only change on the strobe/clock edges and button presses).
+		/// </summary>
+		/// <returns>false: there is no device attached to the port (the outputs are not touched)</returns>
+		bool SimPort(int port, BaseLogic::TriState inputs[], size_t num_inputs, BaseLogic::TriState outputs[], size_t num_outputs, float analog[]);
+
 	public:
 		IOSubsystem();
 		virtual ~IOSubsystem();
@@ -58,7 +90,17 @@ namespace IO
 		void Attach(int port, int handle);
 		void Detach(int port, int handle);
 
+		/// <summary>
+		/// Set the IOState from the frontend thread. The value is put into the mailbox of the device and applied by the simulation thread before the next device simulation (see ProcessMailbox).
+		/// If the value is changed several times in between, only the latest one is applied.
+		/// </summary>
 		void SetState(int handle, size_t io_state, uint32_t value);
+
+		/// <summary>
+		/// Set the IOState immediately (simulation thread only, e.g. the input movie).
+		/// </summary>
+		void ApplyState(int handle, size_t io_state, uint32_t value);
+
 		uint32_t GetState(int handle, size_t io_state);
 
 		int GetNumStates(int handle);
@@ -74,6 +116,11 @@ namespace IO
 
 		virtual void sim(int port);
 
+		/// <summary>
+		/// Apply the IOState values from the mailboxes. Called by the motherboard before simulating the ports.
+		/// </summary>
+		void ProcessMailbox();
+
 #pragma endregion "Interface for Motherboard implementation"
 
 	};
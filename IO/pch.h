@@ -2,9 +2,11 @@
 
 #include <cstdint>
 #include <cstdio>
+#include <cstring>
 #include <string>
 #include <list>
 #include <map>
+#include <atomic>
 
 #include "../Common/BaseLogicLib/BaseLogic.h"
 
@@ -29,13 +29,12 @@ namespace Mappers
 		// Load PRG ROM
 
 		PRGSize = head->PRGSize * 0x4000;
-		PRG = new uint8_t[PRGSize];
-
 		uint8_t* prgPtr = nesImage + sizeof(NESHeader) + (trainer ? NES_TRAINER_SIZE : 0);
-		memcpy(PRG, prgPtr, PRGSize);
+		PRG = ROMPool::Acquire(prgPtr, PRGSize);
 
 		valid = true;
 
+		MapBanks();
 		AddCartMemDescriptors();
 	}
 
@@ -44,7 +43,7 @@ namespace Mappers
 		printf("AOROM::~AOROM()\n");
 
 		if (PRG != nullptr)
-			delete PRG;
+			ROMPool::Release(PRG);
 
 		if (CHR != nullptr)
 			delete CHR;
@@ -55,9 +54,41 @@ namespace Mappers
 		return valid;
 	}
 
+	bool AOROM::StrobeDriven()
+	{
+		return true;
+	}
+
+	/// <summary>
+	/// Counter outputs Q0-Q2 select the 32 KB PRG bank (A15-A17), Q3 goes to VRAM_A10 (single-screen mirroring).
+	/// </summary>
+	void AOROM::MapBanks()
+	{
+		size_t prg_address = (size_t)(bank_reg & 7) << 15;
+
+		for (size_t n = 0; n < 4; n++)
+		{
+			MapPRG(n, PRG, PRGSize, prg_address | (n * 0x2000));
+		}
+
+		for (size_t n = 0; n < 8; n++)
+		{
+			MapCHR(n, CHR, CHRSize, n * 0x400);
+		}
+
+		banks.chr_writable = true;
+
+		for (size_t n = 0; n < 4; n++)
+		{
+			banks.vram_a10[n] = (bank_reg >> 3) & 1;
+		}
+
+		bank_map = true;
+	}
+
 	void AOROM::sim(
-		TriState cart_in[(size_t)CartInput::Max],
-		TriState cart_out[(size_t)CartOutput::Max],
+		Pins32& cart_in,
+		Pins32& cart_out,
 		uint16_t cpu_addr,
 		uint8_t* cpu_data, bool& cpu_data_dirty,
 		uint16_t ppu_addr,
@@ -72,8 +103,8 @@ namespace Mappers
 
 		// Counter (as register) to select PRG Bank
 
-		TriState nROMSEL = cart_in[(size_t)CartInput::nROMSEL];
-		TriState CPU_RnW = cart_in[(size_t)CartInput::RnW];
+		TriState nROMSEL = cart_in.get((size_t)CartInput::nROMSEL);
+		TriState CPU_RnW = cart_in.get((size_t)CartInput::RnW);
 
 		TriState P[4]{};
 
@@ -87,27 +118,36 @@ namespace Mappers
 
 		counter.sim(nROMSEL, vdd, CPU_RnW, gnd, gnd, P, RCO, Q);
 
+		// The banks are remapped only when the counter is loaded with another value
+
+		uint8_t bank = PackNibble(Q);
+		if (bank != bank_reg)
+		{
+			bank_reg = bank;
+			MapBanks();
+		}
+
 		// PPU Part
 
-		TriState nRD = cart_in[(size_t)CartInput::nRD];
-		TriState nWR = cart_in[(size_t)CartInput::nWR];
+		TriState nRD = cart_in.get((size_t)CartInput::nRD);
+		TriState nWR = cart_in.get((size_t)CartInput::nWR);
 
 		// H/V Mirroring
-		cart_out[(size_t)CartOutput::VRAM_A10] = Q[3];
+		cart_out.set((size_t)CartOutput::VRAM_A10, FromByte(banks.vram_a10[(ppu_addr >> 10) & 3]));
 
 		// Contains a jumper between `/PA13` and `/VRAM_CS`
-		cart_out[(size_t)CartOutput::VRAM_nCS] = cart_in[(size_t)CartInput::nPA13];
+		cart_out.set((size_t)CartOutput::VRAM_nCS, cart_in.get((size_t)CartInput::nPA13));
 
 		// CHR_A13 is actually `/CS` for CHR
 		TriState nCHR_CS = FromByte((ppu_addr >> 13) & 1);
 
 		if (nCHR_CS == TriState::Zero)
 		{
-			assert(ppu_addr < CHRSize);
+			uint8_t* chr = banks.chr[(ppu_addr >> 10) & 7] + (ppu_addr & 0x3ff);
 
 			if (nRD == TriState::Zero)
 			{
-				uint8_t val = CHR[ppu_addr];
+				uint8_t val = *chr;
 
 				if (!ppu_data_dirty)
 				{
@@ -120,22 +160,17 @@ namespace Mappers
 				}
 			}
 
-			if (nWR == TriState::Zero)
+			if (nWR == TriState::Zero && banks.chr_writable)
 			{
-				CHR[ppu_addr] = *ppu_data;
+				*chr = *ppu_data;
 			}
 		}
 
 		// CPU Part
 
-		size_t prg_address = (cpu_addr) |
-			((size_t)ToByte(Q[0]) << 15) |		// A15
-			((size_t)ToByte(Q[1]) << 16) |		// A16
-			((size_t)ToByte(Q[2]) << 17);		// A17
-
 		if (nROMSEL == TriState::Zero)
 		{
-			uint8_t val = PRG[prg_address];
+			uint8_t val = banks.prg[(cpu_addr >> 13) & 3][cpu_addr & 0x1fff];
 
 			if (!cpu_data_dirty)
 			{
@@ -148,10 +183,10 @@ namespace Mappers
 			}
 		}
 
-		TriState nIRQ = cart_out[(size_t)CartOutput::nIRQ];
+		TriState nIRQ = cart_out.get((size_t)CartOutput::nIRQ);
 		if (!(nIRQ == TriState::Zero || nIRQ == TriState::One))
 		{
-			cart_out[(size_t)CartOutput::nIRQ] = TriState::Z;
+			cart_out.set((size_t)CartOutput::nIRQ, TriState::Z);
 		}
 
 		if (p1_type == ConnectorType::FamicomStyle && snd_out)
@@ -166,7 +201,7 @@ namespace Mappers
 		memset(chrRegion, 0, sizeof(MemDesciptor));
 		strcpy(chrRegion->name, CHR_ROM_NAME);
 		chrRegion->size = (int32_t)CHRSize;
-		dbg_hub->AddMemRegion(chrRegion, Dbg_ReadCHRByte, Dbg_WriteCHRByte, this, true);
+		dbg_hub->AddMemRegion(chrRegion, Dbg_ReadCHRByte, Dbg_WriteCHRByte, this, true, Dbg_GetCHRSpan);
 	}
 
 	uint8_t AOROM::Dbg_ReadCHRByte(void* opaque, size_t addr)
@@ -186,6 +221,12 @@ namespace Mappers
 		}
 	}
 
+	uint8_t* AOROM::Dbg_GetCHRSpan(void* opaque)
+	{
+		AOROM* aorom = (AOROM*)opaque;
+		return aorom->valid ? aorom->CHR : nullptr;
+	}
+
 	void AOROM::Dbg_WriteCHRByte(void* opaque, size_t addr, uint8_t data)
 	{
 		AOROM* aorom = (AOROM*)opaque;
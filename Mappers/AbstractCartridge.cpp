@@ -15,4 +15,24 @@ namespace Mappers
 	{
 		return true;
 	}
+
+	const CartBankMap* AbstractCartridge::GetBankMap()
+	{
+		return bank_map ? &banks : nullptr;
+	}
+
+	bool AbstractCartridge::StrobeDriven()
+	{
+		return false;
+	}
+
+	void AbstractCartridge::MapPRG(size_t slot, uint8_t* mem, size_t mem_size, size_t offset)
+	{
+		banks.prg[slot & 3] = mem + (offset % mem_size);
+	}
+
+	void AbstractCartridge::MapCHR(size_t slot, uint8_t* mem, size_t mem_size, size_t offset)
+	{
+		banks.chr[slot & 7] = mem + (offset % mem_size);
+	}
 }
@@ -45,6 +45,18 @@ namespace Mappers
 		float normalized;
 	};
 
+	/// <summary>
+	/// Where the cartridge maps the buses for the current state of its bank registers.
+	/// The mapper updates the tables only when the registers change, the rest of the time the buses are decoded with a table lookup.
+	/// </summary>
+	struct CartBankMap
+	{
+		uint8_t* prg[4];			// 8 KB PRG banks, selected by CPU A13-A14 when /ROMSEL = 0 (CPU A15 is not routed to the cartridge)
+		uint8_t* chr[8];			// 1 KB CHR banks, selected by PPU A10-A12 when PPU A13 = 0
+		bool chr_writable;			// The cartridge connects PPU /WR to the CHR (CHR-RAM)
+		uint8_t vram_a10[4];		// VRAM_A10 (nametable mirroring), selected by PPU A10-A11
+	};
+
 	class AbstractCartridge
 	{
 	protected:
@@ -53,15 +65,41 @@ namespace Mappers
 		BaseLogic::TriState gnd = BaseLogic::TriState::Zero;
 		BaseLogic::TriState vdd = BaseLogic::TriState::One;
 
+		CartBankMap banks{};
+		bool bank_map = false;		// The mapper uses the bank tables
+
+		/// <summary>
+		/// Map the 8 KB PRG bank at `offset` of the PRG memory to the slot (0-3). The offset wraps around the memory size, as the unconnected upper address lines do.
+		/// </summary>
+		void MapPRG(size_t slot, uint8_t* mem, size_t mem_size, size_t offset);
+
+		/// <summary>
+		/// Map the 1 KB CHR bank at `offset` of the CHR memory to the slot (0-7).
+		/// </summary>
+		void MapCHR(size_t slot, uint8_t* mem, size_t mem_size, size_t offset);
+
 	public:
 		AbstractCartridge(ConnectorType _p1_type, uint8_t* nesImage, size_t size);
 		virtual ~AbstractCartridge();
 
 		virtual bool Valid();
 
+		/// <summary>
+		/// Get the bank tables of the cartridge.
+		/// </summary>
+		/// <returns>nullptr: the mapper does not use the bank tables</returns>
+		const CartBankMap* GetBankMap();
+
+		/// <summary>
+		/// true: the cartridge only reacts to the bus strobes (/ROMSEL for the CPU, /RD and /WR for the PPU), so the board may skip its simulation while both buses are idle.
+		/// false: the cartridge needs every half cycle (e.g. it divides M2 or counts PPU A12).
+		/// While the cartridge is skipped its debug info keeps the values of the last simulated half cycle (e.g. NROM "Last PA" is the address of the last PPU access, not the current PA).
+		/// </summary>
+		virtual bool StrobeDriven();
+
 		virtual void sim( 
-			BaseLogic::TriState cart_in[(size_t)CartInput::Max],
-			BaseLogic::TriState cart_out[(size_t)CartOutput::Max],
+			BaseLogic::Pins32& cart_in,
+			BaseLogic::Pins32& cart_out,
 			uint16_t cpu_addr,
 			uint8_t* cpu_data, bool& cpu_data_dirty, 
 			uint16_t ppu_addr,
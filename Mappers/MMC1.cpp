@@ -102,6 +102,31 @@ namespace Mappers
 			reg[0].b3 = 1;
 		}
 
+		int regs = (reg[0].bitval & 0x1f) | ((reg[1].bitval & 0x1f) << 5) | ((reg[2].bitval & 0x1f) << 10) | ((reg[3].bitval & 0x1f) << 15);
+		if (regs != packed_regs) {
+			packed_regs = regs;
+			regs_version++;
+		}
+
+		BankOutputs(a14, ppu_a10, ppu_a11, ppu_a12, outputs);
+
+		// SRAM Chip Select
+
+		outputs[(size_t)MMC1_Output::SRAM_CE] = BaseLogic::FromByte(n_romsel && a13 && a14 && delayed_m2 && m2);
+
+		// PRG Chip Select
+
+		outputs[(size_t)MMC1_Output::PRG_nCE] = BaseLogic::FromByte(n_romsel || !rnw);
+
+		// Freeze edge
+
+		prev_m2 = m2;
+		prev_div_ck = div_ck;
+		prev_reg0_enable = reg_enable == 0 ? 1 : 0;
+	}
+
+	void MMC1::BankOutputs(int a14, int ppu_a10, int ppu_a11, int ppu_a12, BaseLogic::TriState outputs[])
+	{
 		// CHR Bank Switch
 
 		outputs[(size_t)MMC1_Output::CHR_A12] = BaseLogic::FromByte( (1 && (reg[2].b0 || !reg[0].b4) && ppu_a12) || (!ppu_a12 && reg[0].b4 && reg[1].b0) );	// 33-aon
@@ -120,20 +145,11 @@ namespace Mappers
 		// CIRAM A10 Line
 
 		outputs[(size_t)MMC1_Output::CIRAM_A10] = BaseLogic::FromByte((ppu_a11 && reg[0].b0 && reg[0].b1) || (!reg[0].b0 && reg[0].b1 && ppu_a10) || (1 && reg[0].b0 && !reg[0].b1));		// 333-aon
+	}
 
-		// SRAM Chip Select
-
-		outputs[(size_t)MMC1_Output::SRAM_CE] = BaseLogic::FromByte(n_romsel && a13 && a14 && delayed_m2 && m2);
-
-		// PRG Chip Select
-
-		outputs[(size_t)MMC1_Output::PRG_nCE] = BaseLogic::FromByte(n_romsel || !rnw);
-
-		// Freeze edge
-
-		prev_m2 = m2;
-		prev_div_ck = div_ck;
-		prev_reg0_enable = reg_enable == 0 ? 1 : 0;
+	uint32_t MMC1::GetRegsVersion()
+	{
+		return regs_version;
 	}
 
 	bool MMC1::posedge(int prev, int cur)
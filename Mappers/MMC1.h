@@ -68,10 +68,24 @@ namespace Mappers
 		int prev_div_ck = -1;
 		int prev_reg0_enable = -1;
 
+		int packed_regs = 0;
+		uint32_t regs_version = 0;
+
 	public:
 		MMC1();
 		~MMC1();
 
 		void sim(BaseLogic::TriState inputs[], BaseLogic::TriState outputs[]);
+
+		/// <summary>
+		/// Bank switching outputs (CHR_A12-A16, PRG_A14-A17, CIRAM_A10) for the given address lines.
+		/// They depend only on the registers and the address, so the cartridge can compute them in advance for all addresses.
+		/// </summary>
+		void BankOutputs(int a14, int ppu_a10, int ppu_a11, int ppu_a12, BaseLogic::TriState outputs[]);
+
+		/// <summary>
+		/// The number is changed every time the registers change (the bank switching outputs may be different).
+		/// </summary>
+		uint32_t GetRegsVersion();
 	};
 }
@@ -38,10 +38,8 @@ namespace Mappers
 		// Load PRG ROM
 
 		PRGSize = head->PRGSize * 0x4000;
-		PRG = new uint8_t[PRGSize];
-
 		uint8_t* prgPtr = nesImage + sizeof(NESHeader) + (trainer ? NES_TRAINER_SIZE : 0);
-		memcpy(PRG, prgPtr, PRGSize);
+		PRG = ROMPool::Acquire(prgPtr, PRGSize);
 
 		// Create WRAM
 
@@ -52,6 +50,8 @@ namespace Mappers
 		}
 
 		valid = true;
+
+		MapBanks();
 	}
 
 	MMC1_Based::~MMC1_Based()
@@ -61,7 +61,7 @@ namespace Mappers
 		delete mmc;
 
 		if (PRG != nullptr)
-			delete PRG;
+			ROMPool::Release(PRG);
 
 		if (CHR != nullptr)
 			delete CHR;
@@ -75,9 +75,59 @@ namespace Mappers
 		return valid;
 	}
 
+	/// <summary>
+	/// Evaluate the MMC1 bank switching outputs for all address lines they depend on: CPU A14 (PRG), PPU A12 (CHR), PPU A10-A11 (CIRAM A10).
+	/// </summary>
+	void MMC1_Based::MapBanks()
+	{
+		TriState mmc1_out[(size_t)MMC1_Output::Max]{};
+
+		for (int a14 = 0; a14 < 2; a14++)
+		{
+			mmc->BankOutputs(a14, 0, 0, 0, mmc1_out);
+
+			size_t prg_address =
+				((size_t)ToByte(mmc1_out[(size_t)MMC1_Output::PRG_A14]) << 14) |
+				((size_t)ToByte(mmc1_out[(size_t)MMC1_Output::PRG_A15]) << 15) |
+				((size_t)ToByte(mmc1_out[(size_t)MMC1_Output::PRG_A16]) << 16) |
+				((size_t)ToByte(mmc1_out[(size_t)MMC1_Output::PRG_A17]) << 17);
+
+			MapPRG(a14 * 2 + 0, PRG, PRGSize, prg_address);
+			MapPRG(a14 * 2 + 1, PRG, PRGSize, prg_address | 0x2000);
+		}
+
+		for (int a12 = 0; a12 < 2; a12++)
+		{
+			mmc->BankOutputs(0, 0, 0, a12, mmc1_out);
+
+			size_t chr_address =
+				((size_t)ToByte(mmc1_out[(size_t)MMC1_Output::CHR_A12]) << 12) |
+				((size_t)ToByte(mmc1_out[(size_t)MMC1_Output::CHR_A13]) << 13) |
+				((size_t)ToByte(mmc1_out[(size_t)MMC1_Output::CHR_A14]) << 14) |
+				((size_t)ToByte(mmc1_out[(size_t)MMC1_Output::CHR_A15]) << 15) |
+				((size_t)ToByte(mmc1_out[(size_t)MMC1_Output::CHR_A16]) << 16);
+
+			for (size_t n = 0; n < 4; n++)
+			{
+				MapCHR(a12 * 4 + n, CHR, CHRSize, chr_address | (n * 0x400));
+			}
+		}
+
+		banks.chr_writable = true;
+
+		for (int n = 0; n < 4; n++)
+		{
+			mmc->BankOutputs(0, n & 1, (n >> 1) & 1, 0, mmc1_out);
+			banks.vram_a10[n] = ToByte(mmc1_out[(size_t)MMC1_Output::CIRAM_A10]);
+		}
+
+		mapped_regs_version = mmc->GetRegsVersion();
+		bank_map = true;
+	}
+
 	void MMC1_Based::sim(
-		BaseLogic::TriState cart_in[(size_t)CartInput::Max],
-		BaseLogic::TriState cart_out[(size_t)CartOutput::Max],
+		BaseLogic::Pins32& cart_in,
+		BaseLogic::Pins32& cart_out,
 		uint16_t cpu_addr,
 		uint8_t* cpu_data, bool& cpu_data_dirty,
 		uint16_t ppu_addr,
@@ -95,9 +145,9 @@ namespace Mappers
 		TriState mmc1_in[(size_t)MMC1_Input::Max]{};
 		TriState mmc1_out[(size_t)MMC1_Output::Max]{};
 
-		mmc1_in[(size_t)MMC1_Input::M2] = cart_in[(size_t)CartInput::M2];
+		mmc1_in[(size_t)MMC1_Input::M2] = cart_in.get((size_t)CartInput::M2);
 		
-		mmc1_in[(size_t)MMC1_Input::CPU_RnW] = cart_in[(size_t)CartInput::RnW];
+		mmc1_in[(size_t)MMC1_Input::CPU_RnW] = cart_in.get((size_t)CartInput::RnW);
 		mmc1_in[(size_t)MMC1_Input::CPU_A13] = FromByte((cpu_addr >> 13) & 1);
 		mmc1_in[(size_t)MMC1_Input::CPU_A14] = FromByte((cpu_addr >> 14) & 1);
 		mmc1_in[(size_t)MMC1_Input::CPU_D0] = FromByte((*cpu_data >> 0) & 1);
@@ -105,37 +155,37 @@ namespace Mappers
 		mmc1_in[(size_t)MMC1_Input::PPU_A10] = FromByte((ppu_addr >> 10) & 1);
 		mmc1_in[(size_t)MMC1_Input::PPU_A11] = FromByte((ppu_addr >> 11) & 1);
 		mmc1_in[(size_t)MMC1_Input::PPU_A12] = FromByte((ppu_addr >> 12) & 1);
-		mmc1_in[(size_t)MMC1_Input::nROMSEL] = cart_in[(size_t)CartInput::nROMSEL];
+		mmc1_in[(size_t)MMC1_Input::nROMSEL] = cart_in.get((size_t)CartInput::nROMSEL);
 
 		mmc->sim(mmc1_in, mmc1_out);
 
+		// MMC1 itself needs every half cycle (the divider counts M2), but the banks are remapped only when its registers change
+
+		if (mmc->GetRegsVersion() != mapped_regs_version)
+		{
+			MapBanks();
+		}
+
 		// PPU Part
 
-		TriState nRD = cart_in[(size_t)CartInput::nRD];
-		TriState nWR = cart_in[(size_t)CartInput::nWR];
+		TriState nRD = cart_in.get((size_t)CartInput::nRD);
+		TriState nWR = cart_in.get((size_t)CartInput::nWR);
 
-		cart_out[(size_t)CartOutput::VRAM_A10] = mmc1_out[(size_t)MMC1_Output::CIRAM_A10];
+		cart_out.set((size_t)CartOutput::VRAM_A10, FromByte(banks.vram_a10[(ppu_addr >> 10) & 3]));
 
 		// Contains a jumper between `/PA13` and `/VRAM_CS` (? probably, just don't care for now)
-		cart_out[(size_t)CartOutput::VRAM_nCS] = cart_in[(size_t)CartInput::nPA13];
+		cart_out.set((size_t)CartOutput::VRAM_nCS, cart_in.get((size_t)CartInput::nPA13));
 
 		// CHR_A13 is actually `/CS` for CHR
 		TriState nCHR_CS = FromByte((ppu_addr >> 13) & 1);
 
-		ppu_addr = (ppu_addr & 0x0fff) |			// Clear original A12+
-			((size_t)ToByte(mmc1_out[(size_t)MMC1_Output::CHR_A12]) << 12) |
-			((size_t)ToByte(mmc1_out[(size_t)MMC1_Output::CHR_A13]) << 13) |
-			((size_t)ToByte(mmc1_out[(size_t)MMC1_Output::CHR_A14]) << 14) |
-			((size_t)ToByte(mmc1_out[(size_t)MMC1_Output::CHR_A15]) << 15) |
-			((size_t)ToByte(mmc1_out[(size_t)MMC1_Output::CHR_A16]) << 16);
-
 		if (nCHR_CS == TriState::Zero)
 		{
-			assert(ppu_addr < CHRSize);
+			uint8_t* chr = banks.chr[(ppu_addr >> 10) & 7] + (ppu_addr & 0x3ff);
 
 			if (nRD == TriState::Zero)
 			{
-				uint8_t val = CHR[ppu_addr];
+				uint8_t val = *chr;
 
 				if (!ppu_data_dirty)
 				{
@@ -148,9 +198,9 @@ namespace Mappers
 				}
 			}
 
-			if (nWR == TriState::Zero)
+			if (nWR == TriState::Zero && banks.chr_writable)
 			{
-				CHR[ppu_addr] = *ppu_data;
+				*chr = *ppu_data;
 			}
 		}
 
@@ -159,15 +209,9 @@ namespace Mappers
 		TriState SRAM_CE = mmc1_out[(size_t)MMC1_Output::SRAM_CE];
 		TriState PRG_nCE = mmc1_out[(size_t)MMC1_Output::PRG_nCE];
 
-		size_t prg_address = (cpu_addr & 0x3fff) |			// Clear original A14 (A15 is not routed actually)
-			((size_t)ToByte(mmc1_out[(size_t)MMC1_Output::PRG_A14]) << 14) |		// A14 
-			((size_t)ToByte(mmc1_out[(size_t)MMC1_Output::PRG_A15]) << 15) |		// A15
-			((size_t)ToByte(mmc1_out[(size_t)MMC1_Output::PRG_A16]) << 16) |		// A16
-			((size_t)ToByte(mmc1_out[(size_t)MMC1_Output::PRG_A17]) << 17);			// A17
-
 		if (PRG_nCE == TriState::Zero)
 		{
-			uint8_t val = PRG[prg_address];
+			uint8_t val = banks.prg[(cpu_addr >> 13) & 3][cpu_addr & 0x1fff];
 
 			if (!cpu_data_dirty)
 			{
@@ -182,7 +226,7 @@ namespace Mappers
 
 		if (SRAM_CE == TriState::One)
 		{
-			uint8_t val = RAM[prg_address & 0x1fff];
+			uint8_t val = RAM[cpu_addr & 0x1fff];
 
 			if (!cpu_data_dirty)
 			{
@@ -195,10 +239,10 @@ namespace Mappers
 			}
 		}
 
-		TriState nIRQ = cart_out[(size_t)CartOutput::nIRQ];
+		TriState nIRQ = cart_out.get((size_t)CartOutput::nIRQ);
 		if (!(nIRQ == TriState::Zero || nIRQ == TriState::One))
 		{
-			cart_out[(size_t)CartOutput::nIRQ] = TriState::Z;
+			cart_out.set((size_t)CartOutput::nIRQ, TriState::Z);
 		}
 
 		if (p1_type == ConnectorType::FamicomStyle && snd_out)
@@ -18,6 +18,9 @@ namespace Mappers
 		size_t RAMSize = 0;
 
 		MMC1* mmc = nullptr;
+		uint32_t mapped_regs_version = 0;		// MMC1 registers the banks are mapped for
+
+		void MapBanks();
 
 	public:
 		MMC1_Based(ConnectorType p1, uint8_t* nesImage, size_t nesImageSize);
@@ -26,8 +29,8 @@ namespace Mappers
 		bool Valid() override;
 
 		void sim(
-			BaseLogic::TriState cart_in[(size_t)CartInput::Max],
-			BaseLogic::TriState cart_out[(size_t)CartOutput::Max],
+			BaseLogic::Pins32& cart_in,
+			BaseLogic::Pins32& cart_out,
 			uint16_t cpu_addr,
 			uint8_t* cpu_data, bool& cpu_data_dirty,
 			uint16_t ppu_addr,
@@ -28,11 +28,12 @@ namespace Mappers
 
 		if (head->CHRSize != 0)
 		{
-			CHRSize = head->CHRSize * 0x2000;
-			CHR = new uint8_t[CHRSize];
+			// CHR-ROM is never written by the cartridge, so it is shared as well
 
+			CHRSize = head->CHRSize * 0x2000;
 			uint8_t* chrPtr = nesImage + sizeof(NESHeader) + (trainer ? NES_TRAINER_SIZE : 0) + head->PRGSize * 0x4000;
-			memcpy(CHR, chrPtr, CHRSize);
+			CHR = ROMPool::Acquire(chrPtr, CHRSize);
+			chr_shared = true;
 		}
 		else
 		{
@@ -45,13 +46,12 @@ namespace Mappers
 		// Load PRG ROM
 
 		PRGSize = head->PRGSize * 0x4000;
-		PRG = new uint8_t[PRGSize];
-
 		uint8_t* prgPtr = nesImage + sizeof(NESHeader) + (trainer ? NES_TRAINER_SIZE : 0);
-		memcpy(PRG, prgPtr, PRGSize);
+		PRG = ROMPool::Acquire(prgPtr, PRGSize);
 
 		valid = true;
 
+		MapBanks();
 		AddCartMemDescriptors();
 		AddCartDebugInfoProviders();
 	}
@@ -61,10 +61,15 @@ namespace Mappers
 		printf("NROM::~NROM()\n");
 
 		if (PRG != nullptr)
-			delete PRG;
+			ROMPool::Release(PRG);
 
 		if (CHR != nullptr)
-			delete CHR;
+		{
+			if (chr_shared)
+				ROMPool::Release(CHR);
+			else
+				delete[] CHR;
+		}
 	}
 
 	bool NROM::Valid()
@@ -72,9 +77,40 @@ namespace Mappers
 		return valid;
 	}
 
+	bool NROM::StrobeDriven()
+	{
+		return true;
+	}
+
+	/// <summary>
+	/// NROM has no registers, so the banks are mapped once (and again when the debugger makes a private copy of CHR).
+	/// </summary>
+	void NROM::MapBanks()
+	{
+		for (size_t n = 0; n < 4; n++)
+		{
+			MapPRG(n, PRG, PRGSize, n * 0x2000);
+		}
+
+		for (size_t n = 0; n < 8; n++)
+		{
+			MapCHR(n, CHR, CHRSize, n * 0x400);
+		}
+
+		banks.chr_writable = chr_ram;
+
+		// Connect to PPU A10 for vertical mirroring or PPU A11 for horizontal mirroring.
+		for (size_t n = 0; n < 4; n++)
+		{
+			banks.vram_a10[n] = V_Mirroring ? (n & 1) : ((n >> 1) & 1);
+		}
+
+		bank_map = true;
+	}
+
 	void NROM::sim(
-		TriState cart_in[(size_t)CartInput::Max],
-		TriState cart_out[(size_t)CartOutput::Max],
+		Pins32& cart_in,
+		Pins32& cart_out,
 		uint16_t cpu_addr,
 		uint8_t* cpu_data, bool& cpu_data_dirty,
 		uint16_t ppu_addr,
@@ -89,17 +125,17 @@ namespace Mappers
 
 		// PPU Part
 
-		TriState nRD = cart_in[(size_t)CartInput::nRD];
-		TriState nWR = cart_in[(size_t)CartInput::nWR];
+		TriState nRD = cart_in.get((size_t)CartInput::nRD);
+		TriState nWR = cart_in.get((size_t)CartInput::nWR);
 
 		nrom_debug.last_nRD = nRD == TriState::One ? 1 : 0;
 		nrom_debug.last_nWR = nWR == TriState::One ? 1 : 0;
 
 		// H/V Mirroring
-		cart_out[(size_t)CartOutput::VRAM_A10] = V_Mirroring ? FromByte((ppu_addr >> 10) & 1) : FromByte((ppu_addr >> 11) & 1);
+		cart_out.set((size_t)CartOutput::VRAM_A10, FromByte(banks.vram_a10[(ppu_addr >> 10) & 3]));
 
 		// Contains a jumper between `/PA13` and `/VRAM_CS`
-		cart_out[(size_t)CartOutput::VRAM_nCS] = cart_in[(size_t)CartInput::nPA13];
+		cart_out.set((size_t)CartOutput::VRAM_nCS, cart_in.get((size_t)CartInput::nPA13));
 
 		// PPU_A13 is actually `/CS` for CHR-ROM
 		TriState nCHR_CS = FromByte((ppu_addr >> 13) & 1);
@@ -108,9 +144,7 @@ namespace Mappers
 		{
 			nrom_debug.last_PA = (uint32_t)ppu_addr;
 
-			assert(ppu_addr < CHRSize);
-
-			uint8_t val = CHR[ppu_addr];
+			uint8_t val = banks.chr[(ppu_addr >> 10) & 7][ppu_addr & 0x3ff];
 
 			if (!ppu_data_dirty)
 			{
@@ -123,19 +157,18 @@ namespace Mappers
 			}
 		}
 
-		if (NOR(nWR, nCHR_CS) == TriState::One && chr_ram)
+		if (NOR(nWR, nCHR_CS) == TriState::One && banks.chr_writable)
 		{
-			assert(ppu_addr < CHRSize);
-			CHR[ppu_addr] = *ppu_data;
+			banks.chr[(ppu_addr >> 10) & 7][ppu_addr & 0x3ff] = *ppu_data;
 		}
 
 		// CPU Part
 
-		TriState nROMSEL = cart_in[(size_t)CartInput::nROMSEL];
+		TriState nROMSEL = cart_in.get((size_t)CartInput::nROMSEL);
 
 		if (nROMSEL == TriState::Zero)
 		{
-			uint8_t val = PRG[cpu_addr & (PRGSize - 1)];
+			uint8_t val = banks.prg[(cpu_addr >> 13) & 3][cpu_addr & 0x1fff];
 
 			if (!cpu_data_dirty)
 			{
@@ -148,10 +181,10 @@ namespace Mappers
 			}
 		}
 
-		TriState nIRQ = cart_out[(size_t)CartOutput::nIRQ];
+		TriState nIRQ = cart_out.get((size_t)CartOutput::nIRQ);
 		if (!(nIRQ == TriState::Zero || nIRQ == TriState::One))
 		{
-			cart_out[(size_t)CartOutput::nIRQ] = TriState::Z;
+			cart_out.set((size_t)CartOutput::nIRQ, TriState::Z);
 		}
 
 		if (p1_type == ConnectorType::FamicomStyle && snd_out)
@@ -181,7 +214,7 @@ namespace Mappers
 		memset(chrRegion, 0, sizeof(MemDesciptor));
 		strcpy(chrRegion->name, CHR_ROM_NAME);
 		chrRegion->size = (int32_t)CHRSize;
-		dbg_hub->AddMemRegion(chrRegion, Dbg_ReadCHRByte, Dbg_WriteCHRByte, this, true);
+		dbg_hub->AddMemRegion(chrRegion, Dbg_ReadCHRByte, Dbg_WriteCHRByte, this, true, Dbg_GetCHRSpan);
 	}
 
 	void NROM::AddCartDebugInfoProviders()
@@ -242,6 +275,12 @@ namespace Mappers
 		}
 	}
 
+	uint8_t* NROM::Dbg_GetCHRSpan(void* opaque)
+	{
+		NROM* nrom = (NROM*)opaque;
+		return nrom->valid ? nrom->CHR : nullptr;
+	}
+
 	void NROM::Dbg_WriteCHRByte(void* opaque, size_t addr, uint8_t data)
 	{
 		NROM* nrom = (NROM*)opaque;
@@ -251,6 +290,14 @@ namespace Mappers
 
 		if (addr < nrom->CHRSize)
 		{
+			// The debugger changes only the CHR-ROM of this cartridge
+
+			if (nrom->chr_shared)
+			{
+				nrom->CHR = ROMPool::MakePrivate(nrom->CHR, nrom->CHRSize);
+				nrom->chr_shared = false;
+				nrom->MapBanks();
+			}
 			nrom->CHR[addr] = data;
 		}
 	}
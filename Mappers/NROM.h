@@ -23,6 +23,7 @@ namespace Mappers
 		size_t CHRSize = 0;
 
 		bool chr_ram = false;
+		bool chr_shared = false;		// CHR-ROM from ROMPool
 
 		NROM_DebugInfo nrom_debug{};
 
@@ -32,6 +33,7 @@ namespace Mappers
 
 		static uint8_t Dbg_ReadCHRByte(void* opaque, size_t addr);
 		static void Dbg_WriteCHRByte(void* opaque, size_t addr, uint8_t data);
+		static uint8_t* Dbg_GetCHRSpan(void* opaque);
 		void GetDebugInfo(NROM_DebugInfo& info);
 		
 		static uint32_t GetCartDebugInfo(void* opaque, DebugInfoEntry* entry);
@@ -40,15 +42,18 @@ namespace Mappers
 		void AddCartMemDescriptors();
 		void AddCartDebugInfoProviders();
 
+		void MapBanks();
+
 	public:
 		NROM(ConnectorType p1, uint8_t* nesImage, size_t nesImageSize);
 		virtual ~NROM();
 
 		bool Valid() override;
+		bool StrobeDriven() override;
 
 		void sim(
-			BaseLogic::TriState cart_in[(size_t)CartInput::Max],
-			BaseLogic::TriState cart_out[(size_t)CartOutput::Max],
+			BaseLogic::Pins32& cart_in,
+			BaseLogic::Pins32& cart_out,
 			uint16_t cpu_addr,
 			uint8_t* cpu_data, bool& cpu_data_dirty,
 			uint16_t ppu_addr,
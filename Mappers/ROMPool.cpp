@@ -0,0 +1,81 @@
+// Storage of the ROM contents shared by the cartridges.
+
+#include "pch.h"
+#include <mutex>
+
+namespace Mappers
+{
+	struct SharedROM
+	{
+		uint8_t* data;
+		size_t size;
+		uint64_t hash;
+		size_t refs;
+	};
+
+	static std::list<SharedROM> pool;
+	static std::mutex pool_lock;
+
+	static uint64_t HashROM(uint8_t* data, size_t size)
+	{
+		// FNV-1a
+		uint64_t hash = 0xcbf29ce484222325ULL;
+		for (size_t n = 0; n < size; n++)
+		{
+			hash ^= data[n];
+			hash *= 0x100000001b3ULL;
+		}
+		return hash;
+	}
+
+	uint8_t* ROMPool::Acquire(uint8_t* data, size_t size)
+	{
+		uint64_t hash = HashROM(data, size);
+
+		std::lock_guard<std::mutex> lock(pool_lock);
+
+		for (auto it = pool.begin(); it != pool.end(); ++it)
+		{
+			if (it->size == size && it->hash == hash && !memcmp(it->data, data, size))
+			{
+				it->refs++;
+				return it->data;
+			}
+		}
+
+		SharedROM rom{};
+		rom.data = new uint8_t[size];
+		memcpy(rom.data, data, size);
+		rom.size = size;
+		rom.hash = hash;
+		rom.refs = 1;
+		pool.push_back(rom);
+		return rom.data;
+	}
+
+	void ROMPool::Release(uint8_t* rom)
+	{
+		std::lock_guard<std::mutex> lock(pool_lock);
+
+		for (auto it = pool.begin(); it != pool.end(); ++it)
+		{
+			if (it->data == rom)
+			{
+				if (--it->refs == 0)
+				{
+					delete[] it->data;
+					pool.erase(it);
+				}
+				return;
+			}
+		}
+	}
+
+	uint8_t* ROMPool::MakePrivate(uint8_t* rom, size_t size)
+	{
+		uint8_t* copy = new uint8_t[size];
+		memcpy(copy, rom, size);
+		Release(rom);
+		return copy;
+	}
+}
@@ -0,0 +1,32 @@
+// Storage of the ROM contents shared by the cartridges.
+
+#pragma once
+
+namespace Mappers
+{
+	/// <summary>
+	/// The ROM contents (PRG, CHR-ROM) are stored once for each distinct image. All the cartridges made from the same .nes image (e.g. several boards) use the same read-only copy.
+	/// The pool is thread-safe.
+	/// </summary>
+	class ROMPool
+	{
+	public:
+		/// <summary>
+		/// Get the shared copy of the ROM contents (made on the first request).
+		/// </summary>
+		/// <param name="data">ROM contents (e.g. a part of the .nes image)</param>
+		/// <param name="size">Size in bytes</param>
+		/// <returns>Read-only shared copy</returns>
+		static uint8_t* Acquire(uint8_t* data, size_t size);
+
+		/// <summary>
+		/// Release the shared copy. The copy is deleted when the last cartridge releases it.
+		/// </summary>
+		static void Release(uint8_t* rom);
+
+		/// <summary>
+		/// Get a private writable copy instead of the shared one (the shared copy is released).
+		/// </summary>
+		static uint8_t* MakePrivate(uint8_t* rom, size_t size);
+	};
+}
@@ -41,13 +41,12 @@ namespace Mappers
 		// Load PRG ROM
 
 		PRGSize = head->PRGSize * 0x4000;
-		PRG = new uint8_t[PRGSize];
-
 		uint8_t* prgPtr = nesImage + sizeof(NESHeader) + (trainer ? NES_TRAINER_SIZE : 0);
-		memcpy(PRG, prgPtr, PRGSize);
+		PRG = ROMPool::Acquire(prgPtr, PRGSize);
 
 		valid = true;
 
+		MapBanks();
 		AddCartMemDescriptors();
 	}
 
@@ -56,7 +55,7 @@ namespace Mappers
 		printf("UNROM::~UNROM()\n");
 
 		if (PRG != nullptr)
-			delete PRG;
+			ROMPool::Release(PRG);
 
 		if (CHR != nullptr)
 			delete CHR;
@@ -67,9 +66,72 @@ namespace Mappers
 		return valid;
 	}
 
+	bool UNROM::StrobeDriven()
+	{
+		return true;
+	}
+
+	void UNROM::MapBanks()
+	{
+		for (size_t n = 0; n < 8; n++)
+		{
+			MapCHR(n, CHR, CHRSize, n * 0x400);
+		}
+
+		// PPU /WR goes to CHR regardless of whether it is RAM or ROM
+		banks.chr_writable = true;
+
+		// Connect to PPU A10 for vertical mirroring or PPU A11 for horizontal mirroring.
+		for (size_t n = 0; n < 4; n++)
+		{
+			banks.vram_a10[n] = V_Mirroring ? (n & 1) : ((n >> 1) & 1);
+		}
+
+		TriState Q[4]{};
+		UnpackNibble(prg_bank, Q);
+		MapPRGBanks(Q);
+
+		bank_map = true;
+	}
+
+	/// <summary>
+	/// Run the OR mux for both values of CPU A14 to get the PRG banks for the counter outputs.
+	/// </summary>
+	void UNROM::MapPRGBanks(TriState Q[4])
+	{
+		for (uint8_t a14 = 0; a14 < 2; a14++)
+		{
+			TriState A[4]{};
+			TriState B[4]{};
+			TriState Y[4]{};
+
+			TriState A14 = FromByte(a14);
+
+			A[0] = Q[1];
+			A[1] = Q[0];
+			A[2] = gnd;
+			A[3] = A14;
+
+			B[0] = A14;
+			B[1] = A14;
+			B[2] = gnd;
+			B[3] = Q[2];
+
+			quad_or.sim(A, B, Y);
+
+			size_t bank_address =
+				((size_t)ToByte(Y[1]) << 14) |		// A14 
+				((size_t)ToByte(Y[0]) << 15) |		// A15
+				((size_t)ToByte(Y[3]) << 16);		// A16
+
+			MapPRG(a14 * 2 + 0, PRG, PRGSize, bank_address);
+			MapPRG(a14 * 2 + 1, PRG, PRGSize, bank_address | 0x2000);
+		}
+	}
+
 	void UNROM::sim(
-		TriState cart_in[(size_t)CartInput::Max],
-		TriState cart_out[(size_t)CartOutput::Max],
+		Pins32& cart_in,
+		Pins32& cart_out,
 		uint16_t cpu_addr,
 		uint8_t* cpu_data, bool& cpu_data_dirty,
 		uint16_t ppu_addr,
@@ -84,25 +146,25 @@ namespace Mappers
 
 		// PPU Part
 
-		TriState nRD = cart_in[(size_t)CartInput::nRD];
-		TriState nWR = cart_in[(size_t)CartInput::nWR];
+		TriState nRD = cart_in.get((size_t)CartInput::nRD);
+		TriState nWR = cart_in.get((size_t)CartInput::nWR);
 
 		// H/V Mirroring
-		cart_out[(size_t)CartOutput::VRAM_A10] = V_Mirroring ? FromByte((ppu_addr >> 10) & 1) : FromByte((ppu_addr >> 11) & 1);
+		cart_out.set((size_t)CartOutput::VRAM_A10, FromByte(banks.vram_a10[(ppu_addr >> 10) & 3]));
 
 		// Contains a jumper between `/PA13` and `/VRAM_CS`
-		cart_out[(size_t)CartOutput::VRAM_nCS] = cart_in[(size_t)CartInput::nPA13];
+		cart_out.set((size_t)CartOutput::VRAM_nCS, cart_in.get((size_t)CartInput::nPA13));
 
 		// CHR_A13 is actually `/CS` for CHR
 		TriState nCHR_CS = FromByte((ppu_addr >> 13) & 1);
 
 		if (nCHR_CS == TriState::Zero)
 		{
-			assert(ppu_addr < CHRSize);
+			uint8_t* chr = banks.chr[(ppu_addr >> 10) & 7] + (ppu_addr & 0x3ff);
 
 			if (nRD == TriState::Zero)
 			{
-				uint8_t val = CHR[ppu_addr];
+				uint8_t val = *chr;
 
 				if (!ppu_data_dirty)
 				{
@@ -115,16 +177,16 @@ namespace Mappers
 				}
 			}
 
-			if (nWR == TriState::Zero)
+			if (nWR == TriState::Zero && banks.chr_writable)
 			{
-				CHR[ppu_addr] = *ppu_data;
+				*chr = *ppu_data;
 			}
 		}
 
 		// CPU Part
 
-		TriState nROMSEL = cart_in[(size_t)CartInput::nROMSEL];
-		TriState CPU_RnW = cart_in[(size_t)CartInput::RnW];
+		TriState nROMSEL = cart_in.get((size_t)CartInput::nROMSEL);
+		TriState CPU_RnW = cart_in.get((size_t)CartInput::RnW);
 
 		// Counter to select PRG Bank
 
@@ -140,34 +202,18 @@ namespace Mappers
 
 		counter.sim(nROMSEL, vdd, CPU_RnW, gnd, gnd, P, RCO, Q);
 
-		// OR as MUX
-
-		TriState A[4]{};
-		TriState B[4]{};
-		TriState Y[4]{};
-
-		TriState A14 = FromByte((cpu_addr >> 14) & 1);
+		// OR as MUX. The PRG banks are remapped only when the counter is loaded with another value
 
-		A[0] = Q[1];
-		A[1] = Q[0];
-		A[2] = gnd;
-		A[3] = A14;
-
-		B[0] = A14;
-		B[1] = A14;
-		B[2] = gnd;
-		B[3] = Q[2];
-
-		quad_or.sim(A, B, Y);
-
-		size_t prg_address = (cpu_addr & 0x3fff) |			// Clear original A14 (A15 is not routed actually)
-			((size_t)ToByte(Y[1]) << 14) |		// A14 
-			((size_t)ToByte(Y[0]) << 15) |		// A15
-			((size_t)ToByte(Y[3]) << 16) ;		// A16
+		uint8_t bank = PackNibble(Q);
+		if (bank != prg_bank)
+		{
+			MapPRGBanks(Q);
+			prg_bank = bank;
+		}
 
 		if (nROMSEL == TriState::Zero)
 		{
-			uint8_t val = PRG[prg_address];
+			uint8_t val = banks.prg[(cpu_addr >> 13) & 3][cpu_addr & 0x1fff];
 
 			if (!cpu_data_dirty)
 			{
@@ -180,10 +226,10 @@ namespace Mappers
 			}
 		}
 
-		TriState nIRQ = cart_out[(size_t)CartOutput::nIRQ];
+		TriState nIRQ = cart_out.get((size_t)CartOutput::nIRQ);
 		if (!(nIRQ == TriState::Zero || nIRQ == TriState::One))
 		{
-			cart_out[(size_t)CartOutput::nIRQ] = TriState::Z;
+			cart_out.set((size_t)CartOutput::nIRQ, TriState::Z);
 		}
 
 		if (p1_type == ConnectorType::FamicomStyle && snd_out)
@@ -198,7 +244,7 @@ namespace Mappers
 		memset(chrRegion, 0, sizeof(MemDesciptor));
 		strcpy(chrRegion->name, CHR_ROM_NAME);
 		chrRegion->size = (int32_t)CHRSize;
-		dbg_hub->AddMemRegion(chrRegion, Dbg_ReadCHRByte, Dbg_WriteCHRByte, this, true);
+		dbg_hub->AddMemRegion(chrRegion, Dbg_ReadCHRByte, Dbg_WriteCHRByte, this, true, Dbg_GetCHRSpan);
 	}
 
 	uint8_t UNROM::Dbg_ReadCHRByte(void* opaque, size_t addr)
@@ -218,6 +264,12 @@ namespace Mappers
 		}
 	}
 
+	uint8_t* UNROM::Dbg_GetCHRSpan(void* opaque)
+	{
+		UNROM* unrom = (UNROM*)opaque;
+		return unrom->valid ? unrom->CHR : nullptr;
+	}
+
 	void UNROM::Dbg_WriteCHRByte(void* opaque, size_t addr, uint8_t data)
 	{
 		UNROM* unrom = (UNROM*)opaque;
@@ -20,21 +20,28 @@ namespace Mappers
 
 		static uint8_t Dbg_ReadCHRByte(void* opaque, size_t addr);
 		static void Dbg_WriteCHRByte(void* opaque, size_t addr, uint8_t data);
+		static uint8_t* Dbg_GetCHRSpan(void* opaque);
 
 		void AddCartMemDescriptors();
 
 		BaseBoard::LS32 quad_or{};
 		BaseBoard::LS161 counter{};
 
+		uint8_t prg_bank = 0;		// Counter value the PRG banks are mapped for
+
+		void MapBanks();
+		void MapPRGBanks(BaseLogic::TriState Q[4]);
+
 	public:
 		UNROM(ConnectorType p1, uint8_t* nesImage, size_t nesImageSize);
 		virtual ~UNROM();
 
 		bool Valid() override;
+		bool StrobeDriven() override;
 
 		void sim(
-			BaseLogic::TriState cart_in[(size_t)CartInput::Max],
-			BaseLogic::TriState cart_out[(size_t)CartOutput::Max],
+			BaseLogic::Pins32& cart_in,
+			BaseLogic::Pins32& cart_out,
 			uint16_t cpu_addr,
 			uint8_t* cpu_data, bool& cpu_data_dirty,
 			uint16_t ppu_addr,
@@ -17,6 +17,7 @@
 
 #include "AbstractCartridge.h"
 #include "NES_Header.h"
+#include "ROMPool.h"
 #include "NROM.h"
 #include "UNROM.h"
 #include "AOROM.h"
@@ -30,45 +30,45 @@ static bool ApuMegaCyclesTest(size_t desired_clk)
 	uint16_t addr_bus = 0;
 	APUSim::AudioOutSignal aux{};
 
-	TriState inputs[(size_t)APUSim::APU_Input::Max]{};
-	TriState outputs[(size_t)APUSim::APU_Output::Max]{};
+	Pins32 inputs{};
+	Pins32 outputs{};
 
-	inputs[(size_t)APUSim::APU_Input::DBG] = TriState::Zero;
-	inputs[(size_t)APUSim::APU_Input::n_IRQ] = TriState::One;
-	inputs[(size_t)APUSim::APU_Input::n_NMI] = TriState::One;
+	inputs.set((size_t)APUSim::APU_Input::DBG, TriState::Zero);
+	inputs.set((size_t)APUSim::APU_Input::n_IRQ, TriState::One);
+	inputs.set((size_t)APUSim::APU_Input::n_NMI, TriState::One);
 
 	// Reset APU
 
-	inputs[(size_t)APUSim::APU_Input::n_RES] = TriState::Zero;
+	inputs.set((size_t)APUSim::APU_Input::n_RES, TriState::Zero);
 
 	for (size_t n = 0; n < 256; n++)
 	{
 		data_bus = 0;
-		inputs[(size_t)APUSim::APU_Input::CLK] = CLK;
+		inputs.set((size_t)APUSim::APU_Input::CLK, CLK);
 		apu->sim(inputs, outputs, &data_bus, &addr_bus, aux);
 		CLK = NOT(CLK);
 
 		data_bus = 0;
-		inputs[(size_t)APUSim::APU_Input::CLK] = CLK;
+		inputs.set((size_t)APUSim::APU_Input::CLK, CLK);
 		apu->sim(inputs, outputs, &data_bus, &addr_bus, aux);
 		CLK = NOT(CLK);
 	}
 
 	// Continue
 
-	inputs[(size_t)APUSim::APU_Input::n_RES] = TriState::One;
+	inputs.set((size_t)APUSim::APU_Input::n_RES, TriState::One);
 
 	auto stamp1 = GetTickCount64();
 
 	for (size_t n = 0; n < desired_clk; n++)
 	{
 		data_bus = 0;
-		inputs[(size_t)APUSim::APU_Input::CLK] = CLK;
+		inputs.set((size_t)APUSim::APU_Input::CLK, CLK);
 		apu->sim(inputs, outputs, &data_bus, &addr_bus, aux);
 		CLK = NOT(CLK);
 
 		data_bus = 0;
-		inputs[(size_t)APUSim::APU_Input::CLK] = CLK;
+		inputs.set((size_t)APUSim::APU_Input::CLK, CLK);
 		apu->sim(inputs, outputs, &data_bus, &addr_bus, aux);
 		CLK = NOT(CLK);
 	}
@@ -105,6 +105,11 @@ int main()
 	bool res = ApuMegaCyclesTest(clks);
 	std::cout << "ApuPumpkin Stop\n";
 
+#ifdef BREAKS_PROFILER
+	Profiler::Report(stdout);
+	Profiler::SaveFolded("ApuPumpkin.folded");
+#endif
+
 	delete apu;
 	delete core;
 	return res ? 0 : -1;
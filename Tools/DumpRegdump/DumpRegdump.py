@@ -10,6 +10,12 @@
 		uint16_t	padding;	// Not used (yet?)
 	};
 
+	The indexed regdump (see RegDumpProcessor.h) begins with the "REGDUMP2" header and consists of blocks:
+	register operations of a frame (clkDelta of the first entry is counted from the beginning of the block) and keyframes.
+	The register operations can be packed (ROPZ block): clkDelta as a variable-length number (7 bits per byte, msb - more bytes follow), the register, the value for writes only.
+
+	Use -legacy <out> to convert the indexed regdump into the old format (bare array of RegDumpEntry).
+
 """
 
 import os
@@ -18,6 +24,13 @@ import struct
 
 regbase = 0x2000
 entry_format = '=IBBH' 		# uint32_t + uint8_t + uint8_t + uint16_t
+header_format = '=8sIIQ'	# magic, version, num_blocks, index_offset
+block_format = '=IIQII'		# type, size, phi, frame, reserved
+
+REGDUMP_MAGIC = b'REGDUMP2'
+REGDUMP_BLOCK_OPS = 0x53504f52
+REGDUMP_BLOCK_KEYFRAME = 0x4d52464b
+REGDUMP_BLOCK_PACKED_OPS = 0x5a504f52
 
 def DumpEntry (entry, clk_counter):
 	print (f"{entry[0]}, ", end="")
@@ -26,14 +39,10 @@ def DumpEntry (entry, clk_counter):
 	else:
 		print (f"write {hex(regbase+entry[1])}={hex(entry[2])}")
 
-def Main (regdump_file):
-	f = open(regdump_file, 'rb')
-	binarycontent = f.read(-1)
-	f.close()
-	regdump_size = len(binarycontent) 
+def DumpLegacy (binarycontent):
 	entry_size = struct.calcsize(entry_format)
 	num_entries = int(len(binarycontent) / entry_size)
-	print (f"regdump size: {regdump_size}, entry size: {entry_size}, entries count: {num_entries}")
+	print (f"regdump size: {len(binarycontent)}, entry size: {entry_size}, entries count: {num_entries}")
 	offset = 0
 	clk_counter = 0
 	for n in range(num_entries):
@@ -42,8 +51,101 @@ def Main (regdump_file):
 		clk_counter += entry[0]
 		offset = offset + entry_size
 
+def ReadBlocks (binarycontent):
+	""" Walk through the blocks from the beginning of the file (the index at the end is not needed for that). """
+	blocks = []
+	entry_size = struct.calcsize(entry_format)
+	block_size = struct.calcsize(block_format)
+	offset = struct.calcsize(header_format)
+	while offset + block_size <= len(binarycontent):
+		block = struct.unpack_from(block_format, binarycontent, offset)
+		if block[0] == REGDUMP_BLOCK_OPS:
+			payload = block[1] * entry_size
+		elif block[0] == REGDUMP_BLOCK_KEYFRAME:
+			payload = block[1]
+		elif block[0] == REGDUMP_BLOCK_PACKED_OPS:
+			payload = block[4]
+		else:
+			break
+		if offset + block_size + payload > len(binarycontent):
+			break
+		blocks.append((block, offset + block_size))
+		offset += block_size + payload
+	return blocks
+
+def BlockEntries (binarycontent, block, offset):
+	""" The register operations of the block as (clkDelta, reg, value, padding) tuples. """
+	if block[0] == REGDUMP_BLOCK_OPS:
+		entry_size = struct.calcsize(entry_format)
+		return [struct.unpack_from(entry_format, binarycontent, offset + n * entry_size) for n in range(block[1])]
+	entries = []
+	ptr = offset
+	for n in range(block[1]):
+		delta = 0
+		shift = 0
+		while binarycontent[ptr] & 0x80:
+			delta |= (binarycontent[ptr] & 0x7f) << shift
+			shift += 7
+			ptr += 1
+		delta |= binarycontent[ptr] << shift
+		reg = binarycontent[ptr + 1]
+		ptr += 2
+		value = 0
+		if (reg & 0x80) == 0:
+			value = binarycontent[ptr]
+			ptr += 1
+		entries.append((delta, reg, value, 0))
+	return entries
+
+def DumpIndexed (binarycontent):
+	header = struct.unpack_from(header_format, binarycontent, 0)
+	print (f"regdump size: {len(binarycontent)}, version: {header[1]}, blocks: {header[2]}, index offset: {header[3]}")
+	for block, offset in ReadBlocks(binarycontent):
+		if block[0] == REGDUMP_BLOCK_KEYFRAME:
+			print (f"keyframe: frame {block[3]}, phi {block[2]}, state size: {block[1]}")
+			continue
+		packed = ", packed" if block[0] == REGDUMP_BLOCK_PACKED_OPS else ""
+		print (f"block: frame {block[3]}, phi {block[2]}, entries: {block[1]}{packed}")
+		clk_counter = block[2]
+		for entry in BlockEntries(binarycontent, block, offset):
+			DumpEntry (entry, clk_counter)
+			clk_counter += entry[0]
+
+def ConvertToLegacy (binarycontent, out_file):
+	entry_size = struct.calcsize(entry_format)
+	out = bytearray()
+	prev_phi = 0
+	for block, offset in ReadBlocks(binarycontent):
+		if block[0] == REGDUMP_BLOCK_KEYFRAME:
+			continue
+		phi = block[2]
+		for entry in BlockEntries(binarycontent, block, offset):
+			phi += entry[0]
+			out += struct.pack(entry_format, phi - prev_phi, entry[1], entry[2], entry[3])
+			prev_phi = phi
+	f = open(out_file, 'wb')
+	f.write(out)
+	f.close()
+	print (f"{int(len(out) / entry_size)} entries saved to {out_file}")
+
+def Main (regdump_file, legacy_file):
+	f = open(regdump_file, 'rb')
+	binarycontent = f.read(-1)
+	f.close()
+	indexed = binarycontent[:len(REGDUMP_MAGIC)] == REGDUMP_MAGIC
+	if legacy_file is not None:
+		if indexed:
+			ConvertToLegacy (binarycontent, legacy_file)
+		else:
+			print ("The regdump is already in the old format")
+	elif indexed:
+		DumpIndexed (binarycontent)
+	else:
+		DumpLegacy (binarycontent)
+
 if __name__ == '__main__':
-	if (len(sys.argv) < 1):
-		print ("Use: python DumpRegdump.py <file.regdump>")
+	if (len(sys.argv) < 2):
+		print ("Use: python DumpRegdump.py <file.regdump> [-legacy <out.regdump>]")
 	else:
-		Main(sys.argv[1])
+		legacy_file = sys.argv[3] if len(sys.argv) > 3 and sys.argv[2] == "-legacy" else None
+		Main(sys.argv[1], legacy_file)
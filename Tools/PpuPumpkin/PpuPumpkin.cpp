@@ -28,15 +28,15 @@ static bool PpuMegaCyclesTest(size_t desired_clk)
 	uint8_t addrHi_bus = 0;
 	PPUSim::VideoOutSignal vout{};
 
-	TriState inputs[(size_t)PPUSim::InputPad::Max]{};
-	TriState outputs[(size_t)PPUSim::OutputPad::Max]{};
+	Pins32 inputs{};
+	Pins32 outputs{};
 
-	inputs[(size_t)InputPad::n_RES] = TriState::One;		// Not neccessary
-	inputs[(size_t)InputPad::n_DBE] = TriState::One;		// CPU I/F disabled
-	inputs[(size_t)InputPad::RnW] = TriState::One;
-	inputs[(size_t)InputPad::RS0] = TriState::Zero;
-	inputs[(size_t)InputPad::RS1] = TriState::Zero;
-	inputs[(size_t)InputPad::RS2] = TriState::Zero;
+	inputs.set((size_t)InputPad::n_RES, TriState::One);		// Not neccessary
+	inputs.set((size_t)InputPad::n_DBE, TriState::One);		// CPU I/F disabled
+	inputs.set((size_t)InputPad::RnW, TriState::One);
+	inputs.set((size_t)InputPad::RS0, TriState::Zero);
+	inputs.set((size_t)InputPad::RS1, TriState::Zero);
+	inputs.set((size_t)InputPad::RS2, TriState::Zero);
 
 	// Enable forced rendering. With rendering enabled, all blocks of the PPU will be engaged
 
@@ -49,12 +49,12 @@ static bool PpuMegaCyclesTest(size_t desired_clk)
 	for (size_t n = 0; n < desired_clk; n++)
 	{
 		ad_bus = 0;
-		inputs[(size_t)InputPad::CLK] = CLK;
+		inputs.set((size_t)InputPad::CLK, CLK);
 		ppu->sim(inputs, outputs, &ext_bus, &data_bus, &ad_bus, &addrHi_bus, vout);
 		CLK = NOT(CLK);
 
 		ad_bus = 0;
-		inputs[(size_t)InputPad::CLK] = CLK;
+		inputs.set((size_t)InputPad::CLK, CLK);
 		ppu->sim(inputs, outputs, &ext_bus, &data_bus, &ad_bus, &addrHi_bus, vout);
 		CLK = NOT(CLK);
 	}
@@ -82,6 +82,11 @@ int main()
 	bool res = PpuMegaCyclesTest(clks);
 	std::cout << "PpuPumpkin Stop\n";
 
+#ifdef BREAKS_PROFILER
+	Profiler::Report(stdout);
+	Profiler::SaveFolded("PpuPumpkin.folded");
+#endif
+
 	delete ppu;
 	return res ? 0 : -1;
 }
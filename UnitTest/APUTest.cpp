@@ -72,6 +72,164 @@ namespace APUSimUnitTest
 		return last_val == 0xff;
 	}
 
+	/// <summary>
+	/// Check that the word-level counters (up, down and reversible) give the same results as the arrays of cells, with random carry, clear, load and step.
+	/// </summary>
+	/// <returns></returns>
+	bool UnitTest::TestWordCounters()
+	{
+		char text[0x100]{};
+		APUSim::CounterBit up_cells[8]{};
+		APUSim::DownCounterBit down_cells[8]{};
+		APUSim::RevCounterBit rev_cells[8]{};
+		APUSim::CounterWord up_word{ 8 };
+		APUSim::DownCounterWord down_word{ 8 };
+		APUSim::RevCounterWord rev_word{ 8 };
+		uint32_t seed = 1234;
+
+		for (size_t n = 0; n < 0x10000; n++)
+		{
+			seed = seed * 1664525 + 1013904223;
+			uint32_t r = seed >> 8;
+
+			// Loads and clears are rare so that the counters have time to run
+
+			TriState Carry = FromByte(r & 1);
+			TriState Dec = FromByte((r >> 1) & 1);
+			TriState Clear = FromByte(((r >> 2) & 0x3f) == 0 ? 1 : 0);
+			TriState Load = FromByte(((r >> 8) & 0x3f) == 0 ? 1 : 0);
+			TriState ACLK1 = FromByte(n & 1);
+			TriState Step = FromByte((n & 1) == 0 && ((r >> 14) & 1) != 0 ? 1 : 0);
+			uint32_t value = (r >> 16) & 0xff;
+
+			TriState up_carry = Carry;
+			TriState down_carry = Carry;
+			TriState rev_carry = Carry;
+			for (size_t bit = 0; bit < 8; bit++)
+			{
+				TriState val_bit = FromByte((value >> bit) & 1);
+				up_carry = up_cells[bit].sim(up_carry, Clear, Load, Step, ACLK1, val_bit);
+				down_carry = down_cells[bit].sim(down_carry, Clear, Load, Step, ACLK1, val_bit);
+				rev_carry = rev_cells[bit].sim(rev_carry, Dec, Clear, Load, Step, ACLK1, val_bit);
+			}
+
+			TriState up_word_carry = up_word.sim(Carry, Clear, Load, Step, ACLK1, value);
+			TriState down_word_carry = down_word.sim(Carry, Clear, Load, Step, ACLK1, value);
+			TriState rev_word_carry = rev_word.sim(Carry, Dec, Clear, Load, Step, ACLK1, value);
+
+			uint32_t up_val = 0, down_val = 0, rev_val = 0;
+			for (size_t bit = 0; bit < 8; bit++)
+			{
+				up_val |= (up_cells[bit].get() == TriState::One ? 1 : 0) << bit;
+				down_val |= (down_cells[bit].get() == TriState::One ? 1 : 0) << bit;
+				rev_val |= (rev_cells[bit].get() == TriState::One ? 1 : 0) << bit;
+			}
+
+			if (up_val != up_word.get() || up_carry != up_word_carry)
+			{
+				sprintf_s(text, sizeof(text), "%zd: CounterBit 0x%02X/%d, CounterWord 0x%02X/%d\n", n, up_val, ToByte(up_carry), up_word.get(), ToByte(up_word_carry));
+				Logger::WriteMessage(text);
+				return false;
+			}
+
+			if (down_val != down_word.get() || down_carry != down_word_carry)
+			{
+				sprintf_s(text, sizeof(text), "%zd: DownCounterBit 0x%02X/%d, DownCounterWord 0x%02X/%d\n", n, down_val, ToByte(down_carry), down_word.get(), ToByte(down_word_carry));
+				Logger::WriteMessage(text);
+				return false;
+			}
+
+			if (rev_val != rev_word.get() || rev_carry != rev_word_carry)
+			{
+				sprintf_s(text, sizeof(text), "%zd: RevCounterBit 0x%02X/%d, RevCounterWord 0x%02X/%d\n", n, rev_val, ToByte(rev_carry), rev_word.get(), ToByte(rev_word_carry));
+				Logger::WriteMessage(text);
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/// <summary>
+	/// Check that the word-level registers (plain, with reset and the square channel frequency register) give the same results as the arrays of cells.
+	/// </summary>
+	/// <returns></returns>
+	bool UnitTest::TestWordRegisters()
+	{
+		char text[0x100]{};
+		APUSim::RegisterBit reg_cells[8]{};
+		APUSim::RegisterBitRes res_cells[8]{};
+		APUSim::FreqRegBit freq_cells[11]{};
+		APUSim::RegisterWord reg_word{ 8 };
+		APUSim::RegisterResWord res_word{ 8 };
+		APUSim::FreqRegWord freq_word{};
+		uint32_t seed = 5678;
+
+		for (size_t n = 0; n < 0x10000; n++)
+		{
+			seed = seed * 1664525 + 1013904223;
+			uint32_t r = seed >> 8;
+
+			TriState ACLK1 = FromByte(n & 1);
+			TriState ACLK3 = FromByte((n & 3) == 2 ? 1 : 0);
+			TriState Enable = FromByte(((r >> 0) & 7) == 0 ? 1 : 0);
+			TriState Res = FromByte(((r >> 3) & 0x1f) == 0 ? 1 : 0);
+			TriState WR_lo = FromByte(((r >> 8) & 0xf) == 0 ? 1 : 0);
+			TriState WR_hi = FromByte(((r >> 12) & 0xf) == 0 ? 1 : 0);
+			TriState ADDOUT = FromByte((r >> 16) & 1);
+			uint32_t value = (r >> 8) & 0xff;
+			uint32_t n_sum = (seed >> 5) & 0x7ff;
+
+			for (size_t bit = 0; bit < 8; bit++)
+			{
+				reg_cells[bit].sim(ACLK1, Enable, FromByte((value >> bit) & 1));
+				res_cells[bit].sim(ACLK1, Enable, FromByte((value >> bit) & 1), Res);
+			}
+
+			for (size_t bit = 0; bit < 11; bit++)
+			{
+				freq_cells[bit].sim(ACLK3, ACLK1, bit < 8 ? WR_lo : WR_hi, FromByte((value >> (bit & 7)) & 1), ADDOUT, FromByte((n_sum >> bit) & 1));
+			}
+
+			reg_word.sim(ACLK1, Enable, value);
+			res_word.sim(ACLK1, Enable, value, Res);
+			uint32_t WR = (WR_lo == TriState::One ? 0xff : 0) | (WR_hi == TriState::One ? 0x700 : 0);
+			freq_word.sim(ACLK3, ACLK1, WR, value | ((value & 7) << 8), ADDOUT, n_sum);
+
+			uint32_t reg_val = 0, res_val = 0, freq_val = 0, Fx = 0, nFx = 0;
+			for (size_t bit = 0; bit < 8; bit++)
+			{
+				reg_val |= (reg_cells[bit].get() == TriState::One ? 1 : 0) << bit;
+				res_val |= (res_cells[bit].get() == TriState::One ? 1 : 0) << bit;
+			}
+
+			for (size_t bit = 0; bit < 11; bit++)
+			{
+				freq_val |= (freq_cells[bit].get() == TriState::One ? 1 : 0) << bit;
+				Fx |= (freq_cells[bit].get_Fx(ADDOUT) == TriState::One ? 1 : 0) << bit;
+				nFx |= (freq_cells[bit].get_nFx(ADDOUT) == TriState::One ? 1 : 0) << bit;
+			}
+
+			if (reg_val != reg_word.get() || res_val != res_word.get())
+			{
+				sprintf_s(text, sizeof(text), "%zd: RegisterBit 0x%02X, RegisterWord 0x%02X, RegisterBitRes 0x%02X, RegisterResWord 0x%02X\n", n,
+					reg_val, reg_word.get(), res_val, res_word.get());
+				Logger::WriteMessage(text);
+				return false;
+			}
+
+			if (freq_val != freq_word.get() || Fx != freq_word.get_Fx(ADDOUT) || nFx != freq_word.get_nFx(ADDOUT))
+			{
+				sprintf_s(text, sizeof(text), "%zd: FreqRegBit 0x%03X/0x%03X/0x%03X, FreqRegWord 0x%03X/0x%03X/0x%03X\n", n,
+					freq_val, Fx, nFx, freq_word.get(), freq_word.get_Fx(ADDOUT), freq_word.get_nFx(ADDOUT));
+				Logger::WriteMessage(text);
+				return false;
+			}
+		}
+
+		return true;
+	}
+
 	/// <summary>
 	/// Run few full cycles and see what happens. The success of the test is checked by the M2 Duty Cycle.
 	/// </summary>
@@ -259,6 +417,118 @@ namespace APUSimUnitTest
 		return true;
 	}
 
+	/// <summary>
+	/// Check the SoftCLK PLA table against the gates for all LFSR values in both modes, then run the table-driven LFSR side by side with the cells on a second APU instance,
+	/// with random $4017 writes, $4015 reads and reset pulses.
+	/// </summary>
+	/// <returns></returns>
+	bool UnitTest::TestSoftCLKTable()
+	{
+		char text[0x100]{};
+		APUSim::CLKGen* clkgen = apu->clkgen;
+
+		// Exhaustive PLA check
+
+		clkgen->SetWordLevel(false);
+
+		for (size_t md = 0; md < 2; md++)
+		{
+			for (uint32_t sout = 0; sout <= clkgen->lfsr_mask; sout++)
+			{
+				for (size_t n = 0; n < clkgen->lfsr_bits; n++)
+				{
+					TriState bit = FromByte((sout >> n) & 1);
+					clkgen->lfsr[n].set(bit, NOT(bit));
+				}
+				clkgen->mode = FromByte((uint8_t)md);
+
+				clkgen->sim_SoftCLK_PLA();
+
+				for (size_t n = 0; n < 6; n++)
+				{
+					if (clkgen->pla[n] != FromByte((clkgen->pla_lut[md][sout] >> n) & 1))
+					{
+						sprintf_s(text, sizeof(text), "mode %zd, LFSR 0x%04X: pla[%zd] mismatch\n", md, sout, n);
+						Logger::WriteMessage(text);
+						return false;
+					}
+				}
+			}
+		}
+
+		// Side by side run on two fresh instances. Enough half-cycles for two full LFSR periods in the 5-step mode.
+
+		APUSim::APU* ref = new APUSim::APU(core, APUSim::Revision::RP2A03G);
+		APUSim::APU* tab = new APUSim::APU(core, APUSim::Revision::RP2A03G);
+		ref->clkgen->SetWordLevel(false);
+
+		APUSim::APU* apus[2] = { ref, tab };
+		const size_t hcycles = 0x400000;
+		uint32_t seed = 1234;
+		size_t w4017_left = 0;
+		size_t r4015_left = 0;
+		uint8_t DB = 0;
+		bool result = true;
+
+		for (size_t n = 0; n < hcycles; n++)
+		{
+			seed = seed * 1664525 + 1013904223;
+			uint32_t r = seed >> 8;
+
+			// The write pulse lasts half of the CPU cycle
+
+			if (w4017_left == 0 && (r & 0xffff) == 0)
+			{
+				w4017_left = 12;
+				DB = (r >> 16) & 0xc0;
+			}
+			if (r4015_left == 0 && ((r >> 4) & 0xffff) == 0)
+			{
+				r4015_left = 12;
+			}
+
+			TriState RES = FromByte(n < 100 || (n >= 0x200000 && n < 0x200100) ? 1 : 0);
+
+			if ((n % 0x40000) == 0)
+			{
+				tab->clkgen->SetWordLevel(((n / 0x40000) & 1) == 0);
+			}
+
+			for (size_t i = 0; i < 2; i++)
+			{
+				apus[i]->wire.n_CLK = FromByte(~n & 1);
+				apus[i]->wire.RES = RES;
+				apus[i]->wire.DMCINT = TriState::Zero;
+				apus[i]->wire.W4017 = FromByte(w4017_left != 0 ? 1 : 0);
+				apus[i]->wire.n_R4015 = FromByte(r4015_left != 0 ? 0 : 1);
+				apus[i]->DB = DB;
+
+				apus[i]->core_int->sim();
+				apus[i]->clkgen->sim();
+			}
+
+			if (w4017_left != 0) w4017_left--;
+			if (r4015_left != 0) r4015_left--;
+
+			if (ref->wire.n_LFO1 != tab->wire.n_LFO1 ||
+				ref->wire.n_LFO2 != tab->wire.n_LFO2 ||
+				ref->wire.INT != tab->wire.INT ||
+				ref->DB != tab->DB)
+			{
+				sprintf_s(text, sizeof(text), "%zd: cells LFO1/LFO2/INT %d/%d/%d, table %d/%d/%d\n", n,
+					ToByte(ref->wire.n_LFO1), ToByte(ref->wire.n_LFO2), ToByte(ref->wire.INT),
+					ToByte(tab->wire.n_LFO1), ToByte(tab->wire.n_LFO2), ToByte(tab->wire.INT));
+				Logger::WriteMessage(text);
+				result = false;
+				break;
+			}
+		}
+
+		delete ref;
+		delete tab;
+		return result;
+	}
+
 	bool UnitTest::VerifyRegOpByAddress(uint16_t addr, bool read)
 	{
 		switch (addr)
@@ -925,45 +1195,45 @@ namespace APUSimUnitTest
 		uint16_t addr_bus = 0;
 		APUSim::AudioOutSignal aux{};
 
-		TriState inputs[(size_t)APUSim::APU_Input::Max]{};
-		TriState outputs[(size_t)APUSim::APU_Output::Max]{};
+		Pins32 inputs{};
+		Pins32 outputs{};
 
-		inputs[(size_t)APUSim::APU_Input::DBG] = TriState::Zero;
-		inputs[(size_t)APUSim::APU_Input::n_IRQ] = TriState::One;
-		inputs[(size_t)APUSim::APU_Input::n_NMI] = TriState::One;
+		inputs.set((size_t)APUSim::APU_Input::DBG, TriState::Zero);
+		inputs.set((size_t)APUSim::APU_Input::n_IRQ, TriState::One);
+		inputs.set((size_t)APUSim::APU_Input::n_NMI, TriState::One);
 
 		// Reset APU
 
-		inputs[(size_t)APUSim::APU_Input::n_RES] = TriState::Zero;
+		inputs.set((size_t)APUSim::APU_Input::n_RES, TriState::Zero);
 
 		for (size_t n = 0; n < 256; n++)
 		{
 			data_bus = 0;
-			inputs[(size_t)APUSim::APU_Input::CLK] = CLK;
+			inputs.set((size_t)APUSim::APU_Input::CLK, CLK);
 			apu->sim(inputs, outputs, &data_bus, &addr_bus, aux);
 			CLK = NOT(CLK);
 
 			data_bus = 0;
-			inputs[(size_t)APUSim::APU_Input::CLK] = CLK;
+			inputs.set((size_t)APUSim::APU_Input::CLK, CLK);
 			apu->sim(inputs, outputs, &data_bus, &addr_bus, aux);
 			CLK = NOT(CLK);
 		}
 
 		// Continue
 
-		inputs[(size_t)APUSim::APU_Input::n_RES] = TriState::One;
+		inputs.set((size_t)APUSim::APU_Input::n_RES, TriState::One);
 
 		auto stamp1 = GetTickCount64();
 
 		for (size_t n = 0; n < desired_clk; n++)
 		{
 			data_bus = 0;
-			inputs[(size_t)APUSim::APU_Input::CLK] = CLK;
+			inputs.set((size_t)APUSim::APU_Input::CLK, CLK);
 			apu->sim(inputs, outputs, &data_bus, &addr_bus, aux);
 			CLK = NOT(CLK);
 
 			data_bus = 0;
-			inputs[(size_t)APUSim::APU_Input::CLK] = CLK;
+			inputs.set((size_t)APUSim::APU_Input::CLK, CLK);
 			apu->sim(inputs, outputs, &data_bus, &addr_bus, aux);
 			CLK = NOT(CLK);
 		}
@@ -14,9 +14,12 @@ namespace APUSimUnitTest
 		~UnitTest();
 
 		bool TestCounters();
+		bool TestWordCounters();
+		bool TestWordRegisters();
 		bool TestDiv(bool trace);
 		bool TestAclk();
 		bool TestLFO(bool mode);
+		bool TestSoftCLKTable();
 		bool TestRegOps();
 		bool TestLengthDecoder();
 		bool TestLengthCounter();
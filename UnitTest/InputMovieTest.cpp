@@ -0,0 +1,199 @@
+#include "pch.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace BreaksCoreUnitTest
+{
+	InputMovieTest::InputMovieTest()
+	{
+		BuildImage();
+	}
+
+	InputMovieTest::~InputMovieTest()
+	{
+		delete[] nes_image;
+	}
+
+	/// <summary>
+	/// NROM-128: the program strobes the controller, reads 8 buttons, adds them to $00 and stores the sums at $0300,X; forever.
+	/// </summary>
+	void InputMovieTest::BuildImage()
+	{
+		static const uint8_t program[] = {
+			0x78,					// C000: SEI
+			0xd8,					// C001: CLD
+			0xa2, 0xff,				// C002: LDX #$FF
+			0x9a,					// C004: TXS
+			0xa9, 0x01,				// C005: LDA #1			(loop)
+			0x8d, 0x16, 0x40,		// C007: STA $4016
+			0xa9, 0x00,				// C00A: LDA #0
+			0x8d, 0x16, 0x40,		// C00C: STA $4016
+			0xa0, 0x08,				// C00F: LDY #8
+			0xad, 0x16, 0x40,		// C011: LDA $4016		(read)
+			0x29, 0x01,				// C014: AND #1
+			0x18,					// C016: CLC
+			0x65, 0x00,				// C017: ADC $00
+			0x85, 0x00,				// C019: STA $00
+			0x9d, 0x00, 0x03,		// C01B: STA $0300,X
+			0xe8,					// C01E: INX
+			0x88,					// C01F: DEY
+			0xd0, 0xef,				// C020: BNE read
+			0x4c, 0x05, 0xc0,		// C022: JMP loop
+		};
+
+		const size_t prg_size = 0x4000;
+		const size_t chr_size = 0x2000;
+
+		nes_image_size = 16 + prg_size + chr_size;
+		nes_image = new uint8_t[nes_image_size];
+		memset(nes_image, 0, nes_image_size);
+
+		uint8_t* header = nes_image;
+		header[0] = 'N'; header[1] = 'E'; header[2] = 'S'; header[3] = 0x1a;
+		header[4] = 1;		// 16K PRG
+		header[5] = 1;		// 8K CHR
+
+		uint8_t* prg = nes_image + 16;
+		memcpy(prg, program, sizeof(program));
+
+		// NMI, RESET, IRQ -> $C000
+
+		for (size_t n = 0; n < 3; n++)
+		{
+			prg[0x3ffa + 2 * n] = 0x00;
+			prg[0x3ffa + 2 * n + 1] = 0xc0;
+		}
+	}
+
+	/// <summary>
+	/// Run the board from Reset and get the hash of the 6502 state, taken every 64 half cycles once the CPU is out of reset.
+	/// The frontend input (IOSetState) comes at fixed points; during playback it must be dropped.
+	/// </summary>
+	uint64_t InputMovieTest::Run(RunMode mode, const char* movie_name, size_t half_cycles, uint64_t* entries, uint64_t* dropped)
+	{
+		uint64_t hash = 14695981039346656037ULL;
+
+		CreateBoard((char*)"NES", (char*)"RP2A03G", (char*)"RP2C02G", (char*)"NES");
+		InsertCartridge(nes_image, nes_image_size);
+
+		size_t handle = IOCreateInstance((uint32_t)IO::DeviceID::NESController);
+		IOAttach(0, handle);
+
+		Reset();
+
+		// The NES board holds the CPU in reset for a long time (see NESBoard::Reset), the program must get to reading the controller
+
+		for (size_t n = 0; n < cpu_reset_half_cycles; n++)
+		{
+			Step();
+		}
+
+		if (mode == RunMode::Record)
+		{
+			StartInputRecording((char*)movie_name);
+		}
+		else if (mode == RunMode::Playback)
+		{
+			StartInputPlayback((char*)movie_name);
+		}
+
+		for (size_t n = 0; n < half_cycles; n++)
+		{
+			if (mode != RunMode::NoInput && (n % 20000) == 10000)
+			{
+				size_t press = n / 20000;
+				IOSetState(handle, press % 8, (uint32_t)((press / 8) & 1) ^ 1);
+			}
+
+			Step();
+
+			if ((n % 64) == 0)
+			{
+				M6502Core::DebugInfo info{};
+				GetAllCoreDebugInfo(&info);
+
+				uint8_t* ptr = (uint8_t*)&info;
+				for (size_t i = 0; i < sizeof(info); i++)
+				{
+					hash ^= ptr[i];
+					hash *= 1099511628211ULL;
+				}
+			}
+		}
+
+		uint64_t phi;
+		GetInputMovieState(&phi, entries, dropped);
+
+		StopInputMovie();
+		IODetach(0, handle);
+		IODisposeInstance(handle);
+		EjectCartridge();
+		DestroyBoard();
+
+		return hash;
+	}
+
+	bool InputMovieTest::TestRecordReplay(size_t half_cycles)
+	{
+		const char* movie_name = "InputMovieTest.bnmv";
+		uint64_t rec_entries = 0, rec_dropped = 0;
+		uint64_t play_entries = 0, play_dropped = 0;
+		uint64_t entries, dropped;
+		char text[0x100]{};
+
+		uint64_t no_input = Run(RunMode::NoInput, nullptr, half_cycles, &entries, &dropped);
+		uint64_t recorded = Run(RunMode::Record, movie_name, half_cycles, &rec_entries, &rec_dropped);
+		uint64_t played = Run(RunMode::Playback, movie_name, half_cycles, &play_entries, &play_dropped);
+
+		sprintf_s(text, sizeof(text), "no input: %016llx, recorded: %016llx (%llu changes, %llu dropped), played: %016llx (%llu changes, %llu dropped)\n",
+			no_input, recorded, rec_entries, rec_dropped, played, play_entries, play_dropped);
+		Logger::WriteMessage(text);
+
+		remove(movie_name);
+
+		// The input must change the run (otherwise the test proves nothing), the playback must repeat it exactly and drop the frontend input
+
+		return rec_entries != 0 && rec_dropped == 0 &&
+			recorded != no_input &&
+			played == recorded && play_entries == rec_entries && play_dropped == rec_entries;
+	}
+
+	bool InputMovieTest::TestInputWhilePaused(size_t changes)
+	{
+		const char* movie_name = "InputMovieTest_paused.bnmv";
+		uint64_t phi, entries, dropped;
+		char text[0x100]{};
+
+		CreateBoard((char*)"NES", (char*)"RP2A03G", (char*)"RP2C02G", (char*)"NES");
+		InsertCartridge(nes_image, nes_image_size);
+		size_t handle = IOCreateInstance((uint32_t)IO::DeviceID::NESController);
+		IOAttach(0, handle);
+		Reset();
+		StartInputRecording((char*)movie_name);
+
+		for (size_t n = 0; n < changes; n++)
+		{
+			IOSetState(handle, n % 8, (uint32_t)(n & 1));
+		}
+
+		GetInputMovieState(&phi, &entries, &dropped);
+		uint64_t dropped_paused = dropped;
+
+		// The queued changes are taken by the first half cycle
+
+		Step();
+		GetInputMovieState(&phi, &entries, &dropped);
+
+		sprintf_s(text, sizeof(text), "%zu changes while paused: %llu dropped, %llu recorded after one step\n", changes, dropped_paused, entries);
+		Logger::WriteMessage(text);
+
+		StopInputMovie();
+		IODetach(0, handle);
+		IODisposeInstance(handle);
+		EjectCartridge();
+		DestroyBoard();
+		remove(movie_name);
+
+		return dropped_paused != 0 && entries + dropped_paused == changes;
+	}
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+namespace BreaksCoreUnitTest
+{
+	/// <summary>
+	/// Checks that the input movie repeats the run bit for bit.
+	/// The NES board runs a small NROM program that keeps reading the controller and accumulating the buttons in the registers.
+	/// </summary>
+	class InputMovieTest
+	{
+		enum class RunMode
+		{
+			NoInput = 0,
+			Record,
+			Playback,
+		};
+
+		// NESBoard::Reset keeps the CPU in reset for 6400000 CLK half cycles; a little more to get to the program
+
+		static const size_t cpu_reset_half_cycles = 6500000;
+
+		uint8_t* nes_image = nullptr;
+		size_t nes_image_size = 0;
+
+		void BuildImage();
+		uint64_t Run(RunMode mode, const char* movie_name, size_t half_cycles, uint64_t* entries, uint64_t* dropped);
+
+	public:
+		InputMovieTest();
+		~InputMovieTest();
+
+		bool TestRecordReplay(size_t half_cycles);
+
+		/// <summary>
+		/// The frontend input must not wait for the simulation thread: while the simulation does not run, the changes that do not fit into the queue are dropped.
+		/// </summary>
+		bool TestInputWhilePaused(size_t changes);
+	};
+}
@@ -105,23 +105,23 @@ namespace PPUSimUnitTest
 
 	bool UnitTest::RunSingleHalfCLK(TriState CLK, TriState n_RES)
 	{
-		TriState inputs[(size_t)InputPad::Max]{};
-		TriState outputs[(size_t)OutputPad::Max]{};
+		Pins32 inputs{};
+		Pins32 outputs{};
 		uint8_t ext = 0;
 		uint8_t data_bus = 0;
 		uint8_t ad_bus = 0;
 		uint8_t addrHi_bus = 0;
 		VideoOutSignal vout{};
 
-		inputs[(size_t)InputPad::RnW] = TriState::Zero;
-		inputs[(size_t)InputPad::RS0] = TriState::Zero;
-		inputs[(size_t)InputPad::RS1] = TriState::Zero;
-		inputs[(size_t)InputPad::RS2] = TriState::Zero;
-		inputs[(size_t)InputPad::n_DBE] = TriState::One;
+		inputs.set((size_t)InputPad::RnW, TriState::Zero);
+		inputs.set((size_t)InputPad::RS0, TriState::Zero);
+		inputs.set((size_t)InputPad::RS1, TriState::Zero);
+		inputs.set((size_t)InputPad::RS2, TriState::Zero);
+		inputs.set((size_t)InputPad::n_DBE, TriState::One);
 
-		inputs[(size_t)InputPad::n_RES] = n_RES;
+		inputs.set((size_t)InputPad::n_RES, n_RES);
 
-		inputs[(size_t)InputPad::CLK] = CLK;
+		inputs.set((size_t)InputPad::CLK, CLK);
 		ppu->sim(inputs, outputs, &ext, &data_bus, &ad_bus, &addrHi_bus, vout);
 
 		return true;
@@ -134,21 +134,21 @@ namespace PPUSimUnitTest
 	/// <returns></returns>
 	bool UnitTest::RunSinglePCLK()
 	{
-		TriState inputs[(size_t)InputPad::Max]{};
-		TriState outputs[(size_t)OutputPad::Max]{};
+		Pins32 inputs{};
+		Pins32 outputs{};
 		uint8_t ext = 0;
 		uint8_t data_bus = 0;
 		uint8_t ad_bus = 0;
 		uint8_t addrHi_bus = 0;
 		VideoOutSignal vout{};
 
-		inputs[(size_t)InputPad::RnW] = TriState::Zero;
-		inputs[(size_t)InputPad::RS0] = TriState::Zero;
-		inputs[(size_t)InputPad::RS1] = TriState::Zero;
-		inputs[(size_t)InputPad::RS2] = TriState::Zero;
-		inputs[(size_t)InputPad::n_DBE] = TriState::One;
+		inputs.set((size_t)InputPad::RnW, TriState::Zero);
+		inputs.set((size_t)InputPad::RS0, TriState::Zero);
+		inputs.set((size_t)InputPad::RS1, TriState::Zero);
+		inputs.set((size_t)InputPad::RS2, TriState::Zero);
+		inputs.set((size_t)InputPad::n_DBE, TriState::One);
 
-		inputs[(size_t)InputPad::n_RES] = TriState::One;
+		inputs.set((size_t)InputPad::n_RES, TriState::One);
 
 		// Iterate over CLK until the internal PCLK counter changes value.
 
@@ -156,11 +156,11 @@ namespace PPUSimUnitTest
 
 		while (prevPclk == ppu->GetPCLKCounter())
 		{
-			inputs[(size_t)InputPad::CLK] = TriState::Zero;
+			inputs.set((size_t)InputPad::CLK, TriState::Zero);
 
 			ppu->sim(inputs, outputs, &ext, &data_bus, &ad_bus, &addrHi_bus, vout);
 
-			inputs[(size_t)InputPad::CLK] = TriState::One;
+			inputs.set((size_t)InputPad::CLK, TriState::One);
 
 			ppu->sim(inputs, outputs, &ext, &data_bus, &ad_bus, &addrHi_bus, vout);
 		}
@@ -636,12 +636,12 @@ namespace PPUSimUnitTest
 
 		// Load value
 
-		Unpack((uint8_t)v, ppu->wire.OB);
-		
+		uint8_t OB = (uint8_t)v;
+
 		lane.UPD = TriState::Zero;
 		lane.LOAD = TriState::One;
 		lane.STEP = TriState::Zero;
-		carry_out = lane.sim_Counter();
+		carry_out = lane.sim_Counter(OB);
 
 		if (v == 0)
 		{
@@ -659,7 +659,7 @@ namespace PPUSimUnitTest
 		lane.UPD = TriState::One;
 		lane.LOAD = TriState::Zero;
 		lane.STEP = TriState::Zero;
-		carry_out = lane.sim_Counter();
+		carry_out = lane.sim_Counter(OB);
 
 		if (lane.get_Counter() != v)
 			return false;
@@ -671,7 +671,7 @@ namespace PPUSimUnitTest
 			lane.UPD = TriState::Zero;
 			lane.LOAD = TriState::Zero;
 			lane.STEP = TriState::One;
-			carry_out = lane.sim_Counter();
+			carry_out = lane.sim_Counter(OB);
 
 			if (carry_out != TriState::Zero)
 				return false;
@@ -679,7 +679,7 @@ namespace PPUSimUnitTest
 			lane.UPD = TriState::One;
 			lane.LOAD = TriState::Zero;
 			lane.STEP = TriState::Zero;
-			carry_out = lane.sim_Counter();
+			carry_out = lane.sim_Counter(OB);
 
 			v--;
 
@@ -695,7 +695,7 @@ namespace PPUSimUnitTest
 		lane.UPD = TriState::Zero;
 		lane.LOAD = TriState::Zero;
 		lane.STEP = TriState::One;
-		carry_out = lane.sim_Counter();
+		carry_out = lane.sim_Counter(OB);
 
 		if (carry_out != TriState::One)
 			return false;
@@ -715,24 +715,18 @@ namespace PPUSimUnitTest
 
 		// Load a value on one register and an inverse value on the other register.
 
-		TriState tx[8]{};
-		TriState ntx[8]{};
-		TriState unused[8]{};
-
-		Unpack(val, tx);
-		Unpack(~val, ntx);
-		uint8_t packed_tx = Pack(tx);
-		uint8_t packed_ntx = Pack(ntx);
+		uint8_t packed_tx = val;
+		uint8_t packed_ntx = ~val;
 
 		ppu->wire.n_PCLK = TriState::Zero;
 		lane.T_SR0 = TriState::One;
 		lane.T_SR1 = TriState::Zero;
 		lane.SR_EN = TriState::Zero;
-		lane.sim_PairedSR(tx, packed_tx);
+		lane.sim_PairedSR(packed_tx);
 
 		lane.T_SR0 = TriState::Zero;
 		lane.T_SR1 = TriState::One;
-		lane.sim_PairedSR(ntx, packed_ntx);
+		lane.sim_PairedSR(packed_ntx);
 
 		// Perform 8 shift iterations and check the output.
 
@@ -743,11 +737,11 @@ namespace PPUSimUnitTest
 		{
 			ppu->wire.n_PCLK = TriState::One;
 			lane.SR_EN = TriState::Zero;
-			lane.sim_PairedSR(unused, 0);
+			lane.sim_PairedSR(0);
 
 			ppu->wire.n_PCLK = TriState::Zero;
 			lane.SR_EN = TriState::One;
-			lane.sim_PairedSR(unused, 0);
+			lane.sim_PairedSR(0);
 
 			if ((lane.nZ_COL0 == TriState::One ? 1 : 0) != (val & 1))
 				return false;
@@ -762,11 +756,11 @@ namespace PPUSimUnitTest
 
 		ppu->wire.n_PCLK = TriState::One;
 		lane.SR_EN = TriState::Zero;
-		lane.sim_PairedSR(unused, 0);
+		lane.sim_PairedSR(0);
 
 		ppu->wire.n_PCLK = TriState::Zero;
 		lane.SR_EN = TriState::One;
-		lane.sim_PairedSR(unused, 0);
+		lane.sim_PairedSR(0);
 
 		if (lane.nZ_COL0 != TriState::One)
 			return false;
@@ -967,15 +961,15 @@ namespace PPUSimUnitTest
 		uint8_t addrHi_bus = 0;
 		PPUSim::VideoOutSignal vout{};
 
-		TriState inputs[(size_t)PPUSim::InputPad::Max]{};
-		TriState outputs[(size_t)PPUSim::OutputPad::Max]{};
+		Pins32 inputs{};
+		Pins32 outputs{};
 
-		inputs[(size_t)InputPad::n_RES] = TriState::One;		// Not neccessary
-		inputs[(size_t)InputPad::n_DBE] = TriState::One;		// CPU I/F disabled
-		inputs[(size_t)InputPad::RnW] = TriState::One;
-		inputs[(size_t)InputPad::RS0] = TriState::Zero;
-		inputs[(size_t)InputPad::RS1] = TriState::Zero;
-		inputs[(size_t)InputPad::RS2] = TriState::Zero;
+		inputs.set((size_t)InputPad::n_RES, TriState::One);		// Not neccessary
+		inputs.set((size_t)InputPad::n_DBE, TriState::One);		// CPU I/F disabled
+		inputs.set((size_t)InputPad::RnW, TriState::One);
+		inputs.set((size_t)InputPad::RS0, TriState::Zero);
+		inputs.set((size_t)InputPad::RS1, TriState::Zero);
+		inputs.set((size_t)InputPad::RS2, TriState::Zero);
 
 		// Enable forced rendering. With rendering enabled, all blocks of the PPU will be engaged
 
@@ -988,12 +982,12 @@ namespace PPUSimUnitTest
 		for (size_t n = 0; n < desired_clk; n++)
 		{
 			ad_bus = 0;
-			inputs[(size_t)InputPad::CLK] = CLK;
+			inputs.set((size_t)InputPad::CLK, CLK);
 			ppu->sim(inputs, outputs, &ext_bus, &data_bus, &ad_bus, &addrHi_bus, vout);
 			CLK = NOT(CLK);
 
 			ad_bus = 0;
-			inputs[(size_t)InputPad::CLK] = CLK;
+			inputs.set((size_t)InputPad::CLK, CLK);
 			ppu->sim(inputs, outputs, &ext_bus, &data_bus, &ad_bus, &addrHi_bus, vout);
 			CLK = NOT(CLK);
 		}
@@ -1013,4 +1007,62 @@ namespace PPUSimUnitTest
 		return delta <= 1000;
 	}
 
+
+	/// <summary>
+	/// Microbenchmark of the sprite FIFO alone (8 lanes + priority circuit).
+	/// The FIFO is fed with a synthetic scanline: the sprite fetch phase loads the lanes, the visible part shifts them out.
+	/// </summary>
+	/// <param name="desired_pclk">Desired PCLK rate per second (Hz)</param>
+	/// <returns></returns>
+	bool UnitTest::FIFOMegaCyclesTest(size_t desired_pclk)
+	{
+		char text[0x100]{};
+		uint8_t rnd = 0x5a;
+
+		auto stamp1 = GetTickCount64();
+
+		for (size_t n = 0; n < desired_pclk; n++)
+		{
+			size_t h = n % 341;
+
+			ppu->wire.H0_Dash2 = (h & 1) ? TriState::One : TriState::Zero;
+			ppu->wire.H1_Dash2 = (h & 2) ? TriState::One : TriState::Zero;
+			ppu->wire.H2_Dash2 = (h & 4) ? TriState::One : TriState::Zero;
+			ppu->wire.H3_Dash2 = (h & 8) ? TriState::One : TriState::Zero;
+			ppu->wire.H4_Dash2 = (h & 0x10) ? TriState::One : TriState::Zero;
+			ppu->wire.H5_Dash2 = (h & 0x20) ? TriState::One : TriState::Zero;
+			ppu->fsm.PARO = (h >= 256 && h < 320) ? TriState::One : TriState::Zero;
+			ppu->fsm.nVIS = h < 256 ? TriState::Zero : TriState::One;
+			ppu->fsm.ZHPOS = h == 339 ? TriState::One : TriState::Zero;
+			ppu->wire.PD_FIFO = TriState::One;
+			ppu->wire.CLPO = TriState::Zero;
+
+			rnd = (rnd << 1) | (((rnd >> 7) ^ (rnd >> 5) ^ (rnd >> 4) ^ (rnd >> 3)) & 1);
+			ppu->PD = rnd;
+			Unpack((uint8_t)(h < 256 ? 0 : rnd), ppu->wire.OB);
+
+			n_pclk();
+			ppu->fifo->sim_SpriteH();
+			ppu->fifo->sim();
+
+			pclk();
+			ppu->fifo->sim_SpriteH();
+			ppu->fifo->sim();
+		}
+
+		auto stamp2 = GetTickCount64();
+		int delta = (int)(stamp2 - stamp1);
+
+		sprintf_s(text, sizeof(text), "FIFO executed %zd PCLK in real %d msec\n", desired_pclk, delta);
+		Logger::WriteMessage(text);
+
+		if (delta > 1000)
+		{
+			sprintf_s(text, sizeof(text), "You're %.2f times slower :(\n", (float)delta / 1000.f);
+			Logger::WriteMessage(text);
+		}
+
+		return delta <= 1000;
+	}
+
 }
@@ -52,5 +52,12 @@ namespace PPUSimUnitTest
 		/// <param name="desired_clk">Desired cycle rate per second (Hz)</param>
 		/// <returns></returns>
 		bool MegaCyclesTest(size_t desired_clk);
+
+		/// <summary>
+		/// Sprite FIFO microbenchmark. Run the FIFO alone for the specified number of PCLK cycles.
+		/// </summary>
+		/// <param name="desired_pclk">Desired PCLK rate per second (Hz)</param>
+		/// <returns></returns>
+		bool FIFOMegaCyclesTest(size_t desired_pclk);
 	};
 }
@@ -59,6 +59,46 @@ namespace UnitTest
 				Assert::IsTrue(MUX3(sel, in) == TriState::One);
 			}
 		}
+
+		TEST_METHOD(TestPinBundle)
+		{
+			Pins32 pins{};
+			TriState vals[4] = { TriState::Zero, TriState::One, TriState::Z, TriState::X };
+
+			for (size_t n = 0; n < 32; n++)
+			{
+				Assert::IsTrue(pins.get(n) == TriState::Zero);
+			}
+
+			for (size_t n = 0; n < 32; n++)
+			{
+				pins.set(n, vals[n & 3]);
+			}
+			for (size_t n = 0; n < 32; n++)
+			{
+				Assert::IsTrue(pins.get(n) == vals[n & 3]);
+			}
+
+			pins.set_bus(4, 8, 0x1a5);
+			Assert::IsTrue(pins.get_bus(4, 8) == 0xa5);
+			Assert::IsTrue(pins.is_driven(4, 8));
+			Assert::IsTrue(pins.get(3) == TriState::X);
+			Assert::IsTrue(pins.get(12) == TriState::Zero);
+
+			pins.float_bus(6, 4);
+			Assert::IsTrue(!pins.is_driven(4, 8));
+			Assert::IsTrue(pins.get(5) == TriState::Zero);
+			Assert::IsTrue(pins.get(6) == TriState::Z);
+			Assert::IsTrue(pins.get(9) == TriState::Z);
+			Assert::IsTrue(pins.get(11) == TriState::One);
+
+			Pins64 wide{};
+			wide.set_bus(0, 64, ~0ULL);
+			Assert::IsTrue(wide.get_bus(0, 64) == ~0ULL);
+			wide.set(63, TriState::Z);
+			Assert::IsTrue(wide.get(63) == TriState::Z);
+			Assert::IsTrue(!wide.is_driven(32, 32));
+		}
 	};
 
 	TEST_CLASS(CoreUnitTest)
@@ -103,6 +143,18 @@ namespace UnitTest
 			Assert::IsTrue(ut.TestCounters());
 		}
 
+		TEST_METHOD(TestWordCounters)
+		{
+			APUSimUnitTest::UnitTest ut(APUSim::Revision::RP2A03G);
+			Assert::IsTrue(ut.TestWordCounters());
+		}
+
+		TEST_METHOD(TestWordRegisters)
+		{
+			APUSimUnitTest::UnitTest ut(APUSim::Revision::RP2A03G);
+			Assert::IsTrue(ut.TestWordRegisters());
+		}
+
 		TEST_METHOD(TestDiv)
 		{
 			APUSimUnitTest::UnitTest ut(APUSim::Revision::RP2A03G);
@@ -122,6 +174,12 @@ namespace UnitTest
 			Assert::IsTrue(ut.TestLFO(true));
 		}
 
+		TEST_METHOD(TestSoftCLKTable)
+		{
+			APUSimUnitTest::UnitTest ut(APUSim::Revision::RP2A03G);
+			Assert::IsTrue(ut.TestSoftCLKTable());
+		}
+
 		TEST_METHOD(TestRegOps)
 		{
 			APUSimUnitTest::UnitTest ut(APUSim::Revision::RP2A03G);
@@ -270,6 +328,15 @@ namespace UnitTest
 			}
 		}
 
+		//BEGIN_TEST_METHOD_ATTRIBUTE(TestFIFOMegaCycles)
+		//	TEST_IGNORE()
+		//END_TEST_METHOD_ATTRIBUTE()
+		TEST_METHOD(TestFIFOMegaCycles)
+		{
+			PPUSimUnitTest::UnitTest ut(PPUSim::Revision::RP2C02G);
+			Assert::IsTrue(ut.FIFOMegaCyclesTest(5'369318));	// 21.477272 MHz ÷ 4
+		}
+
 		TEST_METHOD(TestNtscPpuChromaDecoderOutputs)
 		{
 			PPUSimUnitTest::UnitTest ut(PPUSim::Revision::RP2C02G);
@@ -318,4 +385,20 @@ namespace UnitTest
 			Assert::IsTrue(test.TestSequence(0x55));
 		}
 	};
+
+	TEST_CLASS(BreaksCoreUnitTest)
+	{
+	public:
+		TEST_METHOD(TestInputMovieReplay)
+		{
+			BreaksCoreUnitTest::InputMovieTest test{};
+			Assert::IsTrue(test.TestRecordReplay(600000));
+		}
+
+		TEST_METHOD(TestInputMovieWhilePaused)
+		{
+			BreaksCoreUnitTest::InputMovieTest test{};
+			Assert::IsTrue(test.TestInputWhilePaused(1000));
+		}
+	};
 }
@@ -15,6 +15,8 @@
 
 #include "../IO/CD4021.h"
 
+#include "../Breaknes/BreaksCore/BreaksCore.h"
+
 #include "../Common/JsonLib/Json.h"
 #include "EventLog.h"
 
@@ -22,5 +24,6 @@
 #include "APUTest.h"
 #include "PPUTest.h"
 #include "CD4021UnitTest.h"
+#include "InputMovieTest.h"
 
 #include "CppUnitTest.h"